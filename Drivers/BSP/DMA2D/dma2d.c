@@ -0,0 +1,188 @@
+/**
+ ****************************************************************************************************
+ * @file        dma2d.c
+ * @author      ALIENTEK
+ * @version     V1.0
+ * @date        2022-04-20
+ * @brief       DMA2D传输驱动
+ * @license     MIT
+ ****************************************************************************************************
+ * @attention
+ *
+ * 同一时间只能有一个传输. 新的传输先等待上一次异步传输完成,
+ * 异步传输的完成回调函数在DMA2D中断中调用.
+ *
+ ****************************************************************************************************
+ */
+
+#include "./BSP/DMA2D/dma2d.h"
+
+
+static volatile uint8_t g_dma2d_busy = 0;               /* 1,DMA2D异步传输进行中 */
+static volatile dma2d_done_cb_t g_dma2d_done_cb = 0;    /* DMA2D异步传输完成回调函数 */
+
+static void dma2d_start(const dma2d_xfer_t *xfer, uint8_t it);
+static void dma2d_abort(void);
+
+/**
+ * @brief       DMA2D传输, 等待传输完成
+ * @param       xfer        : 传输参数
+ * @retval      0, 成功;
+ *              1, 超时(本次或之前的异步传输已被中止);
+ */
+uint8_t dma2d_transfer(const dma2d_xfer_t *xfer)
+{
+    uint32_t timeout = 0;
+    uint8_t res;
+
+    res = dma2d_wait();                                     /* 等待异步传输完成 */
+    dma2d_start(xfer, 0);
+
+    while ((DMA2D->ISR & DMA2D_FLAG_TC) == 0)               /* 等待传输完成 */
+    {
+        timeout++;
+
+        if (timeout > DMA2D_WAIT_TIMEOUT)                   /* 超时, 中止传输 */
+        {
+            dma2d_abort();
+            return 1;
+        }
+    }
+
+    DMA2D->IFCR |= DMA2D_FLAG_TC;                           /* 清除传输完成标志 */
+
+    return res;
+}
+
+/**
+ * @brief       启动DMA2D传输, 不等待传输完成
+ * @note        传输完成(或出错)后在DMA2D中断中调用done_cb, 在此之前xfer->src指向的数据不能修改.
+ * @param       xfer        : 传输参数
+ * @param       done_cb     : 传输完成回调函数(中断中调用), 可以为0
+ * @retval      0, 成功;
+ *              1, 上一次异步传输超时, 已被中止(其回调函数不会被调用), 本次传输仍然启动;
+ */
+uint8_t dma2d_transfer_async(const dma2d_xfer_t *xfer, dma2d_done_cb_t done_cb)
+{
+    uint8_t res;
+
+    res = dma2d_wait();                                     /* 等待上一次异步传输完成 */
+
+    g_dma2d_done_cb = done_cb;
+    g_dma2d_busy = 1;
+    dma2d_start(xfer, 1);
+
+    return res;
+}
+
+/**
+ * @brief       等待DMA2D异步传输完成
+ * @note        超时则中止传输, 清除忙标志, 不再调用其完成回调函数.
+ * @param       无
+ * @retval      0, 成功;
+ *              1, 超时, 传输已被中止;
+ */
+uint8_t dma2d_wait(void)
+{
+    uint32_t timeout = 0;
+
+    while (g_dma2d_busy)
+    {
+        timeout++;
+
+        if (timeout > DMA2D_WAIT_TIMEOUT)                   /* 超时, 中止传输 */
+        {
+            dma2d_abort();
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * @brief       配置DMA2D并启动传输
+ * @param       xfer        : 传输参数
+ * @param       it          : 1,使能DMA2D中断; 0,不使能
+ * @retval      无
+ */
+static void dma2d_start(const dma2d_xfer_t *xfer, uint8_t it)
+{
+    __HAL_RCC_DMA2D_CLK_ENABLE();                           /* 使能DMA2D时钟 */
+
+    DMA2D->CR = xfer->mode;                                 /* 设置模式, 停止DMA2D, 关闭中断 */
+    DMA2D->OPFCCR = xfer->pixformat;                        /* 设置输出颜色格式 */
+    DMA2D->OOR = xfer->dst_offline;                         /* 设置输出行偏移 */
+    DMA2D->OMAR = DMA2D_ADDR(xfer->dst);                    /* 输出存储器地址 */
+    DMA2D->NLR = xfer->height | (xfer->width << 16);        /* 设定行数寄存器 */
+
+    if (xfer->mode == DMA2D_R2M)
+    {
+        DMA2D->OCOLR = xfer->color;                         /* 设定输出颜色寄存器 */
+    }
+    else
+    {
+        DMA2D->FGPFCCR = xfer->pixformat;                   /* 设置前景层颜色格式 */
+        DMA2D->FGOR = xfer->src_offline;                    /* 设置前景层行偏移 */
+        DMA2D->FGMAR = DMA2D_ADDR(xfer->src);               /* 源地址 */
+    }
+
+    if (it)
+    {
+        DMA2D->CR |= DMA2D_CR_TCIE | DMA2D_CR_TEIE | DMA2D_CR_CEIE; /* 使能传输完成/传输错误/配置错误中断 */
+    }
+
+    DMA2D->CR |= DMA2D_CR_START;                            /* 启动DMA2D */
+}
+
+/**
+ * @brief       中止DMA2D传输
+ * @note        等待DMA2D停止后关闭中断, 清除标志, 忙标志和完成回调函数.
+ * @param       无
+ * @retval      无
+ */
+static void dma2d_abort(void)
+{
+    uint32_t timeout = 0;
+
+    DMA2D->CR |= DMA2D_CR_ABORT;                            /* 中止传输 */
+
+    while (DMA2D->CR & DMA2D_CR_START)                      /* 等待DMA2D停止 */
+    {
+        timeout++;
+
+        if (timeout > DMA2D_WAIT_TIMEOUT)break;             /* 超时退出 */
+    }
+
+    DMA2D->CR &= ~(DMA2D_CR_TCIE | DMA2D_CR_TEIE | DMA2D_CR_CEIE);    /* 关闭中断 */
+    DMA2D->IFCR |= DMA2D_FLAG_TC | DMA2D_FLAG_TE | DMA2D_FLAG_CE;      /* 清除中断标志 */
+
+    g_dma2d_done_cb = 0;
+    g_dma2d_busy = 0;
+}
+
+/**
+ * @brief       DMA2D中断服务函数
+ * @note        异步传输完成(或出错)时清除标志并调用完成回调函数
+ * @param       无
+ * @retval      无
+ */
+void DMA2D_IRQHandler(void)
+{
+    dma2d_done_cb_t cb;
+
+    if (DMA2D->ISR & (DMA2D_FLAG_TC | DMA2D_FLAG_TE | DMA2D_FLAG_CE))
+    {
+        DMA2D->IFCR |= DMA2D_FLAG_TC | DMA2D_FLAG_TE | DMA2D_FLAG_CE;      /* 清除中断标志 */
+        DMA2D->CR &= ~(DMA2D_CR_TCIE | DMA2D_CR_TEIE | DMA2D_CR_CEIE);    /* 关闭中断 */
+
+        cb = g_dma2d_done_cb;
+        g_dma2d_done_cb = 0;
+        g_dma2d_busy = 0;
+
+        if (cb)
+        {
+            cb();
+        }
+    }
+}
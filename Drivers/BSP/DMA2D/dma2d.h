@@ -0,0 +1,57 @@
+/**
+ ****************************************************************************************************
+ * @file        dma2d.h
+ * @author      ALIENTEK
+ * @version     V1.0
+ * @date        2022-04-20
+ * @brief       DMA2D传输驱动头文件
+ * @license     MIT
+ ****************************************************************************************************
+ * @attention
+ *
+ * 同步/异步(中断)传输, 等待, 超时中止和DMA2D中断服务函数.
+ * LTDC驱动和LVGL的刷新函数通过此接口使用DMA2D, 主机测试中寄存器由DMA2D模型提供.
+ *
+ ****************************************************************************************************
+ */
+
+#ifndef __DMA2D_H
+#define __DMA2D_H
+
+#include "./SYSTEM/sys/sys.h"
+
+
+/******************************************************************************************/
+/* DMA2D配置 */
+
+/* 等待传输完成的最大循环次数, 超过则中止传输 */
+#define DMA2D_WAIT_TIMEOUT              0X1FFFFF
+
+/* 32位地址寄存器使用的地址, 主机测试中由DMA2D模型重新定义 */
+#ifndef DMA2D_ADDR
+#define DMA2D_ADDR(p)                   ((uint32_t)(p))
+#endif
+
+/******************************************************************************************/
+
+typedef void (*dma2d_done_cb_t)(void);      /* DMA2D异步传输完成回调函数 */
+
+/* DMA2D传输参数 */
+typedef struct
+{
+    uint32_t mode;          /* 传输模式: DMA2D_R2M, 寄存器到存储器; DMA2D_M2M, 存储器到存储器 */
+    uint32_t pixformat;     /* 颜色格式, 前景层和输出相同 */
+    const void *src;        /* 源地址, 仅DMA2D_M2M使用 */
+    uint32_t color;         /* 填充颜色, 仅DMA2D_R2M使用 */
+    void *dst;              /* 输出地址 */
+    uint16_t width;         /* 每行像素数 */
+    uint16_t height;        /* 行数 */
+    uint16_t src_offline;   /* 源行偏移(像素) */
+    uint16_t dst_offline;   /* 输出行偏移(像素) */
+} dma2d_xfer_t;
+
+uint8_t dma2d_transfer(const dma2d_xfer_t *xfer);                                   /* 传输并等待完成 */
+uint8_t dma2d_transfer_async(const dma2d_xfer_t *xfer, dma2d_done_cb_t done_cb);    /* 启动传输, 完成后在中断中调用done_cb */
+uint8_t dma2d_wait(void);                                                           /* 等待异步传输完成 */
+
+#endif
@@ -34,9 +34,10 @@ DMA2D_HandleTypeDef g_dma2d_handle;      /* DMA2D
 /* ݲͬɫʽ,֡ */
 #if LTDC_PIXFORMAT == LTDC_PIXFORMAT_ARGB8888 || LTDC_PIXFORMAT == LTDC_PIXFORMAT_RGB888
     uint32_t ltdc_lcd_framebuf[1280][800] __attribute__((at(LTDC_FRAME_BUF_ADDR)));   /* ֱʱ,LTDC֡С */
+    uint32_t ltdc_lcd_framebuf1[1280][800] __attribute__((at(LTDC_FRAME_BUF_ADDR + LTDC_FRAME_BUF_SIZE)));   /* ڶ֡,˫巭ҳʱʹ */
 #else
     uint16_t ltdc_lcd_framebuf[1280][800] __attribute__((at(LTDC_FRAME_BUF_ADDR)));   /* ֱʱ,LTDC֡С */
-//    uint16_t ltdc_lcd_framebuf1[1280][800] __attribute__((at(LTDC_FRAME_BUF_ADDR + 1280 * 800 * 2)));   /* ʹLTDC2ʱʹ(ĬʹLTDC1) */
+    uint16_t ltdc_lcd_framebuf1[1280][800] __attribute__((at(LTDC_FRAME_BUF_ADDR + LTDC_FRAME_BUF_SIZE)));   /* ڶ֡,˫巭ҳʱʹ */
 #endif
 
 #else      /* ʹAC6ʱ */
@@ -44,8 +45,10 @@ DMA2D_HandleTypeDef g_dma2d_handle;      /* DMA2D
 /* ݲͬɫʽ,֡ */
 #if LTDC_PIXFORMAT == LTDC_PIXFORMAT_ARGB8888 || LTDC_PIXFORMAT == LTDC_PIXFORMAT_RGB888
     uint32_t ltdc_lcd_framebuf[1280][800] __attribute__((section(".bss.ARM.__at_0XC0000000")));  /* ֱʱ,LTDC֡С */
+    uint32_t ltdc_lcd_framebuf1[1280][800] __attribute__((section(".bss.ARM.__at_0XC03E8000"))); /* ڶ֡,˫巭ҳʱʹ */
 #else
     uint16_t ltdc_lcd_framebuf[1280][800] __attribute__((section(".bss.ARM.__at_0XC0000000")));  /* ֱʱ,LTDC֡С */
+    uint16_t ltdc_lcd_framebuf1[1280][800] __attribute__((section(".bss.ARM.__at_0XC01F4000"))); /* ڶ֡,˫巭ҳʱʹ */
 #endif
 
 #endif
@@ -53,6 +56,12 @@ DMA2D_HandleTypeDef g_dma2d_handle;      /* DMA2D
 uint32_t *g_ltdc_framebuf[2];                /* LTDC LCDָ֡,ָӦСڴ */
 _ltdc_dev lcdltdc;                           /* LCD LTDCҪ */
 
+static volatile ltdc_reload_cb_t g_ltdc_reload_cb = 0;  /* ֡лɻص */
+static volatile uint8_t g_ltdc_swapbuf = 0;             /* л֡ */
+static volatile uint8_t g_ltdc_backbuf = 0;             /* 1ƺʹõ֡,ҳΪ̨֡,δҳʱΪ0 */
+
+static uint32_t ltdc_draw_framebuf(void);
+
 /**
  * @brief       LTDC
  * @param       sw   : 1 ,0ر
@@ -132,20 +141,20 @@ void ltdc_draw_point(uint16_t x, uint16_t y, uint32_t color)
 #if LTDC_PIXFORMAT == LTDC_PIXFORMAT_ARGB8888 || LTDC_PIXFORMAT == LTDC_PIXFORMAT_RGB888
     if (lcdltdc.dir)   /*  */
     {
-        *(uint32_t *)((uint32_t)g_ltdc_framebuf[lcdltdc.activelayer] + lcdltdc.pixsize * (lcdltdc.pwidth * y + x)) = color;
+        *(uint32_t *)(ltdc_draw_framebuf() + lcdltdc.pixsize * (lcdltdc.pwidth * y + x)) = color;
     }
     else               /*  */
     {
-        *(uint32_t *)((uint32_t)g_ltdc_framebuf[lcdltdc.activelayer] + lcdltdc.pixsize * (lcdltdc.pwidth * (lcdltdc.pheight - x - 1) + y)) = color; 
+        *(uint32_t *)(ltdc_draw_framebuf() + lcdltdc.pixsize * (lcdltdc.pwidth * (lcdltdc.pheight - x - 1) + y)) = color; 
     }
 #else
     if (lcdltdc.dir)   /*  */
     {
-        *(uint16_t *)((uint32_t)g_ltdc_framebuf[lcdltdc.activelayer] + lcdltdc.pixsize * (lcdltdc.pwidth * y + x)) = color;
+        *(uint16_t *)(ltdc_draw_framebuf() + lcdltdc.pixsize * (lcdltdc.pwidth * y + x)) = color;
     }
     else              /*  */
     {
-        *(uint16_t *)((uint32_t)g_ltdc_framebuf[lcdltdc.activelayer] + lcdltdc.pixsize * (lcdltdc.pwidth * (lcdltdc.pheight - x - 1) + y)) = color; 
+        *(uint16_t *)(ltdc_draw_framebuf() + lcdltdc.pixsize * (lcdltdc.pwidth * (lcdltdc.pheight - x - 1) + y)) = color; 
     }
 #endif
 }
@@ -160,20 +169,20 @@ uint32_t ltdc_read_point(uint16_t x, uint16_t y)
 #if LTDC_PIXFORMAT == LTDC_PIXFORMAT_ARGB8888 || LTDC_PIXFORMAT == LTDC_PIXFORMAT_RGB888
     if (lcdltdc.dir)   /*  */
     {
-        return *(uint32_t *)((uint32_t)g_ltdc_framebuf[lcdltdc.activelayer] + lcdltdc.pixsize * (lcdltdc.pwidth * y + x));
+        return *(uint32_t *)(ltdc_draw_framebuf() + lcdltdc.pixsize * (lcdltdc.pwidth * y + x));
     }
     else               /*  */
     {
-        return *(uint32_t *)((uint32_t)g_ltdc_framebuf[lcdltdc.activelayer] + lcdltdc.pixsize * (lcdltdc.pwidth * (lcdltdc.pheight - x - 1) + y)); 
+        return *(uint32_t *)(ltdc_draw_framebuf() + lcdltdc.pixsize * (lcdltdc.pwidth * (lcdltdc.pheight - x - 1) + y)); 
     }
 #else
     if (lcdltdc.dir)   /*  */
     {
-        return *(uint16_t *)((uint32_t)g_ltdc_framebuf[lcdltdc.activelayer] + lcdltdc.pixsize * (lcdltdc.pwidth * y + x));
+        return *(uint16_t *)(ltdc_draw_framebuf() + lcdltdc.pixsize * (lcdltdc.pwidth * y + x));
     }
     else               /*  */
     {
-        return *(uint16_t *)((uint32_t)g_ltdc_framebuf[lcdltdc.activelayer] + lcdltdc.pixsize * (lcdltdc.pwidth * (lcdltdc.pheight - x - 1) + y)); 
+        return *(uint16_t *)(ltdc_draw_framebuf() + lcdltdc.pixsize * (lcdltdc.pwidth * (lcdltdc.pheight - x - 1) + y)); 
     }
 #endif 
 }
@@ -185,14 +194,13 @@ uint32_t ltdc_read_point(uint16_t x, uint16_t y)
  * @param       sx,sy       : ʼ
  * @param       ex,ey       : 
  * @param       color       : ɫ
- * @retval      
+ * @retval      0, ɹ;
+ *              1, ʱ(λ֮ǰ첽ѱֹ);
  */
-void ltdc_fill(uint16_t sx, uint16_t sy, uint16_t ex, uint16_t ey, uint32_t color)
+uint8_t ltdc_fill(uint16_t sx, uint16_t sy, uint16_t ex, uint16_t ey, uint32_t color)
 { 
     uint32_t psx, psy, pex, pey;   /* LCDΪ׼ϵ,仯仯 */
-    uint32_t timeout = 0; 
-    uint16_t offline;
-    uint32_t addr; 
+    dma2d_xfer_t xfer = {0};
 
     /* ϵת */
     if (lcdltdc.dir)               /*  */
@@ -219,25 +227,15 @@ void ltdc_fill(uint16_t sx, uint16_t sy, uint16_t ex, uint16_t ey, uint32_t colo
         pey = lcdltdc.pheight - sx - 1;
     }
 
-    offline = lcdltdc.pwidth - (pex - psx + 1);
-    addr = ((uint32_t)g_ltdc_framebuf[lcdltdc.activelayer] + lcdltdc.pixsize * (lcdltdc.pwidth * psy + psx));
-
-    __HAL_RCC_DMA2D_CLK_ENABLE();                              /* ʹDM2Dʱ */
-    DMA2D->CR &= ~(DMA2D_CR_START);                            /* ֹͣDMA2D */
-    DMA2D->CR = DMA2D_R2M;                                     /* Ĵ洢ģʽ */
-    DMA2D->OPFCCR = LTDC_PIXFORMAT;                            /* ɫʽ */
-    DMA2D->OOR = offline;                                      /* ƫ  */
-    DMA2D->OMAR = addr;                                        /* 洢ַ */
-    DMA2D->NLR = (pey - psy + 1) | ((pex - psx + 1) << 16);    /* 趨Ĵ */
-    DMA2D->OCOLR = color;                                      /* 趨ɫĴ */
-    DMA2D->CR |= DMA2D_CR_START;                               /* DMA2D */
+    xfer.mode = DMA2D_R2M;                                     /* Ĵ洢ģʽ */
+    xfer.pixformat = LTDC_PIXFORMAT;                           /* ɫʽ */
+    xfer.color = color;                                        /* ɫ */
+    xfer.dst = (void *)(ltdc_draw_framebuf() + lcdltdc.pixsize * (lcdltdc.pwidth * psy + psx));
+    xfer.width = pex - psx + 1;
+    xfer.height = pey - psy + 1;
+    xfer.dst_offline = lcdltdc.pwidth - (pex - psx + 1);       /* ƫ */
 
-    while ((DMA2D->ISR & (DMA2D_FLAG_TC)) == 0)                /* ȴ */
-    {
-        timeout++;
-        if (timeout > 0X1FFFFF)break;                          /* ʱ˳ */
-    } 
-    DMA2D->IFCR |= DMA2D_FLAG_TC;                              /* ɱ־ */
+    return dma2d_transfer(&xfer);
 }
 
 ///* ʹDMA2DصHALʹDMA2D(Ƽ) */
@@ -305,22 +303,17 @@ void ltdc_fill(uint16_t sx, uint16_t sy, uint16_t ex, uint16_t ey, uint32_t colo
 //}
 
 /**
- * @brief       ָָɫ,DMA2D
- * @note        ˺֧uint16_t,RGB565ʽɫ.
- *              (sx,sy),(ex,ey):ζԽ,СΪ:(ex - sx + 1) * (ey - sy + 1)
- *              ע:sx,ex,ܴlcddev.width - 1; sy,ey,ܴlcddev.height - 1
+ * @brief       DMA2D洢洢Ĳ
  * @param       sx,sy       : ʼ
  * @param       ex,ey       : 
  * @param       color       : ɫ׵ַ
+ * @param       xfer        : 
  * @retval      
  */
-void ltdc_color_fill(uint16_t sx, uint16_t sy, uint16_t ex, uint16_t ey, uint16_t *color)
+static void ltdc_dma2d_color_xfer(uint16_t sx, uint16_t sy, uint16_t ex, uint16_t ey, uint16_t *color, dma2d_xfer_t *xfer)
 {
     uint32_t psx, psy, pex, pey;   /* LCDΪ׼ϵ,仯仯 */
-    uint32_t timeout = 0; 
-    uint16_t offline;
-    uint32_t addr;
-  
+
     /* ϵת */
     if (lcdltdc.dir)               /*  */
     {
@@ -336,31 +329,130 @@ void ltdc_color_fill(uint16_t sx, uint16_t sy, uint16_t ex, uint16_t ey, uint16_
         pex = ey;
         pey = lcdltdc.pheight - sx - 1;
     }
-    
-    offline = lcdltdc.pwidth - (pex - psx + 1);
-    addr = ((uint32_t)g_ltdc_framebuf[lcdltdc.activelayer] + lcdltdc.pixsize * (lcdltdc.pwidth * psy + psx));
-
-    RCC->AHB1ENR |= 1 << 23;            /* ʹDM2Dʱ */
-
-    DMA2D->CR = 0 << 16;                /* 洢洢ģʽ */
-    DMA2D->FGPFCCR = LTDC_PIXFORMAT;    /* ɫʽ */
-    DMA2D->FGOR = 0;                    /* ǰƫΪ0 */
-    DMA2D->OOR = offline;               /* ƫ */
-    DMA2D->CR &= ~(1 << 0);             /* ֹͣDMA2D */
-    DMA2D->FGMAR = (uint32_t)color;     /* Դַ */
-    DMA2D->OMAR = addr;                 /* 洢ַ */
-    DMA2D->NLR = (pey - psy + 1) | ((pex - psx + 1) << 16); /* 趨Ĵ */
-    DMA2D->CR |= 1 << 0;                /* DMA2D */
-
-    while ((DMA2D->ISR & (1 << 1)) == 0)/* ȴ */
+
+    xfer->mode = DMA2D_M2M;                 /* 洢洢ģʽ */
+    xfer->pixformat = LTDC_PIXFORMAT;       /* ɫʽ */
+    xfer->src = color;                      /* Դַ */
+    xfer->dst = (void *)(ltdc_draw_framebuf() + lcdltdc.pixsize * (lcdltdc.pwidth * psy + psx));
+    xfer->width = pex - psx + 1;
+    xfer->height = pey - psy + 1;
+    xfer->src_offline = 0;                  /* ǰƫΪ0 */
+    xfer->dst_offline = lcdltdc.pwidth - (pex - psx + 1);
+}
+
+/**
+ * @brief       ָָɫ,DMA2D
+ * @note        ˺֧uint16_t,RGB565ʽɫ.
+ *              (sx,sy),(ex,ey):ζԽ,СΪ:(ex - sx + 1) * (ey - sy + 1)
+ *              ע:sx,ex,ܴlcddev.width - 1; sy,ey,ܴlcddev.height - 1
+ * @param       sx,sy       : ʼ
+ * @param       ex,ey       : 
+ * @param       color       : ɫ׵ַ
+ * @retval      0, ɹ;
+ *              1, ʱ(λ֮ǰ첽ѱֹ);
+ */
+uint8_t ltdc_color_fill(uint16_t sx, uint16_t sy, uint16_t ex, uint16_t ey, uint16_t *color)
+{
+    dma2d_xfer_t xfer = {0};
+
+    ltdc_dma2d_color_xfer(sx, sy, ex, ey, color, &xfer);
+
+    return dma2d_transfer(&xfer);
+}  
+
+/**
+ * @brief       ָָɫ,DMA2D,ȴ
+ * @note        ͬltdc_color_fill.
+ *              ɺDMA2Dжеdone_cb, ڴ֮ǰcolorָݲ޸.
+ * @param       sx,sy       : ʼ
+ * @param       ex,ey       : 
+ * @param       color       : ɫ׵ַ
+ * @param       done_cb     : ɻص(же), Ϊ0
+ * @retval      0, ɹ;
+ *              1, һ첽䳬ʱ, ѱֹ(صᱻ), δȻ;
+ */
+uint8_t ltdc_color_fill_async(uint16_t sx, uint16_t sy, uint16_t ex, uint16_t ey, uint16_t *color, ltdc_dma2d_cb_t done_cb)
+{
+    dma2d_xfer_t xfer = {0};
+
+    ltdc_dma2d_color_xfer(sx, sy, ex, ey, color, &xfer);
+
+    return dma2d_transfer_async(&xfer, done_cb);
+}
+
+/**
+ * @brief       ȴDMA2D첽
+ * @note        ʱֹ, æ־, ٵɻص.
+ * @param       
+ * @retval      0, ɹ;
+ *              1, ʱ, ѱֹ;
+ */
+uint8_t ltdc_dma2d_wait(void)
+{
+    return dma2d_wait();
+}
+
+/**
+ * @brief       л1ʾ֡
+ * @note        µַһδֱڼЧ, ˺.
+ *              ЧLTDCжеdone_cb, ڴ֮ǰ޸ԭʾ֡.
+ * @param       bufx        : ֡, 0/1, Ӧg_ltdc_framebuf[bufx]
+ * @param       done_cb     : лɻص(же), Ϊ0
+ * @retval      
+ */
+void ltdc_framebuf_swap(uint8_t bufx, ltdc_reload_cb_t done_cb)
+{
+    g_ltdc_reload_cb = done_cb;
+    g_ltdc_swapbuf = bufx;
+    HAL_LTDC_SetAddress_NoReload(&g_ltdc_handle, (uint32_t)g_ltdc_framebuf[bufx], 0);  /* õ1ַ֡,ݲЧ */
+    HAL_LTDC_Reload(&g_ltdc_handle, LTDC_RELOAD_VERTICAL_BLANKING);                    /* ֱʱ,ʹж */
+}
+
+/**
+ * @brief       LTDCжϷ
+ * @param       
+ * @retval      
+ */
+void LTDC_IRQHandler(void)
+{
+    HAL_LTDC_IRQHandler(&g_ltdc_handle);
+}
+
+/**
+ * @brief       LTDCĴɻص
+ * @note        HAL_LTDC_IRQHandler, ʱµַ֡ѾЧ
+ * @param       hltdc       : LTDC
+ * @retval      
+ */
+void HAL_LTDC_ReloadEventCallback(LTDC_HandleTypeDef *hltdc)
+{
+    ltdc_reload_cb_t cb = g_ltdc_reload_cb;
+
+    g_ltdc_reload_cb = 0;
+    g_ltdc_backbuf = g_ltdc_swapbuf ^ 1;    /* ԭʾ֡Ϊ̨֡ */
+
+    if (cb)
     {
-        timeout++;
+        cb();
+    }
+}
 
-        if (timeout > 0X1FFFFF)break;   /* ʱ˳ */
+/**
+ * @brief       ȡƺʹõַ֡
+ * @note        1ʹ˫巭ҳʱΪǰ̨֡, ޸ʾ֡.
+ *              δҳʱΪg_ltdc_framebuf[0].
+ * @param       
+ * @retval      ֡׵ַ
+ */
+static uint32_t ltdc_draw_framebuf(void)
+{
+    if (lcdltdc.activelayer == 0)
+    {
+        return (uint32_t)g_ltdc_framebuf[g_ltdc_backbuf];
     }
 
-    DMA2D->IFCR |= 1 << 1;              /* ɱ־ */
-}  
+    return (uint32_t)g_ltdc_framebuf[lcdltdc.activelayer];
+}
 
 /**
  * @brief       LTCD
@@ -603,10 +695,11 @@ void ltdc_init(void)
     
 #if LTDC_PIXFORMAT == LTDC_PIXFORMAT_ARGB8888 || LTDC_PIXFORMAT == LTDC_PIXFORMAT_RGB888 
     g_ltdc_framebuf[0] = (uint32_t*) &ltdc_lcd_framebuf;
+    g_ltdc_framebuf[1] = (uint32_t*) &ltdc_lcd_framebuf1;
     lcdltdc.pixsize = 4;                        /* ÿռ4ֽ */
 #else
     g_ltdc_framebuf[0] = (uint32_t*)&ltdc_lcd_framebuf;
-//    g_ltdc_framebuf[1] = (uint32_t*)&ltdc_lcd_framebuf1;
+    g_ltdc_framebuf[1] = (uint32_t*)&ltdc_lcd_framebuf1;
     lcdltdc.pixsize = 2;                        /* ÿռ2ֽ */
 #endif 
     /* LTDC */
@@ -663,6 +756,10 @@ void HAL_LTDC_MspInit(LTDC_HandleTypeDef *hltdc)
     
     __HAL_RCC_LTDC_CLK_ENABLE();                      /* ʹLTDCʱ */
     __HAL_RCC_DMA2D_CLK_ENABLE();                     /* ʹDMA2Dʱ */
+    HAL_NVIC_SetPriority(DMA2D_IRQn, 2, 0);           /* DMA2Dжȼ,ռȼ2,ȼ0 */
+    HAL_NVIC_EnableIRQ(DMA2D_IRQn);                   /* ʹDMA2Dж(첽) */
+    HAL_NVIC_SetPriority(LTDC_IRQn, 2, 0);            /* LTDCжȼ,ռȼ2,ȼ0 */
+    HAL_NVIC_EnableIRQ(LTDC_IRQn);                    /* ʹLTDCж(֡л) */
 
     /* LTDCźſ BL/DE/VSYNC/HSYNC/CLKȵ */
     LTDC_BL_GPIO_CLK_ENABLE();                        /* LTDC_BLʱʹ */
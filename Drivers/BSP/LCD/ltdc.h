@@ -26,6 +26,7 @@
 #define _LTDC_H
 
 #include "./SYSTEM/sys/sys.h"
+#include "./BSP/DMA2D/dma2d.h"
 
 
 /* LCD LTDCҪ */
@@ -46,9 +47,13 @@ typedef struct
     uint32_t pixsize;     /* ÿռֽ */
 }_ltdc_dev; 
 
+typedef dma2d_done_cb_t ltdc_dma2d_cb_t;   /* DMA2D첽ɻص */
+typedef void (*ltdc_reload_cb_t)(void);    /* ֡лɻص */
+
 extern _ltdc_dev lcdltdc;                   /* LCD LTDC */
 extern LTDC_HandleTypeDef g_ltdc_handle;    /* LTDC */
 extern DMA2D_HandleTypeDef g_dma2d_handle;  /* DMA2D */
+extern uint32_t *g_ltdc_framebuf[2];        /* LTDCָ֡ */
 
 #define LTDC_PIXFORMAT_ARGB8888      0X00    /* ARGB8888ʽ */
 #define LTDC_PIXFORMAT_RGB888        0X01    /* RGB888ʽ */
@@ -96,6 +101,16 @@ extern DMA2D_HandleTypeDef g_dma2d_handle;  /* DMA2D
 /* LTDC֡׵ַ,ﶨSDRAM. */
 #define LTDC_FRAME_BUF_ADDR             0XC0000000
 
+/* һ֡ĴС(ֱ1280*800), ڶ֡ڵһ֮ */
+#if LTDC_PIXFORMAT == LTDC_PIXFORMAT_ARGB8888 || LTDC_PIXFORMAT == LTDC_PIXFORMAT_RGB888
+#define LTDC_FRAME_BUF_SIZE             (1280 * 800 * 4)
+#else
+#define LTDC_FRAME_BUF_SIZE             (1280 * 800 * 2)
+#endif
+
+/* ֮֡ĵһַ, SDRAMеݱڴ˵ַ֮ */
+#define LTDC_FRAME_BUF_END              (LTDC_FRAME_BUF_ADDR + 2 * LTDC_FRAME_BUF_SIZE)
+
 /* LTDC */
 #define LTDC_BL(x)   do{ x ? \
                       HAL_GPIO_WritePin(LTDC_BL_GPIO_PORT, LTDC_BL_GPIO_PIN, GPIO_PIN_SET) : \
@@ -110,8 +125,11 @@ void ltdc_select_layer(uint8_t layerx);
 void ltdc_display_dir(uint8_t dir);                                                                                                                                   /* ʾ */
 void ltdc_draw_point(uint16_t x, uint16_t y, uint32_t color);                                                                                                         /* 㺯 */
 uint32_t ltdc_read_point(uint16_t x, uint16_t y);                                                                                                                     /* 㺯 */
-void ltdc_fill(uint16_t sx, uint16_t sy, uint16_t ex, uint16_t ey, uint32_t color);                                                                                   /* εɫ亯 */
-void ltdc_color_fill(uint16_t sx, uint16_t sy, uint16_t ex, uint16_t ey, uint16_t *color);                                                                            /* βɫ亯 */
+uint8_t ltdc_fill(uint16_t sx, uint16_t sy, uint16_t ex, uint16_t ey, uint32_t color);                                                                                /* εɫ亯 */
+uint8_t ltdc_color_fill(uint16_t sx, uint16_t sy, uint16_t ex, uint16_t ey, uint16_t *color);                                                                         /* βɫ亯 */
+uint8_t ltdc_color_fill_async(uint16_t sx, uint16_t sy, uint16_t ex, uint16_t ey, uint16_t *color, ltdc_dma2d_cb_t done_cb);                                          /* βɫ亯(ȴ) */
+uint8_t ltdc_dma2d_wait(void);                                                                                                                                        /* ȴDMA2D첽 */
+void ltdc_framebuf_swap(uint8_t bufx, ltdc_reload_cb_t done_cb);                                                                                                      /* лʾ֡(ֱʱЧ) */
 void ltdc_clear(uint32_t color);                                                                                                                                      /*  */
 uint8_t ltdc_clk_set(uint32_t pllsain, uint32_t pllsair, uint32_t pllsaidivr);                                                                                        /* LTDCʱ */
 void ltdc_layer_window_config(uint8_t layerx, uint16_t sx, uint16_t sy, uint16_t width, uint16_t height);                                                             /* LTDC㴰 */
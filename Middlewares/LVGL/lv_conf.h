@@ -65,6 +65,20 @@
         #undef LV_MEM_POOL_INCLUDE
         #undef LV_MEM_POOL_ALLOC
     #endif
+
+    /*Serve the allocations up to 64 bytes from free lists of 6 size classes carved from pages of this size.
+     *Small allocations and frees are O(1) and don't fragment the memory pool. 0: allocate everything with TLSF*/
+    #define LV_MEM_SMALL_BLOCK_PAGE_SIZE 256     /*[bytes]*/
+
+    /*Size of a second memory pool for large, sequentially accessed data (draw buffers, cached images, layers).
+     *Allocate them with `lv_malloc_placed(size, LV_MEM_PLACEMENT_BULK)` to keep them out of the main pool
+     *which can stay in fast internal RAM. 0: use a single pool for everything*/
+    #define LV_MEM_BULK_SIZE (4U * 1024U * 1024U)     /*[bytes]*/
+
+    /*Address of the bulk memory pool, e.g. in external SDRAM. 0: allocate it as a normal array
+     *The SDRAM starts at 0xC0000000 with the two 1280x800 LTDC framebuffers (2 bytes per pixel
+     *for RGB565, 4 bytes for RGB888 and ARGB8888), the pool follows them*/
+    #define LV_MEM_BULK_ADR (0xC0000000U + 2U * 1280U * 800U * (LV_COLOR_DEPTH <= 16 ? 2U : 4U))
 #endif  /*LV_USE_STDLIB_MALLOC == LV_STDLIB_BUILTIN*/
 
 /*====================
@@ -78,6 +92,15 @@
  *(Not so important, you can adjust it to modify default sizes and spaces)*/
 #define LV_DPI_DEF 215     /*[px/inch]*/
 
+/*Estimated extra cost of refreshing one more invalidated area in pixels (object tree traversal, flush, etc).
+ *Two invalidated areas are joined if refreshing their bounding box is cheaper than refreshing both of them.
+ *0: join only overlapping areas if the joined area is smaller than the two areas together*/
+#define LV_INV_AREA_COST 1024     /*[px]*/
+
+/*Max. width and height of a tile in LV_DISPLAY_RENDER_MODE_TILED.
+ *As many tiles are rendered in parallel as fit into the draw buffer*/
+#define LV_DISPLAY_TILE_SIZE 64     /*[px]*/
+
 /*=================
  * OPERATING SYSTEM
  *=================*/
@@ -128,6 +151,20 @@
 /*The target buffer size for simple layer chunks.*/
 #define LV_DRAW_LAYER_SIMPLE_BUF_SIZE    (24 * 1024)   /*[bytes]*/
 
+/*Keep the pixel buffers freed by the default draw buffer handlers (layers, decoded images)
+ *up to this total size and reuse them instead of allocating new ones in every frame.
+ *The buffers are allocated in size classes, at most 25% larger than requested.
+ *If any allocation fails the kept buffers are freed and it's tried again. 0: disable*/
+#define LV_DRAW_BUF_POOL_SIZE    (256 * 1024)   /*[bytes]*/
+
+/*Allocate the draw tasks and their descriptors from chunks of this size. They are freed at once
+ *when no draw task is pending. Larger or more allocations chain new chunks. 0: use lv_malloc for each*/
+#define LV_DRAW_TASK_ARENA_SIZE    (2 * 1024)   /*[bytes]*/
+
+/*Use at most this many chunks for the draw tasks. If they are full, e.g. because some draw tasks are
+ *never finished and the arena can't be reset, the draw tasks are allocated with lv_malloc. 0: no limit*/
+#define LV_DRAW_TASK_ARENA_CHUNK_MAX    4
+
 /* The stack size of the drawing thread.
  * NOTE: If FreeType or ThorVG is enabled, it is recommended to set it to 32KB or more.
  */
@@ -158,6 +195,11 @@
      * > 1 means multiple threads will render the screen in parallel */
     #define LV_DRAW_SW_DRAW_UNIT_CNT    1
 
+    /* With more draw units split large fill, border, image and layer draw tasks
+     * into horizontal tiles which can be rendered (and stolen) by any idle draw unit.
+     * Draw tasks covering fewer pixels than this are not split. 0: don't split */
+    #define LV_DRAW_SW_TILE_SPLIT_THRESHOLD (128 * 128)  /*[px]*/
+
     /* Use Arm-2D to accelerate the sw render */
     #define LV_USE_DRAW_ARM2D_SYNC      0
 
@@ -181,7 +223,10 @@
         #define LV_DRAW_SW_CIRCLE_CACHE_SIZE 4
     #endif
 
-    #define  LV_USE_DRAW_SW_ASM     LV_DRAW_SW_ASM_NONE
+    /* Hand optimized blending: LV_DRAW_SW_ASM_NEON or LV_DRAW_SW_ASM_HELIUM on Arm,
+     * LV_DRAW_SW_ASM_SSE2 on x86 (e.g. the PC simulator, it uses AVX2 too if the compiler targets it),
+     * LV_DRAW_SW_ASM_SWAR on MCUs without vector units: RGB565 blending two pixels per 32 bit word */
+    #define  LV_USE_DRAW_SW_ASM     LV_DRAW_SW_ASM_SWAR
 
     #if LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_CUSTOM
         #define  LV_DRAW_SW_ASM_CUSTOM_INCLUDE ""
@@ -234,6 +279,15 @@
 /* Use Renesas Dave2D on RA  platforms. */
 #define LV_USE_DRAW_DAVE2D 0
 
+/* Use the DMA2D (Chrom-ART) of STM32 MCUs for fills, images and glyphs.
+ * The buffers have to be in memory DMA2D can access (e.g. not in CCM RAM)*/
+#define LV_USE_DRAW_DMA2D 1
+
+#if LV_USE_DRAW_DMA2D
+    /* The header which defines the `DMA2D` registers, e.g. "stm32f4xx.h" */
+    #define LV_DRAW_DMA2D_HAL_INCLUDE "stm32f4xx.h"
+#endif
+
 /* Draw using cached SDL textures*/
 #define LV_USE_DRAW_SDL 0
 
@@ -369,6 +423,13 @@
  *The main logic is like `LV_CACHE_DEF_SIZE` but for image headers.*/
 #define LV_IMAGE_HEADER_CACHE_DEF_CNT 0
 
+/*Eviction policy of the image cache and the image header cache.
+ *- LV_CACHE_POLICY_LRU: drop the least recently used image
+ *- LV_CACHE_POLICY_S3FIFO: drop the images used only once first. Good if many images are shown only once (e.g. carousels)
+ *- LV_CACHE_POLICY_ARC: balance between the recently and the frequently used images adaptively*/
+#define LV_IMAGE_CACHE_POLICY           LV_CACHE_POLICY_LRU
+#define LV_IMAGE_HEADER_CACHE_POLICY    LV_CACHE_POLICY_LRU
+
 /*Number of stops allowed per gradient. Increase this to allow more stops.
  *This adds (sizeof(lv_color_t) + 1) bytes per additional stop*/
 #define LV_GRADIENT_MAX_STOPS   2
@@ -380,6 +441,36 @@
 /* Add 2 x 32 bit variables to each lv_obj_t to speed up getting style properties */
 #define LV_OBJ_STYLE_CACHE      0
 
+/* Cache the resolved values of the most often used style properties (background, border, text, padding, opacity)
+ * for each part and state of an object. It needs ~140 bytes of heap for each part which was drawn. */
+#define LV_OBJ_STYLE_VALUE_CACHE    1
+#if LV_OBJ_STYLE_VALUE_CACHE
+    /* Maximum number of cached parts (~150 bytes each). The parts drawn after the limit is reached are not cached.
+     * The parts of a screen are freed when the screen is unloaded. */
+    #define LV_OBJ_STYLE_VALUE_CACHE_MAX_CNT    32
+#endif
+
+/* Keep the properties of the styles sorted and add a bit for each built-in property to `lv_style_t`.
+ * A missing property is found with a single bit test and an existing one with binary search.
+ * It needs 20 bytes more in each `lv_style_t`. */
+#define LV_STYLE_PROP_INDEX     1
+
+/* Allocate the objects, their attributes, style lists, local styles and event descriptors
+ * from pages of fixed size blocks instead of the heap.
+ * Allocating and freeing is O(1), but partly used pages need some more memory in total.
+ * Creating and deleting screens is faster with it, but the heap isn't less fragmented
+ * (see Tests/bench_obj_slab.c), so it's disabled. */
+#define LV_USE_OBJ_SLAB     0
+#if LV_USE_OBJ_SLAB
+    /* Size of a page in bytes. Each block size which is in use takes at least one page. */
+    #define LV_OBJ_SLAB_PAGE_SIZE   512
+
+    /* Size of a region taken from the heap in `lv_init()` to allocate the pages from.
+     * This way the pages don't split the free memory of the heap between the other allocations.
+     * If the region is full the pages are allocated from the heap. 0: always use the heap. */
+    #define LV_OBJ_SLAB_POOL_SIZE   0
+#endif
+
 /* Add `id` field to `lv_obj_t` */
 #define LV_USE_OBJ_ID           0
 
@@ -528,6 +619,22 @@
 
 /*Enables/disables support for compressed fonts.*/
 #define LV_USE_FONT_COMPRESSED 0
+#if LV_USE_FONT_COMPRESSED
+    /*Cache the decompressed glyphs to not decompress them on every redraw.
+     *Size in bytes, 0: disable the cache*/
+    #define LV_FONT_FMT_TXT_CACHE_SIZE (8 * 1024)
+
+    /*Eviction policy of the glyph cache. See `LV_IMAGE_CACHE_POLICY`*/
+    #define LV_FONT_FMT_TXT_CACHE_POLICY LV_CACHE_POLICY_LRU
+#endif
+
+/*Number of recently looked up letters to remember in lvgl's native font format.
+ *Must be a power of 2. 0: disable*/
+#define LV_FONT_FMT_TXT_LETTER_CACHE_SIZE 64
+
+/*Build a page index on first use for the large sparse character maps (e.g. CJK fonts)
+ *to search the letters only on a single page instead of the whole list.*/
+#define LV_USE_FONT_FMT_TXT_LOOKUP_INDEX 1
 
 /*Enable drawing placeholders when glyph dsc is not found*/
 #define LV_USE_FONT_PLACEHOLDER 1
@@ -626,6 +733,7 @@
 #if LV_USE_LABEL
     #define LV_LABEL_TEXT_SELECTION 1 /*Enable selecting text of the label*/
     #define LV_LABEL_LONG_TXT_HINT 1  /*Store some extra info in labels to speed up drawing of very long texts*/
+    #define LV_LABEL_LAYOUT_CACHE 1   /*Store the line breaks of the text to not measure it again while drawing*/
     #define LV_LABEL_WAIT_CHAR_COUNT 3  /*The count of wait chart*/
 #endif
 
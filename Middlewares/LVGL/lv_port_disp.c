@@ -12,6 +12,10 @@
 #include "lv_port_disp.h"
 #include <stdbool.h>
 #include "./BSP/LCD/lcd.h"
+#include "./BSP/LCD/ltdc.h"
+#if LV_USE_DRAW_DMA2D
+    #include "lvgl/src/draw/dma2d/lv_draw_dma2d.h"
+#endif
 /*********************
  *      DEFINES
  *********************/
@@ -27,6 +31,24 @@
 
 #define BYTE_PER_PIXEL (LV_COLOR_FORMAT_GET_SIZE(LV_COLOR_FORMAT_RGB565)) /*will be 2 for RGB565 */
 
+/*1: on the RGB panel render directly into the two LTDC framebuffers and flip between them.
+ *0: render into small buffers in SRAM and copy them to the framebuffer with DMA2D*/
+#ifndef DISP_PAGE_FLIP
+    #define DISP_PAGE_FLIP     1
+#endif
+
+/*1: on the MCU panel send only the rows which have changed since they were last sent.
+ *It needs 8 bytes of LVGL heap per row.*/
+#ifndef DISP_FLUSH_DIFF
+    #define DISP_FLUSH_DIFF    1
+#endif
+
+/*The framebuffers are placed at fixed SDRAM addresses, the bulk memory pool must not overlap them*/
+#if LV_USE_STDLIB_MALLOC == LV_STDLIB_BUILTIN && LV_MEM_BULK_SIZE && LV_MEM_BULK_ADR && \
+    LV_MEM_BULK_ADR < LTDC_FRAME_BUF_END && LV_MEM_BULK_ADR + LV_MEM_BULK_SIZE > LTDC_FRAME_BUF_ADDR
+    #error "The bulk memory pool (LV_MEM_BULK_ADR) overlaps the LTDC framebuffers"
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -38,9 +60,22 @@ static void disp_init(void);
 
 static void disp_flush(lv_display_t * disp, const lv_area_t * area, uint8_t * px_map);
 
+static void disp_flush_complete(void);
+
+static bool disp_page_flip_supported(void);
+
+#if LV_USE_DRAW_DMA2D
+static void disp_dma2d_wait(void);
+
+static bool disp_scroll_blit(lv_display_t * disp, lv_draw_buf_t * buf, const lv_area_t * area, int32_t dx, int32_t dy);
+#endif
+
 /**********************
  *  STATIC VARIABLES
  **********************/
+static lv_display_t * disp_flushing;
+
+static bool disp_page_flip;
 
 /**********************
  *      MACROS
@@ -57,27 +92,56 @@ void lv_port_disp_init(void)
      * -----------------------*/
     disp_init();
 
+#if LV_USE_DRAW_DMA2D
+    /*The DMA2D draw unit shares DMA2D with the asynchronous flush*/
+    lv_draw_dma2d_set_wait_cb(disp_dma2d_wait);
+#endif
+
     /*------------------------------------
      * Create a display and set a flush_cb
      * -----------------------------------*/
     lv_display_t * disp = lv_display_create(MY_DISP_HOR_RES, MY_DISP_VER_RES);
     lv_display_set_flush_cb(disp, disp_flush);
 
-    /* Example 1
-     * One buffer for partial rendering*/
-    LV_ATTRIBUTE_MEM_ALIGN
-    static uint8_t buf_1_1[MY_DISP_HOR_RES * 10 * BYTE_PER_PIXEL];            /*A buffer for 10 rows*/
-    lv_display_set_buffers(disp, buf_1_1, NULL, sizeof(buf_1_1), LV_DISPLAY_RENDER_MODE_PARTIAL);
+    disp_page_flip = DISP_PAGE_FLIP && disp_page_flip_supported();
+    if(disp_page_flip) {
+        /* Page flipping
+         * LVGL renders straight into the framebuffer which is not shown and flush_cb only
+         * swaps the LTDC layer address on the next vertical blanking.
+         * `refr_sync_areas()` copies the areas redrawn in the previous frame to the new back buffer.
+         * Start with the hidden framebuffer so the first frame is not drawn on the screen.*/
+        lv_display_set_buffers(disp, g_ltdc_framebuf[1], g_ltdc_framebuf[0],
+                               MY_DISP_HOR_RES * MY_DISP_VER_RES * BYTE_PER_PIXEL, LV_DISPLAY_RENDER_MODE_DIRECT);
 
-    // /* Example 2
-    //  * Two buffers for partial rendering
-    //  * In flush_cb DMA or similar hardware should be used to update the display in the background.*/
-    // LV_ATTRIBUTE_MEM_ALIGN
-    // static uint8_t buf_2_1[MY_DISP_HOR_RES * 10 * BYTE_PER_PIXEL];
+        /*The framebuffers keep the rendered pixels, so scrolled lists can be moved instead of redrawn*/
+        lv_display_set_scroll_blit(disp, true);
+#if LV_USE_DRAW_DMA2D
+        lv_display_set_scroll_blit_cb(disp, disp_scroll_blit);
+#endif
+        return;
+    }
 
+    // /* Example 1
+    //  * One buffer for partial rendering*/
     // LV_ATTRIBUTE_MEM_ALIGN
-    // static uint8_t buf_2_2[MY_DISP_HOR_RES * 10 * BYTE_PER_PIXEL];
-    // lv_display_set_buffers(disp, buf_2_1, buf_2_2, sizeof(buf_2_1), LV_DISPLAY_RENDER_MODE_PARTIAL);
+    // static uint8_t buf_1_1[MY_DISP_HOR_RES * 10 * BYTE_PER_PIXEL];            /*A buffer for 10 rows*/
+    // lv_display_set_buffers(disp, buf_1_1, NULL, sizeof(buf_1_1), LV_DISPLAY_RENDER_MODE_PARTIAL);
+
+    /* Example 2
+     * Two buffers for partial rendering
+     * In flush_cb DMA or similar hardware should be used to update the display in the background.
+     * On the RGB panel DMA2D copies one buffer while LVGL renders into the other.*/
+    LV_ATTRIBUTE_MEM_ALIGN
+    static uint8_t buf_2_1[MY_DISP_HOR_RES * 10 * BYTE_PER_PIXEL];
+
+    LV_ATTRIBUTE_MEM_ALIGN
+    static uint8_t buf_2_2[MY_DISP_HOR_RES * 10 * BYTE_PER_PIXEL];
+    lv_display_set_buffers(disp, buf_2_1, buf_2_2, sizeof(buf_2_1), LV_DISPLAY_RENDER_MODE_PARTIAL);
+
+    /*Writing the MCU panel is slow, so skip the unchanged rows*/
+    if(DISP_FLUSH_DIFF && lcdltdc.pwidth == 0) {
+        lv_display_set_flush_diff(disp, MY_DISP_HOR_RES);
+    }
 
     // /* Example 3
     //  * Two buffers screen sized buffer for double buffering.
@@ -125,8 +189,35 @@ void disp_disable_update(void)
  *'lv_display_flush_ready()' has to be called when it's finished.*/
 static void disp_flush(lv_display_t * disp_drv, const lv_area_t * area, uint8_t * px_map)
 {
-    if(1) {
-        /*The most simple case (but also the slowest) to put all pixels to the screen one-by-one*/
+    if(disp_page_flip) {
+        /*The areas are already in the framebuffer. Show it when the whole frame is ready.
+         *`lv_display_flush_ready()` is called from the LTDC interrupt once the old buffer is not scanned anymore.*/
+        if(disp_flush_enabled && lv_display_flush_is_last(disp_drv)) {
+            disp_flushing = disp_drv;
+            ltdc_framebuf_swap(px_map == (uint8_t *)g_ltdc_framebuf[0] ? 0 : 1, disp_flush_complete);
+            return;
+        }
+
+        lv_display_flush_ready(disp_drv);
+        return;
+    }
+
+    if(disp_flush_enabled && lcdltdc.pwidth != 0) {
+        /*RGB panel: let DMA2D copy the buffer in the background.
+         *`lv_display_flush_ready()` is called from the DMA2D interrupt when the transfer is done.*/
+        disp_flushing = disp_drv;
+#if LV_USE_DRAW_DMA2D
+        lv_draw_dma2d_lock();
+#endif
+        ltdc_color_fill_async(area->x1, area->y1, area->x2, area->y2, (uint16_t *)px_map, disp_flush_complete);
+#if LV_USE_DRAW_DMA2D
+        lv_draw_dma2d_unlock();
+#endif
+        return;
+    }
+
+    if(disp_flush_enabled) {
+        /*MCU panel: copy the pixels synchronously*/
         lcd_color_fill(area->x1, area->y1, area->x2, area->y2, (uint16_t *)px_map);
         // int32_t x;
         // int32_t y;
@@ -144,6 +235,48 @@ static void disp_flush(lv_display_t * disp_drv, const lv_area_t * area, uint8_t
     lv_display_flush_ready(disp_drv);
 }
 
+/*Called from the DMA2D or LTDC interrupt when an asynchronous flush has finished*/
+static void disp_flush_complete(void)
+{
+    lv_display_flush_ready(disp_flushing);
+}
+
+/*The framebuffers can be used directly only if they have the same layout as LVGL's buffer:
+ *an RGB panel of the same size in landscape orientation and 2 bytes per pixel*/
+static bool disp_page_flip_supported(void)
+{
+    return lcdltdc.dir == 1 &&
+           lcdltdc.pwidth == MY_DISP_HOR_RES && lcdltdc.pheight == MY_DISP_VER_RES &&
+           lcdltdc.pixsize == BYTE_PER_PIXEL;
+}
+
+#if LV_USE_DRAW_DMA2D
+/*Wait for the asynchronous flush before the DMA2D draw unit starts a transfer.
+ *A stuck flush is aborted by the DMA2D driver.*/
+static void disp_dma2d_wait(void)
+{
+    if(ltdc_dma2d_wait()) {
+        LV_LOG_WARN("DMA2D flush timed out, aborted");
+    }
+}
+
+/*Move the pixels of a scrolled area with DMA2D.
+ *DMA2D copies forward, so it can be used only if the destination is before the source.*/
+static bool disp_scroll_blit(lv_display_t * disp, lv_draw_buf_t * buf, const lv_area_t * area, int32_t dx, int32_t dy)
+{
+    LV_UNUSED(disp);
+
+    if(dy > 0 || (dy == 0 && dx > 0)) return false;
+
+    uint32_t stride = buf->header.stride;
+    uint8_t * dest = lv_draw_buf_goto_xy(buf, area->x1, area->y1);
+    const uint8_t * src = lv_draw_buf_goto_xy(buf, area->x1 - dx, area->y1 - dy);
+    lv_draw_dma2d_hw_blend(dest, buf->header.cf, stride, src, buf->header.cf, stride,
+                           lv_area_get_width(area), lv_area_get_height(area), LV_OPA_COVER);
+    return true;
+}
+#endif
+
 #else /*Enable this file at the top*/
 
 /*This dummy typedef exists purely to silence -Wpedantic.*/
@@ -32,6 +32,7 @@ extern "C" {
 #include "src/misc/lv_anim_timeline.h"
 #include "src/misc/lv_profiler_builtin.h"
 #include "src/misc/lv_rb.h"
+#include "src/misc/lv_slab.h"
 #include "src/misc/lv_utils.h"
 
 #include "src/tick/lv_tick.h"
@@ -20,10 +20,14 @@ extern "C" {
 #if LV_USE_DRAW_SW
 #include "../draw/sw/lv_draw_sw.h"
 #endif
+#if LV_USE_DRAW_DMA2D
+#include "../draw/dma2d/lv_draw_dma2d.h"
+#endif
 #include "../misc/lv_anim.h"
 #include "../misc/lv_area.h"
 #include "../misc/lv_color_op.h"
 #include "../misc/lv_ll.h"
+#include "../misc/lv_slab.h"
 #include "../misc/lv_log.h"
 #include "../misc/lv_style.h"
 #include "../misc/lv_timer.h"
@@ -31,7 +35,7 @@ extern "C" {
 #include "../others/sysmon/lv_sysmon.h"
 #include "../stdlib/builtin/lv_tlsf.h"
 
-#if LV_USE_FONT_COMPRESSED
+#if LV_USE_FONT_COMPRESSED || LV_FONT_FMT_TXT_LETTER_CACHE_SIZE || LV_USE_FONT_FMT_TXT_LOOKUP_INDEX
 #include "../font/lv_font_fmt_txt_private.h"
 #endif
 
@@ -50,6 +54,7 @@ extern "C" {
 #include "../stdlib/builtin/lv_tlsf_private.h"
 #include "../others/sysmon/lv_sysmon_private.h"
 #include "../layouts/lv_layout_private.h"
+#include "lv_obj_class_private.h"
 
 /*********************
  *      DEFINES
@@ -89,6 +94,22 @@ typedef struct lv_global_t {
     uint32_t style_custom_table_size;
     uint32_t style_last_custom_prop_id;
     uint8_t * style_custom_prop_flag_lookup_table;
+    lv_ll_t style_intern_ll;
+
+#if LV_USE_OBJ_SLAB
+    lv_slab_t obj_slab;
+    lv_slab_class_t obj_slab_classes[LV_OBJ_SLAB_CLASS_CNT];
+#if LV_OBJ_SLAB_POOL_SIZE
+    void * obj_slab_pool;
+#endif
+#endif
+
+#if LV_OBJ_STYLE_VALUE_CACHE
+    uint32_t style_value_cache_gen;
+    uint32_t style_value_cache_cnt;
+    uint32_t style_value_cache_hit_cnt;
+    uint32_t style_value_cache_miss_cnt;
+#endif
 
     lv_ll_t group_ll;
     lv_group_t * group_default;
@@ -102,6 +123,7 @@ typedef struct lv_global_t {
     bool layout_update_mutex;
 
     uint32_t memory_zero;
+    lv_mem_reclaim_cb_t mem_reclaim_cb;
     uint32_t math_rand_seed;
 
     lv_event_t * event_header;
@@ -115,6 +137,9 @@ typedef struct lv_global_t {
     lv_draw_buf_handlers_t font_draw_buf_handlers;
     lv_draw_buf_handlers_t image_cache_draw_buf_handlers;  /**< Ensure that all assigned draw buffers
                                                             * can be managed by image cache. */
+#if LV_DRAW_BUF_POOL_SIZE
+    lv_draw_buf_pool_t draw_buf_pool;
+#endif
 
     lv_ll_t img_decoder_ll;
 
@@ -128,6 +153,13 @@ typedef struct lv_global_t {
 #if LV_DRAW_SW_COMPLEX
     lv_draw_sw_mask_radius_circle_dsc_arr_t sw_circle_cache;
 #endif
+#if LV_USE_DRAW_SW && LV_DRAW_SW_TILE_SPLIT
+    lv_mutex_t sw_tile_mutex;
+#endif
+#if LV_USE_DRAW_DMA2D
+    lv_mutex_t dma2d_mutex;
+    lv_draw_dma2d_wait_cb_t dma2d_wait_cb;
+#endif
 
 #if LV_USE_LOG
     lv_log_print_g_cb_t custom_log_print_cb;
@@ -187,6 +219,21 @@ typedef struct lv_global_t {
 
 #if LV_USE_FONT_COMPRESSED
     lv_font_fmt_rle_t font_fmt_rle;
+    lv_cache_t * font_fmt_txt_cache;
+    lv_font_fmt_txt_cache_stat_t font_fmt_txt_cache_stat;
+    lv_mutex_t font_fmt_txt_cache_stat_mutex;
+#endif
+
+#if LV_FONT_FMT_TXT_LETTER_CACHE_SIZE
+    lv_font_fmt_txt_letter_cache_t font_fmt_txt_letter_cache[LV_FONT_FMT_TXT_LETTER_CACHE_SIZE];
+#endif
+
+#if LV_USE_FONT_FMT_TXT_LOOKUP_INDEX
+    lv_font_fmt_txt_index_t * font_fmt_txt_index_head;
+#endif
+
+#if (LV_FONT_FMT_TXT_LETTER_CACHE_SIZE || LV_USE_FONT_FMT_TXT_LOOKUP_INDEX) && LV_USE_OS != LV_OS_NONE
+    lv_mutex_t font_fmt_txt_lookup_mutex;
 #endif
 
 #if LV_USE_SPAN != 0
@@ -379,7 +379,7 @@ void lv_obj_allocate_spec_attr(lv_obj_t * obj)
     LV_ASSERT_OBJ(obj, MY_CLASS);
 
     if(obj->spec_attr == NULL) {
-        obj->spec_attr = lv_malloc_zeroed(sizeof(lv_obj_spec_attr_t));
+        obj->spec_attr = lv_obj_slab_alloc_zeroed(sizeof(lv_obj_spec_attr_t));
         LV_ASSERT_MALLOC(obj->spec_attr);
         if(obj->spec_attr == NULL) return;
 
@@ -531,19 +531,23 @@ static void lv_obj_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
 
     if(obj->spec_attr) {
         if(obj->spec_attr->children) {
-            lv_free(obj->spec_attr->children);
+            lv_obj_slab_free(obj->spec_attr->children);
             obj->spec_attr->children = NULL;
         }
 
         lv_event_remove_all(&obj->spec_attr->event_list);
 
-        lv_free(obj->spec_attr);
+        lv_obj_slab_free(obj->spec_attr);
         obj->spec_attr = NULL;
     }
 
 #if LV_OBJ_ID_AUTO_ASSIGN
     lv_obj_free_id(obj);
 #endif
+
+#if LV_OBJ_STYLE_VALUE_CACHE
+    lv_obj_style_value_cache_free(obj);
+#endif
 }
 
 static void lv_obj_draw(lv_event_t * e)
@@ -908,6 +912,10 @@ static void update_obj_state(lv_obj_t * obj, lv_state_t new_state)
     lv_obj_invalidate(obj);
 
     obj->state = new_state;
+#if LV_OBJ_STYLE_VALUE_CACHE
+    /*The children might inherit a changed value even if only the drawing of the object has changed*/
+    lv_obj_style_value_cache_invalidate_tree(obj);
+#endif
     lv_obj_update_layer_type(obj);
     lv_obj_style_transition_dsc_t * ts = lv_malloc_zeroed(sizeof(lv_obj_style_transition_dsc_t) * STYLE_TRANSITION_MAX);
     uint32_t tsi = 0;
@@ -12,11 +12,14 @@
 #include "../display/lv_display.h"
 #include "../display/lv_display_private.h"
 #include "../stdlib/lv_string.h"
+#include "lv_global.h"
 
 /*********************
  *      DEFINES
  *********************/
 #define MY_CLASS (&lv_obj_class)
+#define obj_slab (&LV_GLOBAL_DEFAULT()->obj_slab)
+#define obj_slab_pool LV_GLOBAL_DEFAULT()->obj_slab_pool
 
 /**********************
  *      TYPEDEFS
@@ -35,6 +38,12 @@ static uint32_t get_instance_size(const lv_obj_class_t * class_p);
 /**********************
  *  STATIC VARIABLES
  **********************/
+#if LV_USE_OBJ_SLAB
+/*Fit `lv_obj_t`, `lv_button_t` (48), attributes (44), event descriptors (12), local styles (32),
+ *the style value cache and `lv_label_t` (~140) with little waste on 32 bit MCUs.
+ *Two blocks of the largest class still fit a `LV_OBJ_SLAB_PAGE_SIZE` page, the larger widgets use the heap.*/
+static const uint16_t obj_slab_sizes[LV_OBJ_SLAB_CLASS_CNT] = {16, 32, 48, 64, 96, 128, 144, 176};
+#endif
 
 /**********************
  *      MACROS
@@ -48,7 +57,7 @@ lv_obj_t * lv_obj_class_create_obj(const lv_obj_class_t * class_p, lv_obj_t * pa
 {
     LV_TRACE_OBJ_CREATE("Creating object with %p class on %p parent", (void *)class_p, (void *)parent);
     uint32_t s = get_instance_size(class_p);
-    lv_obj_t * obj = lv_malloc_zeroed(s);
+    lv_obj_t * obj = lv_obj_slab_alloc_zeroed(s);
     if(obj == NULL) return NULL;
     obj->class_p = class_p;
     obj->parent = parent;
@@ -59,7 +68,7 @@ lv_obj_t * lv_obj_class_create_obj(const lv_obj_class_t * class_p, lv_obj_t * pa
         lv_display_t * disp = lv_display_get_default();
         if(!disp) {
             LV_LOG_WARN("No display created yet. No place to assign the new screen");
-            lv_free(obj);
+            lv_obj_slab_free(obj);
             return NULL;
         }
 
@@ -70,7 +79,7 @@ lv_obj_t * lv_obj_class_create_obj(const lv_obj_class_t * class_p, lv_obj_t * pa
         lv_obj_t ** screens = lv_realloc(disp->screens, sizeof(lv_obj_t *) * (disp->screen_cnt + 1));
         LV_ASSERT_MALLOC(screens);
         if(screens == NULL) {
-            lv_free(obj);
+            lv_obj_slab_free(obj);
             return NULL;
         }
 
@@ -93,8 +102,8 @@ lv_obj_t * lv_obj_class_create_obj(const lv_obj_class_t * class_p, lv_obj_t * pa
         }
 
         parent->spec_attr->child_cnt++;
-        parent->spec_attr->children = lv_realloc(parent->spec_attr->children,
-                                                 sizeof(lv_obj_t *) * parent->spec_attr->child_cnt);
+        parent->spec_attr->children = lv_obj_slab_realloc(parent->spec_attr->children,
+                                                          sizeof(lv_obj_t *) * parent->spec_attr->child_cnt);
         parent->spec_attr->children[parent->spec_attr->child_cnt - 1] = obj;
     }
 
@@ -170,6 +179,88 @@ bool lv_obj_is_group_def(lv_obj_t * obj)
     return class_p->group_def == LV_OBJ_CLASS_GROUP_DEF_TRUE;
 }
 
+void lv_obj_slab_init(void)
+{
+#if LV_USE_OBJ_SLAB
+    lv_slab_init(obj_slab, LV_GLOBAL_DEFAULT()->obj_slab_classes, obj_slab_sizes, LV_OBJ_SLAB_CLASS_CNT,
+                 LV_OBJ_SLAB_PAGE_SIZE, lv_malloc, lv_free);
+    /*Resize the widgets larger than the largest class (and the children arrays) in place if possible*/
+    lv_slab_set_realloc_cb(obj_slab, lv_realloc);
+
+#if LV_OBJ_SLAB_POOL_SIZE
+    /*Not a problem if it fails, the pages will be allocated from the heap*/
+    obj_slab_pool = lv_malloc(LV_OBJ_SLAB_POOL_SIZE);
+    lv_slab_set_page_pool(obj_slab, obj_slab_pool, LV_OBJ_SLAB_POOL_SIZE);
+#endif
+#endif
+}
+
+void lv_obj_slab_deinit(void)
+{
+#if LV_USE_OBJ_SLAB
+    lv_slab_destroy(obj_slab);
+
+#if LV_OBJ_SLAB_POOL_SIZE
+    lv_free(obj_slab_pool);
+    obj_slab_pool = NULL;
+#endif
+#endif
+}
+
+void * lv_obj_slab_alloc(size_t size)
+{
+#if LV_USE_OBJ_SLAB
+    void * p = lv_slab_alloc(obj_slab, size);
+    LV_ASSERT_MALLOC(p);
+    return p;
+#else
+    return lv_malloc(size);
+#endif
+}
+
+void * lv_obj_slab_alloc_zeroed(size_t size)
+{
+#if LV_USE_OBJ_SLAB
+    void * p = lv_obj_slab_alloc(size);
+    if(p) lv_memzero(p, size);
+    return p;
+#else
+    return lv_malloc_zeroed(size);
+#endif
+}
+
+void * lv_obj_slab_realloc(void * p, size_t new_size)
+{
+#if LV_USE_OBJ_SLAB
+    return lv_slab_realloc(obj_slab, p, new_size);
+#else
+    return lv_realloc(p, new_size);
+#endif
+}
+
+void lv_obj_slab_free(void * p)
+{
+#if LV_USE_OBJ_SLAB
+    lv_slab_free(obj_slab, p);
+#else
+    lv_free(p);
+#endif
+}
+
+#if LV_USE_OBJ_SLAB
+
+void lv_obj_slab_get_stat(lv_slab_stat_t * stat)
+{
+    lv_slab_get_stat(obj_slab, stat);
+}
+
+void lv_obj_slab_reset_stat(void)
+{
+    lv_slab_reset_stat(obj_slab);
+}
+
+#endif /*LV_USE_OBJ_SLAB*/
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
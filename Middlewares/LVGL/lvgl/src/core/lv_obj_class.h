@@ -15,6 +15,7 @@ extern "C" {
  *********************/
 #include "../misc/lv_types.h"
 #include "../misc/lv_area.h"
+#include "../misc/lv_slab.h"
 #include "lv_obj_property.h"
 
 /*********************
@@ -61,6 +62,22 @@ bool lv_obj_is_editable(lv_obj_t * obj);
 
 bool lv_obj_is_group_def(lv_obj_t * obj);
 
+#if LV_USE_OBJ_SLAB
+
+/**
+ * Get the statistics of the memory used by the objects, their attributes, style lists,
+ * local styles and event descriptors
+ * @param stat      store the result here
+ */
+void lv_obj_slab_get_stat(lv_slab_stat_t * stat);
+
+/**
+ * Reset the allocation counters of the object allocator
+ */
+void lv_obj_slab_reset_stat(void);
+
+#endif /*LV_USE_OBJ_SLAB*/
+
 /**********************
  *      MACROS
  **********************/
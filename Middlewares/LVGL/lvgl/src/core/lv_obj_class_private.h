@@ -15,11 +15,17 @@ extern "C" {
  *********************/
 
 #include "lv_obj_class.h"
+#include "../misc/lv_slab.h"
 
 /*********************
  *      DEFINES
  *********************/
 
+#if LV_USE_OBJ_SLAB
+/** Number of block sizes used for the objects and their side allocations*/
+#define LV_OBJ_SLAB_CLASS_CNT   8
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -67,6 +73,46 @@ struct lv_obj_class_t {
 
 void lv_obj_destruct(lv_obj_t * obj);
 
+/**
+ * Initialize the allocator of the objects. Called by LVGL in `lv_init()`
+ */
+void lv_obj_slab_init(void);
+
+/**
+ * Free the pages of the object allocator. Called by LVGL in `lv_deinit()`
+ */
+void lv_obj_slab_deinit(void);
+
+/**
+ * Allocate memory for an object or for a side allocation of an object (attributes, style list, local styles,
+ * event descriptors). Small blocks come from the object slab if `LV_USE_OBJ_SLAB` is enabled.
+ * The memory can be freed only with `lv_obj_slab_free()`.
+ * @param size      size of the memory in bytes
+ * @return          pointer to the allocated memory or NULL if there is not enough memory
+ */
+void * lv_obj_slab_alloc(size_t size);
+
+/**
+ * Allocate zeroed memory for an object or a side allocation of an object
+ * @param size      size of the memory in bytes
+ * @return          pointer to the allocated memory or NULL if there is not enough memory
+ */
+void * lv_obj_slab_alloc_zeroed(size_t size);
+
+/**
+ * Resize a memory allocated by `lv_obj_slab_alloc()`. It works like `lv_realloc()`.
+ * @param p         pointer to the memory or NULL
+ * @param new_size  the new size in bytes. 0 frees the memory.
+ * @return          pointer to the resized memory or NULL
+ */
+void * lv_obj_slab_realloc(void * p, size_t new_size);
+
+/**
+ * Free a memory allocated by `lv_obj_slab_alloc()`
+ * @param p         pointer to the memory. NULL is ignored
+ */
+void lv_obj_slab_free(void * p);
+
 /**********************
  *      MACROS
  **********************/
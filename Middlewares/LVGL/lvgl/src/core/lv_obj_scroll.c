@@ -13,6 +13,7 @@
 #include "../indev/lv_indev_scroll.h"
 #include "../display/lv_display.h"
 #include "../misc/lv_area.h"
+#include "lv_refr_private.h"
 
 /*********************
  *      DEFINES
@@ -422,7 +423,9 @@ lv_result_t lv_obj_scroll_by_raw(lv_obj_t * obj, int32_t x, int32_t y)
     lv_obj_move_children_by(obj, x, y, true);
     lv_result_t res = lv_obj_send_event(obj, LV_EVENT_SCROLL, NULL);
     if(res != LV_RESULT_OK) return res;
-    lv_obj_invalidate(obj);
+
+    /*Move the already rendered pixels if possible, else redraw the whole object*/
+    if(!lv_refr_scroll_blit(obj, x, y)) lv_obj_invalidate(obj);
     return LV_RESULT_OK;
 }
 
@@ -23,6 +23,10 @@
 #define style_trans_ll_p &(LV_GLOBAL_DEFAULT()->style_trans_ll)
 #define _style_custom_prop_flag_lookup_table LV_GLOBAL_DEFAULT()->style_custom_prop_flag_lookup_table
 #define STYLE_PROP_SHIFTED(prop) ((uint32_t)1 << ((prop) >> 3))
+#define style_value_cache_gen LV_GLOBAL_DEFAULT()->style_value_cache_gen
+#define style_value_cache_cnt LV_GLOBAL_DEFAULT()->style_value_cache_cnt
+#define style_value_cache_hit_cnt LV_GLOBAL_DEFAULT()->style_value_cache_hit_cnt
+#define style_value_cache_miss_cnt LV_GLOBAL_DEFAULT()->style_value_cache_miss_cnt
 
 /**********************
  *      TYPEDEFS
@@ -68,11 +72,56 @@ static void fade_in_anim_completed(lv_anim_t * a);
 static bool style_has_flag(const lv_style_t * style, uint32_t flag);
 static lv_style_res_t get_selector_style_prop(const lv_obj_t * obj, lv_style_selector_t selector, lv_style_prop_t prop,
                                               lv_style_value_t * value_act);
+static lv_style_value_t resolve_style_prop(const lv_obj_t * obj, lv_style_selector_t selector, lv_style_prop_t prop);
+#if LV_OBJ_STYLE_VALUE_CACHE
+    static lv_style_value_t get_cached_style_prop(const lv_obj_t * obj, lv_style_selector_t selector, lv_style_prop_t prop,
+                                                  uint32_t slot);
+    static void set_own_style_prop(lv_style_t * style, lv_style_prop_t prop, lv_style_value_t value);
+#else
+    #define set_own_style_prop(style, prop, value) lv_style_set_prop(style, prop, value)
+#endif
 
 /**********************
  *  STATIC VARIABLES
  **********************/
 
+#if LV_OBJ_STYLE_VALUE_CACHE
+/*Index + 1 of the cached properties in `lv_obj_style_value_cache_t::values`. 0: the property is not cached*/
+static const uint8_t value_cache_slots[LV_STYLE_NUM_BUILT_IN_PROPS] = {
+    [LV_STYLE_PAD_TOP] = 1,
+    [LV_STYLE_PAD_BOTTOM] = 2,
+    [LV_STYLE_PAD_LEFT] = 3,
+    [LV_STYLE_PAD_RIGHT] = 4,
+    [LV_STYLE_RADIUS] = 5,
+    [LV_STYLE_CLIP_CORNER] = 6,
+    [LV_STYLE_OPA] = 7,
+    [LV_STYLE_BLEND_MODE] = 8,
+    [LV_STYLE_BASE_DIR] = 9,
+    [LV_STYLE_COLOR_FILTER_DSC] = 10,
+    [LV_STYLE_BG_COLOR] = 11,
+    [LV_STYLE_BG_OPA] = 12,
+    [LV_STYLE_BG_GRAD_DIR] = 13,
+    [LV_STYLE_BG_GRAD] = 14,
+    [LV_STYLE_BG_IMAGE_SRC] = 15,
+    [LV_STYLE_BORDER_COLOR] = 16,
+    [LV_STYLE_BORDER_OPA] = 17,
+    [LV_STYLE_BORDER_WIDTH] = 18,
+    [LV_STYLE_BORDER_SIDE] = 19,
+    [LV_STYLE_BORDER_POST] = 20,
+    [LV_STYLE_OUTLINE_WIDTH] = 21,
+    [LV_STYLE_OUTLINE_OPA] = 22,
+    [LV_STYLE_SHADOW_WIDTH] = 23,
+    [LV_STYLE_SHADOW_OPA] = 24,
+    [LV_STYLE_TEXT_COLOR] = 25,
+    [LV_STYLE_TEXT_OPA] = 26,
+    [LV_STYLE_TEXT_FONT] = 27,
+    [LV_STYLE_TEXT_LETTER_SPACE] = 28,
+    [LV_STYLE_TEXT_LINE_SPACE] = 29,
+    [LV_STYLE_TEXT_DECOR] = 30,
+    [LV_STYLE_TEXT_ALIGN] = 31,
+};
+#endif
+
 /**********************
  *      MACROS
  **********************/
@@ -123,7 +172,7 @@ void lv_obj_add_style(lv_obj_t * obj, const lv_style_t * style, lv_style_selecto
     /*Allocate space for the new style and shift the rest of the style to the end*/
     obj->style_cnt++;
     LV_ASSERT(obj->style_cnt != 0);
-    obj->styles = lv_realloc(obj->styles, obj->style_cnt * sizeof(lv_obj_style_t));
+    obj->styles = lv_obj_slab_realloc(obj->styles, obj->style_cnt * sizeof(lv_obj_style_t));
     LV_ASSERT_MALLOC(obj->styles);
 
     uint32_t j;
@@ -229,7 +278,7 @@ void lv_obj_remove_style(lv_obj_t * obj, const lv_style_t * style, lv_style_sele
 
         if(obj->styles[i].is_local || obj->styles[i].is_trans) {
             if(obj->styles[i].style) lv_style_reset((lv_style_t *)obj->styles[i].style);
-            lv_free((lv_style_t *)obj->styles[i].style);
+            lv_obj_slab_free((lv_style_t *)obj->styles[i].style);
             obj->styles[i].style = NULL;
         }
 
@@ -240,7 +289,7 @@ void lv_obj_remove_style(lv_obj_t * obj, const lv_style_t * style, lv_style_sele
         }
 
         obj->style_cnt--;
-        obj->styles = lv_realloc(obj->styles, obj->style_cnt * sizeof(lv_obj_style_t));
+        obj->styles = lv_obj_slab_realloc(obj->styles, obj->style_cnt * sizeof(lv_obj_style_t));
 
         deleted = true;
         /*The style from the current `i` index is removed, so `i` points to the next style.
@@ -260,6 +309,10 @@ void lv_obj_remove_style_all(lv_obj_t * obj)
 
 void lv_obj_report_style_change(lv_style_t * style)
 {
+#if LV_OBJ_STYLE_VALUE_CACHE
+    lv_obj_style_value_cache_invalidate();
+#endif
+
     if(!style_refr) return;
     lv_display_t * d = lv_display_get_next(NULL);
 
@@ -276,6 +329,11 @@ void lv_obj_refresh_style(lv_obj_t * obj, lv_style_selector_t selector, lv_style
 {
     LV_ASSERT_OBJ(obj, MY_CLASS);
 
+#if LV_OBJ_STYLE_VALUE_CACHE
+    /*Inherited properties might change on the children too, so drop their values as well*/
+    lv_obj_style_value_cache_invalidate_tree(obj);
+#endif
+
     if(!style_refr) return;
 
     lv_obj_invalidate(obj);
@@ -328,13 +386,15 @@ lv_style_value_t lv_obj_get_style_prop(const lv_obj_t * obj, lv_part_t part, lv_
     LV_ASSERT_NULL(obj)
 
     lv_style_selector_t selector = part | obj->state;
-    lv_style_value_t value_act = { .ptr = NULL };
-    lv_style_res_t found;
 
-    found = get_selector_style_prop(obj, selector, prop, &value_act);
-    if(found == LV_STYLE_RES_FOUND) return value_act;
+#if LV_OBJ_STYLE_VALUE_CACHE
+    /*When the transitions are skipped the value is different from the normal one, so don't cache it*/
+    if(prop < LV_STYLE_NUM_BUILT_IN_PROPS && value_cache_slots[prop] != 0 && !obj->skip_trans) {
+        return get_cached_style_prop(obj, selector, prop, value_cache_slots[prop] - 1);
+    }
+#endif
 
-    return lv_style_prop_get_default(prop);
+    return resolve_style_prop(obj, selector, prop);
 }
 
 bool lv_obj_has_style_prop(const lv_obj_t * obj, lv_style_selector_t selector, lv_style_prop_t prop)
@@ -350,6 +410,68 @@ bool lv_obj_has_style_prop(const lv_obj_t * obj, lv_style_selector_t selector, l
     return false;
 }
 
+#if LV_OBJ_STYLE_VALUE_CACHE
+
+void lv_obj_style_value_cache_get_stat(lv_obj_style_value_cache_stat_t * stat)
+{
+    LV_ASSERT_NULL(stat);
+
+    stat->hit_cnt = style_value_cache_hit_cnt;
+    stat->miss_cnt = style_value_cache_miss_cnt;
+    stat->part_cnt = style_value_cache_cnt;
+}
+
+void lv_obj_style_value_cache_reset_stat(void)
+{
+    style_value_cache_hit_cnt = 0;
+    style_value_cache_miss_cnt = 0;
+}
+
+void lv_obj_style_value_cache_invalidate(void)
+{
+    style_value_cache_gen++;
+}
+
+void lv_obj_style_value_cache_invalidate_tree(lv_obj_t * obj)
+{
+    lv_obj_style_value_cache_t * cache;
+    for(cache = obj->style_value_cache; cache; cache = cache->next) {
+        cache->valid = 0;
+    }
+
+    uint32_t child_cnt = lv_obj_get_child_count(obj);
+    uint32_t i;
+    for(i = 0; i < child_cnt; i++) {
+        lv_obj_style_value_cache_invalidate_tree(obj->spec_attr->children[i]);
+    }
+}
+
+void lv_obj_style_value_cache_free(lv_obj_t * obj)
+{
+    lv_obj_style_value_cache_t * cache = obj->style_value_cache;
+    while(cache) {
+        lv_obj_style_value_cache_t * next = cache->next;
+        lv_obj_slab_free(cache);
+        style_value_cache_cnt--;
+        cache = next;
+    }
+
+    obj->style_value_cache = NULL;
+}
+
+void lv_obj_style_value_cache_free_tree(lv_obj_t * obj)
+{
+    lv_obj_style_value_cache_free(obj);
+
+    uint32_t child_cnt = lv_obj_get_child_count(obj);
+    uint32_t i;
+    for(i = 0; i < child_cnt; i++) {
+        lv_obj_style_value_cache_free_tree(obj->spec_attr->children[i]);
+    }
+}
+
+#endif /*LV_OBJ_STYLE_VALUE_CACHE*/
+
 void lv_obj_set_local_style_prop(lv_obj_t * obj, lv_style_prop_t prop, lv_style_value_t value,
                                  lv_style_selector_t selector)
 {
@@ -361,7 +483,7 @@ void lv_obj_set_local_style_prop(lv_obj_t * obj, lv_style_prop_t prop, lv_style_
         lv_obj_invalidate(obj);
     }
 
-    lv_style_set_prop(style, prop, value);
+    set_own_style_prop(style, prop, value);
 
 #if LV_OBJ_STYLE_CACHE
     uint32_t prop_shifted = STYLE_PROP_SHIFTED(prop);
@@ -641,7 +763,7 @@ static lv_style_t * get_local_style(lv_obj_t * obj, lv_style_selector_t selector
 
     obj->style_cnt++;
     LV_ASSERT(obj->style_cnt != 0);
-    obj->styles = lv_realloc(obj->styles, obj->style_cnt * sizeof(lv_obj_style_t));
+    obj->styles = lv_obj_slab_realloc(obj->styles, obj->style_cnt * sizeof(lv_obj_style_t));
     LV_ASSERT_MALLOC(obj->styles);
 
     for(i = obj->style_cnt - 1; i > 0 ; i--) {
@@ -652,7 +774,7 @@ static lv_style_t * get_local_style(lv_obj_t * obj, lv_style_selector_t selector
     }
 
     lv_memzero(&obj->styles[i], sizeof(lv_obj_style_t));
-    obj->styles[i].style = lv_malloc(sizeof(lv_style_t));
+    obj->styles[i].style = lv_obj_slab_alloc(sizeof(lv_style_t));
     lv_style_init((lv_style_t *)obj->styles[i].style);
 
     obj->styles[i].is_local = 1;
@@ -679,14 +801,14 @@ static lv_obj_style_t * get_trans_style(lv_obj_t * obj,  lv_style_selector_t sel
 
     obj->style_cnt++;
     LV_ASSERT(obj->style_cnt != 0);
-    obj->styles = lv_realloc(obj->styles, obj->style_cnt * sizeof(lv_obj_style_t));
+    obj->styles = lv_obj_slab_realloc(obj->styles, obj->style_cnt * sizeof(lv_obj_style_t));
 
     for(i = obj->style_cnt - 1; i > 0 ; i--) {
         obj->styles[i] = obj->styles[i - 1];
     }
 
     lv_memzero(&obj->styles[0], sizeof(lv_obj_style_t));
-    obj->styles[0].style = lv_malloc(sizeof(lv_style_t));
+    obj->styles[0].style = lv_obj_slab_alloc(sizeof(lv_style_t));
     lv_style_init((lv_style_t *)obj->styles[0].style);
 
     obj->styles[0].is_trans = 1;
@@ -888,7 +1010,7 @@ static void trans_anim_cb(void * _tr, int32_t v)
                 refr = false;
             }
         }
-        lv_style_set_prop((lv_style_t *)obj->styles[i].style, tr->prop, value_final);
+        set_own_style_prop((lv_style_t *)obj->styles[i].style, tr->prop, value_final);
         if(refr) lv_obj_refresh_style(tr->obj, tr->selector, tr->prop);
         break;
 
@@ -1053,6 +1175,94 @@ static bool style_has_flag(const lv_style_t * style, uint32_t flag)
     return false;
 }
 
+/**
+ * Get the value of a style property from the styles of the object, its parents or the defaults
+ * @param obj       pointer to an object
+ * @param selector  the part and state whose value should be get
+ * @param prop      the property to get
+ * @return          the value of the property
+ */
+static lv_style_value_t resolve_style_prop(const lv_obj_t * obj, lv_style_selector_t selector, lv_style_prop_t prop)
+{
+    lv_style_value_t value_act = { .ptr = NULL };
+    lv_style_res_t found;
+
+    found = get_selector_style_prop(obj, selector, prop, &value_act);
+    if(found == LV_STYLE_RES_FOUND) return value_act;
+
+    return lv_style_prop_get_default(prop);
+}
+
+#if LV_OBJ_STYLE_VALUE_CACHE
+/**
+ * Get the value of a style property from the cache of the object's part.
+ * If the value is not cached yet or the cached values are outdated, resolve it and store it in the cache.
+ * @param obj       pointer to an object
+ * @param selector  the part and the current state of the object
+ * @param prop      the property to get
+ * @param slot      index of the property in `lv_obj_style_value_cache_t::values`
+ * @return          the value of the property
+ */
+static lv_style_value_t get_cached_style_prop(const lv_obj_t * obj, lv_style_selector_t selector, lv_style_prop_t prop,
+                                              uint32_t slot)
+{
+    lv_part_t part = lv_obj_style_get_selector_part(selector);
+    lv_obj_style_value_cache_t * cache = obj->style_value_cache;
+    while(cache && lv_obj_style_get_selector_part(cache->selector) != part) {
+        cache = cache->next;
+    }
+
+    if(cache == NULL) {
+        /*Not a problem, just get the value without caching it*/
+        if(style_value_cache_cnt >= LV_OBJ_STYLE_VALUE_CACHE_MAX_CNT) return resolve_style_prop(obj, selector, prop);
+        cache = lv_obj_slab_alloc(sizeof(lv_obj_style_value_cache_t));
+        if(cache == NULL) return resolve_style_prop(obj, selector, prop);
+        style_value_cache_cnt++;
+
+        cache->selector = selector;
+        cache->gen = style_value_cache_gen;
+        cache->valid = 0;
+
+        /*Only the cache is modified, not the object itself*/
+        lv_obj_t * obj_cache = (lv_obj_t *)obj;
+        cache->next = obj_cache->style_value_cache;
+        obj_cache->style_value_cache = cache;
+    }
+    else if(cache->selector != selector || cache->gen != style_value_cache_gen) {
+        /*The state has changed or a style was modified since the values were resolved*/
+        cache->selector = selector;
+        cache->gen = style_value_cache_gen;
+        cache->valid = 0;
+    }
+
+    uint32_t bit = (uint32_t)1 << slot;
+    if(cache->valid & bit) {
+        style_value_cache_hit_cnt++;
+        return cache->values[slot];
+    }
+
+    style_value_cache_miss_cnt++;
+    cache->values[slot] = resolve_style_prop(obj, selector, prop);
+    cache->valid |= bit;
+    return cache->values[slot];
+}
+
+/**
+ * Set a property in a style which is used only by one object (local or transition style).
+ * The caller refreshes the style of the object which drops the cached values of its subtree,
+ * so unlike `lv_style_set_prop` the cached values of all the other objects can be kept.
+ * @param style     pointer to a style of an object
+ * @param prop      the property to set
+ * @param value     the new value
+ */
+static void set_own_style_prop(lv_style_t * style, lv_style_prop_t prop, lv_style_value_t value)
+{
+    uint32_t gen = style_value_cache_gen;
+    lv_style_set_prop(style, prop, value);
+    style_value_cache_gen = gen;
+}
+#endif /*LV_OBJ_STYLE_VALUE_CACHE*/
+
 static lv_style_res_t get_selector_style_prop(const lv_obj_t * obj, lv_style_selector_t selector, lv_style_prop_t prop,
                                               lv_style_value_t * value_act)
 {
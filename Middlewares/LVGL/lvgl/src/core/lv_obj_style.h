@@ -34,6 +34,15 @@ typedef enum {
 
 typedef uint32_t lv_style_selector_t;
 
+#if LV_OBJ_STYLE_VALUE_CACHE
+/** Statistics of the cache of resolved style values */
+typedef struct {
+    uint32_t hit_cnt;       /**< Number of style properties read from the cache */
+    uint32_t miss_cnt;      /**< Number of style properties which needed to be resolved from the styles */
+    uint32_t part_cnt;      /**< Number of parts whose values are cached */
+} lv_obj_style_value_cache_stat_t;
+#endif
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -138,6 +147,22 @@ lv_style_value_t lv_obj_get_style_prop(const lv_obj_t * obj, lv_part_t part, lv_
  */
 bool lv_obj_has_style_prop(const lv_obj_t * obj, lv_style_selector_t selector, lv_style_prop_t prop);
 
+#if LV_OBJ_STYLE_VALUE_CACHE
+
+/**
+ * Get the statistics of the cache of resolved style values.
+ * The cache is enabled by `LV_OBJ_STYLE_VALUE_CACHE`.
+ * @param stat      store the statistics here
+ */
+void lv_obj_style_value_cache_get_stat(lv_obj_style_value_cache_stat_t * stat);
+
+/**
+ * Reset the hit and miss counters of the style value cache
+ */
+void lv_obj_style_value_cache_reset_stat(void);
+
+#endif /*LV_OBJ_STYLE_VALUE_CACHE*/
+
 /**
  * Set local style property on an object's part and state.
  * @param obj       pointer to an object
@@ -20,6 +20,9 @@ extern "C" {
  *      DEFINES
  *********************/
 
+/** Number of style properties whose resolved value is cached*/
+#define LV_OBJ_STYLE_VALUE_CACHE_PROP_CNT   31
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -40,6 +43,17 @@ struct lv_obj_style_transition_dsc_t {
     void * user_data;
 };
 
+#if LV_OBJ_STYLE_VALUE_CACHE
+/** Resolved values of the often used style properties of a part of an object*/
+struct lv_obj_style_value_cache_t {
+    lv_obj_style_value_cache_t * next;  /**< Cache of an other part of the same object*/
+    lv_style_selector_t selector;       /**< The part and state whose values are stored*/
+    uint32_t gen;                       /**< The style generation when the values were resolved*/
+    uint32_t valid;                     /**< Bit `n` is set if `values[n]` is resolved*/
+    lv_style_value_t values[LV_OBJ_STYLE_VALUE_CACHE_PROP_CNT];
+};
+#endif
+
 
 /**********************
  * GLOBAL PROTOTYPES
@@ -84,6 +98,37 @@ lv_style_state_cmp_t lv_obj_style_state_compare(lv_obj_t * obj, lv_state_t state
  */
 void lv_obj_update_layer_type(lv_obj_t * obj);
 
+#if LV_OBJ_STYLE_VALUE_CACHE
+/**
+ * Mark the resolved style values of all objects as outdated.
+ * Needs to be called when a style is changed which can be used by any object.
+ */
+void lv_obj_style_value_cache_invalidate(void);
+
+/**
+ * Mark the resolved style values of an object and its children as outdated.
+ * Needs to be called when the resolved values of only this object can change,
+ * e.g. its state or its own styles are changed. The children are included
+ * because they might inherit the changed values.
+ * @param obj       pointer to an object
+ */
+void lv_obj_style_value_cache_invalidate_tree(lv_obj_t * obj);
+
+/**
+ * Free the resolved style values of an object.
+ * Called by LVGL when the object is deleted.
+ * @param obj       pointer to an object
+ */
+void lv_obj_style_value_cache_free(lv_obj_t * obj);
+
+/**
+ * Free the resolved style values of an object and its children.
+ * Called by LVGL when a screen is unloaded to give its cache records to the new screen.
+ * @param obj       pointer to an object
+ */
+void lv_obj_style_value_cache_free_tree(lv_obj_t * obj);
+#endif
+
 /**********************
  *      MACROS
  **********************/
@@ -13,6 +13,8 @@
 #include "../draw/lv_draw_mask_private.h"
 #include "lv_obj_private.h"
 #include "lv_obj_event_private.h"
+#include "lv_obj_class_private.h"
+#include "../misc/lv_event_private.h"
 #include "../display/lv_display.h"
 #include "../display/lv_display_private.h"
 #include "../tick/lv_tick.h"
@@ -32,6 +34,11 @@
 /*Display being refreshed*/
 #define disp_refr LV_GLOBAL_DEFAULT()->disp_refresh
 
+/*Bits of `inv_area_joined` used by `join_inv_areas`. Only `INV_AREA_JOINED` remains set when it returns*/
+#define INV_AREA_JOINED         0x01    /*Joined into an other area*/
+#define INV_AREA_GROWN          0x02    /*Other areas were joined into it in the current pass*/
+#define INV_AREA_GROWN_PREV     0x04    /*Other areas were joined into it in the previous pass*/
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -40,17 +47,44 @@
  *  STATIC PROTOTYPES
  **********************/
 static void lv_refr_join_area(void);
+static bool join_inv_areas(lv_display_t * disp);
+static inline int64_t inv_area_gap_cost(int32_t end, int32_t start, int32_t size);
+static void sort_inv_areas(lv_area_t * areas, uint32_t cnt);
+static void compact_inv_areas(lv_display_t * disp);
+static bool grow_inv_areas(lv_display_t * disp);
+static void shrink_inv_areas(lv_display_t * disp);
+static void merge_into_cheapest_inv_area(lv_display_t * disp, const lv_area_t * area_p);
 static void refr_invalid_areas(void);
 static void refr_sync_areas(void);
+static void sync_area_add(lv_ll_t * areas, const lv_area_t * area_p);
+static bool is_scroll_blit_src(const lv_area_t * area_p);
+static void refr_scroll_blits(void);
+static void scroll_blit_sw(lv_draw_buf_t * buf, const lv_area_t * area, int32_t dx, int32_t dy);
+static bool scroll_blit_is_safe(lv_obj_t * obj);
+static void get_scrollbar_tracks(lv_obj_t * obj, lv_area_t * hor_area, lv_area_t * ver_area);
+static void scroll_blit_inv_moved(lv_display_t * disp, const lv_display_scroll_blit_t * blit, const lv_area_t * area_p);
+static void scroll_blit_inv_on_top(lv_display_t * disp, const lv_display_scroll_blit_t * blit,
+                                   const lv_area_t * area_p);
+static void scroll_blit_inv_children_on_top(lv_display_t * disp, const lv_display_scroll_blit_t * blit,
+                                            lv_obj_t * parent, uint32_t start, bool floating_only);
 static void refr_area(const lv_area_t * area_p);
 static void refr_area_part(lv_layer_t * layer);
+static void refr_area_tiled(const lv_area_t * area_p);
+static bool batch_layer_is_waiting(lv_layer_t * layer);
+static void refr_screens(lv_layer_t * layer, lv_obj_t * top_act_scr, lv_obj_t * top_prev_scr);
 static lv_obj_t * lv_refr_get_top_obj(const lv_area_t * area_p, lv_obj_t * obj);
 static void refr_obj_and_children(lv_layer_t * layer, lv_obj_t * top_obj);
 static void refr_obj(lv_layer_t * layer, lv_obj_t * obj);
 static uint32_t get_max_row(lv_display_t * disp, int32_t area_w, int32_t area_h);
 static void draw_buf_flush(lv_display_t * disp);
+static void tile_flush(lv_display_t * disp, lv_layer_t * tile, bool last_tile);
 static void call_flush_cb(lv_display_t * disp, const lv_area_t * area, uint8_t * px_map);
+static bool flush_diff_area(lv_display_t * disp, lv_area_t * area, uint8_t * px_map);
+static uint32_t flush_diff_hash(const uint8_t * data, uint32_t len);
 static void wait_for_flushing(lv_display_t * disp);
+static void swap_buffers(lv_display_t * disp);
+static lv_draw_buf_t * get_prev_buf(lv_display_t * disp);
+static uint32_t get_buf_index(lv_display_t * disp, const lv_draw_buf_t * buf);
 
 /**********************
  *  STATIC VARIABLES
@@ -310,23 +344,134 @@ void lv_inv_area(lv_display_t * disp, const lv_area_t * area_p)
     if(res != LV_RESULT_OK) return;
 
     /*Save only if this area is not in one of the saved areas*/
-    uint16_t i;
+    uint32_t i;
     for(i = 0; i < disp->inv_p; i++) {
         if(lv_area_is_in(&com_area, &disp->inv_areas[i], 0) != false) return;
     }
 
-    /*Save the area*/
-    lv_area_t * tmp_area_p = &com_area;
-    if(disp->inv_p >= LV_INV_BUF_SIZE) { /*If no place for the area add the screen*/
-        disp->inv_p = 0;
-        tmp_area_p = &scr_area;
+    /*If there is no place for the area first try to join the saved areas, then allocate more space*/
+    if(disp->inv_p >= disp->inv_size) {
+        if(join_inv_areas(disp)) compact_inv_areas(disp);
+        else grow_inv_areas(disp);
+    }
+
+    /*Save the area or, if still no place for it, join it into the saved area which grows the least*/
+    if(disp->inv_p < disp->inv_size) {
+        lv_area_copy(&disp->inv_areas[disp->inv_p], &com_area);
+        disp->inv_p++;
+    }
+    else {
+        merge_into_cheapest_inv_area(disp, &com_area);
     }
-    lv_area_copy(&disp->inv_areas[disp->inv_p], tmp_area_p);
-    disp->inv_p++;
 
     lv_display_send_event(disp, LV_EVENT_REFR_REQUEST, NULL);
 }
 
+bool lv_refr_scroll_blit(lv_obj_t * obj, int32_t dx, int32_t dy)
+{
+    lv_display_t * disp = lv_obj_get_display(obj);
+    if(disp == NULL || !disp->scroll_blit) return false;
+    if(disp->render_mode != LV_DISPLAY_RENDER_MODE_DIRECT) return false;
+    if(disp->rotation != LV_DISPLAY_ROTATION_0) return false;
+    if(disp->buf_act == NULL || lv_color_format_get_bpp(disp->color_format) < 8) return false;
+    if(!lv_display_is_invalidation_enabled(disp) || disp->rendering_in_progress) return false;
+
+    /*During screen load animations the moved pixels might belong to the other screen*/
+    if(disp->prev_scr || lv_obj_get_screen(obj) != disp->act_scr) return false;
+
+    if(!scroll_blit_is_safe(obj)) return false;
+
+    /*The visible part of the object. It's redrawn except where the moved pixels land.*/
+    lv_area_t obj_area = obj->coords;
+    if(!lv_obj_area_is_visible(obj, &obj_area)) return true;
+
+    lv_area_t disp_area;
+    lv_area_set(&disp_area, 0, 0, lv_display_get_horizontal_resolution(disp) - 1,
+                lv_display_get_vertical_resolution(disp) - 1);
+    if(!lv_area_intersect(&obj_area, &obj_area, &disp_area)) return true;
+
+    /*Only the inner part can be moved: leave out the border, the rounded corners and the scrollbars*/
+    lv_area_t blit_area = obj->coords;
+    int32_t w = lv_area_get_width(&blit_area);
+    int32_t h = lv_area_get_height(&blit_area);
+    int32_t shrink = lv_obj_get_style_radius(obj, LV_PART_MAIN);
+    shrink = LV_MIN3(shrink, w / 2, h / 2);
+    if(lv_obj_get_style_border_side(obj, LV_PART_MAIN) != LV_BORDER_SIDE_NONE &&
+       lv_obj_get_style_border_opa(obj, LV_PART_MAIN) > LV_OPA_MIN) {
+        shrink = LV_MAX(shrink, lv_obj_get_style_border_width(obj, LV_PART_MAIN));
+    }
+    lv_area_increase(&blit_area, -shrink, -shrink);
+
+    lv_area_t hor_track;
+    lv_area_t ver_track;
+    get_scrollbar_tracks(obj, &hor_track, &ver_track);
+    if(lv_area_get_width(&ver_track) > 0) {
+        if(ver_track.x1 == obj->coords.x1) blit_area.x1 = LV_MAX(blit_area.x1, ver_track.x2 + 1);
+        else blit_area.x2 = LV_MIN(blit_area.x2, ver_track.x1 - 1);
+    }
+    if(lv_area_get_height(&hor_track) > 0) blit_area.y2 = LV_MIN(blit_area.y2, hor_track.y1 - 1);
+
+    if(!lv_area_intersect(&blit_area, &blit_area, &obj_area)) return false;
+
+    /*The moved pixels land where both the source and the destination are in the blit area*/
+    lv_display_scroll_blit_t blit;
+    lv_area_t moved_area = blit_area;
+    lv_area_move(&moved_area, dx, dy);
+    if(!lv_area_intersect(&blit.area, &blit_area, &moved_area)) return false;
+    blit.dx = dx;
+    blit.dy = dy;
+
+    /*The pixels of the not yet redrawn areas are outdated at their new position too.
+     *Work on a copy of them as invalidating might join, reorder and compact the saved areas.*/
+    uint32_t inv_p = disp->inv_p;
+    uint32_t i;
+    if(inv_p > 0) {
+        lv_area_t * old_areas = lv_malloc(inv_p * sizeof(lv_area_t));
+        if(old_areas == NULL) return false;
+        lv_memcpy(old_areas, disp->inv_areas, inv_p * sizeof(lv_area_t));
+        for(i = 0; i < inv_p; i++) {
+            scroll_blit_inv_moved(disp, &blit, &old_areas[i]);
+        }
+        lv_free(old_areas);
+    }
+
+    /*Redraw the rest of the object, e.g. the newly exposed part*/
+    lv_area_t res[4];
+    int8_t res_c = lv_area_diff(res, &obj_area, &blit.area);
+    int8_t j;
+    for(j = 0; j < res_c; j++) {
+        lv_inv_area(disp, &res[j]);
+    }
+
+    /*The objects and scrollbars drawn on the scrolled object don't move.
+     *Redraw them and where their pixels are moved.*/
+    scroll_blit_inv_children_on_top(disp, &blit, obj, 0, true);
+    lv_obj_t * child = obj;
+    lv_obj_t * parent = lv_obj_get_parent(obj);
+    while(parent) {
+        scroll_blit_inv_children_on_top(disp, &blit, parent, lv_obj_get_index(child) + 1, false);
+
+        get_scrollbar_tracks(parent, &hor_track, &ver_track);
+        if(lv_area_get_width(&hor_track) > 0) scroll_blit_inv_on_top(disp, &blit, &hor_track);
+        if(lv_area_get_width(&ver_track) > 0) scroll_blit_inv_on_top(disp, &blit, &ver_track);
+
+        child = parent;
+        parent = lv_obj_get_parent(parent);
+    }
+    scroll_blit_inv_children_on_top(disp, &blit, disp->top_layer, 0, false);
+    scroll_blit_inv_children_on_top(disp, &blit, disp->sys_layer, 0, false);
+
+    lv_display_scroll_blit_t * new_blit = lv_ll_ins_tail(&disp->scroll_blits);
+    LV_ASSERT_MALLOC(new_blit);
+    if(new_blit == NULL) {
+        lv_inv_area(disp, &blit.area);
+        return true;
+    }
+    *new_blit = blit;
+
+    return true;
+}
+
 /**
  * Get the display which is being refreshed
  * @return the display being refreshed
@@ -395,6 +540,7 @@ void lv_display_refr_timer(lv_timer_t * tmr)
 
     lv_refr_join_area();
     refr_sync_areas();
+    refr_scroll_blits();
     refr_invalid_areas();
 
     if(disp_refr->inv_p == 0) goto refr_finish;
@@ -402,24 +548,43 @@ void lv_display_refr_timer(lv_timer_t * tmr)
     /*If refresh happened ...*/
     lv_display_send_event(disp_refr, LV_EVENT_RENDER_READY, NULL);
 
-    /*In double buffered direct mode save the updated areas.
-     *They will be used on the next call to synchronize the buffers.*/
+    /*In double buffered direct mode save the updated areas with the number of the frame.
+     *They will be used to synchronize the buffers which don't have this frame yet.*/
     if(lv_display_is_double_buffered(disp_refr) && disp_refr->render_mode == LV_DISPLAY_RENDER_MODE_DIRECT) {
+        disp_refr->sync_frame++;
         uint32_t i;
         for(i = 0; i < disp_refr->inv_p; i++) {
             if(disp_refr->inv_area_joined[i])
                 continue;
 
-            lv_area_t * sync_area = lv_ll_ins_tail(&disp_refr->sync_areas);
-            *sync_area = disp_refr->inv_areas[i];
+            lv_display_sync_area_t * sync_area = lv_ll_ins_tail(&disp_refr->sync_areas);
+            LV_ASSERT_MALLOC(sync_area);
+            if(sync_area == NULL) break;
+            sync_area->area = disp_refr->inv_areas[i];
+            sync_area->frame = disp_refr->sync_frame;
+        }
+
+        /*The moved pixels are changed too*/
+        lv_display_scroll_blit_t * blit;
+        LV_LL_READ(&disp_refr->scroll_blits, blit) {
+            lv_display_sync_area_t * sync_area = lv_ll_ins_tail(&disp_refr->sync_areas);
+            LV_ASSERT_MALLOC(sync_area);
+            if(sync_area == NULL) break;
+            sync_area->area = blit->area;
+            sync_area->frame = disp_refr->sync_frame;
         }
     }
 
-    lv_memzero(disp_refr->inv_areas, sizeof(disp_refr->inv_areas));
-    lv_memzero(disp_refr->inv_area_joined, sizeof(disp_refr->inv_area_joined));
+    lv_memzero(disp_refr->inv_areas, disp_refr->inv_p * sizeof(lv_area_t));
+    lv_memzero(disp_refr->inv_area_joined, disp_refr->inv_p * sizeof(uint8_t));
+
+    /*Free the grown buffer after a burst of invalidations, i.e. if this frame fit into the static one.
+     *Frames which need more areas in a row keep it and don't reallocate it every time.*/
+    if(disp_refr->inv_p <= LV_INV_BUF_SIZE) shrink_inv_areas(disp_refr);
     disp_refr->inv_p = 0;
 
 refr_finish:
+    lv_ll_clear(&disp_refr->scroll_blits);
 
 #if LV_DRAW_SW_COMPLEX == 1
     lv_draw_sw_mask_cleanup();
@@ -441,41 +606,232 @@ refr_finish:
 static void lv_refr_join_area(void)
 {
     LV_PROFILER_BEGIN;
-    uint32_t join_from;
-    uint32_t join_in;
-    lv_area_t joined_area;
-    for(join_in = 0; join_in < disp_refr->inv_p; join_in++) {
-        if(disp_refr->inv_area_joined[join_in] != 0) continue;
+    join_inv_areas(disp_refr);
+    LV_PROFILER_END;
+}
 
-        /*Check all areas to join them in 'join_in'*/
-        for(join_from = 0; join_from < disp_refr->inv_p; join_from++) {
-            /*Handle only unjoined areas and ignore itself*/
-            if(disp_refr->inv_area_joined[join_from] != 0 || join_in == join_from) {
-                continue;
-            }
+/**
+ * Join the invalidated areas of a display if it's cheaper to refresh them together.
+ * The areas are sorted by `y1` first so only the areas in a narrow band below an area
+ * need to be checked instead of all the others.
+ * @param disp      pointer to a display
+ * @return          true: at least one area was joined
+ */
+static bool join_inv_areas(lv_display_t * disp)
+{
+    if(disp->inv_p < 2) return false;
 
-            /*Check if the areas are on each other*/
-            if(lv_area_is_on(&disp_refr->inv_areas[join_in], &disp_refr->inv_areas[join_from]) == false) {
-                continue;
+    sort_inv_areas(disp->inv_areas, disp->inv_p);
+
+    uint8_t * flags = disp->inv_area_joined;
+    bool joined_any = false;
+    bool first_pass = true;
+    bool joined;
+    lv_area_t joined_area;
+    do {
+        joined = false;
+        uint32_t join_from;
+        uint32_t join_in;
+        for(join_in = 0; join_in < disp->inv_p; join_in++) {
+            if(flags[join_in] & INV_AREA_JOINED) continue;
+            lv_area_t * area_in = &disp->inv_areas[join_in];
+
+            /*Only the areas after 'join_in' need to be checked as the earlier ones were already tested.
+             *'area_in->y1' never changes as only areas with greater or equal y1 are joined into it
+             *so the order remains valid.*/
+            for(join_from = join_in + 1; join_from < disp->inv_p; join_from++) {
+                if(flags[join_from] & INV_AREA_JOINED) continue;
+                lv_area_t * area_from = &disp->inv_areas[join_from];
+
+                /*The rest of the areas start even lower so they are even further*/
+                if(inv_area_gap_cost(area_in->y2, area_from->y1, lv_area_get_width(area_in)) >= LV_INV_AREA_COST) break;
+
+                /*Pairs which were tested in the previous pass and haven't changed since then can be skipped*/
+                if(!first_pass && !((flags[join_in] | flags[join_from]) & (INV_AREA_GROWN | INV_AREA_GROWN_PREV))) continue;
+
+                if(inv_area_gap_cost(area_in->x2, area_from->x1, lv_area_get_height(area_in)) >= LV_INV_AREA_COST ||
+                   inv_area_gap_cost(area_from->x2, area_in->x1, lv_area_get_height(area_in)) >= LV_INV_AREA_COST) continue;
+
+                lv_area_join(&joined_area, area_in, area_from);
+
+                /*Join two area only if the joined area is cheaper to refresh*/
+                if(lv_area_get_size(&joined_area) < lv_area_get_size(area_in) + lv_area_get_size(area_from) +
+                   LV_INV_AREA_COST) {
+                    lv_area_copy(area_in, &joined_area);
+
+                    /*Mark 'join_form' is joined into 'join_in'*/
+                    flags[join_from] = INV_AREA_JOINED;
+                    flags[join_in] |= INV_AREA_GROWN;
+                    joined = true;
+                }
             }
+        }
 
-            lv_area_join(&joined_area, &disp_refr->inv_areas[join_in], &disp_refr->inv_areas[join_from]);
+        /*A grown area might reach an area which was checked earlier, so repeat until nothing changes,
+         *but test only the pairs with an area grown since they were tested*/
+        uint32_t i;
+        for(i = 0; i < disp->inv_p; i++) {
+            if(flags[i] & INV_AREA_JOINED) continue;
+            flags[i] = (flags[i] & INV_AREA_GROWN) ? INV_AREA_GROWN_PREV : 0;
+        }
 
-            /*Join two area only if the joined area size is smaller*/
-            if(lv_area_get_size(&joined_area) < (lv_area_get_size(&disp_refr->inv_areas[join_in]) +
-                                                 lv_area_get_size(&disp_refr->inv_areas[join_from]))) {
-                lv_area_copy(&disp_refr->inv_areas[join_in], &joined_area);
+        if(joined) joined_any = true;
+        first_pass = false;
+    } while(joined);
 
-                /*Mark 'join_form' is joined into 'join_in'*/
-                disp_refr->inv_area_joined[join_from] = 1;
-            }
+    return joined_any;
+}
+
+/**
+ * Get the least extra cost of joining two areas caused by the gap between them.
+ * The bounding box of areas separated by `gap` px is at least as wide as the first area
+ * (`size` px) and `gap` px longer than the two areas together, so the gap alone costs `size * gap` px.
+ * @param end       last coordinate of the first area along the direction of the gap
+ * @param start     first coordinate of the second area along the direction of the gap
+ * @param size      size of the first area perpendicular to the gap
+ * @return          the cost of the gap in pixels, or -1 if the areas overlap or touch in this direction
+ */
+static inline int64_t inv_area_gap_cost(int32_t end, int32_t start, int32_t size)
+{
+    int32_t gap = start - end - 1;
+    if(gap < 0) return -1;
+    return (int64_t)gap * size;
+}
+
+/**
+ * Sort areas by their `y1` coordinate with heap sort
+ * @param areas     array of areas
+ * @param cnt       number of areas
+ */
+static void sort_inv_areas(lv_area_t * areas, uint32_t cnt)
+{
+    uint32_t start = cnt / 2;
+    uint32_t end = cnt;
+    lv_area_t tmp;
+    while(end > 1) {
+        if(start > 0) {
+            /*Build the heap*/
+            start--;
+        }
+        else {
+            /*Move the largest to the end and restore the heap*/
+            end--;
+            tmp = areas[end];
+            areas[end] = areas[0];
+            areas[0] = tmp;
+        }
+
+        uint32_t root = start;
+        uint32_t child;
+        while((child = 2 * root + 1) < end) {
+            if(child + 1 < end && areas[child + 1].y1 > areas[child].y1) child++;
+            if(areas[root].y1 >= areas[child].y1) break;
+            tmp = areas[root];
+            areas[root] = areas[child];
+            areas[child] = tmp;
+            root = child;
         }
     }
-    LV_PROFILER_END;
 }
 
 /**
- * Refresh the sync areas
+ * Remove the joined areas from the invalidated areas
+ * @param disp      pointer to a display
+ */
+static void compact_inv_areas(lv_display_t * disp)
+{
+    uint32_t i;
+    uint32_t cnt = 0;
+    for(i = 0; i < disp->inv_p; i++) {
+        if(disp->inv_area_joined[i]) continue;
+        disp->inv_areas[cnt] = disp->inv_areas[i];
+        cnt++;
+    }
+    lv_memzero(disp->inv_area_joined, disp->inv_p * sizeof(uint8_t));
+    disp->inv_p = cnt;
+}
+
+/**
+ * Double the number of invalidated areas a display can store, up to `LV_INV_BUF_MAX`
+ * @param disp      pointer to a display
+ * @return          true: success; false: the limit is reached or out of memory
+ */
+static bool grow_inv_areas(lv_display_t * disp)
+{
+    if(disp->inv_size >= LV_INV_BUF_MAX) return false;
+    uint32_t new_size = LV_MIN(disp->inv_size * 2, LV_INV_BUF_MAX);
+
+    /*Store the areas and the join flags in one allocation*/
+    uint8_t * buf = lv_malloc(new_size * (sizeof(lv_area_t) + sizeof(uint8_t)));
+    if(buf == NULL) {
+        LV_LOG_WARN("Couldn't allocate %" LV_PRIu32 " invalidated areas", new_size);
+        return false;
+    }
+
+    lv_area_t * new_areas = (lv_area_t *)buf;
+    uint8_t * new_joined = buf + new_size * sizeof(lv_area_t);
+    lv_memcpy(new_areas, disp->inv_areas, disp->inv_p * sizeof(lv_area_t));
+    lv_memcpy(new_joined, disp->inv_area_joined, disp->inv_p * sizeof(uint8_t));
+    lv_memzero(new_joined + disp->inv_p, (new_size - disp->inv_p) * sizeof(uint8_t));
+
+    if(disp->inv_areas != disp->_static_inv_areas) lv_free(disp->inv_areas);
+
+    disp->inv_areas = new_areas;
+    disp->inv_area_joined = new_joined;
+    disp->inv_size = new_size;
+
+    return true;
+}
+
+/**
+ * Free the heap buffer of the invalidated areas and use the static one of the display again.
+ * The saved areas must fit into it.
+ * @param disp      pointer to a display
+ */
+static void shrink_inv_areas(lv_display_t * disp)
+{
+    if(disp->inv_areas == disp->_static_inv_areas) return;
+    LV_ASSERT(disp->inv_p <= LV_INV_BUF_SIZE);
+
+    lv_memcpy(disp->_static_inv_areas, disp->inv_areas, disp->inv_p * sizeof(lv_area_t));
+    lv_memcpy(disp->_static_inv_area_joined, disp->inv_area_joined, disp->inv_p * sizeof(uint8_t));
+    lv_memzero(disp->_static_inv_area_joined + disp->inv_p, (LV_INV_BUF_SIZE - disp->inv_p) * sizeof(uint8_t));
+
+    lv_free(disp->inv_areas);
+    disp->inv_areas = disp->_static_inv_areas;
+    disp->inv_area_joined = disp->_static_inv_area_joined;
+    disp->inv_size = LV_INV_BUF_SIZE;
+}
+
+/**
+ * Join an area into the saved invalidated area whose size increases the least
+ * @param disp      pointer to a display
+ * @param area_p    the area to join
+ */
+static void merge_into_cheapest_inv_area(lv_display_t * disp, const lv_area_t * area_p)
+{
+    uint32_t i;
+    uint32_t best_i = 0;
+    uint32_t best_cost = UINT32_MAX;
+    lv_area_t joined_area;
+    for(i = 0; i < disp->inv_p; i++) {
+        if(disp->inv_area_joined[i]) continue;
+        lv_area_join(&joined_area, &disp->inv_areas[i], area_p);
+        uint32_t cost = lv_area_get_size(&joined_area) - lv_area_get_size(&disp->inv_areas[i]);
+        if(cost < best_cost) {
+            best_cost = cost;
+            best_i = i;
+        }
+    }
+
+    lv_area_join(&disp->inv_areas[best_i], &disp->inv_areas[best_i], area_p);
+}
+
+/**
+ * Refresh the sync areas.
+ * Each buffer remembers the frame it was rendered last time ("buffer age").
+ * Only the areas redrawn since then and not redrawn in this frame are copied to it
+ * from the buffer with the latest content.
  */
 static void refr_sync_areas(void)
 {
@@ -485,18 +841,34 @@ static void refr_sync_areas(void)
     /*Do not sync if not double buffered*/
     if(!lv_display_is_double_buffered(disp_refr)) return;
 
+    /*The buffers are already swapped.
+     *So the active buffer is the off screen buffer where LVGL will render*/
+    lv_draw_buf_t * off_screen = disp_refr->buf_act;
+    uint32_t off_screen_i = get_buf_index(disp_refr, off_screen);
+    uint32_t off_screen_frame = disp_refr->buf_frame[off_screen_i];
+
+    /*After syncing and rendering it will have the content of the next frame*/
+    disp_refr->buf_frame[off_screen_i] = disp_refr->sync_frame + 1;
+
     /*Do not sync if no sync areas*/
     if(lv_ll_is_empty(&disp_refr->sync_areas)) return;
 
     LV_PROFILER_BEGIN;
-    /*With double buffered direct mode synchronize the rendered areas to the other buffer*/
-    /*We need to wait for ready here to not mess up the active screen*/
-    wait_for_flushing(disp_refr);
-
-    /*The buffers are already swapped.
-     *So the active buffer is the off screen buffer where LVGL will render*/
-    lv_draw_buf_t * off_screen = disp_refr->buf_act;
-    lv_draw_buf_t * on_screen = disp_refr->buf_act == disp_refr->buf_1 ? disp_refr->buf_2 : disp_refr->buf_1;
+    /*We need to wait for ready here to not mess up the active screen.
+     *With 3 buffers the off screen buffer was shown before the one being flushed,
+     *so it's already free when the previous flush has started.*/
+    if(disp_refr->buf_3 == NULL) wait_for_flushing(disp_refr);
+
+    /*The previous buffer in the rotation has the latest content*/
+    lv_draw_buf_t * on_screen = get_prev_buf(disp_refr);
+
+    /*Collect the areas redrawn since the off screen buffer was rendered*/
+    lv_ll_t areas;
+    lv_ll_init(&areas, sizeof(lv_area_t));
+    lv_display_sync_area_t * stamped_area;
+    LV_LL_READ(&disp_refr->sync_areas, stamped_area) {
+        if(stamped_area->frame > off_screen_frame) sync_area_add(&areas, &stamped_area->area);
+    }
 
     uint32_t hor_res = lv_display_get_horizontal_resolution(disp_refr);
     uint32_t ver_res = lv_display_get_vertical_resolution(disp_refr);
@@ -511,11 +883,14 @@ static void refr_sync_areas(void)
         /*Skip joined areas*/
         if(disp_refr->inv_area_joined[i]) continue;
 
+        /*The pixels will be moved from here so they need to be synced even if they are redrawn*/
+        if(is_scroll_blit_src(&disp_refr->inv_areas[i])) continue;
+
         /*Iterate over sync areas*/
-        sync_area = lv_ll_get_head(&disp_refr->sync_areas);
+        sync_area = lv_ll_get_head(&areas);
         while(sync_area != NULL) {
             /*Get next sync area*/
-            next_area = lv_ll_get_next(&disp_refr->sync_areas, sync_area);
+            next_area = lv_ll_get_next(&areas, sync_area);
 
             /*Remove intersect of redraw area from sync area and get remaining areas*/
             res_c = lv_area_diff(res, sync_area, &disp_refr->inv_areas[i]);
@@ -524,10 +899,10 @@ static void refr_sync_areas(void)
             if(res_c != -1) {
                 /*Replace old sync area with new areas*/
                 for(j = 0; j < res_c; j++) {
-                    new_area = lv_ll_ins_prev(&disp_refr->sync_areas, sync_area);
+                    new_area = lv_ll_ins_prev(&areas, sync_area);
                     *new_area = res[j];
                 }
-                lv_ll_remove(&disp_refr->sync_areas, sync_area);
+                lv_ll_remove(&areas, sync_area);
                 lv_free(sync_area);
             }
 
@@ -538,20 +913,303 @@ static void refr_sync_areas(void)
 
     lv_area_t disp_area = {0, 0, (int32_t)hor_res - 1, (int32_t)ver_res - 1};
     /*Copy sync areas (if any remaining)*/
-    for(sync_area = lv_ll_get_head(&disp_refr->sync_areas); sync_area != NULL;
-        sync_area = lv_ll_get_next(&disp_refr->sync_areas, sync_area)) {
-        /**
-         * @todo Resize SDL window will trigger crash because of sync_area is larger than disp_area
-         */
-        lv_area_intersect(sync_area, sync_area, &disp_area);
-        lv_draw_buf_copy(off_screen, sync_area, on_screen, sync_area);
+    LV_LL_READ(&areas, sync_area) {
+        /*The display might be resized since the area was saved*/
+        if(lv_area_intersect(sync_area, sync_area, &disp_area)) {
+            lv_draw_buf_copy(off_screen, sync_area, on_screen, sync_area);
+        }
     }
 
-    /*Clear sync areas*/
-    lv_ll_clear(&disp_refr->sync_areas);
+    lv_ll_clear(&areas);
+
+    /*Drop the areas which are already in all buffers*/
+    uint32_t min_frame = LV_MIN(disp_refr->buf_frame[0], disp_refr->buf_frame[1]);
+    if(disp_refr->buf_3) min_frame = LV_MIN(min_frame, disp_refr->buf_frame[2]);
+
+    stamped_area = lv_ll_get_head(&disp_refr->sync_areas);
+    while(stamped_area != NULL) {
+        lv_display_sync_area_t * next_stamped_area = lv_ll_get_next(&disp_refr->sync_areas, stamped_area);
+        if(stamped_area->frame <= min_frame) {
+            lv_ll_remove(&disp_refr->sync_areas, stamped_area);
+            lv_free(stamped_area);
+        }
+        stamped_area = next_stamped_area;
+    }
     LV_PROFILER_END;
 }
 
+/**
+ * Add an area to a list of areas to copy.
+ * Overlapping areas are merged if the result is not larger than the two areas together,
+ * so that pixels changed in multiple frames are copied only once.
+ * @param areas     linked list of `lv_area_t`
+ * @param area_p    the area to add
+ */
+static void sync_area_add(lv_ll_t * areas, const lv_area_t * area_p)
+{
+    lv_area_t merged = *area_p;
+    lv_area_t * a = lv_ll_get_head(areas);
+    while(a != NULL) {
+        lv_area_t * next = lv_ll_get_next(areas, a);
+        if(lv_area_is_on(a, &merged)) {
+            lv_area_t joined;
+            lv_area_join(&joined, a, &merged);
+            if(lv_area_get_size(&joined) <= lv_area_get_size(a) + lv_area_get_size(&merged)) {
+                merged = joined;
+                lv_ll_remove(areas, a);
+                lv_free(a);
+                /*The larger area might overlap with the already checked areas too*/
+                next = lv_ll_get_head(areas);
+            }
+        }
+        a = next;
+    }
+
+    lv_area_t * new_area = lv_ll_ins_tail(areas);
+    LV_ASSERT_MALLOC(new_area);
+    if(new_area) *new_area = merged;
+}
+
+/**
+ * Check if pixels are moved from an area by a pending scroll blit
+ * @param area_p    the area to check
+ * @return          true: a scroll blit reads the area
+ */
+static bool is_scroll_blit_src(const lv_area_t * area_p)
+{
+    lv_display_scroll_blit_t * blit;
+    LV_LL_READ(&disp_refr->scroll_blits, blit) {
+        lv_area_t src = blit->area;
+        lv_area_move(&src, -blit->dx, -blit->dy);
+        if(lv_area_is_on(area_p, &src)) return true;
+    }
+
+    return false;
+}
+
+/**
+ * Move the pixels of the scrolled objects in the buffer.
+ * The areas which can't be moved are already invalidated by `lv_refr_scroll_blit`.
+ */
+static void refr_scroll_blits(void)
+{
+    if(lv_ll_is_empty(&disp_refr->scroll_blits)) return;
+
+    lv_display_scroll_blit_t * blit;
+
+    /*The render mode might have been changed since the scroll. Just redraw the areas then.*/
+    if(disp_refr->render_mode != LV_DISPLAY_RENDER_MODE_DIRECT) {
+        LV_LL_READ(&disp_refr->scroll_blits, blit) {
+            lv_inv_area(disp_refr, &blit->area);
+        }
+        lv_ll_clear(&disp_refr->scroll_blits);
+        return;
+    }
+
+    LV_PROFILER_BEGIN;
+    /*Don't modify the buffer while it's being shown or sent to the display*/
+    if(disp_refr->buf_3 == NULL) wait_for_flushing(disp_refr);
+
+    lv_draw_buf_t * buf = disp_refr->buf_act;
+    LV_LL_READ(&disp_refr->scroll_blits, blit) {
+        if(disp_refr->scroll_blit_cb && disp_refr->scroll_blit_cb(disp_refr, buf, &blit->area, blit->dx, blit->dy)) continue;
+        scroll_blit_sw(buf, &blit->area, blit->dx, blit->dy);
+    }
+    LV_PROFILER_END;
+}
+
+/**
+ * Move pixels in a buffer with `lv_memmove`
+ * @param buf       the buffer
+ * @param area      the destination area
+ * @param dx        move the pixels from `area->x1 - dx`
+ * @param dy        move the pixels from `area->y1 - dy`
+ */
+static void scroll_blit_sw(lv_draw_buf_t * buf, const lv_area_t * area, int32_t dx, int32_t dy)
+{
+    uint32_t stride = buf->header.stride;
+    uint32_t line_size = lv_area_get_width(area) * lv_color_format_get_size(buf->header.cf);
+    int32_t h = lv_area_get_height(area);
+    uint8_t * dest = lv_draw_buf_goto_xy(buf, area->x1, area->y1);
+    const uint8_t * src = lv_draw_buf_goto_xy(buf, area->x1 - dx, area->y1 - dy);
+
+    int32_t y;
+    if(dy > 0) {
+        /*Moving down: start with the last line to not overwrite the lines which are not moved yet*/
+        dest += (h - 1) * stride;
+        src += (h - 1) * stride;
+        for(y = 0; y < h; y++) {
+            lv_memmove(dest, src, line_size);
+            dest -= stride;
+            src -= stride;
+        }
+    }
+    else {
+        for(y = 0; y < h; y++) {
+            lv_memmove(dest, src, line_size);
+            dest += stride;
+            src += stride;
+        }
+    }
+}
+
+/**
+ * Check if the rendered pixels of an object stay the same when they are moved by a scroll
+ * @param obj       the scrolled object
+ * @return          true: the pixels can be moved
+ */
+static bool scroll_blit_is_safe(lv_obj_t * obj)
+{
+    /*Widgets might draw something at a fixed position in their event function,
+     *so allow only plain objects and the classes which don't add drawing (e.g. list)*/
+    const lv_obj_class_t * class_p;
+    for(class_p = obj->class_p; class_p != &lv_obj_class; class_p = class_p->base_class) {
+        if(class_p == NULL || class_p->event_cb) return false;
+    }
+
+    /*The same for the draw event handlers added by the user*/
+    uint32_t event_cnt = lv_obj_get_event_count(obj);
+    uint32_t i;
+    for(i = 0; i < event_cnt; i++) {
+        lv_event_dsc_t * dsc = lv_obj_get_event_dsc(obj, i);
+        uint32_t filter = dsc->filter & ~LV_EVENT_PREPROCESS;
+        if(filter == LV_EVENT_ALL) return false;
+        if(filter >= LV_EVENT_DRAW_MAIN_BEGIN && filter <= LV_EVENT_DRAW_POST_END) return false;
+    }
+
+    /*The children drawn out of the object wouldn't be redrawn at their old position*/
+    if(lv_obj_has_flag(obj, LV_OBJ_FLAG_OVERFLOW_VISIBLE)) return false;
+
+    /*The moved part of the background needs to look the same everywhere.
+     *With transparency the not moving parent would be visible.*/
+    if(lv_obj_get_style_bg_opa(obj, LV_PART_MAIN) < LV_OPA_MAX) return false;
+    if(lv_obj_get_style_bg_grad_dir(obj, LV_PART_MAIN) != LV_GRAD_DIR_NONE) return false;
+    if(lv_obj_get_style_bg_grad(obj, LV_PART_MAIN) != NULL) return false;
+    if(lv_obj_get_style_bg_image_src(obj, LV_PART_MAIN) != NULL) return false;
+    if(lv_obj_get_style_opa_recursive(obj, LV_PART_MAIN) < LV_OPA_MAX) return false;
+
+    /*Transformed, masked or blended objects are not drawn directly to the buffer
+     *and the parents' rounded corners and post drawn borders would be moved too*/
+    lv_obj_t * parent;
+    for(parent = obj; parent; parent = lv_obj_get_parent(parent)) {
+        if(lv_obj_get_layer_type(parent) != LV_LAYER_TYPE_NONE) return false;
+        if(parent == obj) continue;
+
+        if(lv_obj_get_style_clip_corner(parent, LV_PART_MAIN) &&
+           lv_obj_get_style_radius(parent, LV_PART_MAIN) > 0) return false;
+        if(lv_obj_get_style_border_post(parent, LV_PART_MAIN) &&
+           lv_obj_get_style_border_width(parent, LV_PART_MAIN) > 0) return false;
+    }
+
+    return true;
+}
+
+/**
+ * Get the areas where the scrollbars of an object can be drawn.
+ * Unlike `lv_obj_get_scrollbar_area` it doesn't depend on the scroll position and
+ * returns the area even if the scrollbars are hidden now.
+ * @param obj       pointer to an object
+ * @param hor_area  store the area of the horizontal scrollbar here (empty area if there is none)
+ * @param ver_area  store the area of the vertical scrollbar here (empty area if there is none)
+ */
+static void get_scrollbar_tracks(lv_obj_t * obj, lv_area_t * hor_area, lv_area_t * ver_area)
+{
+    lv_area_set(hor_area, 0, 0, -1, -1);
+    lv_area_set(ver_area, 0, 0, -1, -1);
+
+    if(lv_obj_has_flag(obj, LV_OBJ_FLAG_SCROLLABLE) == false) return;
+    if(lv_obj_get_scrollbar_mode(obj) == LV_SCROLLBAR_MODE_OFF) return;
+
+    int32_t thickness = lv_obj_get_style_width(obj, LV_PART_SCROLLBAR);
+    if(thickness <= 0) return;
+
+    lv_dir_t dir = lv_obj_get_scroll_dir(obj);
+    if(dir & LV_DIR_VER) {
+        *ver_area = obj->coords;
+        if(lv_obj_get_style_base_dir(obj, LV_PART_SCROLLBAR) == LV_BASE_DIR_RTL) {
+            ver_area->x2 = obj->coords.x1 + lv_obj_get_style_pad_left(obj, LV_PART_SCROLLBAR) + thickness - 1;
+        }
+        else {
+            ver_area->x1 = obj->coords.x2 - lv_obj_get_style_pad_right(obj, LV_PART_SCROLLBAR) - thickness + 1;
+        }
+    }
+
+    if(dir & LV_DIR_HOR) {
+        *hor_area = obj->coords;
+        hor_area->y1 = obj->coords.y2 - lv_obj_get_style_pad_bottom(obj, LV_PART_SCROLLBAR) - thickness + 1;
+    }
+}
+
+/**
+ * Invalidate where the pixels of an area land after a scroll blit
+ * @param disp      pointer to a display
+ * @param blit      the scroll blit
+ * @param area_p    the area whose pixels are outdated
+ */
+static void scroll_blit_inv_moved(lv_display_t * disp, const lv_display_scroll_blit_t * blit, const lv_area_t * area_p)
+{
+    lv_area_t src = blit->area;
+    lv_area_move(&src, -blit->dx, -blit->dy);
+
+    lv_area_t moved;
+    if(!lv_area_intersect(&moved, area_p, &src)) return;
+
+    lv_area_move(&moved, blit->dx, blit->dy);
+    lv_inv_area(disp, &moved);
+}
+
+/**
+ * Invalidate a not moving area on top of a scrolled object.
+ * Its pixels are moved away and overwritten by the moved pixels.
+ * @param disp      pointer to a display
+ * @param blit      the scroll blit
+ * @param area_p    the not moving area
+ */
+static void scroll_blit_inv_on_top(lv_display_t * disp, const lv_display_scroll_blit_t * blit,
+                                   const lv_area_t * area_p)
+{
+    scroll_blit_inv_moved(disp, blit, area_p);
+
+    lv_area_t overwritten;
+    if(lv_area_intersect(&overwritten, area_p, &blit->area)) lv_inv_area(disp, &overwritten);
+}
+
+/**
+ * Invalidate the not moving children on top of a scrolled object
+ * @param disp          pointer to a display
+ * @param blit          the scroll blit
+ * @param parent        the parent of the children
+ * @param start         index of the first child to check
+ * @param floating_only true: check only the children with `LV_OBJ_FLAG_FLOATING`
+ */
+static void scroll_blit_inv_children_on_top(lv_display_t * disp, const lv_display_scroll_blit_t * blit,
+                                            lv_obj_t * parent, uint32_t start, bool floating_only)
+{
+    if(parent == NULL) return;
+
+    uint32_t child_cnt = lv_obj_get_child_count(parent);
+    uint32_t i;
+    for(i = start; i < child_cnt; i++) {
+        lv_obj_t * child = lv_obj_get_child(parent, i);
+        if(lv_obj_has_flag(child, LV_OBJ_FLAG_HIDDEN)) continue;
+        if(floating_only && !lv_obj_has_flag(child, LV_OBJ_FLAG_FLOATING)) continue;
+
+        lv_area_t child_area;
+        if(lv_obj_has_flag(child, LV_OBJ_FLAG_OVERFLOW_VISIBLE)) {
+            /*Its children can be anywhere*/
+            lv_area_set(&child_area, 0, 0, lv_display_get_horizontal_resolution(disp) - 1,
+                        lv_display_get_vertical_resolution(disp) - 1);
+        }
+        else {
+            int32_t ext_size = lv_obj_get_ext_draw_size(child);
+            child_area = child->coords;
+            lv_area_increase(&child_area, ext_size, ext_size);
+        }
+
+        scroll_blit_inv_on_top(disp, blit, &child_area);
+    }
+}
+
 /**
  * Refresh the joined areas
  */
@@ -623,7 +1281,7 @@ static void refr_area(const lv_area_t * area_p)
 
     /*With full refresh just redraw directly into the buffer*/
     /*In direct mode draw directly on the absolute coordinates of the buffer*/
-    if(disp_refr->render_mode != LV_DISPLAY_RENDER_MODE_PARTIAL) {
+    if(disp_refr->render_mode == LV_DISPLAY_RENDER_MODE_FULL || disp_refr->render_mode == LV_DISPLAY_RENDER_MODE_DIRECT) {
         layer->buf_area.x1 = 0;
         layer->buf_area.y1 = 0;
         layer->buf_area.x2 = lv_display_get_horizontal_resolution(disp_refr) - 1;
@@ -650,6 +1308,13 @@ static void refr_area(const lv_area_t * area_p)
         return;
     }
 
+    /*Indexed buffers can't be split into tiles as they start with a palette. Use strips for them.*/
+    if(disp_refr->render_mode == LV_DISPLAY_RENDER_MODE_TILED && !LV_COLOR_FORMAT_IS_INDEXED(layer->color_format)) {
+        refr_area_tiled(area_p);
+        LV_PROFILER_END;
+        return;
+    }
+
     /*Normal refresh: draw the area in parts*/
     /*Calculate the max row num*/
     int32_t w = lv_area_get_width(area_p);
@@ -710,7 +1375,8 @@ static void refr_area_part(lv_layer_t * layer)
     /*If the screen is transparent initialize it when the flushing is ready*/
     if(lv_color_format_has_alpha(disp_refr->color_format)) {
         lv_area_t a = disp_refr->refreshed_area;
-        if(disp_refr->render_mode == LV_DISPLAY_RENDER_MODE_PARTIAL) {
+        if(disp_refr->render_mode == LV_DISPLAY_RENDER_MODE_PARTIAL ||
+           disp_refr->render_mode == LV_DISPLAY_RENDER_MODE_TILED) {
             /*The area always starts at 0;0*/
             lv_area_move(&a, -disp_refr->refreshed_area.x1, -disp_refr->refreshed_area.y1);
         }
@@ -727,6 +1393,204 @@ static void refr_area_part(lv_layer_t * layer)
         top_prev_scr = lv_refr_get_top_obj(&layer->_clip_area, disp_refr->prev_scr);
     }
 
+    refr_screens(layer, top_act_scr, top_prev_scr);
+
+    draw_buf_flush(disp_refr);
+    LV_PROFILER_END;
+}
+
+/**
+ * Render an area in square tiles. As many tiles are added at once as fit into the draw buffer,
+ * each with its own layer, so the draw units can render them in parallel. Then the tiles are flushed one by one.
+ * The draw tasks of a batch are created only once on a layer covering the batch and copied to the tiles.
+ * @param area_p    pointer to an area to refresh
+ */
+static void refr_area_tiled(const lv_area_t * area_p)
+{
+    lv_layer_t * layer_head = disp_refr->layer_head;
+    lv_color_format_t cf = layer_head->color_format;
+    uint32_t buf_size = disp_refr->buf_act->data_size;
+
+    int32_t area_w = lv_area_get_width(area_p);
+    int32_t area_h = lv_area_get_height(area_p);
+    int32_t tile_w = LV_MIN(area_w, LV_DISPLAY_TILE_SIZE);
+    int32_t tile_h = LV_MIN(area_h, LV_DISPLAY_TILE_SIZE);
+    uint32_t tile_stride = lv_draw_buf_width_to_stride(tile_w, cf);
+
+    /*Make the tiles lower if even one doesn't fit into the buffer*/
+    uint32_t tile_size = LV_ROUND_UP(tile_stride * tile_h, LV_DRAW_BUF_ALIGN);
+    while(tile_size > buf_size && tile_h > 1) {
+        tile_h--;
+        tile_size = LV_ROUND_UP(tile_stride * tile_h, LV_DRAW_BUF_ALIGN);
+    }
+
+    if(tile_size > buf_size) {
+        LV_LOG_WARN("The draw buffer is too small for a tile");
+        return;
+    }
+
+    int32_t col_cnt = (area_w + tile_w - 1) / tile_w;
+    int32_t row_cnt = (area_h + tile_h - 1) / tile_h;
+    uint32_t tile_cnt = col_cnt * row_cnt;
+    uint32_t batch_size = LV_MIN(buf_size / tile_size, tile_cnt);
+
+    lv_layer_t * tiles = lv_malloc_zeroed(batch_size * sizeof(lv_layer_t));
+    lv_draw_buf_t * tile_bufs = lv_malloc_zeroed(batch_size * sizeof(lv_draw_buf_t));
+    LV_ASSERT_MALLOC(tiles);
+    LV_ASSERT_MALLOC(tile_bufs);
+    if(tiles == NULL || tile_bufs == NULL) {
+        lv_free(tiles);
+        lv_free(tile_bufs);
+        return;
+    }
+
+    /*The tiles are in the area so the objects covering the area cover the tiles too*/
+    lv_obj_t * top_act_scr = lv_refr_get_top_obj(area_p, lv_display_get_screen_active(disp_refr));
+    lv_obj_t * top_prev_scr = NULL;
+    if(disp_refr->prev_scr) {
+        top_prev_scr = lv_refr_get_top_obj(area_p, disp_refr->prev_scr);
+    }
+
+    uint32_t tile_first;
+    for(tile_first = 0; tile_first < tile_cnt; tile_first += batch_size) {
+        uint32_t batch_cnt = LV_MIN(batch_size, tile_cnt - tile_first);
+
+        /*In single buffered mode wait until the buffer is freed*/
+        if(!lv_display_is_double_buffered(disp_refr)) {
+            wait_for_flushing(disp_refr);
+        }
+
+        /*Get the tiles of the batch*/
+        lv_area_t batch_area;
+        uint32_t i;
+        for(i = 0; i < batch_cnt; i++) {
+            int32_t col = (tile_first + i) % col_cnt;
+            int32_t row = (tile_first + i) / col_cnt;
+            lv_area_t * tile_area = &tiles[i].buf_area;
+            tile_area->x1 = area_p->x1 + col * tile_w;
+            tile_area->y1 = area_p->y1 + row * tile_h;
+            tile_area->x2 = LV_MIN(tile_area->x1 + tile_w - 1, area_p->x2);
+            tile_area->y2 = LV_MIN(tile_area->y1 + tile_h - 1, area_p->y2);
+
+            if(i == 0) batch_area = *tile_area;
+            else lv_area_join(&batch_area, &batch_area, tile_area);
+        }
+
+        /*Create the draw tasks of the batch only once on a layer which is never rendered*/
+        lv_layer_t batch_layer;
+        lv_memzero(&batch_layer, sizeof(lv_layer_t));
+        batch_layer.buf_area = batch_area;
+        batch_layer._clip_area = batch_area;
+        batch_layer.phy_clip_area = batch_area;
+        batch_layer.color_format = cf;
+#if LV_DRAW_TRANSFORM_USE_MATRIX
+        lv_matrix_identity(&batch_layer.matrix);
+#endif
+        if(disp_refr->layer_init) disp_refr->layer_init(disp_refr, &batch_layer);
+
+        disp_refr->refreshed_area = batch_area;
+        refr_screens(&batch_layer, top_act_scr, top_prev_scr);
+
+        /*The layers of the objects are rendered as usual. Wait for them as the copies of the
+         *layer drawing tasks can't be queued by the layers*/
+        while(batch_layer_is_waiting(&batch_layer)) {
+            lv_draw_dispatch_wait_for_request();
+            lv_draw_dispatch();
+        }
+
+        /*Copy the draw tasks to the tiles of the batch*/
+        uint8_t * tile_data = disp_refr->buf_act->data;
+        for(i = 0; i < batch_cnt; i++) {
+            lv_layer_t * tile = &tiles[i];
+            lv_area_t tile_area = tile->buf_area;
+
+            uint32_t stride = lv_draw_buf_width_to_stride(lv_area_get_width(&tile_area), cf);
+            lv_draw_buf_init(&tile_bufs[i], lv_area_get_width(&tile_area), lv_area_get_height(&tile_area), cf,
+                             stride, tile_data + i * tile_size, tile_size);
+
+            lv_memzero(tile, sizeof(lv_layer_t));
+            tile->draw_buf = &tile_bufs[i];
+            tile->buf_area = tile_area;
+            tile->_clip_area = tile_area;
+            tile->phy_clip_area = tile_area;
+            tile->color_format = cf;
+#if LV_DRAW_TRANSFORM_USE_MATRIX
+            lv_matrix_identity(&tile->matrix);
+#endif
+            if(disp_refr->layer_init) disp_refr->layer_init(disp_refr, tile);
+
+            /*Link the tiles after the display's layer to get them dispatched*/
+            lv_layer_t * tile_prev = i == 0 ? layer_head : &tiles[i - 1];
+            tile->next = tile_prev->next;
+            tile_prev->next = tile;
+
+            if(lv_color_format_has_alpha(cf)) lv_draw_buf_clear(tile->draw_buf, NULL);
+
+            lv_draw_task_t * t = batch_layer.draw_task_head;
+            while(t) {
+                lv_draw_add_task_copy(tile, t);
+                t = t->next;
+            }
+
+            lv_draw_dispatch();
+        }
+
+        /*Wait until all the tiles are rendered*/
+        for(i = 0; i < batch_cnt; i++) {
+            while(tiles[i].draw_task_head) {
+                lv_draw_dispatch_wait_for_request();
+                lv_draw_dispatch();
+            }
+        }
+
+        /*Free the draw tasks and the layers of the objects, it also removes the layers from the display*/
+        lv_draw_discard_tasks(disp_refr, &batch_layer);
+        if(disp_refr->layer_deinit) disp_refr->layer_deinit(disp_refr, &batch_layer);
+
+        /*Unlink the tiles. The layers of the objects are already removed so they are all after the head*/
+        layer_head->next = tiles[batch_cnt - 1].next;
+        for(i = 0; i < batch_cnt; i++) {
+            if(disp_refr->layer_deinit) disp_refr->layer_deinit(disp_refr, &tiles[i]);
+        }
+
+        for(i = 0; i < batch_cnt; i++) {
+            tile_flush(disp_refr, &tiles[i], tile_first + i == tile_cnt - 1);
+        }
+
+        /*If there are 2 buffers swap them to render the next batch while the last tile is being flushed*/
+        if(lv_display_is_double_buffered(disp_refr)) {
+            swap_buffers(disp_refr);
+        }
+    }
+
+    lv_free(tiles);
+    lv_free(tile_bufs);
+}
+
+/**
+ * Check if a layer has a layer drawing task waiting for its source layer to be rendered
+ * @param layer     pointer to a layer
+ * @return          true: there is at least one waiting draw task
+ */
+static bool batch_layer_is_waiting(lv_layer_t * layer)
+{
+    lv_draw_task_t * t = layer->draw_task_head;
+    while(t) {
+        if(t->state == LV_DRAW_TASK_STATE_WAITING) return true;
+        t = t->next;
+    }
+
+    return false;
+}
+
+/**
+ * Draw the screens and the display's layers on a layer
+ * @param layer         pointer to a layer to draw to
+ * @param top_act_scr   the top object of the active screen covering the layer or NULL
+ * @param top_prev_scr  the top object of the previous screen covering the layer or NULL
+ */
+static void refr_screens(lv_layer_t * layer, lv_obj_t * top_act_scr, lv_obj_t * top_prev_scr)
+{
     /*Draw a bottom layer background if there is no top object*/
     if(top_act_scr == NULL && top_prev_scr == NULL) {
         refr_obj_and_children(layer, lv_display_get_layer_bottom(disp_refr));
@@ -756,9 +1620,6 @@ static void refr_area_part(lv_layer_t * layer)
     /*Also refresh top and sys layer unconditionally*/
     refr_obj_and_children(layer, lv_display_get_layer_top(disp_refr));
     refr_obj_and_children(layer, lv_display_get_layer_sys(disp_refr));
-
-    draw_buf_flush(disp_refr);
-    LV_PROFILER_END;
 }
 
 /**
@@ -1179,12 +2040,29 @@ static void draw_buf_flush(lv_display_t * disp)
     }
     /*If there are 2 buffers swap them. With direct mode swap only on the last area*/
     if(lv_display_is_double_buffered(disp) && (disp->render_mode != LV_DISPLAY_RENDER_MODE_DIRECT || flushing_last)) {
-        if(disp->buf_act == disp->buf_1) {
-            disp->buf_act = disp->buf_2;
-        }
-        else {
-            disp->buf_act = disp->buf_1;
-        }
+        swap_buffers(disp);
+    }
+}
+
+/**
+ * Flush a rendered tile to the display
+ * @param disp          pointer to the display
+ * @param tile          the layer of the tile
+ * @param last_tile     true: it's the last tile of the refreshed area
+ */
+static void tile_flush(lv_display_t * disp, lv_layer_t * tile, bool last_tile)
+{
+    /*The tiles share the draw buffer, so only one of them can be sent to the display at once*/
+    wait_for_flushing(disp);
+
+    disp->refreshed_area = tile->buf_area;
+    disp->flushing = 1;
+
+    if(disp->last_area && last_tile) disp->flushing_last = 1;
+    else disp->flushing_last = 0;
+
+    if(disp->flush_cb) {
+        call_flush_cb(disp, &tile->buf_area, tile->draw_buf->data);
     }
 }
 
@@ -1194,6 +2072,20 @@ static void call_flush_cb(lv_display_t * disp, const lv_area_t * area, uint8_t *
     LV_TRACE_REFR("Calling flush_cb on (%d;%d)(%d;%d) area with %p image pointer",
                   (int)area->x1, (int)area->y1, (int)area->x2, (int)area->y2, (void *)px_map);
 
+    lv_area_t diff_area = *area;
+    if(disp->flush_diff_map && disp->render_mode != LV_DISPLAY_RENDER_MODE_DIRECT &&
+       disp->render_mode != LV_DISPLAY_RENDER_MODE_FULL) {
+        if(!flush_diff_area(disp, &diff_area, px_map)) {
+            /*Nothing has changed, behave as if the driver was ready at once*/
+            LV_TRACE_REFR("flush_cb skipped, the area is unchanged");
+            disp->flushing = 0;
+            disp->flushing_last = 0;
+            LV_PROFILER_END;
+            return;
+        }
+        area = &diff_area;
+    }
+
     lv_area_t offset_area = {
         .x1 = area->x1 + disp->offset_x,
         .y1 = area->y1 + disp->offset_y,
@@ -1214,6 +2106,131 @@ static void call_flush_cb(lv_display_t * disp, const lv_area_t * area, uint8_t *
     LV_PROFILER_END;
 }
 
+/**
+ * Compare the rows of a rendered area with the checksums of the last flushed content
+ * and cut off the unchanged parts. The remaining pixels are moved to the start of `px_map`
+ * with the stride of the new width.
+ * @param disp      pointer to a display with flush diff enabled
+ * @param area      the area to flush, reduced to the bounding box of the changed pixels
+ * @param px_map    the rendered pixels of `area`
+ * @return          false: nothing has changed, no need to flush
+ */
+static bool flush_diff_area(lv_display_t * disp, lv_area_t * area, uint8_t * px_map)
+{
+    lv_color_format_t cf = disp->color_format;
+    if(lv_color_format_get_bpp(cf) < 8) return true;
+
+    /*The map is not updated to the new resolution yet*/
+    if(area->x1 < 0 || area->y1 < 0 ||
+       area->x2 >= (int32_t)(disp->flush_diff_cols * disp->flush_diff_block_w) ||
+       area->y2 >= (int32_t)disp->flush_diff_rows) {
+        return true;
+    }
+
+    LV_PROFILER_BEGIN;
+
+    uint32_t px_size = lv_color_format_get_size(cf);
+    int32_t w = lv_area_get_width(area);
+    int32_t h = lv_area_get_height(area);
+    uint32_t stride = lv_draw_buf_width_to_stride(w, cf);
+    int32_t block_w = disp->flush_diff_block_w;
+    int32_t col_first = area->x1 / block_w;
+    int32_t col_last = area->x2 / block_w;
+
+    lv_area_t changed;
+    changed.x1 = LV_COORD_MAX;
+    changed.y1 = LV_COORD_MAX;
+    changed.x2 = LV_COORD_MIN;
+    changed.y2 = LV_COORD_MIN;
+
+    int32_t y;
+    for(y = area->y1; y <= area->y2; y++) {
+        const uint8_t * row = px_map + (y - area->y1) * stride;
+        lv_display_flush_diff_block_t * block = &disp->flush_diff_map[y * disp->flush_diff_cols + col_first];
+        int32_t col;
+        for(col = col_first; col <= col_last; col++, block++) {
+            int32_t seg_x1 = LV_MAX(area->x1, col * block_w);
+            int32_t seg_x2 = LV_MIN(area->x2, (col + 1) * block_w - 1);
+            uint32_t seg_w = seg_x2 - seg_x1 + 1;
+            uint32_t x_ofs = seg_x1 - col * block_w;
+            uint32_t hash = flush_diff_hash(row + (seg_x1 - area->x1) * px_size, seg_w * px_size);
+
+            if(block->len == seg_w && block->x_ofs == x_ofs && block->hash == hash) continue;
+
+            block->hash = hash;
+            block->x_ofs = (uint16_t)x_ofs;
+            block->len = (uint16_t)seg_w;
+            changed.x1 = LV_MIN(changed.x1, seg_x1);
+            changed.x2 = LV_MAX(changed.x2, seg_x2);
+            changed.y1 = LV_MIN(changed.y1, y);
+            changed.y2 = LV_MAX(changed.y2, y);
+        }
+    }
+
+    uint32_t area_bytes = stride * h;
+    if(changed.x1 > changed.x2) {
+        disp->flush_diff_stat.skipped_cnt++;
+        disp->flush_diff_stat.saved_bytes += area_bytes;
+        LV_PROFILER_END;
+        return false;
+    }
+
+    int32_t new_w = lv_area_get_width(&changed);
+    int32_t new_h = lv_area_get_height(&changed);
+    uint32_t new_stride = lv_draw_buf_width_to_stride(new_w, cf);
+    if(new_w == w) {
+        if(changed.y1 != area->y1) {
+            lv_memmove(px_map, px_map + (changed.y1 - area->y1) * stride, stride * new_h);
+        }
+    }
+    else {
+        /*The destination is never after the source, so the rows can be moved from the top*/
+        const uint8_t * src = px_map + (changed.y1 - area->y1) * stride + (changed.x1 - area->x1) * px_size;
+        uint8_t * dest = px_map;
+        for(y = 0; y < new_h; y++) {
+            lv_memmove(dest, src, new_w * px_size);
+            dest += new_stride;
+            src += stride;
+        }
+    }
+
+    disp->flush_diff_stat.sent_bytes += new_stride * new_h;
+    disp->flush_diff_stat.saved_bytes += area_bytes - new_stride * new_h;
+    *area = changed;
+
+    LV_PROFILER_END;
+    return true;
+}
+
+/**
+ * Calculate a 32 bit checksum of a row segment for the flush diff
+ * @param data      pointer to the pixels
+ * @param len       number of bytes
+ * @return          the checksum
+ */
+static uint32_t flush_diff_hash(const uint8_t * data, uint32_t len)
+{
+    uint32_t h = 0x811C9DC5 ^ len;
+
+    /*Assemble the words from bytes so the result doesn't depend on the alignment.
+     *The compilers usually make a single load from it where unaligned access is allowed.*/
+    while(len >= 4) {
+        h ^= (uint32_t)data[0] | ((uint32_t)data[1] << 8) | ((uint32_t)data[2] << 16) | ((uint32_t)data[3] << 24);
+        h *= 0x9E3779B1;
+        h ^= h >> 16;
+        data += 4;
+        len -= 4;
+    }
+
+    while(len) {
+        h = (h ^ *data) * 0x01000193;
+        data++;
+        len--;
+    }
+
+    return h;
+}
+
 static void wait_for_flushing(lv_display_t * disp)
 {
     LV_PROFILER_BEGIN;
@@ -1237,3 +2254,45 @@ static void wait_for_flushing(lv_display_t * disp)
     LV_LOG_TRACE("end");
     LV_PROFILER_END;
 }
+
+/**
+ * Make the next buffer active. The buffers are used in the order `buf_1`, `buf_2`, `buf_3`.
+ * @param disp      pointer to a display with at least 2 buffers
+ */
+static void swap_buffers(lv_display_t * disp)
+{
+    if(disp->buf_act == disp->buf_1) {
+        disp->buf_act = disp->buf_2;
+    }
+    else if(disp->buf_act == disp->buf_2 && disp->buf_3) {
+        disp->buf_act = disp->buf_3;
+    }
+    else {
+        disp->buf_act = disp->buf_1;
+    }
+}
+
+/**
+ * Get the buffer which was active before the current one
+ * @param disp      pointer to a display with at least 2 buffers
+ * @return          the previous buffer
+ */
+static lv_draw_buf_t * get_prev_buf(lv_display_t * disp)
+{
+    if(disp->buf_act == disp->buf_1) return disp->buf_3 ? disp->buf_3 : disp->buf_2;
+    else if(disp->buf_act == disp->buf_2) return disp->buf_1;
+    else return disp->buf_2;
+}
+
+/**
+ * Get the index of a display buffer
+ * @param disp      pointer to a display
+ * @param buf       one of the buffers of the display
+ * @return          0, 1 or 2 for `buf_1`, `buf_2` or `buf_3`
+ */
+static uint32_t get_buf_index(lv_display_t * disp, const lv_draw_buf_t * buf)
+{
+    if(buf == disp->buf_1) return 0;
+    else if(buf == disp->buf_2) return 1;
+    else return 2;
+}
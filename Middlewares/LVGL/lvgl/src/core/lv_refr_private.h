@@ -46,6 +46,17 @@ void lv_refr_deinit(void);
  */
 void lv_inv_area(lv_display_t * disp, const lv_area_t * area_p);
 
+/**
+ * Invalidate a scrolled object. If the display has scroll blit enabled and it's safe,
+ * the rendered pixels of the object will be moved by `dx;dy` before the next refresh and
+ * only the rest is invalidated.
+ * @param obj   pointer to an object which was just scrolled
+ * @param dx    the horizontal scroll distance
+ * @param dy    the vertical scroll distance
+ * @return      true: the object is invalidated; false: the caller needs to invalidate the whole object
+ */
+bool lv_refr_scroll_blit(lv_obj_t * obj, int32_t dx, int32_t dy);
+
 /**
  * Get the display which is being refreshed
  * @return the display being refreshed
@@ -11,6 +11,7 @@
 #include "../misc/lv_anim_private.h"
 #include "../draw/lv_draw_private.h"
 #include "../core/lv_obj_private.h"
+#include "../core/lv_obj_style_private.h"
 #include "lv_display.h"
 #include "../misc/lv_math.h"
 #include "../core/lv_refr_private.h"
@@ -46,6 +47,7 @@ static void set_y_anim(void * obj, int32_t v);
 static void scr_anim_completed(lv_anim_t * a);
 static bool is_out_anim(lv_screen_load_anim_t a);
 static void disp_event_cb(lv_event_t * e);
+static void flush_diff_map_alloc(lv_display_t * disp);
 
 /**********************
  *  STATIC VARIABLES
@@ -88,10 +90,14 @@ lv_display_t * lv_display_create(int32_t hor_res, int32_t ver_res)
     disp->layer_head->buf_area.y2 = ver_res - 1;
     disp->layer_head->color_format = disp->color_format;
 
+    disp->inv_areas = disp->_static_inv_areas;
+    disp->inv_area_joined = disp->_static_inv_area_joined;
+    disp->inv_size = LV_INV_BUF_SIZE;
     disp->inv_en_cnt = 1;
     disp->last_activity_time = lv_tick_get();
 
-    lv_ll_init(&disp->sync_areas, sizeof(lv_area_t));
+    lv_ll_init(&disp->sync_areas, sizeof(lv_display_sync_area_t));
+    lv_ll_init(&disp->scroll_blits, sizeof(lv_display_scroll_blit_t));
 
     lv_display_t * disp_def_tmp = disp_def;
     disp_def                 = disp; /*Temporarily change the default screen to create the default screens on the
@@ -198,6 +204,9 @@ void lv_display_delete(lv_display_t * disp)
     }
 
     lv_ll_clear(&disp->sync_areas);
+    lv_ll_clear(&disp->scroll_blits);
+    lv_free(disp->flush_diff_map);
+    if(disp->inv_areas != disp->_static_inv_areas) lv_free(disp->inv_areas);
     lv_ll_remove(disp_ll_p, disp);
     if(disp->refr_timer) lv_timer_delete(disp->refr_timer);
 
@@ -410,7 +419,32 @@ void lv_display_set_draw_buffers(lv_display_t * disp, lv_draw_buf_t * buf1, lv_d
 
     disp->buf_1 = buf1;
     disp->buf_2 = buf2;
+    disp->buf_3 = NULL;
     disp->buf_act = disp->buf_1;
+
+    /*The content of the new buffers is unknown*/
+    lv_ll_clear(&disp->sync_areas);
+    disp->sync_frame = 0;
+    lv_memzero(disp->buf_frame, sizeof(disp->buf_frame));
+}
+
+void lv_display_set_3rd_draw_buffer(lv_display_t * disp, lv_draw_buf_t * buf3)
+{
+    if(disp == NULL) disp = lv_display_get_default();
+    if(disp == NULL) return;
+
+    LV_ASSERT_MSG(buf3 == NULL || disp->buf_2 != NULL, "Set 2 buffers before adding a 3rd one");
+
+    disp->buf_3 = buf3;
+    disp->buf_frame[2] = 0;
+
+    /*The areas redrawn before might be already dropped from the sync areas, so redraw everything*/
+    if(buf3) {
+        lv_area_t a;
+        lv_area_set(&a, 0, 0, lv_display_get_horizontal_resolution(disp) - 1,
+                    lv_display_get_vertical_resolution(disp) - 1);
+        lv_inv_area(disp, &a);
+    }
 }
 
 void lv_display_set_buffers(lv_display_t * disp, void * buf1, void * buf2, uint32_t buf_size,
@@ -428,8 +462,8 @@ void lv_display_set_buffers(lv_display_t * disp, void * buf1, void * buf2, uint3
     LV_ASSERT_FORMAT_MSG(buf2 == NULL || buf2 == lv_draw_buf_align(buf2, cf), "buf2 is not aligned: %p", buf2);
 
     uint32_t stride = lv_draw_buf_width_to_stride(w, cf);
-    if(render_mode == LV_DISPLAY_RENDER_MODE_PARTIAL) {
-        /* for partial mode, we calculate the height based on the buf_size and stride */
+    if(render_mode == LV_DISPLAY_RENDER_MODE_PARTIAL || render_mode == LV_DISPLAY_RENDER_MODE_TILED) {
+        /* for partial and tiled modes, we calculate the height based on the buf_size and stride */
         h = buf_size / stride;
         LV_ASSERT_MSG(h != 0, "the buffer is too small");
     }
@@ -476,6 +510,7 @@ void lv_display_set_color_format(lv_display_t * disp, lv_color_format_t color_fo
     disp->layer_head->color_format = color_format;
     if(disp->buf_1) disp->buf_1->header.cf = color_format;
     if(disp->buf_2) disp->buf_2->header.cf = color_format;
+    if(disp->buf_3) disp->buf_3->header.cf = color_format;
 
     lv_display_send_event(disp, LV_EVENT_COLOR_FORMAT_CHANGED, NULL);
 }
@@ -504,6 +539,67 @@ bool lv_display_get_antialiasing(lv_display_t * disp)
     return disp->antialiasing;
 }
 
+void lv_display_set_scroll_blit(lv_display_t * disp, bool en)
+{
+    if(disp == NULL) disp = lv_display_get_default();
+    if(disp == NULL) return;
+
+    disp->scroll_blit = en;
+}
+
+bool lv_display_get_scroll_blit(lv_display_t * disp)
+{
+    if(disp == NULL) disp = lv_display_get_default();
+    if(disp == NULL) return false;
+
+    return disp->scroll_blit;
+}
+
+void lv_display_set_scroll_blit_cb(lv_display_t * disp, lv_display_scroll_blit_cb_t blit_cb)
+{
+    if(disp == NULL) disp = lv_display_get_default();
+    if(disp == NULL) return;
+
+    disp->scroll_blit_cb = blit_cb;
+}
+
+void lv_display_set_flush_diff(lv_display_t * disp, uint32_t block_width)
+{
+    if(disp == NULL) disp = lv_display_get_default();
+    if(disp == NULL) return;
+
+    disp->flush_diff_block_w = block_width;
+    flush_diff_map_alloc(disp);
+}
+
+void lv_display_get_flush_diff_stat(lv_display_t * disp, lv_display_flush_diff_stat_t * stat)
+{
+    if(disp == NULL) disp = lv_display_get_default();
+    if(disp == NULL) {
+        lv_memzero(stat, sizeof(lv_display_flush_diff_stat_t));
+        return;
+    }
+
+    *stat = disp->flush_diff_stat;
+}
+
+void lv_display_reset_flush_diff_stat(lv_display_t * disp)
+{
+    if(disp == NULL) disp = lv_display_get_default();
+    if(disp == NULL) return;
+
+    lv_memzero(&disp->flush_diff_stat, sizeof(lv_display_flush_diff_stat_t));
+}
+
+void lv_display_reset_flush_diff(lv_display_t * disp)
+{
+    if(disp == NULL) disp = lv_display_get_default();
+    if(disp == NULL || disp->flush_diff_map == NULL) return;
+
+    lv_memzero(disp->flush_diff_map,
+               disp->flush_diff_cols * disp->flush_diff_rows * sizeof(lv_display_flush_diff_block_t));
+}
+
 LV_ATTRIBUTE_FLUSH_READY void lv_display_flush_ready(lv_display_t * disp)
 {
     disp->flushing = 0;
@@ -609,6 +705,9 @@ void lv_screen_load_anim(lv_obj_t * new_scr, lv_screen_load_anim_t anim_type, ui
     d->scr_to_load = new_scr;
 
     if(d->prev_scr && d->del_prev) lv_obj_delete(d->prev_scr);
+#if LV_OBJ_STYLE_VALUE_CACHE
+    else if(d->prev_scr && d->prev_scr != d->act_scr) lv_obj_style_value_cache_free_tree(d->prev_scr);
+#endif
     d->prev_scr = NULL;
 
     d->draw_prev_over_act = is_out_anim(anim_type);
@@ -1030,16 +1129,46 @@ static void update_resolution(lv_display_t * disp)
     lv_area_set_height(&disp->bottom_layer->coords, ver_res);
     lv_obj_send_event(disp->bottom_layer, LV_EVENT_SIZE_CHANGED, &prev_coords);
 
-    lv_memzero(disp->inv_areas, sizeof(disp->inv_areas));
-    lv_memzero(disp->inv_area_joined, sizeof(disp->inv_area_joined));
+    lv_memzero(disp->inv_areas, disp->inv_size * sizeof(lv_area_t));
+    lv_memzero(disp->inv_area_joined, disp->inv_size * sizeof(uint8_t));
     disp->inv_p = 0;
     lv_obj_invalidate(disp->sys_layer);
 
     lv_obj_tree_walk(NULL, invalidate_layout_cb, NULL);
 
+    if(disp->flush_diff_map) flush_diff_map_alloc(disp);
+
     lv_display_send_event(disp, LV_EVENT_RESOLUTION_CHANGED, NULL);
 }
 
+/**
+ * (Re)allocate the checksum map of the flush diff for the current resolution
+ * @param disp      pointer to a display
+ */
+static void flush_diff_map_alloc(lv_display_t * disp)
+{
+    lv_free(disp->flush_diff_map);
+    disp->flush_diff_map = NULL;
+    disp->flush_diff_cols = 0;
+    disp->flush_diff_rows = 0;
+
+    if(disp->flush_diff_block_w == 0) return;
+
+    uint32_t hor_res = lv_display_get_horizontal_resolution(disp);
+    uint32_t ver_res = lv_display_get_vertical_resolution(disp);
+    if(disp->flush_diff_block_w > hor_res) disp->flush_diff_block_w = hor_res;
+    if(disp->flush_diff_block_w > UINT16_MAX) disp->flush_diff_block_w = UINT16_MAX;
+    if(hor_res == 0 || ver_res == 0) return;
+
+    uint32_t cols = (hor_res + disp->flush_diff_block_w - 1) / disp->flush_diff_block_w;
+    disp->flush_diff_map = lv_malloc_zeroed(cols * ver_res * sizeof(lv_display_flush_diff_block_t));
+    LV_ASSERT_MALLOC(disp->flush_diff_map);
+    if(disp->flush_diff_map == NULL) return;
+
+    disp->flush_diff_cols = cols;
+    disp->flush_diff_rows = ver_res;
+}
+
 static lv_obj_tree_walk_res_t invalidate_layout_cb(lv_obj_t * obj, void * user_data)
 {
     LV_UNUSED(user_data);
@@ -1067,6 +1196,11 @@ static void scr_load_internal(lv_obj_t * scr)
     lv_obj_send_event(scr, LV_EVENT_SCREEN_LOADED, NULL);
     if(old_scr) lv_obj_send_event(old_scr, LV_EVENT_SCREEN_UNLOADED, NULL);
 
+#if LV_OBJ_STYLE_VALUE_CACHE
+    /*The old screen is not drawn anymore, let the new one use its cache records*/
+    if(old_scr && old_scr != scr) lv_obj_style_value_cache_free_tree(old_scr);
+#endif
+
     lv_obj_invalidate(scr);
 }
 
@@ -1103,6 +1237,9 @@ static void scr_anim_completed(lv_anim_t * a)
     lv_obj_send_event(d->prev_scr, LV_EVENT_SCREEN_UNLOADED, NULL);
 
     if(d->prev_scr && d->del_prev) lv_obj_delete(d->prev_scr);
+#if LV_OBJ_STYLE_VALUE_CACHE
+    else if(d->prev_scr && d->prev_scr != d->act_scr) lv_obj_style_value_cache_free_tree(d->prev_scr);
+#endif
     d->prev_scr = NULL;
     d->draw_prev_over_act = false;
     d->scr_to_load = NULL;
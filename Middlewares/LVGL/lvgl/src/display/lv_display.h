@@ -57,6 +57,13 @@ typedef enum {
      * With 2 buffers in flush_cb only and address change is required.
      */
     LV_DISPLAY_RENDER_MODE_FULL,
+
+    /**
+     * Similar to LV_DISPLAY_RENDER_MODE_PARTIAL but the areas are rendered in square tiles of `LV_DISPLAY_TILE_SIZE`.
+     * As many tiles are rendered together as fit into the buffer, so the draw units can render them in parallel.
+     * The tiles are flushed one by one.
+     */
+    LV_DISPLAY_RENDER_MODE_TILED,
 } lv_display_render_mode_t;
 
 typedef enum {
@@ -78,9 +85,24 @@ typedef enum {
     LV_SCR_LOAD_ANIM_OUT_BOTTOM,
 } lv_screen_load_anim_t;
 
+/** Statistics of the flush diff, see `lv_display_set_flush_diff`*/
+typedef struct {
+    uint64_t sent_bytes;        /**< Bytes passed to `flush_cb`*/
+    uint64_t saved_bytes;       /**< Bytes not passed to `flush_cb` because they were unchanged*/
+    uint32_t skipped_cnt;       /**< Number of `flush_cb` calls left out as nothing changed in the area*/
+} lv_display_flush_diff_stat_t;
+
 typedef void (*lv_display_flush_cb_t)(lv_display_t * disp, const lv_area_t * area, uint8_t * px_map);
 typedef void (*lv_display_flush_wait_cb_t)(lv_display_t * disp);
 
+/**
+ * Move the pixels of a scrolled area in the draw buffer.
+ * The pixels of `area` shifted by `-dx;-dy` should be copied to `area`. The two areas can overlap.
+ * Return `false` to let LVGL move the pixels with `lv_memmove`.
+ */
+typedef bool (*lv_display_scroll_blit_cb_t)(lv_display_t * disp, lv_draw_buf_t * buf, const lv_area_t * area,
+                                            int32_t dx, int32_t dy);
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -234,7 +256,7 @@ int32_t lv_display_get_dpi(const lv_display_t * disp);
  * @param buf1              first buffer
  * @param buf2              second buffer (can be `NULL`)
  * @param buf_size          buffer size in byte
- * @param render_mode       LV_DISPLAY_RENDER_MODE_PARTIAL/DIRECT/FULL
+ * @param render_mode       LV_DISPLAY_RENDER_MODE_PARTIAL/DIRECT/FULL/TILED
  */
 void lv_display_set_buffers(lv_display_t * disp, void * buf1, void * buf2, uint32_t buf_size,
                             lv_display_render_mode_t render_mode);
@@ -249,10 +271,20 @@ void lv_display_set_buffers(lv_display_t * disp, void * buf1, void * buf2, uint3
  */
 void lv_display_set_draw_buffers(lv_display_t * disp, lv_draw_buf_t * buf1, lv_draw_buf_t * buf2);
 
+/**
+ * Add a third buffer to a double buffered display. The buffers are used in rotation,
+ * so LVGL can render the next frame while one buffer is shown and an other is waiting to be shown.
+ * In DIRECT mode only the areas changed since a buffer was last rendered are copied to it.
+ * Call it after `lv_display_set_buffers` or `lv_display_set_draw_buffers`.
+ * @param disp      pointer to a display
+ * @param buf3      the third buffer with the same size and format as the others, or `NULL` to remove it
+ */
+void lv_display_set_3rd_draw_buffer(lv_display_t * disp, lv_draw_buf_t * buf3);
+
 /**
  * Set display render mode
  * @param disp              pointer to a display
- * @param render_mode       LV_DISPLAY_RENDER_MODE_PARTIAL/DIRECT/FULL
+ * @param render_mode       LV_DISPLAY_RENDER_MODE_PARTIAL/DIRECT/FULL/TILED
  */
 void lv_display_set_render_mode(lv_display_t * disp, lv_display_render_mode_t render_mode);
 
@@ -307,6 +339,65 @@ void lv_display_set_antialiasing(lv_display_t * disp, bool en);
  */
 bool lv_display_get_antialiasing(lv_display_t * disp);
 
+/**
+ * Enable moving the already rendered pixels when an object is scrolled.
+ * Only the newly exposed areas and the non-scrolling objects on the scrolled area are redrawn.
+ * It's used only in DIRECT render mode and only if the moved pixels are known to stay
+ * the same, e.g. the object has an opaque, plain background and no transformations.
+ * Otherwise the scrolled object is simply redrawn.
+ * @param disp      pointer to a display
+ * @param en        true/false
+ */
+void lv_display_set_scroll_blit(lv_display_t * disp, bool en);
+
+/**
+ * Get if moving the rendered pixels on scroll is enabled
+ * @param disp      pointer to a display (NULL to use the default display)
+ * @return          true/false
+ */
+bool lv_display_get_scroll_blit(lv_display_t * disp);
+
+/**
+ * Set a callback to move the pixels of a scrolled area, e.g. with DMA.
+ * @param disp      pointer to a display
+ * @param blit_cb   the callback or `NULL` to always use `lv_memmove`
+ */
+void lv_display_set_scroll_blit_cb(lv_display_t * disp, lv_display_scroll_blit_cb_t blit_cb);
+
+/**
+ * Skip sending the pixels which are the same as the ones already on the display.
+ * A checksum of each `block_width` wide part of each row is stored when flushed.
+ * Before flushing in PARTIAL or TILED render mode the unchanged rows and blocks are
+ * cut off from the area, or `flush_cb` is not called at all if nothing has changed.
+ * Useful if the pixels are sent on a slow bus, e.g. SPI.
+ * The checksum map needs 8 bytes per block. A block is compared only if the same part of it
+ * is flushed again, so in TILED mode use at most `LV_DISPLAY_TILE_SIZE` wide blocks.
+ * @param disp          pointer to a display
+ * @param block_width   width of the blocks in pixels; larger than the horizontal resolution
+ *                      to use one block per row (only rows are cut off); 0 to disable
+ */
+void lv_display_set_flush_diff(lv_display_t * disp, uint32_t block_width);
+
+/**
+ * Get the statistics of the flush diff
+ * @param disp      pointer to a display (NULL to use the default display)
+ * @param stat      store the statistics here
+ */
+void lv_display_get_flush_diff_stat(lv_display_t * disp, lv_display_flush_diff_stat_t * stat);
+
+/**
+ * Reset the statistics of the flush diff
+ * @param disp      pointer to a display (NULL to use the default display)
+ */
+void lv_display_reset_flush_diff_stat(lv_display_t * disp);
+
+/**
+ * Forget the content of the display stored by the flush diff, so all pixels will be sent
+ * on the next flush. Call it if the display was drawn without LVGL.
+ * @param disp      pointer to a display (NULL to use the default display)
+ */
+void lv_display_reset_flush_diff(lv_display_t * disp);
+
 //! @cond Doxygen_Suppress
 
 /**
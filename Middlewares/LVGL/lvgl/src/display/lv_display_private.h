@@ -26,13 +26,37 @@ extern "C" {
  *      DEFINES
  *********************/
 #ifndef LV_INV_BUF_SIZE
-#define LV_INV_BUF_SIZE 32 /**< Buffer size for invalid areas */
+#define LV_INV_BUF_SIZE 32 /**< Initial buffer size for invalid areas. Grows on the heap if required. */
+#endif
+
+#ifndef LV_INV_BUF_MAX
+#define LV_INV_BUF_MAX (LV_INV_BUF_SIZE * 8) /**< The heap buffer of invalid areas doesn't grow beyond this. */
 #endif
 
 /**********************
  *      TYPEDEFS
  **********************/
 
+/** An area redrawn in a frame, to be copied to the buffers which have an older content*/
+typedef struct {
+    lv_area_t area;
+    uint32_t frame;     /**< The frame in which `area` was redrawn*/
+} lv_display_sync_area_t;
+
+/** Pixels to move in the draw buffer before rendering the next frame*/
+typedef struct {
+    lv_area_t area;     /**< The destination. The source is `area` shifted by `-dx;-dy`*/
+    int32_t dx;
+    int32_t dy;
+} lv_display_scroll_blit_t;
+
+/** Checksum of the last flushed part of a row block*/
+typedef struct {
+    uint32_t hash;
+    uint16_t x_ofs;     /**< Start of the flushed part relative to the start of the block*/
+    uint16_t len;       /**< Width of the flushed part. 0: unknown*/
+} lv_display_flush_diff_block_t;
+
 struct lv_display_t {
 
     /*---------------------
@@ -65,6 +89,7 @@ struct lv_display_t {
      *--------------------*/
     lv_draw_buf_t * buf_1;
     lv_draw_buf_t * buf_2;
+    lv_draw_buf_t * buf_3;  /**< Optional third buffer. Used only if `buf_2` is set too*/
 
     /** Internal, used by the library*/
     lv_draw_buf_t * buf_act;
@@ -95,19 +120,46 @@ struct lv_display_t {
     /** 1: The current screen rendering is in progress*/
     uint32_t rendering_in_progress : 1;
 
+    /** 1: Move the rendered pixels on scroll instead of redrawing them. Used only in DIRECT mode*/
+    uint32_t scroll_blit : 1;
+
+    /** Move the pixels of a scrolled area. If not set or returns `false` `lv_memmove` is used*/
+    lv_display_scroll_blit_cb_t scroll_blit_cb;
+
+    /** Scrolled areas (`lv_display_scroll_blit_t` items) to move before rendering the next frame*/
+    lv_ll_t scroll_blits;
+
+    /** Checksums of the flushed content, `flush_diff_cols * flush_diff_rows` items. NULL: flush diff is disabled*/
+    lv_display_flush_diff_block_t * flush_diff_map;
+    uint32_t flush_diff_block_w;
+    uint32_t flush_diff_cols;
+    uint32_t flush_diff_rows;
+    lv_display_flush_diff_stat_t flush_diff_stat;
+
     lv_color_format_t   color_format;
 
-    /** Invalidated (marked to redraw) areas*/
-    lv_area_t inv_areas[LV_INV_BUF_SIZE];
-    uint8_t inv_area_joined[LV_INV_BUF_SIZE];
+    /** Invalidated (marked to redraw) areas.
+     * Points to `_static_inv_areas` until more than `LV_INV_BUF_SIZE` areas are needed
+     * and again after a frame which needed less*/
+    lv_area_t * inv_areas;
+    uint8_t * inv_area_joined;
     uint32_t inv_p;
+    uint32_t inv_size;      /**< Number of areas `inv_areas` can store*/
     int32_t inv_en_cnt;
 
-    /** Double buffer sync areas (redrawn during last refresh) */
+    /** Double buffer sync areas (`lv_display_sync_area_t` items redrawn during the last refreshes) */
     lv_ll_t sync_areas;
 
+    /** Number of frames rendered in direct mode. Used to stamp the sync areas*/
+    uint32_t sync_frame;
+
+    /** The frame whose content each of `buf_1`, `buf_2` and `buf_3` holds (0: unknown)*/
+    uint32_t buf_frame[3];
+
     lv_draw_buf_t _static_buf1; /**< Used when user pass in a raw buffer as display draw buffer */
     lv_draw_buf_t _static_buf2;
+    lv_area_t _static_inv_areas[LV_INV_BUF_SIZE];  /**< Initial storage of `inv_areas`*/
+    uint8_t _static_inv_area_joined[LV_INV_BUF_SIZE];
     /*---------------------
      * Layer
      *--------------------*/
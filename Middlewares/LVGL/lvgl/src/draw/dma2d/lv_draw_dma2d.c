@@ -0,0 +1,577 @@
+/**
+ * @file lv_draw_dma2d.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_draw_dma2d.h"
+#if LV_USE_DRAW_DMA2D
+
+#include LV_DRAW_DMA2D_HAL_INCLUDE
+#include "../lv_draw_image_private.h"
+#include "../lv_draw_label_private.h"
+#include "../../misc/lv_area_private.h"
+#include "../../misc/lv_log.h"
+#include "../../core/lv_global.h"
+#include "../../font/lv_font_fmt_txt.h"
+#include "../sw/lv_draw_sw.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+#define DRAW_UNIT_ID_DMA2D  5
+
+/*Transfer modes (CR.MODE)*/
+#define DMA2D_MODE_M2M          0x0UL
+#define DMA2D_MODE_M2M_PFC      0x1UL
+#define DMA2D_MODE_M2M_BLEND    0x2UL
+#define DMA2D_MODE_R2M          0x3UL
+
+/*Color modes (xxPFCCR.CM)*/
+#define DMA2D_CM_ARGB8888   0x0UL
+#define DMA2D_CM_RGB888     0x1UL
+#define DMA2D_CM_RGB565     0x2UL
+#define DMA2D_CM_A8         0x9UL
+
+/*Alpha modes (xxPFCCR.AM)*/
+#define DMA2D_AM_NONE       0x0UL
+#define DMA2D_AM_REPLACE    0x1UL
+#define DMA2D_AM_MULTIPLY   0x2UL
+
+#define DMA2D_PFCCR(cm, am, alpha)  ((cm) | ((am) << 16) | ((uint32_t)(alpha) << 24))
+
+#define DMA2D_ERROR_FLAGS   (DMA2D_ISR_TEIF | DMA2D_ISR_CEIF)
+
+/*The address of a buffer as DMA2D sees it. The HAL header can redefine it, e.g. a model of DMA2D on a PC.*/
+#ifndef DMA2D_ADDR
+    #define DMA2D_ADDR(p)   ((uint32_t)(uintptr_t)(p))
+#endif
+
+/*Number of polls after a transfer is considered stuck and aborted. Same as in the LTDC driver.*/
+#define DMA2D_TIMEOUT       0x1FFFFFUL
+
+#define dma2d_mutex         LV_GLOBAL_DEFAULT()->dma2d_mutex
+#define dma2d_wait_cb       LV_GLOBAL_DEFAULT()->dma2d_wait_cb
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static int32_t evaluate(lv_draw_unit_t * draw_unit, lv_draw_task_t * task);
+
+static int32_t dispatch(lv_draw_unit_t * draw_unit, lv_layer_t * layer);
+
+static int32_t delete_cb(lv_draw_unit_t * draw_unit);
+
+#if LV_USE_OS
+    static void render_thread_cb(void * ptr);
+#endif
+
+static void execute_drawing(lv_draw_dma2d_unit_t * u);
+
+static void execute_drawing_sw(lv_draw_dma2d_unit_t * u);
+
+static bool image_supported(const lv_draw_image_dsc_t * dsc);
+
+static bool font_supported(const lv_font_t * font);
+
+static void wait_idle(void);
+
+static void abort_transfer(void);
+
+static uint32_t cf_to_dma2d(lv_color_format_t cf);
+
+static void setup_background(void * dest, lv_color_format_t dest_cf, uint32_t dest_stride, int32_t w);
+
+static void run_transfer(uint32_t mode, void * dest, lv_color_format_t dest_cf, uint32_t dest_stride,
+                         int32_t w, int32_t h);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_draw_dma2d_init(void)
+{
+#ifdef RCC_AHB1ENR_DMA2DEN
+    RCC->AHB1ENR |= RCC_AHB1ENR_DMA2DEN;
+#endif
+
+    lv_mutex_init(&dma2d_mutex);
+    dma2d_wait_cb = NULL;
+
+    lv_draw_dma2d_unit_t * draw_dma2d_unit = lv_draw_create_unit(sizeof(lv_draw_dma2d_unit_t));
+    draw_dma2d_unit->base_unit.evaluate_cb = evaluate;
+    draw_dma2d_unit->base_unit.dispatch_cb = dispatch;
+    draw_dma2d_unit->base_unit.delete_cb = delete_cb;
+
+#if LV_USE_OS
+    lv_thread_init(&draw_dma2d_unit->thread, LV_THREAD_PRIO_HIGH, render_thread_cb, LV_DRAW_THREAD_STACK_SIZE,
+                   draw_dma2d_unit);
+#endif
+}
+
+void lv_draw_dma2d_deinit(void)
+{
+    /*Let a running transfer finish*/
+    lv_draw_dma2d_lock();
+    wait_idle();
+    lv_draw_dma2d_unlock();
+
+    lv_mutex_delete(&dma2d_mutex);
+    dma2d_wait_cb = NULL;
+}
+
+void lv_draw_dma2d_set_wait_cb(lv_draw_dma2d_wait_cb_t wait_cb)
+{
+    dma2d_wait_cb = wait_cb;
+}
+
+void lv_draw_dma2d_lock(void)
+{
+    lv_mutex_lock(&dma2d_mutex);
+}
+
+void lv_draw_dma2d_unlock(void)
+{
+    lv_mutex_unlock(&dma2d_mutex);
+}
+
+bool lv_draw_dma2d_cf_supported(lv_color_format_t cf)
+{
+    switch(cf) {
+        case LV_COLOR_FORMAT_RGB565:
+        case LV_COLOR_FORMAT_RGB888:
+        case LV_COLOR_FORMAT_XRGB8888:
+        case LV_COLOR_FORMAT_ARGB8888:
+            return true;
+        default:
+            return false;
+    }
+}
+
+bool lv_draw_dma2d_buf_supported(lv_color_format_t cf, uint32_t stride)
+{
+    if(!lv_draw_dma2d_cf_supported(cf)) return false;
+
+    uint32_t px_size = lv_color_format_get_size(cf);
+    return stride % px_size == 0 && stride / px_size <= 0x3FFF;
+}
+
+void lv_draw_dma2d_hw_fill(void * dest, lv_color_format_t dest_cf, uint32_t dest_stride,
+                           int32_t w, int32_t h, lv_color_t color, lv_opa_t opa)
+{
+    uint32_t rgb = ((uint32_t)color.red << 16) | ((uint32_t)color.green << 8) | color.blue;
+
+    lv_draw_dma2d_lock();
+
+    if(opa >= LV_OPA_MAX) {
+        wait_idle();
+
+        uint32_t ocolr;
+        if(dest_cf == LV_COLOR_FORMAT_RGB565) ocolr = lv_color_to_u16(color);
+        else if(dest_cf == LV_COLOR_FORMAT_RGB888) ocolr = rgb;
+        else ocolr = 0xFF000000 | rgb;
+
+        DMA2D->OCOLR = ocolr;
+        run_transfer(DMA2D_MODE_R2M, dest, dest_cf, dest_stride, w, h);
+        lv_draw_dma2d_unlock();
+        return;
+    }
+
+    /*Register to memory mode can't blend. Blend an A8 foreground instead whose alpha is
+     *replaced by `opa`. Its pixels are never used so just read the bytes of the destination.*/
+    wait_idle();
+
+    DMA2D->FGMAR = DMA2D_ADDR(dest);
+    DMA2D->FGOR = dest_stride - w;
+    DMA2D->FGPFCCR = DMA2D_PFCCR(DMA2D_CM_A8, DMA2D_AM_REPLACE, opa);
+    DMA2D->FGCOLR = rgb;
+    setup_background(dest, dest_cf, dest_stride, w);
+    run_transfer(DMA2D_MODE_M2M_BLEND, dest, dest_cf, dest_stride, w, h);
+
+    lv_draw_dma2d_unlock();
+}
+
+void lv_draw_dma2d_hw_blend(void * dest, lv_color_format_t dest_cf, uint32_t dest_stride,
+                            const void * src, lv_color_format_t src_cf, uint32_t src_stride,
+                            int32_t w, int32_t h, lv_opa_t opa)
+{
+    uint32_t mode;
+    uint32_t am;
+    uint32_t alpha = opa;
+
+    if(src_cf == LV_COLOR_FORMAT_ARGB8888) {
+        am = opa >= LV_OPA_MAX ? DMA2D_AM_NONE : DMA2D_AM_MULTIPLY;
+        mode = DMA2D_MODE_M2M_BLEND;
+    }
+    else {
+        /*The X byte of XRGB8888 is not an alpha value*/
+        if(opa >= LV_OPA_MAX) alpha = 0xFF;
+        am = src_cf == LV_COLOR_FORMAT_XRGB8888 || opa < LV_OPA_MAX ? DMA2D_AM_REPLACE : DMA2D_AM_NONE;
+
+        if(opa < LV_OPA_MAX) mode = DMA2D_MODE_M2M_BLEND;
+        else if(src_cf == dest_cf) mode = DMA2D_MODE_M2M;
+        else mode = DMA2D_MODE_M2M_PFC;
+    }
+
+    lv_draw_dma2d_lock();
+    wait_idle();
+
+    DMA2D->FGMAR = DMA2D_ADDR(src);
+    DMA2D->FGOR = src_stride / lv_color_format_get_size(src_cf) - w;
+    DMA2D->FGPFCCR = DMA2D_PFCCR(cf_to_dma2d(src_cf), am, alpha);
+    if(mode == DMA2D_MODE_M2M_BLEND) setup_background(dest, dest_cf, dest_stride, w);
+    run_transfer(mode, dest, dest_cf, dest_stride, w, h);
+
+    lv_draw_dma2d_unlock();
+}
+
+void lv_draw_dma2d_hw_blend_a8(void * dest, lv_color_format_t dest_cf, uint32_t dest_stride,
+                               const uint8_t * mask, uint32_t mask_stride,
+                               int32_t w, int32_t h, lv_color_t color, lv_opa_t opa)
+{
+    lv_draw_dma2d_lock();
+    wait_idle();
+
+    DMA2D->FGMAR = DMA2D_ADDR(mask);
+    DMA2D->FGOR = mask_stride - w;
+    DMA2D->FGPFCCR = DMA2D_PFCCR(DMA2D_CM_A8, opa >= LV_OPA_MAX ? DMA2D_AM_NONE : DMA2D_AM_MULTIPLY, opa);
+    DMA2D->FGCOLR = ((uint32_t)color.red << 16) | ((uint32_t)color.green << 8) | color.blue;
+    setup_background(dest, dest_cf, dest_stride, w);
+    run_transfer(DMA2D_MODE_M2M_BLEND, dest, dest_cf, dest_stride, w, h);
+
+    lv_draw_dma2d_unlock();
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static bool image_supported(const lv_draw_image_dsc_t * dsc)
+{
+    if(dsc->rotation != 0 || dsc->scale_x != LV_SCALE_NONE || dsc->scale_y != LV_SCALE_NONE) return false;
+    if(dsc->skew_x != 0 || dsc->skew_y != 0) return false;
+    if(dsc->recolor_opa > LV_OPA_MIN) return false;
+    if(dsc->blend_mode != LV_BLEND_MODE_NORMAL) return false;
+    if(dsc->bitmap_mask_src || dsc->clip_radius || dsc->tile) return false;
+
+    return true;
+}
+
+/**
+ * Only the built-in and converted fonts are accepted as their glyphs are always A1..A8 bitmaps.
+ * Other fonts (e.g. FreeType outlines) can return vector glyphs which can't be drawn here.
+ */
+static bool font_supported(const lv_font_t * font)
+{
+    while(font) {
+        if(font->get_glyph_bitmap != lv_font_get_bitmap_fmt_txt) return false;
+        font = font->fallback;
+    }
+
+    return true;
+}
+
+static int32_t evaluate(lv_draw_unit_t * draw_unit, lv_draw_task_t * task)
+{
+    LV_UNUSED(draw_unit);
+
+    const lv_draw_dsc_base_t * base_dsc = task->draw_dsc;
+    if(!lv_draw_dma2d_cf_supported(base_dsc->layer->color_format)) return 0;
+
+    switch(task->type) {
+        case LV_DRAW_TASK_TYPE_FILL: {
+                const lv_draw_fill_dsc_t * dsc = task->draw_dsc;
+                /*Only plain rectangles*/
+                if(dsc->radius != 0 || dsc->grad.dir != LV_GRAD_DIR_NONE) return 0;
+                break;
+            }
+        case LV_DRAW_TASK_TYPE_IMAGE: {
+                const lv_draw_image_dsc_t * dsc = task->draw_dsc;
+                if(!image_supported(dsc)) return 0;
+                if(!lv_draw_dma2d_cf_supported(dsc->header.cf)) return 0;
+                if(dsc->header.flags & (LV_IMAGE_FLAGS_PREMULTIPLIED | LV_IMAGE_FLAGS_COMPRESSED)) return 0;
+                break;
+            }
+        case LV_DRAW_TASK_TYPE_LAYER: {
+                const lv_draw_image_dsc_t * dsc = task->draw_dsc;
+                const lv_layer_t * layer_to_draw = dsc->src;
+                if(!image_supported(dsc)) return 0;
+                if(!lv_draw_dma2d_cf_supported(layer_to_draw->color_format)) return 0;
+                break;
+            }
+        case LV_DRAW_TASK_TYPE_LABEL: {
+                const lv_draw_label_dsc_t * dsc = task->draw_dsc;
+                if(!font_supported(dsc->font)) return 0;
+                break;
+            }
+        default:
+            return 0;
+    }
+
+    if(task->preference_score > 70) {
+        task->preference_score = 70;
+        task->preferred_draw_unit_id = DRAW_UNIT_ID_DMA2D;
+    }
+
+    return 1;
+}
+
+static int32_t dispatch(lv_draw_unit_t * draw_unit, lv_layer_t * layer)
+{
+    lv_draw_dma2d_unit_t * draw_dma2d_unit = (lv_draw_dma2d_unit_t *) draw_unit;
+
+    /*Return immediately if it's busy with draw task*/
+    if(draw_dma2d_unit->task_act) return 0;
+
+    lv_draw_task_t * t = lv_draw_get_next_available_task(layer, NULL, DRAW_UNIT_ID_DMA2D);
+    if(t == NULL || t->preferred_draw_unit_id != DRAW_UNIT_ID_DMA2D) return LV_DRAW_UNIT_IDLE;
+
+    if(lv_draw_layer_alloc_buf(layer) == NULL) return LV_DRAW_UNIT_IDLE;
+
+    t->state = LV_DRAW_TASK_STATE_IN_PROGRESS;
+    draw_dma2d_unit->base_unit.target_layer = layer;
+    draw_dma2d_unit->base_unit.clip_area = &t->clip_area;
+    draw_dma2d_unit->task_act = t;
+
+#if LV_USE_OS
+    /*Let the render thread work*/
+    if(draw_dma2d_unit->inited) lv_thread_sync_signal(&draw_dma2d_unit->sync);
+#else
+    execute_drawing(draw_dma2d_unit);
+
+    draw_dma2d_unit->task_act->state = LV_DRAW_TASK_STATE_READY;
+    draw_dma2d_unit->task_act = NULL;
+
+    /*The draw unit is free now. Request a new dispatching as it can get a new task*/
+    lv_draw_dispatch_request();
+#endif
+
+    return 1;
+}
+
+static int32_t delete_cb(lv_draw_unit_t * draw_unit)
+{
+#if LV_USE_OS
+    lv_draw_dma2d_unit_t * draw_dma2d_unit = (lv_draw_dma2d_unit_t *) draw_unit;
+
+    LV_LOG_INFO("cancel DMA2D draw thread");
+    draw_dma2d_unit->exit_status = true;
+
+    if(draw_dma2d_unit->inited) lv_thread_sync_signal(&draw_dma2d_unit->sync);
+
+    return lv_thread_delete(&draw_dma2d_unit->thread);
+#else
+    LV_UNUSED(draw_unit);
+    return 0;
+#endif
+}
+
+static void execute_drawing(lv_draw_dma2d_unit_t * u)
+{
+    lv_draw_task_t * t = u->task_act;
+    lv_draw_unit_t * draw_unit = (lv_draw_unit_t *)u;
+    lv_layer_t * layer = draw_unit->target_layer;
+
+    lv_area_t draw_area;
+    if(!lv_area_intersect(&draw_area, &t->area, draw_unit->clip_area)) return;
+
+    if(!lv_draw_dma2d_buf_supported(layer->draw_buf->header.cf, layer->draw_buf->header.stride)) {
+        execute_drawing_sw(u);
+        return;
+    }
+
+    /*DMA2D reads and writes the memory directly*/
+    lv_area_move(&draw_area, -layer->buf_area.x1, -layer->buf_area.y1);
+    lv_draw_buf_invalidate_cache(layer->draw_buf, &draw_area);
+
+    switch(t->type) {
+        case LV_DRAW_TASK_TYPE_FILL:
+            lv_draw_dma2d_fill(draw_unit, t->draw_dsc, &t->area);
+            break;
+        case LV_DRAW_TASK_TYPE_IMAGE:
+            lv_draw_dma2d_image(draw_unit, t->draw_dsc, &t->area);
+            break;
+        case LV_DRAW_TASK_TYPE_LAYER:
+            lv_draw_dma2d_layer(draw_unit, t->draw_dsc, &t->area);
+            break;
+        case LV_DRAW_TASK_TYPE_LABEL:
+            lv_draw_dma2d_label(draw_unit, t->draw_dsc, &t->area);
+            break;
+        default:
+            break;
+    }
+}
+
+/**
+ * Draw the task with the software renderer if the target buffer can't be used by DMA2D.
+ */
+static void execute_drawing_sw(lv_draw_dma2d_unit_t * u)
+{
+    lv_draw_task_t * t = u->task_act;
+    lv_draw_unit_t * draw_unit = (lv_draw_unit_t *)u;
+
+    switch(t->type) {
+        case LV_DRAW_TASK_TYPE_FILL:
+            lv_draw_sw_fill(draw_unit, t->draw_dsc, &t->area);
+            break;
+        case LV_DRAW_TASK_TYPE_IMAGE:
+            lv_draw_sw_image(draw_unit, t->draw_dsc, &t->area);
+            break;
+        case LV_DRAW_TASK_TYPE_LAYER:
+            lv_draw_sw_layer(draw_unit, t->draw_dsc, &t->area);
+            break;
+        case LV_DRAW_TASK_TYPE_LABEL:
+            lv_draw_sw_label(draw_unit, t->draw_dsc, &t->area);
+            break;
+        default:
+            break;
+    }
+}
+
+#if LV_USE_OS
+static void render_thread_cb(void * ptr)
+{
+    lv_draw_dma2d_unit_t * u = ptr;
+
+    lv_thread_sync_init(&u->sync);
+    u->inited = true;
+
+    while(1) {
+        /*Wait for sync if there is no task set*/
+        while(u->task_act == NULL) {
+            if(u->exit_status) break;
+
+            lv_thread_sync_wait(&u->sync);
+        }
+
+        if(u->exit_status) {
+            LV_LOG_INFO("ready to exit DMA2D draw thread");
+            break;
+        }
+
+        execute_drawing(u);
+
+        /*Signal the ready state to dispatcher*/
+        u->task_act->state = LV_DRAW_TASK_STATE_READY;
+
+        /*Cleanup*/
+        u->task_act = NULL;
+
+        /*The draw unit is free now. Request a new dispatching as it can get a new task*/
+        lv_draw_dispatch_request();
+    }
+
+    u->inited = false;
+    lv_thread_sync_delete(&u->sync);
+    LV_LOG_INFO("exit DMA2D draw thread");
+}
+#endif
+
+/**
+ * The application can use DMA2D too, e.g. for an interrupt driven flush.
+ * Wait until its transfer is finished and the interrupt is handled, or abort it if it's stuck.
+ */
+static void wait_idle(void)
+{
+    if(dma2d_wait_cb) dma2d_wait_cb();
+
+    uint32_t timeout = 0;
+    while(DMA2D->CR & (DMA2D_CR_START | DMA2D_CR_TCIE)) {
+        timeout++;
+        if(timeout > DMA2D_TIMEOUT) {
+            LV_LOG_WARN("DMA2D is busy for too long, abort its transfer");
+            abort_transfer();
+            return;
+        }
+    }
+}
+
+/**
+ * Abort the running transfer and leave DMA2D idle with its interrupts disabled
+ */
+static void abort_transfer(void)
+{
+    DMA2D->CR |= DMA2D_CR_ABORT;
+
+    uint32_t timeout = 0;
+    while(DMA2D->CR & DMA2D_CR_START) {
+        timeout++;
+        if(timeout > DMA2D_TIMEOUT) break;
+    }
+
+    DMA2D->CR &= ~(DMA2D_CR_TCIE | DMA2D_CR_TEIE | DMA2D_CR_CEIE);
+    DMA2D->IFCR = DMA2D_IFCR_CTCIF | DMA2D_IFCR_CTEIF | DMA2D_IFCR_CCEIF;
+}
+
+static uint32_t cf_to_dma2d(lv_color_format_t cf)
+{
+    switch(cf) {
+        case LV_COLOR_FORMAT_RGB565:
+            return DMA2D_CM_RGB565;
+        case LV_COLOR_FORMAT_RGB888:
+            return DMA2D_CM_RGB888;
+        default:
+            return DMA2D_CM_ARGB8888;
+    }
+}
+
+/**
+ * Read the destination back as background of a blending transfer.
+ */
+static void setup_background(void * dest, lv_color_format_t dest_cf, uint32_t dest_stride, int32_t w)
+{
+    DMA2D->BGMAR = DMA2D_ADDR(dest);
+    DMA2D->BGOR = dest_stride / lv_color_format_get_size(dest_cf) - w;
+
+    /*Consider XRGB8888 backgrounds opaque, so that the result is opaque too*/
+    if(dest_cf == LV_COLOR_FORMAT_XRGB8888) DMA2D->BGPFCCR = DMA2D_PFCCR(DMA2D_CM_ARGB8888, DMA2D_AM_REPLACE, 0xFF);
+    else DMA2D->BGPFCCR = DMA2D_PFCCR(cf_to_dma2d(dest_cf), DMA2D_AM_NONE, 0);
+}
+
+/**
+ * Set the output, start the transfer and wait until it's finished.
+ * The transfer is polled (no interrupts) and `DMA2D_IRQHandler` is left to the application.
+ * A transfer which doesn't finish in time is aborted, so a stuck DMA2D can't hang the drawing.
+ */
+static void run_transfer(uint32_t mode, void * dest, lv_color_format_t dest_cf, uint32_t dest_stride,
+                         int32_t w, int32_t h)
+{
+    DMA2D->OMAR = DMA2D_ADDR(dest);
+    DMA2D->OOR = dest_stride / lv_color_format_get_size(dest_cf) - w;
+    DMA2D->OPFCCR = cf_to_dma2d(dest_cf);
+    DMA2D->NLR = ((uint32_t)w << 16) | (uint32_t)h;
+    DMA2D->IFCR = DMA2D_IFCR_CTCIF | DMA2D_IFCR_CTEIF | DMA2D_IFCR_CCEIF;
+    DMA2D->CR = (mode << 16) | DMA2D_CR_START;
+
+    uint32_t timeout = 0;
+    while((DMA2D->ISR & (DMA2D_ISR_TCIF | DMA2D_ERROR_FLAGS)) == 0) {
+        timeout++;
+        if(timeout > DMA2D_TIMEOUT) {
+            LV_LOG_WARN("DMA2D transfer timed out, aborted");
+            abort_transfer();
+            return;
+        }
+    }
+
+    if(DMA2D->ISR & DMA2D_ERROR_FLAGS) {
+        LV_LOG_WARN("DMA2D transfer failed (ISR: 0x%x)", (unsigned int)DMA2D->ISR);
+    }
+
+    DMA2D->IFCR = DMA2D_IFCR_CTCIF | DMA2D_IFCR_CTEIF | DMA2D_IFCR_CCEIF;
+}
+
+#endif /*LV_USE_DRAW_DMA2D*/
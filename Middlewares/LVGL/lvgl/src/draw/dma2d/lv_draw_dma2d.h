@@ -0,0 +1,160 @@
+/**
+ * @file lv_draw_dma2d.h
+ *
+ */
+
+#ifndef LV_DRAW_DMA2D_H
+#define LV_DRAW_DMA2D_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../lv_conf_internal.h"
+#if LV_USE_DRAW_DMA2D
+#include "../lv_draw_private.h"
+#include "../lv_draw_image.h"
+#include "../lv_draw_label.h"
+#include "../lv_draw_rect.h"
+
+#if !LV_USE_DRAW_SW
+    #error "LV_USE_DRAW_DMA2D requires LV_USE_DRAW_SW to draw the unsupported tasks"
+#endif
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**
+ * Wait until the application's own DMA2D transfer (e.g. an interrupt driven flush) is finished
+ * or abort it if it doesn't finish in time.
+ */
+typedef void (*lv_draw_dma2d_wait_cb_t)(void);
+
+typedef struct {
+    lv_draw_unit_t base_unit;
+    lv_draw_task_t * volatile task_act;
+#if LV_USE_OS
+    lv_thread_sync_t sync;
+    lv_thread_t thread;
+    volatile bool inited;
+    volatile bool exit_status;
+#endif
+} lv_draw_dma2d_unit_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Create the DMA2D draw unit. It takes plain fills, non-transformed images and layers
+ * and A8 glyphs; everything else is left to the software renderer.
+ */
+void lv_draw_dma2d_init(void);
+
+void lv_draw_dma2d_deinit(void);
+
+/**
+ * Set a function which waits for the application's DMA2D transfers before the draw unit starts a new one.
+ * @param wait_cb   the wait function or NULL to wait only until DMA2D is idle
+ */
+void lv_draw_dma2d_set_wait_cb(lv_draw_dma2d_wait_cb_t wait_cb);
+
+/**
+ * Get exclusive access to DMA2D. The draw unit takes it for each transfer, the application
+ * needs to take it too while it programs DMA2D from another thread, e.g. to start a flush.
+ */
+void lv_draw_dma2d_lock(void);
+
+/**
+ * Release the access to DMA2D taken by `lv_draw_dma2d_lock()`
+ */
+void lv_draw_dma2d_unlock(void);
+
+void lv_draw_dma2d_fill(lv_draw_unit_t * draw_unit, lv_draw_fill_dsc_t * dsc, const lv_area_t * coords);
+
+void lv_draw_dma2d_image(lv_draw_unit_t * draw_unit, const lv_draw_image_dsc_t * dsc, const lv_area_t * coords);
+
+void lv_draw_dma2d_layer(lv_draw_unit_t * draw_unit, const lv_draw_image_dsc_t * dsc, const lv_area_t * coords);
+
+void lv_draw_dma2d_label(lv_draw_unit_t * draw_unit, const lv_draw_label_dsc_t * dsc, const lv_area_t * coords);
+
+/**
+ * Check if DMA2D can read or write pixels of the given color format
+ * @param cf    a color format
+ * @return      true: supported
+ */
+bool lv_draw_dma2d_cf_supported(lv_color_format_t cf);
+
+/**
+ * Check if DMA2D can address a buffer. The line offsets are set in pixels,
+ * so the stride needs to be a multiple of the pixel size.
+ * @param cf        color format of the buffer
+ * @param stride    stride of the buffer in bytes
+ * @return          true: supported
+ */
+bool lv_draw_dma2d_buf_supported(lv_color_format_t cf, uint32_t stride);
+
+/**
+ * Fill an area of a buffer with a color
+ * @param dest          pointer to the first pixel to fill
+ * @param dest_cf       color format of the buffer
+ * @param dest_stride   stride of the buffer in bytes
+ * @param w             width of the area in pixels
+ * @param h             height of the area in pixels
+ * @param color         the fill color
+ * @param opa           opacity of the color
+ */
+void lv_draw_dma2d_hw_fill(void * dest, lv_color_format_t dest_cf, uint32_t dest_stride,
+                           int32_t w, int32_t h, lv_color_t color, lv_opa_t opa);
+
+/**
+ * Copy or blend an image to a buffer, converting the color format
+ * @param dest          pointer to the first pixel to write
+ * @param dest_cf       color format of the buffer
+ * @param dest_stride   stride of the buffer in bytes
+ * @param src           pointer to the first pixel to read
+ * @param src_cf        color format of the image
+ * @param src_stride    stride of the image in bytes
+ * @param w             width of the area in pixels
+ * @param h             height of the area in pixels
+ * @param opa           opacity of the image
+ */
+void lv_draw_dma2d_hw_blend(void * dest, lv_color_format_t dest_cf, uint32_t dest_stride,
+                            const void * src, lv_color_format_t src_cf, uint32_t src_stride,
+                            int32_t w, int32_t h, lv_opa_t opa);
+
+/**
+ * Blend a color through an A8 mask (e.g. a glyph bitmap) to a buffer
+ * @param dest          pointer to the first pixel to write
+ * @param dest_cf       color format of the buffer
+ * @param dest_stride   stride of the buffer in bytes
+ * @param mask          pointer to the first mask pixel
+ * @param mask_stride   stride of the mask in bytes
+ * @param w             width of the area in pixels
+ * @param h             height of the area in pixels
+ * @param color         the color to blend
+ * @param opa           overall opacity
+ */
+void lv_draw_dma2d_hw_blend_a8(void * dest, lv_color_format_t dest_cf, uint32_t dest_stride,
+                               const uint8_t * mask, uint32_t mask_stride,
+                               int32_t w, int32_t h, lv_color_t color, lv_opa_t opa);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /*LV_USE_DRAW_DMA2D*/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_DRAW_DMA2D_H*/
@@ -0,0 +1,67 @@
+/**
+ * @file lv_draw_dma2d_fill.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_draw_dma2d.h"
+#if LV_USE_DRAW_DMA2D
+
+#include "../lv_draw_buf.h"
+#include "../../misc/lv_area_private.h"
+#include "../sw/lv_draw_sw.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_draw_dma2d_fill(lv_draw_unit_t * draw_unit, lv_draw_fill_dsc_t * dsc, const lv_area_t * coords)
+{
+    if(dsc->opa <= LV_OPA_MIN) return;
+
+    /*Rounded or gradient fills of labels (e.g. selection background) are drawn in software*/
+    if(dsc->radius != 0 || dsc->grad.dir != LV_GRAD_DIR_NONE) {
+        lv_draw_sw_fill(draw_unit, dsc, coords);
+        return;
+    }
+
+    lv_area_t blend_area;
+    if(!lv_area_intersect(&blend_area, coords, draw_unit->clip_area)) return;
+
+    lv_layer_t * layer = draw_unit->target_layer;
+    lv_draw_buf_t * draw_buf = layer->draw_buf;
+    lv_area_move(&blend_area, -layer->buf_area.x1, -layer->buf_area.y1);
+
+    lv_draw_dma2d_hw_fill(lv_draw_buf_goto_xy(draw_buf, blend_area.x1, blend_area.y1),
+                          draw_buf->header.cf, draw_buf->header.stride,
+                          lv_area_get_width(&blend_area), lv_area_get_height(&blend_area),
+                          dsc->color, dsc->opa);
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+#endif /*LV_USE_DRAW_DMA2D*/
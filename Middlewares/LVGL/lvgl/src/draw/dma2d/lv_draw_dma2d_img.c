@@ -0,0 +1,116 @@
+/**
+ * @file lv_draw_dma2d_img.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_draw_dma2d.h"
+#if LV_USE_DRAW_DMA2D
+
+#include "../lv_draw_image_private.h"
+#include "../lv_image_decoder_private.h"
+#include "../lv_draw_buf.h"
+#include "../../misc/lv_area_private.h"
+#include "../sw/blend/lv_draw_sw_blend_private.h"
+#include "../../stdlib/lv_string.h"
+#include "../../misc/lv_log.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+
+static void img_draw_core(lv_draw_unit_t * draw_unit, const lv_draw_image_dsc_t * draw_dsc,
+                          const lv_image_decoder_dsc_t * decoder_dsc, lv_draw_image_sup_t * sup,
+                          const lv_area_t * img_coords, const lv_area_t * clipped_img_area);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_draw_dma2d_image(lv_draw_unit_t * draw_unit, const lv_draw_image_dsc_t * dsc, const lv_area_t * coords)
+{
+    lv_draw_image_normal_helper(draw_unit, dsc, coords, img_draw_core);
+}
+
+void lv_draw_dma2d_layer(lv_draw_unit_t * draw_unit, const lv_draw_image_dsc_t * dsc, const lv_area_t * coords)
+{
+    lv_layer_t * layer_to_draw = (lv_layer_t *)dsc->src;
+
+    /*It can happen that nothing was draw on a layer and therefore its buffer is not allocated.
+     *In this case just return. */
+    if(layer_to_draw->draw_buf == NULL) return;
+
+    lv_draw_image_dsc_t new_draw_dsc = *dsc;
+    new_draw_dsc.src = layer_to_draw->draw_buf;
+    lv_draw_dma2d_image(draw_unit, &new_draw_dsc, coords);
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static void img_draw_core(lv_draw_unit_t * draw_unit, const lv_draw_image_dsc_t * draw_dsc,
+                          const lv_image_decoder_dsc_t * decoder_dsc, lv_draw_image_sup_t * sup,
+                          const lv_area_t * img_coords, const lv_area_t * clipped_img_area)
+{
+    LV_UNUSED(sup);
+
+    const lv_draw_buf_t * decoded = decoder_dsc->decoded;
+    lv_color_format_t cf = decoded->header.cf;
+    uint32_t img_stride = decoded->header.stride;
+
+    lv_area_t blend_area;
+    if(!lv_area_intersect(&blend_area, img_coords, clipped_img_area)) return;
+
+    /*The decoder might have converted the image to a format DMA2D can't read*/
+    if(!lv_draw_dma2d_buf_supported(cf, img_stride) || (decoded->header.flags & LV_IMAGE_FLAGS_PREMULTIPLIED)) {
+        /*The alpha plane of these would be read as pixels*/
+        if(cf == LV_COLOR_FORMAT_A8 || cf == LV_COLOR_FORMAT_RGB565A8) {
+            LV_LOG_WARN("Decoded color format %d is not supported", cf);
+            return;
+        }
+
+        lv_draw_sw_blend_dsc_t blend_dsc;
+        lv_memzero(&blend_dsc, sizeof(lv_draw_sw_blend_dsc_t));
+        blend_dsc.opa = draw_dsc->opa;
+        blend_dsc.blend_mode = draw_dsc->blend_mode;
+        blend_dsc.src_stride = img_stride;
+        blend_dsc.src_area = img_coords;
+        blend_dsc.src_buf = decoded->data;
+        blend_dsc.blend_area = &blend_area;
+        blend_dsc.src_color_format = cf;
+        lv_draw_sw_blend(draw_unit, &blend_dsc);
+        return;
+    }
+
+    lv_layer_t * layer = draw_unit->target_layer;
+    lv_draw_buf_t * draw_buf = layer->draw_buf;
+
+    const void * src = lv_draw_buf_goto_xy(decoded, blend_area.x1 - img_coords->x1, blend_area.y1 - img_coords->y1);
+    void * dest = lv_draw_buf_goto_xy(draw_buf, blend_area.x1 - layer->buf_area.x1, blend_area.y1 - layer->buf_area.y1);
+
+    lv_draw_dma2d_hw_blend(dest, draw_buf->header.cf, draw_buf->header.stride,
+                           src, cf, img_stride,
+                           lv_area_get_width(&blend_area), lv_area_get_height(&blend_area),
+                           draw_dsc->opa);
+}
+
+#endif /*LV_USE_DRAW_DMA2D*/
@@ -0,0 +1,125 @@
+/**
+ * @file lv_draw_dma2d_label.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_draw_dma2d.h"
+#if LV_USE_DRAW_DMA2D
+
+#include "../lv_draw_label_private.h"
+#include "../lv_draw_buf.h"
+#include "../../misc/lv_area_private.h"
+#include "../sw/lv_draw_sw.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+
+static void draw_letter_cb(lv_draw_unit_t * draw_unit, lv_draw_glyph_dsc_t * glyph_draw_dsc,
+                           lv_draw_fill_dsc_t * fill_draw_dsc, const lv_area_t * fill_area);
+
+static void draw_glyph(lv_draw_unit_t * draw_unit, lv_draw_glyph_dsc_t * glyph_draw_dsc);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_draw_dma2d_label(lv_draw_unit_t * draw_unit, const lv_draw_label_dsc_t * dsc, const lv_area_t * coords)
+{
+    if(dsc->opa <= LV_OPA_MIN) return;
+
+    LV_PROFILER_BEGIN;
+    lv_draw_label_iterate_characters(draw_unit, dsc, coords, draw_letter_cb);
+    LV_PROFILER_END;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static void draw_letter_cb(lv_draw_unit_t * draw_unit, lv_draw_glyph_dsc_t * glyph_draw_dsc,
+                           lv_draw_fill_dsc_t * fill_draw_dsc, const lv_area_t * fill_area)
+{
+    if(glyph_draw_dsc) {
+        switch(glyph_draw_dsc->format) {
+            case LV_FONT_GLYPH_FORMAT_NONE: {
+#if LV_USE_FONT_PLACEHOLDER
+                    /* Draw a placeholder rectangle*/
+                    lv_draw_border_dsc_t border_draw_dsc;
+                    lv_draw_border_dsc_init(&border_draw_dsc);
+                    border_draw_dsc.opa = glyph_draw_dsc->opa;
+                    border_draw_dsc.color = glyph_draw_dsc->color;
+                    border_draw_dsc.width = 1;
+                    lv_draw_sw_border(draw_unit, &border_draw_dsc, glyph_draw_dsc->bg_coords);
+#endif
+                }
+                break;
+            case LV_FONT_GLYPH_FORMAT_A1:
+            case LV_FONT_GLYPH_FORMAT_A2:
+            case LV_FONT_GLYPH_FORMAT_A4:
+            case LV_FONT_GLYPH_FORMAT_A8:
+                /*The bitmaps are always converted to A8*/
+                draw_glyph(draw_unit, glyph_draw_dsc);
+                break;
+            case LV_FONT_GLYPH_FORMAT_IMAGE: {
+#if LV_USE_IMGFONT
+                    lv_draw_image_dsc_t img_dsc;
+                    lv_draw_image_dsc_init(&img_dsc);
+                    img_dsc.opa = glyph_draw_dsc->opa;
+                    img_dsc.src = glyph_draw_dsc->glyph_data;
+                    lv_draw_sw_image(draw_unit, &img_dsc, glyph_draw_dsc->letter_coords);
+#endif
+                }
+                break;
+            default:
+                break;
+        }
+    }
+
+    if(fill_draw_dsc && fill_area) {
+        lv_draw_dma2d_fill(draw_unit, fill_draw_dsc, fill_area);
+    }
+}
+
+static void draw_glyph(lv_draw_unit_t * draw_unit, lv_draw_glyph_dsc_t * glyph_draw_dsc)
+{
+    const lv_area_t * letter_coords = glyph_draw_dsc->letter_coords;
+
+    lv_area_t blend_area;
+    if(!lv_area_intersect(&blend_area, letter_coords, draw_unit->clip_area)) return;
+
+    const lv_draw_buf_t * glyph_buf = glyph_draw_dsc->glyph_data;
+    uint32_t mask_stride = glyph_buf->header.stride;
+    const uint8_t * mask = glyph_buf->data;
+    mask += mask_stride * (blend_area.y1 - letter_coords->y1) + (blend_area.x1 - letter_coords->x1);
+
+    lv_layer_t * layer = draw_unit->target_layer;
+    lv_draw_buf_t * draw_buf = layer->draw_buf;
+    void * dest = lv_draw_buf_goto_xy(draw_buf, blend_area.x1 - layer->buf_area.x1, blend_area.y1 - layer->buf_area.y1);
+
+    lv_draw_dma2d_hw_blend_a8(dest, draw_buf->header.cf, draw_buf->header.stride,
+                              mask, mask_stride,
+                              lv_area_get_width(&blend_area), lv_area_get_height(&blend_area),
+                              glyph_draw_dsc->color, glyph_draw_dsc->opa);
+}
+
+#endif /*LV_USE_DRAW_DMA2D*/
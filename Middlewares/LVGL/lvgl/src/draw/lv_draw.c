@@ -12,6 +12,7 @@
  *********************/
 #include "../misc/lv_area_private.h"
 #include "lv_draw_private.h"
+#include "lv_draw_vector_private.h"
 #include "sw/lv_draw_sw.h"
 #include "../display/lv_display_private.h"
 #include "../core/lv_global.h"
@@ -23,14 +24,41 @@
  *********************/
 #define _draw_info LV_GLOBAL_DEFAULT()->draw_info
 
+/*The layer is divided into DEP_GRID_SIZE x DEP_GRID_SIZE cells to find the independent draw tasks*/
+#define DEP_GRID_SIZE 4
+
 /**********************
  *      TYPEDEFS
  **********************/
 
+/**
+ * A coarse grid over a layer. Each cell stores the bounding box of the
+ * not ready draw tasks' areas within that cell.
+ */
+typedef struct {
+    lv_area_t layer_area;
+    int32_t cell_w;
+    int32_t cell_h;
+    lv_area_t cells[DEP_GRID_SIZE * DEP_GRID_SIZE];
+    bool cell_used[DEP_GRID_SIZE * DEP_GRID_SIZE];
+} dep_grid_t;
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
-static bool is_independent(lv_layer_t * layer, lv_draw_task_t * t_check);
+static void dep_grid_init(dep_grid_t * grid, const lv_area_t * layer_area);
+static void dep_grid_add(dep_grid_t * grid, const lv_area_t * area);
+static bool dep_grid_is_on(const dep_grid_t * grid, const lv_area_t * area);
+static void dep_grid_get_cell_area(const dep_grid_t * grid, int32_t col, int32_t row, lv_area_t * cell_area);
+static void dep_grid_get_cell_range(const dep_grid_t * grid, const lv_area_t * area, int32_t * col1, int32_t * row1,
+                                    int32_t * col2, int32_t * row2);
+
+static void remove_ready_tasks(lv_display_t * disp, lv_layer_t * layer);
+static void task_free(lv_draw_task_t * t);
+#if LV_DRAW_TASK_ARENA_SIZE
+static inline void task_arena_enter(void);
+static inline void task_arena_leave(void);
+#endif
 
 static inline uint32_t get_layer_size_kb(uint32_t size_byte)
 {
@@ -57,6 +85,11 @@ void lv_draw_init(void)
 #if LV_USE_OS
     lv_thread_sync_init(&_draw_info.sync);
 #endif
+
+#if LV_DRAW_TASK_ARENA_SIZE
+    lv_arena_init(&_draw_info.task_arena, LV_DRAW_TASK_ARENA_SIZE);
+    lv_arena_set_chunk_max(&_draw_info.task_arena, LV_DRAW_TASK_ARENA_CHUNK_MAX);
+#endif
 }
 
 void lv_draw_deinit(void)
@@ -74,6 +107,11 @@ void lv_draw_deinit(void)
         lv_free(cur_unit);
     }
     _draw_info.unit_head = NULL;
+
+#if LV_DRAW_TASK_ARENA_SIZE
+    lv_arena_destroy(&_draw_info.task_arena);
+    _draw_info.task_cnt = 0;
+#endif
 }
 
 void * lv_draw_create_unit(size_t size)
@@ -90,7 +128,24 @@ void * lv_draw_create_unit(size_t size)
 lv_draw_task_t * lv_draw_add_task(lv_layer_t * layer, const lv_area_t * coords)
 {
     LV_PROFILER_BEGIN;
+#if LV_DRAW_TASK_ARENA_SIZE
+    task_arena_enter();
+    lv_draw_task_t * new_task = lv_arena_alloc(&_draw_info.task_arena, sizeof(lv_draw_task_t));
+    if(new_task) {
+        lv_memzero(new_task, sizeof(lv_draw_task_t));
+        _draw_info.task_cnt++;
+    }
+    task_arena_leave();
+
+    /*All chunks are used, e.g. some tasks are pending for long so the arena couldn't be reset*/
+    if(new_task == NULL) {
+        new_task = lv_malloc_zeroed(sizeof(lv_draw_task_t));
+        LV_ASSERT_MALLOC(new_task);
+        new_task->heap_allocated = 1;
+    }
+#else
     lv_draw_task_t * new_task = lv_malloc_zeroed(sizeof(lv_draw_task_t));
+#endif
 
     new_task->area = *coords;
     new_task->_real_area = *coords;
@@ -115,6 +170,28 @@ lv_draw_task_t * lv_draw_add_task(lv_layer_t * layer, const lv_area_t * coords)
     return new_task;
 }
 
+void * lv_draw_task_alloc_dsc(lv_draw_task_t * t, size_t size)
+{
+#if LV_DRAW_TASK_ARENA_SIZE
+    /*The descriptor of a task allocated with lv_malloc can't be in the arena as it can be reset before
+     *the task is freed*/
+    void * dsc = NULL;
+    if(!t->heap_allocated) {
+        task_arena_enter();
+        dsc = lv_arena_alloc(&_draw_info.task_arena, size);
+        task_arena_leave();
+    }
+
+    if(dsc) t->dsc_allocated = 1;
+    else dsc = lv_malloc(size);
+    LV_ASSERT_MALLOC(dsc);
+    return dsc;
+#else
+    LV_UNUSED(t);
+    return lv_malloc(size);
+#endif
+}
+
 void lv_draw_finalize_task_creation(lv_layer_t * layer, lv_draw_task_t * t)
 {
     LV_PROFILER_BEGIN;
@@ -159,6 +236,57 @@ void lv_draw_finalize_task_creation(lv_layer_t * layer, lv_draw_task_t * t)
     LV_PROFILER_END;
 }
 
+lv_draw_task_t * lv_draw_add_task_copy(lv_layer_t * layer, const lv_draw_task_t * t)
+{
+    LV_PROFILER_BEGIN;
+    lv_area_t clip_area;
+    if(!lv_area_intersect(&clip_area, &t->clip_area, &layer->_clip_area)) {
+        LV_PROFILER_END;
+        return NULL;
+    }
+
+    lv_draw_task_t * new_task = lv_draw_add_task(layer, &t->area);
+    new_task->type = t->type;
+    new_task->_real_area = t->_real_area;
+    new_task->clip_area_original = t->clip_area_original;
+    new_task->clip_area = clip_area;
+#if LV_DRAW_TRANSFORM_USE_MATRIX
+    new_task->matrix = t->matrix;
+#endif
+    new_task->preferred_draw_unit_id = t->preferred_draw_unit_id;
+    new_task->preference_score = t->preference_score;
+
+#if LV_USE_VECTOR_GRAPHIC
+    if(t->type == LV_DRAW_TASK_TYPE_VECTOR) {
+        /*Vector drawing finds its target through the descriptor so it needs its own copy.
+         *The task list in it is still owned by the original.*/
+        lv_draw_vector_task_dsc_t * dsc = lv_draw_task_alloc_dsc(new_task, sizeof(lv_draw_vector_task_dsc_t));
+        lv_memcpy(dsc, t->draw_dsc, sizeof(lv_draw_vector_task_dsc_t));
+        dsc->base.layer = layer;
+        new_task->draw_dsc = dsc;
+        LV_PROFILER_END;
+        return new_task;
+    }
+#endif
+
+    new_task->draw_dsc = t->draw_dsc;
+    new_task->dsc_shared = 1;
+
+    LV_PROFILER_END;
+    return new_task;
+}
+
+void lv_draw_discard_tasks(lv_display_t * disp, lv_layer_t * layer)
+{
+    lv_draw_task_t * t = layer->draw_task_head;
+    while(t) {
+        t->state = LV_DRAW_TASK_STATE_READY;
+        t = t->next;
+    }
+
+    remove_ready_tasks(disp, layer);
+}
+
 void lv_draw_wait_for_finish(void)
 {
 #if LV_USE_OS
@@ -196,58 +324,7 @@ bool lv_draw_dispatch_layer(lv_display_t * disp, lv_layer_t * layer)
 {
     LV_PROFILER_BEGIN;
     /*Remove the finished tasks first*/
-    lv_draw_task_t * t_prev = NULL;
-    lv_draw_task_t * t = layer->draw_task_head;
-    while(t) {
-        lv_draw_task_t * t_next = t->next;
-        if(t->state == LV_DRAW_TASK_STATE_READY) {
-            if(t_prev) t_prev->next = t->next;      /*Remove it by assigning the next task to the previous*/
-            else layer->draw_task_head = t_next;    /*If it was the head, set the next as head*/
-
-            /*If it was layer drawing free the layer too*/
-            if(t->type == LV_DRAW_TASK_TYPE_LAYER) {
-                lv_draw_image_dsc_t * draw_image_dsc = t->draw_dsc;
-                lv_layer_t * layer_drawn = (lv_layer_t *)draw_image_dsc->src;
-
-                if(layer_drawn->draw_buf) {
-                    int32_t h = lv_area_get_height(&layer_drawn->buf_area);
-                    uint32_t layer_size_byte = h * layer_drawn->draw_buf->header.stride;
-
-                    _draw_info.used_memory_for_layers_kb -= get_layer_size_kb(layer_size_byte);
-                    LV_LOG_INFO("Layer memory used: %" LV_PRIu32 " kB\n", _draw_info.used_memory_for_layers_kb);
-                    lv_draw_buf_destroy(layer_drawn->draw_buf);
-                    layer_drawn->draw_buf = NULL;
-                }
-
-                /*Remove the layer from  the display's*/
-                if(disp) {
-                    lv_layer_t * l2 = disp->layer_head;
-                    while(l2) {
-                        if(l2->next == layer_drawn) {
-                            l2->next = layer_drawn->next;
-                            break;
-                        }
-                        l2 = l2->next;
-                    }
-
-                    if(disp->layer_deinit) disp->layer_deinit(disp, layer_drawn);
-                    lv_free(layer_drawn);
-                }
-            }
-            lv_draw_label_dsc_t * draw_label_dsc = lv_draw_task_get_label_dsc(t);
-            if(draw_label_dsc && draw_label_dsc->text_local) {
-                lv_free((void *)draw_label_dsc->text);
-                draw_label_dsc->text = NULL;
-            }
-
-            lv_free(t->draw_dsc);
-            lv_free(t);
-        }
-        else {
-            t_prev = t;
-        }
-        t = t_next;
-    }
+    remove_ready_tasks(disp, layer);
 
     bool task_dispatched = false;
 
@@ -358,15 +435,29 @@ lv_draw_task_t * lv_draw_get_next_available_task(lv_layer_t * layer, lv_draw_tas
         }
     }
 
-    lv_draw_task_t * t = t_prev ? t_prev->next : layer->draw_task_head;
+    /*Collect the areas of the not ready tasks in a grid while iterating, so checking
+     *if a task is independent from the older ones takes only a few cell tests*/
+    dep_grid_t grid;
+    dep_grid_init(&grid, &layer->buf_area);
+
+    lv_draw_task_t * t_start = t_prev ? t_prev->next : layer->draw_task_head;
+    bool started = false;
+    lv_draw_task_t * t = layer->draw_task_head;
     while(t) {
+        if(t == t_start) started = true;
+
         /*Find a queued and independent task*/
-        if(t->state == LV_DRAW_TASK_STATE_QUEUED &&
+        if(started && t->state == LV_DRAW_TASK_STATE_QUEUED &&
            (t->preferred_draw_unit_id == LV_DRAW_UNIT_NONE || t->preferred_draw_unit_id == draw_unit_id) &&
-           is_independent(layer, t)) {
+           !dep_grid_is_on(&grid, &t->_real_area)) {
             LV_PROFILER_END;
             return t;
         }
+
+        /*The newer tasks can't overlap with this one*/
+        if(t->state != LV_DRAW_TASK_STATE_READY) {
+            dep_grid_add(&grid, &t->_real_area);
+        }
         t = t->next;
     }
 
@@ -478,28 +569,206 @@ void lv_draw_task_get_area(const lv_draw_task_t * t, lv_area_t * area)
  **********************/
 
 /**
- * Check if there are older draw task overlapping the area of `t_check`
- * @param layer      the draw ctx to search in
- * @param t_check       check this task if it overlaps with the older ones
- * @return              true: `t_check` is not overlapping with older tasks so it's independent
+ * Remove and free the ready draw tasks of a layer
+ * @param disp      pointer to the display of the layer
+ * @param layer     pointer to a layer
  */
-static bool is_independent(lv_layer_t * layer, lv_draw_task_t * t_check)
+static void remove_ready_tasks(lv_display_t * disp, lv_layer_t * layer)
 {
-    LV_PROFILER_BEGIN;
+    lv_draw_task_t * t_prev = NULL;
     lv_draw_task_t * t = layer->draw_task_head;
+    while(t) {
+        lv_draw_task_t * t_next = t->next;
+        if(t->state == LV_DRAW_TASK_STATE_READY) {
+            if(t_prev) t_prev->next = t->next;      /*Remove it by assigning the next task to the previous*/
+            else layer->draw_task_head = t_next;    /*If it was the head, set the next as head*/
 
-    /*If t_check is outside of the older tasks then it's independent*/
-    while(t && t != t_check) {
-        if(t->state != LV_DRAW_TASK_STATE_READY) {
+            /*If it was layer drawing free the layer too (unless it's only a copy of the task)*/
+            if(t->type == LV_DRAW_TASK_TYPE_LAYER && !t->dsc_shared) {
+                lv_draw_image_dsc_t * draw_image_dsc = t->draw_dsc;
+                lv_layer_t * layer_drawn = (lv_layer_t *)draw_image_dsc->src;
+
+                if(layer_drawn->draw_buf) {
+                    int32_t h = lv_area_get_height(&layer_drawn->buf_area);
+                    uint32_t layer_size_byte = h * layer_drawn->draw_buf->header.stride;
+
+                    _draw_info.used_memory_for_layers_kb -= get_layer_size_kb(layer_size_byte);
+                    LV_LOG_INFO("Layer memory used: %" LV_PRIu32 " kB\n", _draw_info.used_memory_for_layers_kb);
+                    lv_draw_buf_destroy(layer_drawn->draw_buf);
+                    layer_drawn->draw_buf = NULL;
+                }
+
+                /*Remove the layer from  the display's*/
+                if(disp) {
+                    lv_layer_t * l2 = disp->layer_head;
+                    while(l2) {
+                        if(l2->next == layer_drawn) {
+                            l2->next = layer_drawn->next;
+                            break;
+                        }
+                        l2 = l2->next;
+                    }
+
+                    if(disp->layer_deinit) disp->layer_deinit(disp, layer_drawn);
+                    lv_free(layer_drawn);
+                }
+            }
+            lv_draw_label_dsc_t * draw_label_dsc = lv_draw_task_get_label_dsc(t);
+            if(draw_label_dsc && draw_label_dsc->text_local && !t->dsc_shared) {
+                lv_free((void *)draw_label_dsc->text);
+                draw_label_dsc->text = NULL;
+            }
+
+            task_free(t);
+        }
+        else {
+            t_prev = t;
+        }
+        t = t_next;
+    }
+}
+
+static void task_free(lv_draw_task_t * t)
+{
+#if LV_DRAW_TASK_ARENA_SIZE
+    if(!t->dsc_allocated && !t->dsc_shared) lv_free(t->draw_dsc);
+
+    if(t->heap_allocated) {
+        lv_free(t);
+        return;
+    }
+
+    /*The draw tasks are freed in any order, but they all live only until the layers are rendered.
+     *So free their memory at once when the last one is freed.*/
+    task_arena_enter();
+    LV_ASSERT(_draw_info.task_cnt > 0);
+    _draw_info.task_cnt--;
+    if(_draw_info.task_cnt == 0) lv_arena_reset(&_draw_info.task_arena);
+    task_arena_leave();
+#else
+    if(!t->dsc_shared) lv_free(t->draw_dsc);
+    lv_free(t);
+#endif
+}
+
+#if LV_DRAW_TASK_ARENA_SIZE
+/*The task arena isn't locked: the draw tasks are created and freed only in LVGL's thread
+ *(from `lv_timer_handler()` or holding `lv_lock()`). Catch the calls from other threads when they overlap.*/
+static inline void task_arena_enter(void)
+{
+#if LV_USE_OS
+    LV_ASSERT_MSG(_draw_info.task_arena_busy == 0, "Draw tasks are created or freed in more threads");
+    _draw_info.task_arena_busy = 1;
+#endif
+}
+
+static inline void task_arena_leave(void)
+{
+#if LV_USE_OS
+    _draw_info.task_arena_busy = 0;
+#endif
+}
+#endif
+
+/**
+ * Initialize a dependency grid
+ * @param grid          pointer to a grid to initialize
+ * @param layer_area    the area of the layer to divide into cells
+ */
+static void dep_grid_init(dep_grid_t * grid, const lv_area_t * layer_area)
+{
+    grid->layer_area = *layer_area;
+    grid->cell_w = LV_MAX(1, (lv_area_get_width(layer_area) + DEP_GRID_SIZE - 1) / DEP_GRID_SIZE);
+    grid->cell_h = LV_MAX(1, (lv_area_get_height(layer_area) + DEP_GRID_SIZE - 1) / DEP_GRID_SIZE);
+    lv_memzero(grid->cell_used, sizeof(grid->cell_used));
+}
+
+/**
+ * Add the area of a not ready draw task to the cells it touches
+ * @param grid      pointer to a grid
+ * @param area      the area to add
+ */
+static void dep_grid_add(dep_grid_t * grid, const lv_area_t * area)
+{
+    int32_t col1, row1, col2, row2;
+    dep_grid_get_cell_range(grid, area, &col1, &row1, &col2, &row2);
+
+    int32_t row;
+    int32_t col;
+    for(row = row1; row <= row2; row++) {
+        for(col = col1; col <= col2; col++) {
+            lv_area_t cell_area;
             lv_area_t a;
-            if(lv_area_intersect(&a, &t->_real_area, &t_check->_real_area)) {
-                LV_PROFILER_END;
-                return false;
+            dep_grid_get_cell_area(grid, col, row, &cell_area);
+            if(!lv_area_intersect(&a, area, &cell_area)) continue;
+
+            uint32_t i = row * DEP_GRID_SIZE + col;
+            if(grid->cell_used[i]) {
+                lv_area_join(&grid->cells[i], &grid->cells[i], &a);
+            }
+            else {
+                grid->cells[i] = a;
+                grid->cell_used[i] = true;
             }
         }
-        t = t->next;
     }
-    LV_PROFILER_END;
+}
+
+/**
+ * Check if an area overlaps with the areas added to the grid.
+ * As the cells store only bounding boxes it might report overlapping for
+ * an independent area but never the opposite.
+ * @param grid      pointer to a grid
+ * @param area      the area to check
+ * @return          true: the area might overlap with an added area
+ */
+static bool dep_grid_is_on(const dep_grid_t * grid, const lv_area_t * area)
+{
+    int32_t col1, row1, col2, row2;
+    dep_grid_get_cell_range(grid, area, &col1, &row1, &col2, &row2);
+
+    int32_t row;
+    int32_t col;
+    for(row = row1; row <= row2; row++) {
+        for(col = col1; col <= col2; col++) {
+            uint32_t i = row * DEP_GRID_SIZE + col;
+            if(grid->cell_used[i] && lv_area_is_on(&grid->cells[i], area)) return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * Get the area of a cell. The cells on the edges are extended to infinity
+ * to cover the draw tasks reaching out of the layer too (e.g. shadows).
+ * @param grid          pointer to a grid
+ * @param col           column index of the cell
+ * @param row           row index of the cell
+ * @param cell_area     store the area of the cell here
+ */
+static void dep_grid_get_cell_area(const dep_grid_t * grid, int32_t col, int32_t row, lv_area_t * cell_area)
+{
+    cell_area->x1 = col == 0 ? LV_COORD_MIN : grid->layer_area.x1 + col * grid->cell_w;
+    cell_area->x2 = col == DEP_GRID_SIZE - 1 ? LV_COORD_MAX : grid->layer_area.x1 + (col + 1) * grid->cell_w - 1;
+    cell_area->y1 = row == 0 ? LV_COORD_MIN : grid->layer_area.y1 + row * grid->cell_h;
+    cell_area->y2 = row == DEP_GRID_SIZE - 1 ? LV_COORD_MAX : grid->layer_area.y1 + (row + 1) * grid->cell_h - 1;
+}
 
-    return true;
+/**
+ * Get the range of cells an area touches
+ * @param grid      pointer to a grid
+ * @param area      the area
+ * @param col1      store the first column here
+ * @param row1      store the first row here
+ * @param col2      store the last column here
+ * @param row2      store the last row here
+ */
+static void dep_grid_get_cell_range(const dep_grid_t * grid, const lv_area_t * area, int32_t * col1, int32_t * row1,
+                                    int32_t * col2, int32_t * row2)
+{
+    *col1 = LV_CLAMP(0, (area->x1 - grid->layer_area.x1) / grid->cell_w, DEP_GRID_SIZE - 1);
+    *col2 = LV_CLAMP(0, (area->x2 - grid->layer_area.x1) / grid->cell_w, DEP_GRID_SIZE - 1);
+    *row1 = LV_CLAMP(0, (area->y1 - grid->layer_area.y1) / grid->cell_h, DEP_GRID_SIZE - 1);
+    *row2 = LV_CLAMP(0, (area->y2 - grid->layer_area.y1) / grid->cell_h, DEP_GRID_SIZE - 1);
 }
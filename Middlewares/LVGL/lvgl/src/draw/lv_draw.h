@@ -147,6 +147,15 @@ void * lv_draw_create_unit(size_t size);
  */
 lv_draw_task_t * lv_draw_add_task(lv_layer_t * layer, const lv_area_t * coords);
 
+/**
+ * Allocate the draw descriptor of a draw task. The memory is freed with the draw task
+ * so it shouldn't be freed manually.
+ * @param t         pointer to a draw task created by `lv_draw_add_task()`
+ * @param size      size of the draw descriptor in bytes. E.g. `sizeof(lv_draw_fill_dsc_t)`
+ * @return          pointer to the allocated memory, it's not initialized
+ */
+void * lv_draw_task_alloc_dsc(lv_draw_task_t * t, size_t size);
+
 /**
  * Needs to be called when a draw task is created and configured.
  * It will send an event about the new draw task to the widget
@@ -156,6 +165,23 @@ lv_draw_task_t * lv_draw_add_task(lv_layer_t * layer, const lv_area_t * coords);
  */
 void lv_draw_finalize_task_creation(lv_layer_t * layer, lv_draw_task_t * t);
 
+/**
+ * Add a copy of a draw task to an other layer, clipped to the clip area of the layer.
+ * The copy uses the draw descriptor of the original draw task, so it doesn't need to be finalized,
+ * but the original needs to be kept until the copy is ready.
+ * @param layer     pointer to a layer
+ * @param t         pointer to a finalized draw task of an other layer
+ * @return          the new draw task or NULL if the draw task is out of the clip area of the layer
+ */
+lv_draw_task_t * lv_draw_add_task_copy(lv_layer_t * layer, const lv_draw_task_t * t);
+
+/**
+ * Remove all draw tasks of a layer without drawing them
+ * @param disp      pointer to the display of the layer
+ * @param layer     pointer to a layer
+ */
+void lv_draw_discard_tasks(lv_display_t * disp, lv_layer_t * layer);
+
 /**
  * Try dispatching draw tasks to draw units
  */
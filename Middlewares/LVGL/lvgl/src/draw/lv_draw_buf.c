@@ -19,15 +19,33 @@
 #define default_handlers LV_GLOBAL_DEFAULT()->draw_buf_handlers
 #define font_draw_buf_handlers LV_GLOBAL_DEFAULT()->font_draw_buf_handlers
 #define image_cache_draw_buf_handlers LV_GLOBAL_DEFAULT()->image_cache_draw_buf_handlers
+#define pool LV_GLOBAL_DEFAULT()->draw_buf_pool
+
+/*Smaller buffers are not kept in the pool as allocating them is cheap and doesn't fragment the memory*/
+#define POOL_MIN_SIZE   1024
+
+/*Smaller buffers (e.g. glyphs and short labels) are allocated in the fast memory. They are written and read
+ *right away, so the slower bulk memory would cost more than the little space they take in the fast one.*/
+#define BULK_MIN_SIZE   1024
 
 /**********************
  *      TYPEDEFS
  **********************/
 
+#if LV_DRAW_BUF_POOL_SIZE
+/*Stored in front of the pixel buffers allocated by the default handlers*/
+typedef struct lv_draw_buf_pool_header_t {
+    struct lv_draw_buf_pool_header_t * next;    /*The next less recently freed buffer while this one is idle*/
+    struct lv_draw_buf_pool_header_t * prev;    /*The next more recently freed buffer while this one is idle*/
+    size_t size;                                /*Size of the buffer after the header*/
+} lv_draw_buf_pool_header_t;
+#endif
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
 static void * buf_malloc(size_t size, lv_color_format_t color_format);
+static lv_mem_placement_t buf_placement(size_t size);
 static void buf_free(void * buf);
 static void * buf_align(void * buf, lv_color_format_t color_format);
 static void * draw_buf_malloc(const lv_draw_buf_handlers_t * handler, size_t size_bytes,
@@ -36,6 +54,13 @@ static void draw_buf_free(const lv_draw_buf_handlers_t * handler, void * buf);
 static uint32_t width_to_stride(uint32_t w, lv_color_format_t color_format);
 static uint32_t _calculate_draw_buf_size(uint32_t w, uint32_t h, lv_color_format_t cf, uint32_t stride);
 static void draw_buf_get_full_area(const lv_draw_buf_t * draw_buf, lv_area_t * full_area);
+#if LV_DRAW_BUF_POOL_SIZE
+static size_t pool_class_size(size_t size);
+static void * pool_alloc(size_t size);
+static bool pool_reclaim(void);
+static void pool_free(void * buf);
+static void pool_release(size_t max_size);
+#endif
 
 /**********************
  *  STATIC VARIABLES
@@ -78,6 +103,53 @@ void lv_draw_buf_handlers_init(lv_draw_buf_handlers_t * handlers,
     handlers->width_to_stride_cb = width_to_stride_cb;
 }
 
+void lv_draw_buf_pool_init(void)
+{
+#if LV_DRAW_BUF_POOL_SIZE
+#if LV_USE_OS
+    lv_mutex_init(&pool.mutex);
+#endif
+    /*If an allocation fails free the kept buffers and try again*/
+    lv_mem_set_reclaim_cb(pool_reclaim);
+#endif
+}
+
+void lv_draw_buf_pool_deinit(void)
+{
+#if LV_DRAW_BUF_POOL_SIZE
+    lv_mem_set_reclaim_cb(NULL);
+    lv_draw_buf_pool_trim();
+#if LV_USE_OS
+    lv_mutex_delete(&pool.mutex);
+#endif
+#endif
+}
+
+#if LV_DRAW_BUF_POOL_SIZE
+void lv_draw_buf_pool_get_stat(lv_draw_buf_pool_stat_t * stat)
+{
+    *stat = pool.stat;
+}
+
+void lv_draw_buf_pool_reset_stat(void)
+{
+    pool.stat.hit_cnt = 0;
+    pool.stat.miss_cnt = 0;
+    pool.stat.reclaim_cnt = 0;
+}
+
+void lv_draw_buf_pool_trim(void)
+{
+#if LV_USE_OS
+    lv_mutex_lock(&pool.mutex);
+#endif
+    pool_release(0);
+#if LV_USE_OS
+    lv_mutex_unlock(&pool.mutex);
+#endif
+}
+#endif
+
 lv_draw_buf_handlers_t * lv_draw_buf_get_handlers(void)
 {
     return &default_handlers;
@@ -600,12 +672,25 @@ static void * buf_malloc(size_t size_bytes, lv_color_format_t color_format)
 
     /*Allocate larger memory to be sure it can be aligned as needed*/
     size_bytes += LV_DRAW_BUF_ALIGN - 1;
-    return lv_malloc(size_bytes);
+#if LV_DRAW_BUF_POOL_SIZE
+    return pool_alloc(size_bytes);
+#else
+    return lv_malloc_placed(size_bytes, buf_placement(size_bytes));
+#endif
+}
+
+static lv_mem_placement_t buf_placement(size_t size)
+{
+    return size >= BULK_MIN_SIZE ? LV_MEM_PLACEMENT_BULK : LV_MEM_PLACEMENT_FAST;
 }
 
 static void buf_free(void * buf)
 {
+#if LV_DRAW_BUF_POOL_SIZE
+    pool_free(buf);
+#else
     lv_free(buf);
+#endif
 }
 
 static void * buf_align(void * buf, lv_color_format_t color_format)
@@ -667,3 +752,143 @@ static void draw_buf_get_full_area(const lv_draw_buf_t * draw_buf, lv_area_t * f
     const lv_image_header_t * header = &draw_buf->header;
     lv_area_set(full_area, 0, 0, header->w - 1, header->h - 1);
 }
+
+#if LV_DRAW_BUF_POOL_SIZE
+
+/**
+ * Round up a size to a size class. There are 4 classes between the powers of 2,
+ * e.g. 1280, 1536, 1792 and 2048, so at most 25% is wasted.
+ * The size already reflects the stride and the color format, so buffers with different
+ * shape or format but similar size can be reused for each other.
+ * @param size      the requested size in bytes
+ * @return          the size of the class
+ */
+static size_t pool_class_size(size_t size)
+{
+    size_t step = 16;
+    while(size > (step << 3)) step <<= 1;
+    return (size + step - 1) & ~(step - 1);
+}
+
+static void * pool_alloc(size_t size)
+{
+    lv_draw_buf_pool_header_t * h;
+    if(size >= POOL_MIN_SIZE) {
+        size = pool_class_size(size);
+
+#if LV_USE_OS
+        lv_mutex_lock(&pool.mutex);
+#endif
+        /*Reuse the most recently freed buffer of the same class as it's the most likely to be in the cache*/
+        h = pool.idle_head;
+        while(h && h->size != size) h = h->next;
+
+        if(h) {
+            if(h->prev) h->prev->next = h->next;
+            else pool.idle_head = h->next;
+            if(h->next) h->next->prev = h->prev;
+            else pool.idle_tail = h->prev;
+
+            pool.stat.idle_size -= size;
+            pool.stat.idle_cnt--;
+            pool.stat.used_size += size;
+            pool.stat.hit_cnt++;
+        }
+        else {
+            pool.stat.miss_cnt++;
+        }
+#if LV_USE_OS
+        lv_mutex_unlock(&pool.mutex);
+#endif
+        if(h) return h + 1;
+    }
+
+    /*If there is not enough memory `lv_malloc_placed()` frees the kept buffers and tries again*/
+    h = lv_malloc_placed(sizeof(lv_draw_buf_pool_header_t) + size, buf_placement(size));
+    if(h == NULL) return NULL;
+
+    h->size = size;
+#if LV_USE_OS
+    lv_mutex_lock(&pool.mutex);
+#endif
+    pool.stat.used_size += size;
+#if LV_USE_OS
+    lv_mutex_unlock(&pool.mutex);
+#endif
+
+    return h + 1;
+}
+
+/**
+ * Free the kept buffers after a failed allocation. Registered by `lv_draw_buf_pool_init()`.
+ * @return      true: some memory was freed so the allocation can be tried again
+ */
+static bool pool_reclaim(void)
+{
+#if LV_USE_OS
+    lv_mutex_lock(&pool.mutex);
+#endif
+    bool freed = pool.idle_head != NULL;
+    if(freed) {
+        pool_release(0);
+        pool.stat.reclaim_cnt++;
+    }
+#if LV_USE_OS
+    lv_mutex_unlock(&pool.mutex);
+#endif
+    return freed;
+}
+
+static void pool_free(void * buf)
+{
+    if(buf == NULL) return;
+
+    lv_draw_buf_pool_header_t * h = (lv_draw_buf_pool_header_t *)buf - 1;
+
+#if LV_USE_OS
+    lv_mutex_lock(&pool.mutex);
+#endif
+
+    pool.stat.used_size -= h->size;
+    if(h->size < POOL_MIN_SIZE || h->size > LV_DRAW_BUF_POOL_SIZE) {
+        lv_free(h);
+    }
+    else {
+        /*Make room by dropping the least recently freed buffers*/
+        pool_release(LV_DRAW_BUF_POOL_SIZE - h->size);
+
+        h->prev = NULL;
+        h->next = pool.idle_head;
+        if(pool.idle_head) pool.idle_head->prev = h;
+        else pool.idle_tail = h;
+        pool.idle_head = h;
+
+        pool.stat.idle_size += h->size;
+        pool.stat.idle_cnt++;
+    }
+
+#if LV_USE_OS
+    lv_mutex_unlock(&pool.mutex);
+#endif
+}
+
+/**
+ * Free the least recently freed idle buffers until their total size is not larger than `max_size`.
+ * The pool needs to be locked.
+ * @param max_size      the size to keep in bytes
+ */
+static void pool_release(size_t max_size)
+{
+    while(pool.stat.idle_size > max_size) {
+        lv_draw_buf_pool_header_t * h = pool.idle_tail;
+        pool.idle_tail = h->prev;
+        if(h->prev) h->prev->next = NULL;
+        else pool.idle_head = NULL;
+
+        pool.stat.idle_size -= h->size;
+        pool.stat.idle_cnt--;
+        lv_free(h);
+    }
+}
+
+#endif /*LV_DRAW_BUF_POOL_SIZE*/
@@ -93,6 +93,18 @@ struct lv_draw_buf_t {
     const lv_draw_buf_handlers_t * handlers; /**< draw buffer alloc/free ops. */
 };
 
+#if LV_DRAW_BUF_POOL_SIZE
+/** Usage of the pixel buffers allocated by the default draw buffer handlers*/
+typedef struct {
+    size_t used_size;       /**< Size of the buffers in use in bytes*/
+    size_t idle_size;       /**< Size of the freed buffers kept for reuse in bytes*/
+    uint32_t idle_cnt;      /**< Number of the freed buffers kept for reuse*/
+    uint32_t hit_cnt;       /**< Number of allocations served by a kept buffer since the last stat reset*/
+    uint32_t miss_cnt;      /**< Number of allocations which needed new memory since the last stat reset*/
+    uint32_t reclaim_cnt;   /**< Number of times a failed allocation freed the kept buffers since the last stat reset*/
+} lv_draw_buf_pool_stat_t;
+#endif
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -334,6 +346,24 @@ void lv_draw_buf_to_image(const lv_draw_buf_t * buf, lv_image_dsc_t * img);
  */
 void lv_draw_buf_set_palette(lv_draw_buf_t * draw_buf, uint8_t index, lv_color32_t color);
 
+#if LV_DRAW_BUF_POOL_SIZE
+/**
+ * Get the usage of the pixel buffers allocated by the default draw buffer handlers
+ * @param stat      store the result here
+ */
+void lv_draw_buf_pool_get_stat(lv_draw_buf_pool_stat_t * stat);
+
+/**
+ * Reset the allocation counters of the draw buffer pool
+ */
+void lv_draw_buf_pool_reset_stat(void);
+
+/**
+ * Free all the draw buffers kept for reuse, e.g. before a memory hungry operation
+ */
+void lv_draw_buf_pool_trim(void);
+#endif
+
 /**
  * @deprecated Use lv_draw_buf_set_palette instead.
  */
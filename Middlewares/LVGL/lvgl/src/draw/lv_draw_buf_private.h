@@ -15,6 +15,7 @@ extern "C" {
  *********************/
 
 #include "lv_draw_buf.h"
+#include "../osal/lv_os.h"
 
 /*********************
  *      DEFINES
@@ -33,6 +34,18 @@ struct lv_draw_buf_handlers_t {
     lv_draw_buf_width_to_stride_cb width_to_stride_cb;
 };
 
+#if LV_DRAW_BUF_POOL_SIZE
+/** The pixel buffers freed by the default draw buffer handlers and kept for reuse*/
+typedef struct {
+    struct lv_draw_buf_pool_header_t * idle_head;   /**< The most recently freed buffer*/
+    struct lv_draw_buf_pool_header_t * idle_tail;   /**< The least recently freed buffer, it's dropped first*/
+    lv_draw_buf_pool_stat_t stat;
+#if LV_USE_OS
+    lv_mutex_t mutex;
+#endif
+} lv_draw_buf_pool_t;
+#endif
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -42,6 +55,16 @@ struct lv_draw_buf_handlers_t {
  */
 void lv_draw_buf_init_handlers(void);
 
+/**
+ * Called internally to initialize the pool of the draw buffers
+ */
+void lv_draw_buf_pool_init(void);
+
+/**
+ * Called internally to free the draw buffers kept in the pool
+ */
+void lv_draw_buf_pool_deinit(void);
+
 /**********************
  *      MACROS
  **********************/
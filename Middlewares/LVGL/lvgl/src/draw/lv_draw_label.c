@@ -38,6 +38,10 @@
  **********************/
 static void draw_letter(lv_draw_unit_t * draw_unit, lv_draw_glyph_dsc_t * dsc,  const lv_point_t * pos,
                         const lv_font_t * font, uint32_t letter, lv_draw_glyph_cb_t cb);
+static inline uint32_t get_line_end(const lv_draw_label_dsc_t * dsc, const lv_draw_label_layout_t * layout,
+                                    uint32_t line_i, uint32_t line_start, int32_t w);
+static inline int32_t get_line_width(const lv_draw_label_dsc_t * dsc, const lv_draw_label_layout_t * layout,
+                                     uint32_t line_i, uint32_t line_start, uint32_t line_end);
 
 /**********************
  *  STATIC VARIABLES
@@ -92,7 +96,7 @@ void LV_ATTRIBUTE_FAST_MEM lv_draw_label(lv_layer_t * layer, const lv_draw_label
     LV_PROFILER_BEGIN;
     lv_draw_task_t * t = lv_draw_add_task(layer, coords);
 
-    t->draw_dsc = lv_malloc(sizeof(*dsc));
+    t->draw_dsc = lv_draw_task_alloc_dsc(t, sizeof(*dsc));
     lv_memcpy(t->draw_dsc, dsc, sizeof(*dsc));
     t->type = LV_DRAW_TASK_TYPE_LABEL;
 
@@ -162,10 +166,21 @@ void lv_draw_label_iterate_characters(lv_draw_unit_t * draw_unit, const lv_draw_
 
     lv_bidi_calculate_align(&align, &base_dir, dsc->text);
 
+    /*Use the lines measured in advance if they belong to this text*/
+    const lv_draw_label_layout_t * layout = dsc->layout;
+    if(layout && !lv_draw_label_layout_is_valid(layout, dsc->text, font, dsc->letter_space, lv_area_get_width(coords),
+                                                dsc->flag)) {
+        layout = NULL;
+    }
+
     if((dsc->flag & LV_TEXT_FLAG_EXPAND) == 0) {
         /*Normally use the label's width as width*/
         w = lv_area_get_width(coords);
     }
+    else if(layout) {
+        /*The lines are not wrapped so the width is not used*/
+        w = LV_COORD_MAX;
+    }
     else {
         /*If EXPAND is enabled then not limit the text's width to the object's width*/
         lv_point_t p;
@@ -189,10 +204,11 @@ void lv_draw_label_iterate_characters(lv_draw_unit_t * draw_unit, const lv_draw_
     pos.y += y_ofs;
 
     uint32_t line_start     = 0;
+    uint32_t line_i         = 0;
     int32_t last_line_start = -1;
 
-    /*Check the hint to use the cached info*/
-    if(dsc->hint && y_ofs == 0 && coords->y1 < 0) {
+    /*Check the hint to use the cached info. With a layout skipping the lines is fast anyway.*/
+    if(dsc->hint && layout == NULL && y_ofs == 0 && coords->y1 < 0) {
         /*If the label changed too much recalculate the hint.*/
         if(LV_ABS(dsc->hint->coord_y - coords->y1) > LV_LABEL_HINT_UPDATE_TH - 2 * line_height) {
             dsc->hint->line_start = -1;
@@ -206,18 +222,18 @@ void lv_draw_label_iterate_characters(lv_draw_unit_t * draw_unit, const lv_draw_
         pos.y += dsc->hint->y;
     }
 
-    uint32_t line_end = line_start + lv_text_get_next_line(&dsc->text[line_start], font, dsc->letter_space, w, NULL,
-                                                           dsc->flag);
+    uint32_t line_end = get_line_end(dsc, layout, line_i, line_start, w);
 
     /*Go the first visible line*/
     while(pos.y + line_height_font < draw_unit->clip_area->y1) {
         /*Go to next line*/
         line_start = line_end;
-        line_end += lv_text_get_next_line(&dsc->text[line_start], font, dsc->letter_space, w, NULL, dsc->flag);
+        line_i++;
+        line_end = get_line_end(dsc, layout, line_i, line_start, w);
         pos.y += line_height;
 
         /*Save at the threshold coordinate*/
-        if(dsc->hint && pos.y >= -LV_LABEL_HINT_UPDATE_TH && dsc->hint->line_start < 0) {
+        if(dsc->hint && layout == NULL && pos.y >= -LV_LABEL_HINT_UPDATE_TH && dsc->hint->line_start < 0) {
             dsc->hint->line_start = line_start;
             dsc->hint->y          = pos.y - coords->y1;
             dsc->hint->coord_y    = coords->y1;
@@ -228,14 +244,14 @@ void lv_draw_label_iterate_characters(lv_draw_unit_t * draw_unit, const lv_draw_
 
     /*Align to middle*/
     if(align == LV_TEXT_ALIGN_CENTER) {
-        line_width = lv_text_get_width(&dsc->text[line_start], line_end - line_start, font, dsc->letter_space);
+        line_width = get_line_width(dsc, layout, line_i, line_start, line_end);
 
         pos.x += (lv_area_get_width(coords) - line_width) / 2;
 
     }
     /*Align to the right*/
     else if(align == LV_TEXT_ALIGN_RIGHT) {
-        line_width = lv_text_get_width(&dsc->text[line_start], line_end - line_start, font, dsc->letter_space);
+        line_width = get_line_width(dsc, layout, line_i, line_start, line_end);
         pos.x += lv_area_get_width(coords) - line_width;
     }
 
@@ -346,20 +362,19 @@ void lv_draw_label_iterate_characters(lv_draw_unit_t * draw_unit, const lv_draw_
 #endif
         /*Go to next line*/
         line_start = line_end;
-        line_end += lv_text_get_next_line(&dsc->text[line_start], font, dsc->letter_space, w, NULL, dsc->flag);
+        line_i++;
+        line_end = get_line_end(dsc, layout, line_i, line_start, w);
 
         pos.x = coords->x1;
         /*Align to middle*/
         if(align == LV_TEXT_ALIGN_CENTER) {
-            line_width =
-                lv_text_get_width(&dsc->text[line_start], line_end - line_start, font, dsc->letter_space);
+            line_width = get_line_width(dsc, layout, line_i, line_start, line_end);
 
             pos.x += (lv_area_get_width(coords) - line_width) / 2;
         }
         /*Align to the right*/
         else if(align == LV_TEXT_ALIGN_RIGHT) {
-            line_width =
-                lv_text_get_width(&dsc->text[line_start], line_end - line_start, font, dsc->letter_space);
+            line_width = get_line_width(dsc, layout, line_i, line_start, line_end);
             pos.x += lv_area_get_width(coords) - line_width;
         }
 
@@ -374,10 +389,158 @@ void lv_draw_label_iterate_characters(lv_draw_unit_t * draw_unit, const lv_draw_
     LV_ASSERT_MEM_INTEGRITY();
 }
 
+void lv_draw_label_layout_init(lv_draw_label_layout_t * layout)
+{
+    lv_memzero(layout, sizeof(lv_draw_label_layout_t));
+}
+
+void lv_draw_label_layout_update(lv_draw_label_layout_t * layout, const char * text, const lv_font_t * font,
+                                 int32_t letter_space, int32_t max_width, lv_text_flag_t flag)
+{
+    if(lv_draw_label_layout_is_valid(layout, text, font, letter_space, max_width, flag)) return;
+
+    LV_PROFILER_BEGIN;
+    layout->text = NULL;
+    layout->line_cnt = 0;
+    layout->max_line_width = 0;
+
+    if(text == NULL || font == NULL) {
+        LV_PROFILER_END;
+        return;
+    }
+
+    /*The same as in `lv_text_get_size()`*/
+    int32_t line_max_width = (flag & LV_TEXT_FLAG_EXPAND) ? LV_COORD_MAX : max_width;
+    uint32_t line_start = 0;
+    while(text[line_start] != '\0') {
+        uint32_t line_end = line_start + lv_text_get_next_line(&text[line_start], font, letter_space, line_max_width, NULL,
+                                                               flag);
+
+        if(layout->line_cnt == layout->line_buf_cnt) {
+            uint32_t new_buf_cnt = layout->line_buf_cnt ? layout->line_buf_cnt * 2 : 4;
+            lv_draw_label_layout_line_t * new_lines = lv_realloc(layout->lines, new_buf_cnt * sizeof(layout->lines[0]));
+            if(new_lines == NULL) {
+                LV_LOG_WARN("Couldn't allocate the lines, the text will be measured while drawing");
+                layout->line_cnt = 0;
+                LV_PROFILER_END;
+                return;
+            }
+            layout->lines = new_lines;
+            layout->line_buf_cnt = new_buf_cnt;
+        }
+
+        lv_draw_label_layout_line_t * line = &layout->lines[layout->line_cnt];
+        line->end = line_end;
+        line->width = lv_text_get_width(&text[line_start], line_end - line_start, font, letter_space);
+        layout->max_line_width = LV_MAX(layout->max_line_width, line->width);
+        layout->line_cnt++;
+
+        line_start = line_end;
+    }
+
+    /*Don't keep a large buffer, e.g. if the text was measured in a narrow object before*/
+    if(layout->line_buf_cnt > layout->line_cnt * 2 + 4) {
+        if(layout->line_cnt == 0) {
+            lv_free(layout->lines);
+            layout->lines = NULL;
+            layout->line_buf_cnt = 0;
+        }
+        else {
+            lv_draw_label_layout_line_t * new_lines = lv_realloc(layout->lines, layout->line_cnt * sizeof(layout->lines[0]));
+            if(new_lines) {
+                layout->lines = new_lines;
+                layout->line_buf_cnt = layout->line_cnt;
+            }
+        }
+    }
+
+    layout->text = text;
+    layout->font = font;
+    layout->letter_space = letter_space;
+    layout->max_width = max_width;
+    layout->flag = flag;
+    LV_PROFILER_END;
+}
+
+bool lv_draw_label_layout_is_valid(const lv_draw_label_layout_t * layout, const char * text, const lv_font_t * font,
+                                   int32_t letter_space, int32_t max_width, lv_text_flag_t flag)
+{
+    if(layout->text == NULL || layout->text != text) return false;
+    if(layout->font != font || layout->letter_space != letter_space || layout->flag != flag) return false;
+
+    /*The lines are broken only at new line characters in these cases, so the width doesn't matter*/
+    if(flag & (LV_TEXT_FLAG_EXPAND | LV_TEXT_FLAG_FIT)) return true;
+
+    return layout->max_width == max_width;
+}
+
+void lv_draw_label_layout_get_size(const lv_draw_label_layout_t * layout, int32_t line_space, lv_point_t * size_res)
+{
+    int32_t letter_height = lv_font_get_line_height(layout->font);
+
+    size_res->x = layout->max_line_width;
+    size_res->y = (letter_height + line_space) * (int32_t)layout->line_cnt;
+
+    /*Make the text one line taller if the last character is '\n' or '\r'*/
+    if(layout->line_cnt > 0) {
+        char last_char = layout->text[layout->lines[layout->line_cnt - 1].end - 1];
+        if(last_char == '\n' || last_char == '\r') size_res->y += letter_height + line_space;
+    }
+
+    /*Correction with the last line space or set the height manually if the text is empty*/
+    if(size_res->y == 0) size_res->y = letter_height;
+    else size_res->y -= line_space;
+}
+
+void lv_draw_label_layout_invalidate(lv_draw_label_layout_t * layout)
+{
+    layout->text = NULL;
+}
+
+void lv_draw_label_layout_free(lv_draw_label_layout_t * layout)
+{
+    lv_free(layout->lines);
+    lv_draw_label_layout_init(layout);
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
 
+/**
+ * Get the byte index where the line after a given line starts
+ * @param dsc           the label draw descriptor
+ * @param layout        valid layout of the text or NULL to measure the line now
+ * @param line_i        index of the line
+ * @param line_start    byte index of the line's first character
+ * @param w             max width of the line
+ * @return              byte index of the next line's first character
+ */
+static inline uint32_t get_line_end(const lv_draw_label_dsc_t * dsc, const lv_draw_label_layout_t * layout,
+                                    uint32_t line_i, uint32_t line_start, int32_t w)
+{
+    if(layout) return line_i < layout->line_cnt ? layout->lines[line_i].end : line_start;
+
+    return line_start + lv_text_get_next_line(&dsc->text[line_start], dsc->font, dsc->letter_space, w, NULL, dsc->flag);
+}
+
+/**
+ * Get the width of a line
+ * @param dsc           the label draw descriptor
+ * @param layout        valid layout of the text or NULL to measure the line now
+ * @param line_i        index of the line
+ * @param line_start    byte index of the line's first character
+ * @param line_end      byte index of the next line's first character
+ * @return              width of the line in pixels
+ */
+static inline int32_t get_line_width(const lv_draw_label_dsc_t * dsc, const lv_draw_label_layout_t * layout,
+                                     uint32_t line_i, uint32_t line_start, uint32_t line_end)
+{
+    if(layout) return line_i < layout->line_cnt ? layout->lines[line_i].width : 0;
+
+    return lv_text_get_width(&dsc->text[line_start], line_end - line_start, dsc->font, dsc->letter_space);
+}
+
 static void draw_letter(lv_draw_unit_t * draw_unit, lv_draw_glyph_dsc_t * dsc,  const lv_point_t * pos,
                         const lv_font_t * font, uint32_t letter, lv_draw_glyph_cb_t cb)
 {
@@ -54,6 +54,10 @@ typedef struct {
      * 0: `text` is const and it's pointer will be valid during rendering.*/
     uint8_t text_local : 1;
     lv_draw_label_hint_t * hint;
+    /**
+     * Line breaks measured in advance. Used only if it was measured with the same
+     * text, font, letter space, width and flags. Can be NULL.*/
+    const lv_draw_label_layout_t * layout;
 } lv_draw_label_dsc_t;
 
 /**
@@ -41,6 +41,37 @@ struct lv_draw_label_hint_t {
     int32_t coord_y;
 };
 
+/** A line of `lv_draw_label_layout_t`*/
+typedef struct {
+    /** Byte index of the first character of the next line*/
+    uint32_t end;
+
+    /** Width of the line in pixels*/
+    int32_t width;
+} lv_draw_label_layout_line_t;
+
+/** Store the line breaks and line widths of a text.
+ * Breaking a text into lines needs the width of all the characters so it's slow for long texts.
+ * Labels measure their text when it changes and the lines are used while drawing instead of
+ * measuring the text again in every frame and for every area to redraw.*/
+struct lv_draw_label_layout_t {
+    /** The text and parameters the lines were measured with. `text == NULL` means invalid layout*/
+    const char * text;
+    const lv_font_t * font;
+    int32_t letter_space;
+    int32_t max_width;
+    lv_text_flag_t flag;
+
+    /** Width of the longest line*/
+    int32_t max_line_width;
+
+    lv_draw_label_layout_line_t * lines;
+    uint32_t line_cnt;
+
+    /** Number of lines `lines` has space for*/
+    uint32_t line_buf_cnt;
+};
+
 struct lv_draw_glyph_dsc_t {
     void * glyph_data;  /**< Depends on `format` field, it could be image source or draw buf of bitmap or vector data. */
     lv_font_glyph_format_t format;
@@ -57,6 +88,58 @@ struct lv_draw_glyph_dsc_t {
  * GLOBAL PROTOTYPES
  **********************/
 
+/**
+ * Initialize an empty (invalid) text layout
+ * @param layout        pointer to a layout
+ */
+void lv_draw_label_layout_init(lv_draw_label_layout_t * layout);
+
+/**
+ * Measure the lines of a text if the layout was measured with different parameters.
+ * If there is not enough memory the layout remains invalid.
+ * @param layout        pointer to a layout
+ * @param text          the text to measure
+ * @param font          font of the text
+ * @param letter_space  letter space of the text
+ * @param max_width     max width of the lines
+ * @param flag          settings for the text from ::lv_text_flag_t
+ */
+void lv_draw_label_layout_update(lv_draw_label_layout_t * layout, const char * text, const lv_font_t * font,
+                                 int32_t letter_space, int32_t max_width, lv_text_flag_t flag);
+
+/**
+ * Check if a layout was measured with the given parameters
+ * @param layout        pointer to a layout
+ * @param text          the text to draw
+ * @param font          font of the text
+ * @param letter_space  letter space of the text
+ * @param max_width     max width of the lines
+ * @param flag          settings for the text from ::lv_text_flag_t
+ * @return              true: the layout can be used
+ */
+bool lv_draw_label_layout_is_valid(const lv_draw_label_layout_t * layout, const char * text, const lv_font_t * font,
+                                   int32_t letter_space, int32_t max_width, lv_text_flag_t flag);
+
+/**
+ * Get the size of a text from its layout. The result is the same as `lv_text_get_size()`'s.
+ * @param layout        pointer to a valid layout
+ * @param line_space    line space of the text
+ * @param size_res      store the result here
+ */
+void lv_draw_label_layout_get_size(const lv_draw_label_layout_t * layout, int32_t line_space, lv_point_t * size_res);
+
+/**
+ * Mark the layout invalid, e.g. because its text has been modified.
+ * @param layout        pointer to a layout
+ */
+void lv_draw_label_layout_invalidate(lv_draw_label_layout_t * layout);
+
+/**
+ * Free the memory used by the layout
+ * @param layout        pointer to a layout
+ */
+void lv_draw_label_layout_free(lv_draw_label_layout_t * layout);
+
 /**********************
  *      MACROS
  **********************/
@@ -19,6 +19,7 @@ extern "C" {
  *********************/
 
 #include "lv_draw.h"
+#include "../misc/lv_arena.h"
 
 /*********************
  *      DEFINES
@@ -75,6 +76,14 @@ struct lv_draw_task_t {
      */
     uint8_t preference_score;
 
+    /** 1: `draw_dsc` was allocated by `lv_draw_task_alloc_dsc`*/
+    uint8_t dsc_allocated : 1;
+
+    /** 1: `draw_dsc` belongs to the draw task this one was copied from*/
+    uint8_t dsc_shared : 1;
+
+    /** 1: the task was allocated with `lv_malloc` because the chunks of the task arena were full*/
+    uint8_t heap_allocated : 1;
 };
 
 struct lv_draw_mask_t {
@@ -179,6 +188,13 @@ typedef struct {
 #endif
     lv_mutex_t circle_cache_mutex;
     bool task_running;
+#if LV_DRAW_TASK_ARENA_SIZE
+    lv_arena_t task_arena;      /**< The draw tasks and their descriptors are allocated here*/
+    uint32_t task_cnt;          /**< Number of not freed draw tasks in the arena. It's reset when this becomes 0.*/
+#if LV_USE_OS
+    uint8_t task_arena_busy;    /**< Set while the arena is used to catch the use from more threads*/
+#endif
+#endif
 } lv_draw_global_info_t;
 
 /**********************
@@ -0,0 +1,1063 @@
+/**
+ * @file lv_blend_sse2.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../../../lv_conf_internal.h"
+#if LV_USE_DRAW_SW && LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_SSE2
+
+#include "lv_blend_sse2.h"
+#if LV_BLEND_SSE2_AVAILABLE
+
+#include "../../../../misc/lv_color.h"
+#include "../../../../misc/lv_color_op.h"
+#include "../../../../stdlib/lv_string.h"
+
+#if defined(__AVX2__)
+    #include <immintrin.h>
+#else
+    #include <emmintrin.h>
+#endif
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/* The kernels are written once for a generic vector type.
+ * With AVX2 the unpack/pack operations work on the two 128 bit halves separately,
+ * so an unpack has to be undone by a pack of the same width to keep the order of the pixels.*/
+#if defined(__AVX2__)
+    #define VEC_BYTES                   32
+    #define vec_t                       __m256i
+    #define vec_loadu(p)                _mm256_loadu_si256((const __m256i *)(p))
+    #define vec_storeu(p, v)            _mm256_storeu_si256((__m256i *)(p), v)
+    #define vec_zero()                  _mm256_setzero_si256()
+    #define vec_set1_16(x)              _mm256_set1_epi16((short)(x))
+    #define vec_set1_32(x)              _mm256_set1_epi32((int)(x))
+    #define vec_and                     _mm256_and_si256
+    #define vec_or                      _mm256_or_si256
+    #define vec_andnot                  _mm256_andnot_si256
+    #define vec_add16                   _mm256_add_epi16
+    #define vec_sub16                   _mm256_sub_epi16
+    #define vec_add32                   _mm256_add_epi32
+    #define vec_sub32                   _mm256_sub_epi32
+    #define vec_mullo16                 _mm256_mullo_epi16
+    #define vec_mulhi16u                _mm256_mulhi_epu16
+    #define vec_slli16                  _mm256_slli_epi16
+    #define vec_srli16                  _mm256_srli_epi16
+    #define vec_slli32                  _mm256_slli_epi32
+    #define vec_srli32                  _mm256_srli_epi32
+    #define vec_srai32                  _mm256_srai_epi32
+    #define vec_cmpeq16                 _mm256_cmpeq_epi16
+    #define vec_cmpeq32                 _mm256_cmpeq_epi32
+    #define vec_cmpgt32                 _mm256_cmpgt_epi32
+    #define vec_unpacklo8               _mm256_unpacklo_epi8
+    #define vec_unpackhi8               _mm256_unpackhi_epi8
+    #define vec_unpacklo16              _mm256_unpacklo_epi16
+    #define vec_unpackhi16              _mm256_unpackhi_epi16
+    #define vec_packs32                 _mm256_packs_epi32
+    #define vec_packus16                _mm256_packus_epi16
+    #define vec_shufflelo16             _mm256_shufflelo_epi16
+    #define vec_shufflehi16             _mm256_shufflehi_epi16
+    #define vec_movemask32(v)           _mm256_movemask_ps(_mm256_castsi256_ps(v))
+    /*Zero extend `VEC_PX16` bytes to 16 bit lanes*/
+    #define vec_load_u8_16(p)           _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i *)(p)))
+    /*Zero extend `VEC_PX32` bytes to 32 bit lanes*/
+    #define vec_load_u8_32(p)           _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i *)(p)))
+    /*Pack the 32 bit lanes of two vectors of consecutive pixels to 16 bit lanes in order*/
+    #define vec_packs32_ordered(a, b)   _mm256_permute4x64_epi64(_mm256_packs_epi32(a, b), 0xD8)
+#else
+    #define VEC_BYTES                   16
+    #define vec_t                       __m128i
+    #define vec_loadu(p)                _mm_loadu_si128((const __m128i *)(p))
+    #define vec_storeu(p, v)            _mm_storeu_si128((__m128i *)(p), v)
+    #define vec_zero()                  _mm_setzero_si128()
+    #define vec_set1_16(x)              _mm_set1_epi16((short)(x))
+    #define vec_set1_32(x)              _mm_set1_epi32((int)(x))
+    #define vec_and                     _mm_and_si128
+    #define vec_or                      _mm_or_si128
+    #define vec_andnot                  _mm_andnot_si128
+    #define vec_add16                   _mm_add_epi16
+    #define vec_sub16                   _mm_sub_epi16
+    #define vec_add32                   _mm_add_epi32
+    #define vec_sub32                   _mm_sub_epi32
+    #define vec_mullo16                 _mm_mullo_epi16
+    #define vec_mulhi16u                _mm_mulhi_epu16
+    #define vec_slli16                  _mm_slli_epi16
+    #define vec_srli16                  _mm_srli_epi16
+    #define vec_slli32                  _mm_slli_epi32
+    #define vec_srli32                  _mm_srli_epi32
+    #define vec_srai32                  _mm_srai_epi32
+    #define vec_cmpeq16                 _mm_cmpeq_epi16
+    #define vec_cmpeq32                 _mm_cmpeq_epi32
+    #define vec_cmpgt32                 _mm_cmpgt_epi32
+    #define vec_unpacklo8               _mm_unpacklo_epi8
+    #define vec_unpackhi8               _mm_unpackhi_epi8
+    #define vec_unpacklo16              _mm_unpacklo_epi16
+    #define vec_unpackhi16              _mm_unpackhi_epi16
+    #define vec_packs32                 _mm_packs_epi32
+    #define vec_packus16                _mm_packus_epi16
+    #define vec_shufflelo16             _mm_shufflelo_epi16
+    #define vec_shufflehi16             _mm_shufflehi_epi16
+    #define vec_movemask32(v)           _mm_movemask_ps(_mm_castsi128_ps(v))
+    #define vec_load_u8_16(p)           _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)(p)), _mm_setzero_si128())
+    #define vec_load_u8_32(p)           _mm_unpacklo_epi16(vec_load_u8_16_4(p), _mm_setzero_si128())
+    #define vec_packs32_ordered(a, b)   _mm_packs_epi32(a, b)
+#endif
+
+/*Number of 16 and 32 bit pixels in a vector*/
+#define VEC_PX16        (VEC_BYTES / 2)
+#define VEC_PX32        (VEC_BYTES / 4)
+
+/*Select `b` where `m` is set and `a` elsewhere*/
+#define vec_select(a, b, m)     vec_or(vec_and(m, b), vec_andnot(m, a))
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+
+static inline vec_t rgb565_mix(vec_t fg, vec_t bg, vec_t mix);
+static inline vec_t rgb565_mix_half(vec_t fg, vec_t bg, vec_t mix);
+static inline vec_t argb8888_to_rgb565_mix(vec_t src_lo, vec_t src_hi, vec_t bg, vec_t mix);
+static inline vec_t argb8888_mix_opaque(vec_t fg, vec_t bg);
+static inline vec_t xrgb8888_mix(vec_t src, vec_t dest, vec_t mix);
+static inline vec_t opa_mix2(vec_t a, vec_t b);
+static inline vec_t opa_mix3(vec_t a, vec_t b, vec_t c);
+
+static void rgb565_fill(uint16_t * dest, int32_t w, int32_t h, int32_t dest_stride, uint16_t color);
+static void rgb565_copy(uint16_t * dest, int32_t w, int32_t h, int32_t dest_stride,
+                        const uint16_t * src, int32_t src_stride);
+static inline void rgb565_blend(uint16_t * dest, int32_t w, int32_t h, int32_t dest_stride,
+                                const uint16_t * src, int32_t src_stride, uint16_t color,
+                                const lv_opa_t * mask, int32_t mask_stride, lv_opa_t opa);
+static inline void argb8888_to_rgb565_blend(uint16_t * dest, int32_t w, int32_t h, int32_t dest_stride,
+                                            const uint32_t * src, int32_t src_stride, bool src_alpha,
+                                            const lv_opa_t * mask, int32_t mask_stride, lv_opa_t opa);
+
+static void rgb888_fill(uint8_t * dest, int32_t w, int32_t h, int32_t dest_stride, lv_color_t color);
+static void rgb888_fill_opa(uint8_t * dest, int32_t w, int32_t h, int32_t dest_stride, lv_color_t color, lv_opa_t opa);
+static inline void xrgb8888_blend(uint32_t * dest, int32_t w, int32_t h, int32_t dest_stride,
+                                  const uint32_t * src, int32_t src_stride, uint32_t color,
+                                  const lv_opa_t * mask, int32_t mask_stride, lv_opa_t opa);
+
+static void argb8888_fill(uint32_t * dest, int32_t w, int32_t h, int32_t dest_stride, uint32_t color);
+static inline void argb8888_blend(uint32_t * dest, int32_t w, int32_t h, int32_t dest_stride,
+                                  const uint32_t * src, int32_t src_stride, uint32_t color,
+                                  const lv_opa_t * mask, int32_t mask_stride, lv_opa_t opa);
+static inline void argb8888_blend_vec(uint32_t * dest, vec_t fg);
+static lv_color32_t argb8888_mix_both_alpha(lv_color32_t fg, lv_color32_t bg);
+
+static inline void * drawbuf_next_row(const void * buf, uint32_t stride);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+lv_result_t lv_color_blend_to_rgb565_sse2(lv_draw_sw_blend_fill_dsc_t * dsc)
+{
+    rgb565_fill(dsc->dest_buf, dsc->dest_w, dsc->dest_h, dsc->dest_stride, lv_color_to_u16(dsc->color));
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_color_blend_to_rgb565_with_opa_sse2(lv_draw_sw_blend_fill_dsc_t * dsc)
+{
+    rgb565_blend(dsc->dest_buf, dsc->dest_w, dsc->dest_h, dsc->dest_stride, NULL, 0, lv_color_to_u16(dsc->color),
+                 NULL, 0, dsc->opa);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_color_blend_to_rgb565_with_mask_sse2(lv_draw_sw_blend_fill_dsc_t * dsc)
+{
+    rgb565_blend(dsc->dest_buf, dsc->dest_w, dsc->dest_h, dsc->dest_stride, NULL, 0, lv_color_to_u16(dsc->color),
+                 dsc->mask_buf, dsc->mask_stride, LV_OPA_COVER);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_color_blend_to_rgb565_mix_mask_opa_sse2(lv_draw_sw_blend_fill_dsc_t * dsc)
+{
+    rgb565_blend(dsc->dest_buf, dsc->dest_w, dsc->dest_h, dsc->dest_stride, NULL, 0, lv_color_to_u16(dsc->color),
+                 dsc->mask_buf, dsc->mask_stride, dsc->opa);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_rgb565_blend_normal_to_rgb565_sse2(lv_draw_sw_blend_image_dsc_t * dsc)
+{
+    rgb565_copy(dsc->dest_buf, dsc->dest_w, dsc->dest_h, dsc->dest_stride, dsc->src_buf, dsc->src_stride);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_rgb565_blend_normal_to_rgb565_with_opa_sse2(lv_draw_sw_blend_image_dsc_t * dsc)
+{
+    rgb565_blend(dsc->dest_buf, dsc->dest_w, dsc->dest_h, dsc->dest_stride, dsc->src_buf, dsc->src_stride, 0,
+                 NULL, 0, dsc->opa);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_rgb565_blend_normal_to_rgb565_with_mask_sse2(lv_draw_sw_blend_image_dsc_t * dsc)
+{
+    rgb565_blend(dsc->dest_buf, dsc->dest_w, dsc->dest_h, dsc->dest_stride, dsc->src_buf, dsc->src_stride, 0,
+                 dsc->mask_buf, dsc->mask_stride, LV_OPA_COVER);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_rgb565_blend_normal_to_rgb565_mix_mask_opa_sse2(lv_draw_sw_blend_image_dsc_t * dsc)
+{
+    rgb565_blend(dsc->dest_buf, dsc->dest_w, dsc->dest_h, dsc->dest_stride, dsc->src_buf, dsc->src_stride, 0,
+                 dsc->mask_buf, dsc->mask_stride, dsc->opa);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_rgb888_blend_normal_to_rgb565_sse2(lv_draw_sw_blend_image_dsc_t * dsc, uint32_t src_px_size)
+{
+    /*Only XRGB8888 can be loaded by pixels*/
+    if(src_px_size != 4) return LV_RESULT_INVALID;
+
+    argb8888_to_rgb565_blend(dsc->dest_buf, dsc->dest_w, dsc->dest_h, dsc->dest_stride, dsc->src_buf, dsc->src_stride,
+                             false, NULL, 0, LV_OPA_COVER);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_rgb888_blend_normal_to_rgb565_with_opa_sse2(lv_draw_sw_blend_image_dsc_t * dsc, uint32_t src_px_size)
+{
+    if(src_px_size != 4) return LV_RESULT_INVALID;
+
+    argb8888_to_rgb565_blend(dsc->dest_buf, dsc->dest_w, dsc->dest_h, dsc->dest_stride, dsc->src_buf, dsc->src_stride,
+                             false, NULL, 0, dsc->opa);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_rgb888_blend_normal_to_rgb565_with_mask_sse2(lv_draw_sw_blend_image_dsc_t * dsc, uint32_t src_px_size)
+{
+    if(src_px_size != 4) return LV_RESULT_INVALID;
+
+    argb8888_to_rgb565_blend(dsc->dest_buf, dsc->dest_w, dsc->dest_h, dsc->dest_stride, dsc->src_buf, dsc->src_stride,
+                             false, dsc->mask_buf, dsc->mask_stride, LV_OPA_COVER);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_rgb888_blend_normal_to_rgb565_mix_mask_opa_sse2(lv_draw_sw_blend_image_dsc_t * dsc,
+                                                                uint32_t src_px_size)
+{
+    if(src_px_size != 4) return LV_RESULT_INVALID;
+
+    argb8888_to_rgb565_blend(dsc->dest_buf, dsc->dest_w, dsc->dest_h, dsc->dest_stride, dsc->src_buf, dsc->src_stride,
+                             false, dsc->mask_buf, dsc->mask_stride, dsc->opa);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_argb8888_blend_normal_to_rgb565_sse2(lv_draw_sw_blend_image_dsc_t * dsc)
+{
+    argb8888_to_rgb565_blend(dsc->dest_buf, dsc->dest_w, dsc->dest_h, dsc->dest_stride, dsc->src_buf, dsc->src_stride,
+                             true, NULL, 0, LV_OPA_COVER);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_argb8888_blend_normal_to_rgb565_with_opa_sse2(lv_draw_sw_blend_image_dsc_t * dsc)
+{
+    argb8888_to_rgb565_blend(dsc->dest_buf, dsc->dest_w, dsc->dest_h, dsc->dest_stride, dsc->src_buf, dsc->src_stride,
+                             true, NULL, 0, dsc->opa);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_argb8888_blend_normal_to_rgb565_with_mask_sse2(lv_draw_sw_blend_image_dsc_t * dsc)
+{
+    argb8888_to_rgb565_blend(dsc->dest_buf, dsc->dest_w, dsc->dest_h, dsc->dest_stride, dsc->src_buf, dsc->src_stride,
+                             true, dsc->mask_buf, dsc->mask_stride, LV_OPA_COVER);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_argb8888_blend_normal_to_rgb565_mix_mask_opa_sse2(lv_draw_sw_blend_image_dsc_t * dsc)
+{
+    argb8888_to_rgb565_blend(dsc->dest_buf, dsc->dest_w, dsc->dest_h, dsc->dest_stride, dsc->src_buf, dsc->src_stride,
+                             true, dsc->mask_buf, dsc->mask_stride, dsc->opa);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_color_blend_to_rgb888_sse2(lv_draw_sw_blend_fill_dsc_t * dsc, uint32_t dst_px_size)
+{
+    if(dst_px_size == 3) {
+        rgb888_fill(dsc->dest_buf, dsc->dest_w, dsc->dest_h, dsc->dest_stride, dsc->color);
+    }
+    else {
+        argb8888_fill(dsc->dest_buf, dsc->dest_w, dsc->dest_h, dsc->dest_stride, lv_color_to_u32(dsc->color));
+    }
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_color_blend_to_rgb888_with_opa_sse2(lv_draw_sw_blend_fill_dsc_t * dsc, uint32_t dst_px_size)
+{
+    if(dst_px_size == 3) {
+        rgb888_fill_opa(dsc->dest_buf, dsc->dest_w, dsc->dest_h, dsc->dest_stride, dsc->color, dsc->opa);
+    }
+    else {
+        xrgb8888_blend(dsc->dest_buf, dsc->dest_w, dsc->dest_h, dsc->dest_stride, NULL, 0, lv_color_to_u32(dsc->color),
+                       NULL, 0, dsc->opa);
+    }
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_color_blend_to_rgb888_with_mask_sse2(lv_draw_sw_blend_fill_dsc_t * dsc, uint32_t dst_px_size)
+{
+    /*The mask can't be spread to 3 byte pixels efficiently*/
+    if(dst_px_size != 4) return LV_RESULT_INVALID;
+
+    xrgb8888_blend(dsc->dest_buf, dsc->dest_w, dsc->dest_h, dsc->dest_stride, NULL, 0, lv_color_to_u32(dsc->color),
+                   dsc->mask_buf, dsc->mask_stride, LV_OPA_COVER);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_color_blend_to_rgb888_mix_mask_opa_sse2(lv_draw_sw_blend_fill_dsc_t * dsc, uint32_t dst_px_size)
+{
+    if(dst_px_size != 4) return LV_RESULT_INVALID;
+
+    xrgb8888_blend(dsc->dest_buf, dsc->dest_w, dsc->dest_h, dsc->dest_stride, NULL, 0, lv_color_to_u32(dsc->color),
+                   dsc->mask_buf, dsc->mask_stride, dsc->opa);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_argb8888_blend_normal_to_rgb888_sse2(lv_draw_sw_blend_image_dsc_t * dsc, uint32_t dst_px_size)
+{
+    if(dst_px_size != 4) return LV_RESULT_INVALID;
+
+    xrgb8888_blend(dsc->dest_buf, dsc->dest_w, dsc->dest_h, dsc->dest_stride, dsc->src_buf, dsc->src_stride, 0,
+                   NULL, 0, LV_OPA_COVER);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_argb8888_blend_normal_to_rgb888_with_opa_sse2(lv_draw_sw_blend_image_dsc_t * dsc, uint32_t dst_px_size)
+{
+    if(dst_px_size != 4) return LV_RESULT_INVALID;
+
+    xrgb8888_blend(dsc->dest_buf, dsc->dest_w, dsc->dest_h, dsc->dest_stride, dsc->src_buf, dsc->src_stride, 0,
+                   NULL, 0, dsc->opa);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_argb8888_blend_normal_to_rgb888_with_mask_sse2(lv_draw_sw_blend_image_dsc_t * dsc, uint32_t dst_px_size)
+{
+    if(dst_px_size != 4) return LV_RESULT_INVALID;
+
+    xrgb8888_blend(dsc->dest_buf, dsc->dest_w, dsc->dest_h, dsc->dest_stride, dsc->src_buf, dsc->src_stride, 0,
+                   dsc->mask_buf, dsc->mask_stride, LV_OPA_COVER);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_argb8888_blend_normal_to_rgb888_mix_mask_opa_sse2(lv_draw_sw_blend_image_dsc_t * dsc,
+                                                                  uint32_t dst_px_size)
+{
+    if(dst_px_size != 4) return LV_RESULT_INVALID;
+
+    xrgb8888_blend(dsc->dest_buf, dsc->dest_w, dsc->dest_h, dsc->dest_stride, dsc->src_buf, dsc->src_stride, 0,
+                   dsc->mask_buf, dsc->mask_stride, dsc->opa);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_color_blend_to_argb8888_sse2(lv_draw_sw_blend_fill_dsc_t * dsc)
+{
+    argb8888_fill(dsc->dest_buf, dsc->dest_w, dsc->dest_h, dsc->dest_stride, lv_color_to_u32(dsc->color));
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_color_blend_to_argb8888_with_opa_sse2(lv_draw_sw_blend_fill_dsc_t * dsc)
+{
+    argb8888_blend(dsc->dest_buf, dsc->dest_w, dsc->dest_h, dsc->dest_stride, NULL, 0, lv_color_to_u32(dsc->color),
+                   NULL, 0, dsc->opa);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_color_blend_to_argb8888_with_mask_sse2(lv_draw_sw_blend_fill_dsc_t * dsc)
+{
+    argb8888_blend(dsc->dest_buf, dsc->dest_w, dsc->dest_h, dsc->dest_stride, NULL, 0, lv_color_to_u32(dsc->color),
+                   dsc->mask_buf, dsc->mask_stride, LV_OPA_COVER);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_color_blend_to_argb8888_mix_mask_opa_sse2(lv_draw_sw_blend_fill_dsc_t * dsc)
+{
+    argb8888_blend(dsc->dest_buf, dsc->dest_w, dsc->dest_h, dsc->dest_stride, NULL, 0, lv_color_to_u32(dsc->color),
+                   dsc->mask_buf, dsc->mask_stride, dsc->opa);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_argb8888_blend_normal_to_argb8888_sse2(lv_draw_sw_blend_image_dsc_t * dsc)
+{
+    argb8888_blend(dsc->dest_buf, dsc->dest_w, dsc->dest_h, dsc->dest_stride, dsc->src_buf, dsc->src_stride, 0,
+                   NULL, 0, LV_OPA_COVER);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_argb8888_blend_normal_to_argb8888_with_opa_sse2(lv_draw_sw_blend_image_dsc_t * dsc)
+{
+    argb8888_blend(dsc->dest_buf, dsc->dest_w, dsc->dest_h, dsc->dest_stride, dsc->src_buf, dsc->src_stride, 0,
+                   NULL, 0, dsc->opa);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_argb8888_blend_normal_to_argb8888_with_mask_sse2(lv_draw_sw_blend_image_dsc_t * dsc)
+{
+    argb8888_blend(dsc->dest_buf, dsc->dest_w, dsc->dest_h, dsc->dest_stride, dsc->src_buf, dsc->src_stride, 0,
+                   dsc->mask_buf, dsc->mask_stride, LV_OPA_COVER);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_argb8888_blend_normal_to_argb8888_mix_mask_opa_sse2(lv_draw_sw_blend_image_dsc_t * dsc)
+{
+    argb8888_blend(dsc->dest_buf, dsc->dest_w, dsc->dest_h, dsc->dest_stride, dsc->src_buf, dsc->src_stride, 0,
+                   dsc->mask_buf, dsc->mask_stride, dsc->opa);
+    return LV_RESULT_OK;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+#if !defined(__AVX2__)
+/*Zero extend 4 bytes to 16 bit lanes (the upper 4 lanes are 0)*/
+static inline __m128i vec_load_u8_16_4(const uint8_t * p)
+{
+    int32_t v = (int32_t)((uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24));
+    return _mm_unpacklo_epi8(_mm_cvtsi32_si128(v), _mm_setzero_si128());
+}
+#endif
+
+/**
+ * Same as `LV_OPA_MIX2()` on 16 or 32 bit lanes holding 0..255
+ */
+static inline vec_t opa_mix2(vec_t a, vec_t b)
+{
+    /*The product fits into 16 bit, and the upper half of the 32 bit lanes is 0*/
+    return vec_srli16(vec_mullo16(a, b), 8);
+}
+
+/**
+ * Same as `LV_OPA_MIX3()` on 16 or 32 bit lanes holding 0..255
+ */
+static inline vec_t opa_mix3(vec_t a, vec_t b, vec_t c)
+{
+    return vec_mulhi16u(vec_mullo16(a, b), c);
+}
+
+/**
+ * Same as `lv_color_16_16_mix()` on `VEC_PX16` pixels.
+ * The special cases of `lv_color_16_16_mix()` give the same result as the calculation,
+ * so no need to handle them separately.
+ * @param fg    the RGB565 foreground pixels
+ * @param bg    the RGB565 background pixels
+ * @param mix   the mix ratios (0..255) in 16 bit lanes
+ * @return      the mixed RGB565 pixels
+ */
+static inline vec_t rgb565_mix(vec_t fg, vec_t bg, vec_t mix)
+{
+    vec_t zero = vec_zero();
+    mix = vec_srli16(vec_add16(mix, vec_set1_16(4)), 3);
+
+    vec_t lo = rgb565_mix_half(vec_unpacklo16(fg, zero), vec_unpacklo16(bg, zero), vec_unpacklo16(mix, zero));
+    vec_t hi = rgb565_mix_half(vec_unpackhi16(fg, zero), vec_unpackhi16(bg, zero), vec_unpackhi16(mix, zero));
+    return vec_packs32(lo, hi);
+}
+
+/**
+ * Mix RGB565 pixels zero extended to 32 bit lanes.
+ * @param fg    the foreground pixels
+ * @param bg    the background pixels
+ * @param mix   the mix ratios (0..32)
+ * @return      the mixed pixels sign extended from 16 bit, ready to be packed
+ */
+static inline vec_t rgb565_mix_half(vec_t fg, vec_t bg, vec_t mix)
+{
+    /*0x7E0F81F = 0b00000111111000001111100000011111*/
+    vec_t spread_mask = vec_set1_32(0x7E0F81F);
+    fg = vec_and(vec_or(fg, vec_slli32(fg, 16)), spread_mask);
+    bg = vec_and(vec_or(bg, vec_slli32(bg, 16)), spread_mask);
+
+    /*There is no 32 bit multiplication in SSE2, but `mix` fits into 16 bit, so
+     *low 32 bit of (H * 2^16 + L) * mix = (mulhi(L, mix) + mullo(H, mix)) * 2^16 + mullo(L, mix)*/
+    vec_t diff = vec_sub32(fg, bg);
+    mix = vec_or(mix, vec_slli32(mix, 16));
+    vec_t prod = vec_add16(vec_mullo16(diff, mix), vec_slli32(vec_mulhi16u(diff, mix), 16));
+
+    vec_t res = vec_and(vec_add32(vec_srli32(prod, 5), bg), spread_mask);
+    res = vec_or(res, vec_srli32(res, 16));
+    return vec_srai32(vec_slli32(res, 16), 16);
+}
+
+/**
+ * Same as `lv_color_24_16_mix()` on `VEC_PX16` pixels
+ * @param src_lo    the first `VEC_PX32` XRGB8888 pixels
+ * @param src_hi    the next `VEC_PX32` XRGB8888 pixels
+ * @param bg        the RGB565 background pixels
+ * @param mix       the mix ratios (0..255) in 16 bit lanes
+ * @return          the mixed RGB565 pixels
+ */
+static inline vec_t argb8888_to_rgb565_mix(vec_t src_lo, vec_t src_hi, vec_t bg, vec_t mix)
+{
+    vec_t ff = vec_set1_32(0xFF);
+    vec_t b = vec_packs32_ordered(vec_and(src_lo, ff), vec_and(src_hi, ff));
+    vec_t g = vec_packs32_ordered(vec_and(vec_srli32(src_lo, 8), ff), vec_and(vec_srli32(src_hi, 8), ff));
+    vec_t r = vec_packs32_ordered(vec_and(vec_srli32(src_lo, 16), ff), vec_and(vec_srli32(src_hi, 16), ff));
+
+    vec_t full = vec_add16(vec_add16(vec_slli16(vec_and(r, vec_set1_16(0xF8)), 8),
+                                     vec_slli16(vec_and(g, vec_set1_16(0xFC)), 3)),
+                           vec_srli16(vec_and(b, vec_set1_16(0xF8)), 3));
+
+    vec_t mix_inv = vec_sub16(vec_set1_16(255), mix);
+    vec_t rr = vec_add16(vec_mullo16(vec_srli16(r, 3), mix), vec_mullo16(vec_srli16(bg, 11), mix_inv));
+    vec_t gg = vec_add16(vec_mullo16(vec_srli16(g, 2), mix),
+                         vec_mullo16(vec_and(vec_srli16(bg, 5), vec_set1_16(0x3F)), mix_inv));
+    vec_t bb = vec_add16(vec_mullo16(vec_srli16(b, 3), mix), vec_mullo16(vec_and(bg, vec_set1_16(0x1F)), mix_inv));
+
+    vec_t res = vec_add16(vec_add16(vec_and(vec_slli16(rr, 3), vec_set1_16(0xF800)),
+                                    vec_and(vec_srli16(gg, 3), vec_set1_16(0x07E0))),
+                          vec_srli16(bb, 8));
+
+    res = vec_select(res, full, vec_cmpeq16(mix, vec_set1_16(255)));
+    return vec_select(res, bg, vec_cmpeq16(mix, vec_zero()));
+}
+
+/**
+ * Same as `lv_color_mix32()` on `VEC_PX32` pixels where the alpha of `fg` is not
+ * handled as fully transparent or opaque
+ * @param fg    the ARGB8888 foreground pixels
+ * @param bg    the ARGB8888 background pixels
+ * @return      the mixed pixels with the alpha of `bg`
+ */
+static inline vec_t argb8888_mix_opaque(vec_t fg, vec_t bg)
+{
+    vec_t zero = vec_zero();
+    vec_t v255 = vec_set1_16(255);
+
+    vec_t fg_lo = vec_unpacklo8(fg, zero);
+    vec_t fg_hi = vec_unpackhi8(fg, zero);
+    vec_t a_lo = vec_shufflehi16(vec_shufflelo16(fg_lo, 0xFF), 0xFF);
+    vec_t a_hi = vec_shufflehi16(vec_shufflelo16(fg_hi, 0xFF), 0xFF);
+
+    vec_t lo = vec_add16(vec_mullo16(fg_lo, a_lo), vec_mullo16(vec_unpacklo8(bg, zero), vec_sub16(v255, a_lo)));
+    vec_t hi = vec_add16(vec_mullo16(fg_hi, a_hi), vec_mullo16(vec_unpackhi8(bg, zero), vec_sub16(v255, a_hi)));
+    vec_t res = vec_packus16(vec_srli16(lo, 8), vec_srli16(hi, 8));
+
+    return vec_select(res, bg, vec_set1_32(0xFF000000));
+}
+
+/**
+ * Same as `lv_color_24_24_mix()` on `VEC_PX32` XRGB8888 pixels
+ * @param src   the source pixels
+ * @param dest  the destination pixels
+ * @param mix   the mix ratios (0..255) in 32 bit lanes
+ * @return      the mixed pixels, the 4th byte of `dest` is kept
+ */
+static inline vec_t xrgb8888_mix(vec_t src, vec_t dest, vec_t mix)
+{
+    vec_t zero = vec_zero();
+    vec_t v255 = vec_set1_16(255);
+
+    vec_t m = vec_or(vec_or(mix, vec_slli32(mix, 8)), vec_slli32(mix, 16));
+    vec_t m_lo = vec_unpacklo8(m, zero);
+    vec_t m_hi = vec_unpackhi8(m, zero);
+
+    vec_t lo = vec_add16(vec_mullo16(vec_unpacklo8(src, zero), m_lo),
+                         vec_mullo16(vec_unpacklo8(dest, zero), vec_sub16(v255, m_lo)));
+    vec_t hi = vec_add16(vec_mullo16(vec_unpackhi8(src, zero), m_hi),
+                         vec_mullo16(vec_unpackhi8(dest, zero), vec_sub16(v255, m_hi)));
+    vec_t res = vec_packus16(vec_srli16(lo, 8), vec_srli16(hi, 8));
+
+    res = vec_select(res, src, vec_cmpgt32(mix, vec_set1_32(LV_OPA_MAX - 1)));
+    res = vec_select(res, dest, vec_or(vec_cmpeq32(mix, zero), vec_set1_32(0xFF000000)));
+    return res;
+}
+
+static void rgb565_fill(uint16_t * dest, int32_t w, int32_t h, int32_t dest_stride, uint16_t color)
+{
+    vec_t c = vec_set1_16(color);
+    int32_t y;
+    for(y = 0; y < h; y++) {
+        int32_t x;
+        for(x = 0; x <= w - VEC_PX16; x += VEC_PX16) {
+            vec_storeu(&dest[x], c);
+        }
+        for(; x < w; x++) {
+            dest[x] = color;
+        }
+        dest = drawbuf_next_row(dest, dest_stride);
+    }
+}
+
+static void rgb565_copy(uint16_t * dest, int32_t w, int32_t h, int32_t dest_stride,
+                        const uint16_t * src, int32_t src_stride)
+{
+    int32_t y;
+    for(y = 0; y < h; y++) {
+        int32_t x;
+        for(x = 0; x <= w - VEC_PX16; x += VEC_PX16) {
+            vec_storeu(&dest[x], vec_loadu(&src[x]));
+        }
+        for(; x < w; x++) {
+            dest[x] = src[x];
+        }
+        dest = drawbuf_next_row(dest, dest_stride);
+        src = drawbuf_next_row(src, src_stride);
+    }
+}
+
+/**
+ * Mix a color or an RGB565 image to an RGB565 buffer
+ * @param dest          the destination buffer
+ * @param w             width of the area
+ * @param h             height of the area
+ * @param dest_stride   stride of `dest` in bytes
+ * @param src           the source image or NULL to use `color`
+ * @param src_stride    stride of `src` in bytes
+ * @param color         the RGB565 color to use if there is no `src`
+ * @param mask          the mask or NULL
+ * @param mask_stride   stride of `mask` in bytes
+ * @param opa           the overall opacity
+ */
+static inline void rgb565_blend(uint16_t * dest, int32_t w, int32_t h, int32_t dest_stride,
+                                const uint16_t * src, int32_t src_stride, uint16_t color,
+                                const lv_opa_t * mask, int32_t mask_stride, lv_opa_t opa)
+{
+    vec_t fg = vec_set1_16(color);
+    vec_t opa_v = vec_set1_16(opa);
+
+    /*The last, partial vector of the rows is processed in these buffers*/
+    uint16_t dest_tmp[VEC_PX16];
+    uint16_t src_tmp[VEC_PX16];
+    lv_opa_t mask_tmp[VEC_PX16];
+    int32_t w_full = w & ~(VEC_PX16 - 1);
+    int32_t w_rest = w - w_full;
+
+    int32_t y;
+    for(y = 0; y < h; y++) {
+        int32_t x;
+        for(x = 0; x < w; x += VEC_PX16) {
+            uint16_t * d = &dest[x];
+            const uint16_t * s = src ? &src[x] : NULL;
+            const lv_opa_t * m = mask ? &mask[x] : NULL;
+            if(x >= w_full) {
+                lv_memzero(dest_tmp, sizeof(dest_tmp));
+                lv_memcpy(dest_tmp, d, w_rest * sizeof(uint16_t));
+                d = dest_tmp;
+                if(s) {
+                    lv_memzero(src_tmp, sizeof(src_tmp));
+                    lv_memcpy(src_tmp, s, w_rest * sizeof(uint16_t));
+                    s = src_tmp;
+                }
+                if(m) {
+                    lv_memzero(mask_tmp, sizeof(mask_tmp));
+                    lv_memcpy(mask_tmp, m, w_rest);
+                    m = mask_tmp;
+                }
+            }
+
+            vec_t mix = opa_v;
+            if(m) {
+                mix = vec_load_u8_16(m);
+                if(opa < LV_OPA_MAX) mix = opa_mix2(mix, opa_v);
+            }
+            if(s) fg = vec_loadu(s);
+            vec_storeu(d, rgb565_mix(fg, vec_loadu(d), mix));
+
+            if(d == dest_tmp) lv_memcpy(&dest[x], dest_tmp, w_rest * sizeof(uint16_t));
+        }
+
+        dest = drawbuf_next_row(dest, dest_stride);
+        if(src) src = drawbuf_next_row(src, src_stride);
+        if(mask) mask += mask_stride;
+    }
+}
+
+/**
+ * Mix an ARGB8888 or XRGB8888 image to an RGB565 buffer
+ * @param dest          the destination buffer
+ * @param w             width of the area
+ * @param h             height of the area
+ * @param dest_stride   stride of `dest` in bytes
+ * @param src           the source image
+ * @param src_stride    stride of `src` in bytes
+ * @param src_alpha     true: use the alpha channel of `src`
+ * @param mask          the mask or NULL
+ * @param mask_stride   stride of `mask` in bytes
+ * @param opa           the overall opacity
+ */
+static inline void argb8888_to_rgb565_blend(uint16_t * dest, int32_t w, int32_t h, int32_t dest_stride,
+                                            const uint32_t * src, int32_t src_stride, bool src_alpha,
+                                            const lv_opa_t * mask, int32_t mask_stride, lv_opa_t opa)
+{
+    vec_t opa_v = vec_set1_16(opa);
+
+    uint16_t dest_tmp[VEC_PX16];
+    uint32_t src_tmp[VEC_PX16];
+    lv_opa_t mask_tmp[VEC_PX16];
+    int32_t w_full = w & ~(VEC_PX16 - 1);
+    int32_t w_rest = w - w_full;
+
+    int32_t y;
+    for(y = 0; y < h; y++) {
+        int32_t x;
+        for(x = 0; x < w; x += VEC_PX16) {
+            uint16_t * d = &dest[x];
+            const uint32_t * s = &src[x];
+            const lv_opa_t * m = mask ? &mask[x] : NULL;
+            if(x >= w_full) {
+                lv_memzero(dest_tmp, sizeof(dest_tmp));
+                lv_memzero(src_tmp, sizeof(src_tmp));
+                lv_memcpy(dest_tmp, d, w_rest * sizeof(uint16_t));
+                lv_memcpy(src_tmp, s, w_rest * sizeof(uint32_t));
+                d = dest_tmp;
+                s = src_tmp;
+                if(m) {
+                    lv_memzero(mask_tmp, sizeof(mask_tmp));
+                    lv_memcpy(mask_tmp, m, w_rest);
+                    m = mask_tmp;
+                }
+            }
+
+            vec_t src_lo = vec_loadu(s);
+            vec_t src_hi = vec_loadu(s + VEC_PX32);
+            vec_t mix;
+            if(src_alpha) {
+                mix = vec_packs32_ordered(vec_srli32(src_lo, 24), vec_srli32(src_hi, 24));
+                if(m && opa < LV_OPA_MAX) mix = opa_mix3(mix, vec_load_u8_16(m), opa_v);
+                else if(m) mix = opa_mix2(mix, vec_load_u8_16(m));
+                else if(opa < LV_OPA_MAX) mix = opa_mix2(mix, opa_v);
+            }
+            else {
+                if(m && opa < LV_OPA_MAX) mix = opa_mix2(vec_load_u8_16(m), opa_v);
+                else if(m) mix = vec_load_u8_16(m);
+                else if(opa < LV_OPA_MAX) mix = opa_v;
+                else mix = vec_set1_16(255);
+            }
+
+            vec_storeu(d, argb8888_to_rgb565_mix(src_lo, src_hi, vec_loadu(d), mix));
+
+            if(d == dest_tmp) lv_memcpy(&dest[x], dest_tmp, w_rest * sizeof(uint16_t));
+        }
+
+        dest = drawbuf_next_row(dest, dest_stride);
+        src = drawbuf_next_row(src, src_stride);
+        if(mask) mask += mask_stride;
+    }
+}
+
+static void rgb888_fill(uint8_t * dest, int32_t w, int32_t h, int32_t dest_stride, lv_color_t color)
+{
+    /*3 vectors contain a whole number of pixels*/
+    uint8_t pattern[3 * VEC_BYTES];
+    int32_t i;
+    for(i = 0; i < 3 * VEC_BYTES; i += 3) {
+        pattern[i + 0] = color.blue;
+        pattern[i + 1] = color.green;
+        pattern[i + 2] = color.red;
+    }
+
+    vec_t p0 = vec_loadu(&pattern[0]);
+    vec_t p1 = vec_loadu(&pattern[VEC_BYTES]);
+    vec_t p2 = vec_loadu(&pattern[2 * VEC_BYTES]);
+
+    int32_t w_bytes = w * 3;
+    int32_t y;
+    for(y = 0; y < h; y++) {
+        int32_t x;
+        for(x = 0; x <= w_bytes - 3 * VEC_BYTES; x += 3 * VEC_BYTES) {
+            vec_storeu(&dest[x], p0);
+            vec_storeu(&dest[x + VEC_BYTES], p1);
+            vec_storeu(&dest[x + 2 * VEC_BYTES], p2);
+        }
+        lv_memcpy(&dest[x], pattern, w_bytes - x);
+        dest += dest_stride;
+    }
+}
+
+static void rgb888_fill_opa(uint8_t * dest, int32_t w, int32_t h, int32_t dest_stride, lv_color_t color, lv_opa_t opa)
+{
+    /*`lv_color_24_24_mix()` doesn't change anything with 0 mix*/
+    if(opa == 0) return;
+
+    uint8_t pattern[3 * VEC_BYTES];
+    int32_t i;
+    for(i = 0; i < 3 * VEC_BYTES; i += 3) {
+        pattern[i + 0] = color.blue;
+        pattern[i + 1] = color.green;
+        pattern[i + 2] = color.red;
+    }
+
+    /*Pre-multiply the color channels of the 3 vectors*/
+    vec_t zero = vec_zero();
+    vec_t opa_v = vec_set1_16(opa);
+    vec_t opa_inv = vec_set1_16(255 - opa);
+    vec_t fg_lo[3];
+    vec_t fg_hi[3];
+    for(i = 0; i < 3; i++) {
+        vec_t p = vec_loadu(&pattern[i * VEC_BYTES]);
+        fg_lo[i] = vec_mullo16(vec_unpacklo8(p, zero), opa_v);
+        fg_hi[i] = vec_mullo16(vec_unpackhi8(p, zero), opa_v);
+    }
+
+    uint8_t dest_tmp[3 * VEC_BYTES];
+    int32_t w_bytes = w * 3;
+    int32_t y;
+    for(y = 0; y < h; y++) {
+        int32_t x;
+        for(x = 0; x < w_bytes; x += 3 * VEC_BYTES) {
+            uint8_t * d = &dest[x];
+            int32_t rest = w_bytes - x;
+            if(rest < 3 * VEC_BYTES) {
+                lv_memcpy(dest_tmp, d, rest);
+                d = dest_tmp;
+            }
+
+            for(i = 0; i < 3; i++) {
+                vec_t bg = vec_loadu(&d[i * VEC_BYTES]);
+                vec_t lo = vec_add16(fg_lo[i], vec_mullo16(vec_unpacklo8(bg, zero), opa_inv));
+                vec_t hi = vec_add16(fg_hi[i], vec_mullo16(vec_unpackhi8(bg, zero), opa_inv));
+                vec_storeu(&d[i * VEC_BYTES], vec_packus16(vec_srli16(lo, 8), vec_srli16(hi, 8)));
+            }
+
+            if(d == dest_tmp) lv_memcpy(&dest[x], dest_tmp, rest);
+        }
+        dest += dest_stride;
+    }
+}
+
+/**
+ * Mix a color or an ARGB8888 image to an XRGB8888 buffer
+ * @param dest          the destination buffer
+ * @param w             width of the area
+ * @param h             height of the area
+ * @param dest_stride   stride of `dest` in bytes
+ * @param src           the ARGB8888 source image or NULL to use `color`
+ * @param src_stride    stride of `src` in bytes
+ * @param color         the XRGB8888 color to use if there is no `src`
+ * @param mask          the mask or NULL
+ * @param mask_stride   stride of `mask` in bytes
+ * @param opa           the overall opacity
+ */
+static inline void xrgb8888_blend(uint32_t * dest, int32_t w, int32_t h, int32_t dest_stride,
+                                  const uint32_t * src, int32_t src_stride, uint32_t color,
+                                  const lv_opa_t * mask, int32_t mask_stride, lv_opa_t opa)
+{
+    vec_t fg = vec_set1_32(color);
+    vec_t opa_v = vec_set1_32(opa);
+
+    uint32_t dest_tmp[VEC_PX32];
+    uint32_t src_tmp[VEC_PX32];
+    lv_opa_t mask_tmp[VEC_PX32];
+    int32_t w_full = w & ~(VEC_PX32 - 1);
+    int32_t w_rest = w - w_full;
+
+    int32_t y;
+    for(y = 0; y < h; y++) {
+        int32_t x;
+        for(x = 0; x < w; x += VEC_PX32) {
+            uint32_t * d = &dest[x];
+            const uint32_t * s = src ? &src[x] : NULL;
+            const lv_opa_t * m = mask ? &mask[x] : NULL;
+            if(x >= w_full) {
+                lv_memzero(dest_tmp, sizeof(dest_tmp));
+                lv_memcpy(dest_tmp, d, w_rest * sizeof(uint32_t));
+                d = dest_tmp;
+                if(s) {
+                    lv_memzero(src_tmp, sizeof(src_tmp));
+                    lv_memcpy(src_tmp, s, w_rest * sizeof(uint32_t));
+                    s = src_tmp;
+                }
+                if(m) {
+                    lv_memzero(mask_tmp, sizeof(mask_tmp));
+                    lv_memcpy(mask_tmp, m, w_rest);
+                    m = mask_tmp;
+                }
+            }
+
+            vec_t mix;
+            if(s) {
+                fg = vec_loadu(s);
+                mix = vec_srli32(fg, 24);
+                if(m && opa < LV_OPA_MAX) mix = opa_mix3(mix, vec_load_u8_32(m), opa_v);
+                else if(m) mix = opa_mix2(mix, vec_load_u8_32(m));
+                else if(opa < LV_OPA_MAX) mix = opa_mix2(mix, opa_v);
+            }
+            else {
+                if(m && opa < LV_OPA_MAX) mix = opa_mix2(opa_v, vec_load_u8_32(m));
+                else if(m) mix = vec_load_u8_32(m);
+                else mix = opa_v;
+            }
+
+            vec_storeu(d, xrgb8888_mix(fg, vec_loadu(d), mix));
+
+            if(d == dest_tmp) lv_memcpy(&dest[x], dest_tmp, w_rest * sizeof(uint32_t));
+        }
+
+        dest = drawbuf_next_row(dest, dest_stride);
+        if(src) src = drawbuf_next_row(src, src_stride);
+        if(mask) mask += mask_stride;
+    }
+}
+
+static void argb8888_fill(uint32_t * dest, int32_t w, int32_t h, int32_t dest_stride, uint32_t color)
+{
+    vec_t c = vec_set1_32(color);
+    int32_t y;
+    for(y = 0; y < h; y++) {
+        int32_t x;
+        for(x = 0; x <= w - VEC_PX32; x += VEC_PX32) {
+            vec_storeu(&dest[x], c);
+        }
+        for(; x < w; x++) {
+            dest[x] = color;
+        }
+        dest = drawbuf_next_row(dest, dest_stride);
+    }
+}
+
+/**
+ * Mix a color or an ARGB8888 image to an ARGB8888 buffer
+ * @param dest          the destination buffer
+ * @param w             width of the area
+ * @param h             height of the area
+ * @param dest_stride   stride of `dest` in bytes
+ * @param src           the source image or NULL to use `color`
+ * @param src_stride    stride of `src` in bytes
+ * @param color         the XRGB8888 color to use if there is no `src`
+ * @param mask          the mask or NULL
+ * @param mask_stride   stride of `mask` in bytes
+ * @param opa           the overall opacity
+ */
+static inline void argb8888_blend(uint32_t * dest, int32_t w, int32_t h, int32_t dest_stride,
+                                  const uint32_t * src, int32_t src_stride, uint32_t color,
+                                  const lv_opa_t * mask, int32_t mask_stride, lv_opa_t opa)
+{
+    vec_t rgb_mask = vec_set1_32(0x00FFFFFF);
+    vec_t fg = vec_set1_32(color);
+    vec_t opa_v = vec_set1_32(opa);
+
+    uint32_t dest_tmp[VEC_PX32];
+    uint32_t src_tmp[VEC_PX32];
+    lv_opa_t mask_tmp[VEC_PX32];
+    int32_t w_full = w & ~(VEC_PX32 - 1);
+    int32_t w_rest = w - w_full;
+
+    int32_t y;
+    for(y = 0; y < h; y++) {
+        int32_t x;
+        for(x = 0; x < w; x += VEC_PX32) {
+            uint32_t * d = &dest[x];
+            const uint32_t * s = src ? &src[x] : NULL;
+            const lv_opa_t * m = mask ? &mask[x] : NULL;
+            if(x >= w_full) {
+                lv_memzero(dest_tmp, sizeof(dest_tmp));
+                lv_memcpy(dest_tmp, d, w_rest * sizeof(uint32_t));
+                d = dest_tmp;
+                if(s) {
+                    lv_memzero(src_tmp, sizeof(src_tmp));
+                    lv_memcpy(src_tmp, s, w_rest * sizeof(uint32_t));
+                    s = src_tmp;
+                }
+                if(m) {
+                    lv_memzero(mask_tmp, sizeof(mask_tmp));
+                    lv_memcpy(mask_tmp, m, w_rest);
+                    m = mask_tmp;
+                }
+            }
+
+            vec_t alpha;
+            if(s) {
+                fg = vec_loadu(s);
+                alpha = vec_srli32(fg, 24);
+                if(m && opa < LV_OPA_MAX) alpha = opa_mix3(alpha, opa_v, vec_load_u8_32(m));
+                else if(m) alpha = opa_mix2(alpha, vec_load_u8_32(m));
+                else if(opa < LV_OPA_MAX) alpha = opa_mix2(alpha, opa_v);
+            }
+            else {
+                if(m && opa < LV_OPA_MAX) alpha = opa_mix2(vec_load_u8_32(m), opa_v);
+                else if(m) alpha = vec_load_u8_32(m);
+                else alpha = opa_v;
+            }
+
+            argb8888_blend_vec(d, vec_or(vec_and(fg, rgb_mask), vec_slli32(alpha, 24)));
+
+            if(d == dest_tmp) lv_memcpy(&dest[x], dest_tmp, w_rest * sizeof(uint32_t));
+        }
+
+        dest = drawbuf_next_row(dest, dest_stride);
+        if(src) src = drawbuf_next_row(src, src_stride);
+        if(mask) mask += mask_stride;
+    }
+}
+
+/**
+ * Same as `lv_color_32_32_mix()` on `VEC_PX32` pixels. The pixels where both
+ * colors are semi-transparent need a division, so they are mixed one by one.
+ * @param dest      pointer to the background pixels, the result is written here
+ * @param fg        the foreground pixels
+ */
+static inline void argb8888_blend_vec(uint32_t * dest, vec_t fg)
+{
+    vec_t bg = vec_loadu(dest);
+    vec_t fg_a = vec_srli32(fg, 24);
+    vec_t bg_a = vec_srli32(bg, 24);
+
+    vec_t use_fg = vec_or(vec_cmpgt32(fg_a, vec_set1_32(LV_OPA_MAX - 1)), vec_cmpgt32(vec_set1_32(LV_OPA_MIN + 1), bg_a));
+    vec_t use_bg = vec_cmpgt32(vec_set1_32(LV_OPA_MIN + 1), fg_a);
+    vec_t bg_opaque = vec_cmpeq32(bg_a, vec_set1_32(255));
+
+    vec_t res = argb8888_mix_opaque(fg, bg);
+    res = vec_select(res, bg, use_bg);
+    res = vec_select(res, fg, use_fg);
+    vec_storeu(dest, res);
+
+    int32_t slow = ~vec_movemask32(vec_or(vec_or(use_fg, use_bg), bg_opaque)) & ((1 << VEC_PX32) - 1);
+    if(slow) {
+        lv_color32_t fg_px[VEC_PX32];
+        lv_color32_t bg_px[VEC_PX32];
+        vec_storeu(fg_px, fg);
+        vec_storeu(bg_px, bg);
+        int32_t i;
+        for(i = 0; i < VEC_PX32; i++) {
+            if(slow & (1 << i)) {
+                lv_color32_t c = argb8888_mix_both_alpha(fg_px[i], bg_px[i]);
+                lv_memcpy(&dest[i], &c, sizeof(c));
+            }
+        }
+    }
+}
+
+/**
+ * The expensive part of `lv_color_32_32_mix()`, used when both colors are semi-transparent
+ * @param fg    the foreground color
+ * @param bg    the background color
+ * @return      the mixed color
+ */
+static lv_color32_t argb8888_mix_both_alpha(lv_color32_t fg, lv_color32_t bg)
+{
+    /*Info:
+     * https://en.wikipedia.org/wiki/Alpha_compositing#Analytical_derivation_of_the_over_operator*/
+    lv_opa_t res_alpha = 255 - LV_OPA_MIX2(255 - fg.alpha, 255 - bg.alpha);
+    fg.alpha = (uint32_t)((uint32_t)fg.alpha * 255) / res_alpha;
+
+    lv_color32_t res = lv_color_mix32(fg, bg);
+    res.alpha = res_alpha;
+    return res;
+}
+
+static inline void * drawbuf_next_row(const void * buf, uint32_t stride)
+{
+    return (void *)((uint8_t *)buf + stride);
+}
+
+#endif /*LV_BLEND_SSE2_AVAILABLE*/
+
+#endif /*LV_USE_DRAW_SW && LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_SSE2*/
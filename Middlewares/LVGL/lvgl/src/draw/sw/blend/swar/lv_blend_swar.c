@@ -0,0 +1,224 @@
+/**
+ * @file lv_blend_swar.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../../../lv_conf_internal.h"
+#if LV_USE_DRAW_SW && LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_SWAR && LV_DRAW_SW_SUPPORT_RGB565
+
+#include "lv_blend_swar.h"
+#include "../../../../misc/lv_color.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/*Convert a mix ratio from the 0..255 range to the 0..32 range used by `lv_color_16_16_mix()`*/
+#define MIX_TO_32(mix)      (((uint32_t)(mix) + 4) >> 3)
+
+/*Mix ratio 32 in both lanes, i.e. keep the foreground pixels*/
+#define MIX2_COVER          0x00200020
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+
+static inline uint32_t LV_ATTRIBUTE_FAST_MEM px_mix(uint32_t fg, uint32_t bg, uint32_t mix);
+static inline uint32_t LV_ATTRIBUTE_FAST_MEM px2_mix(uint32_t fg2, uint32_t bg2, uint32_t mix);
+static inline uint32_t LV_ATTRIBUTE_FAST_MEM px_mix_ratio(const lv_opa_t * mask, int32_t x, lv_opa_t opa);
+static inline uint32_t LV_ATTRIBUTE_FAST_MEM px2_mix_ratio(const lv_opa_t * mask, int32_t x, lv_opa_t opa);
+static inline void LV_ATTRIBUTE_FAST_MEM rgb565_blend(uint16_t * dest, int32_t w, int32_t h, int32_t dest_stride,
+                                                      const uint16_t * src, int32_t src_stride, uint16_t color,
+                                                      const lv_opa_t * mask, int32_t mask_stride, lv_opa_t opa);
+static inline void * LV_ATTRIBUTE_FAST_MEM drawbuf_next_row(const void * buf, uint32_t stride);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+lv_result_t LV_ATTRIBUTE_FAST_MEM lv_color_blend_to_rgb565_with_opa_swar(lv_draw_sw_blend_fill_dsc_t * dsc)
+{
+    rgb565_blend(dsc->dest_buf, dsc->dest_w, dsc->dest_h, dsc->dest_stride, NULL, 0, lv_color_to_u16(dsc->color),
+                 NULL, 0, dsc->opa);
+    return LV_RESULT_OK;
+}
+
+lv_result_t LV_ATTRIBUTE_FAST_MEM lv_color_blend_to_rgb565_with_mask_swar(lv_draw_sw_blend_fill_dsc_t * dsc)
+{
+    rgb565_blend(dsc->dest_buf, dsc->dest_w, dsc->dest_h, dsc->dest_stride, NULL, 0, lv_color_to_u16(dsc->color),
+                 dsc->mask_buf, dsc->mask_stride, LV_OPA_COVER);
+    return LV_RESULT_OK;
+}
+
+lv_result_t LV_ATTRIBUTE_FAST_MEM lv_color_blend_to_rgb565_mix_mask_opa_swar(lv_draw_sw_blend_fill_dsc_t * dsc)
+{
+    rgb565_blend(dsc->dest_buf, dsc->dest_w, dsc->dest_h, dsc->dest_stride, NULL, 0, lv_color_to_u16(dsc->color),
+                 dsc->mask_buf, dsc->mask_stride, dsc->opa);
+    return LV_RESULT_OK;
+}
+
+lv_result_t LV_ATTRIBUTE_FAST_MEM lv_rgb565_blend_normal_to_rgb565_with_opa_swar(lv_draw_sw_blend_image_dsc_t * dsc)
+{
+    rgb565_blend(dsc->dest_buf, dsc->dest_w, dsc->dest_h, dsc->dest_stride, dsc->src_buf, dsc->src_stride, 0,
+                 NULL, 0, dsc->opa);
+    return LV_RESULT_OK;
+}
+
+lv_result_t LV_ATTRIBUTE_FAST_MEM lv_rgb565_blend_normal_to_rgb565_with_mask_swar(lv_draw_sw_blend_image_dsc_t * dsc)
+{
+    rgb565_blend(dsc->dest_buf, dsc->dest_w, dsc->dest_h, dsc->dest_stride, dsc->src_buf, dsc->src_stride, 0,
+                 dsc->mask_buf, dsc->mask_stride, LV_OPA_COVER);
+    return LV_RESULT_OK;
+}
+
+lv_result_t LV_ATTRIBUTE_FAST_MEM lv_rgb565_blend_normal_to_rgb565_mix_mask_opa_swar(lv_draw_sw_blend_image_dsc_t * dsc)
+{
+    rgb565_blend(dsc->dest_buf, dsc->dest_w, dsc->dest_h, dsc->dest_stride, dsc->src_buf, dsc->src_stride, 0,
+                 dsc->mask_buf, dsc->mask_stride, dsc->opa);
+    return LV_RESULT_OK;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Mix one pixel. It's the same as `lv_color_16_16_mix()` but the ratio is already converted.
+ * @param fg    foreground pixel
+ * @param bg    background pixel
+ * @param mix   mix ratio in 0..32 range
+ * @return      the mixed pixel
+ */
+static inline uint32_t LV_ATTRIBUTE_FAST_MEM px_mix(uint32_t fg, uint32_t bg, uint32_t mix)
+{
+    /*Spread the channels with gaps between them and mix them with a single multiplication*/
+    uint32_t fg_s = (fg | (fg << 16)) & 0x07E0F81F;
+    uint32_t bg_s = (bg | (bg << 16)) & 0x07E0F81F;
+    uint32_t res = ((((fg_s - bg_s) * mix) >> 5) + bg_s) & 0x07E0F81F;
+    return (res | (res >> 16)) & 0xFFFF;
+}
+
+/**
+ * Mix two pixels stored in a word with the same ratio.
+ * Each channel of both pixels is moved to the bottom of its 16 bit lane, and `(fg * mix + bg * (32 - mix)) / 32`
+ * is calculated for both lanes at once. It gives the same result as `lv_color_16_16_mix()`,
+ * and the products are smaller than 2^11 so they never overflow into the other lane.
+ * @param fg2   two foreground pixels
+ * @param bg2   two background pixels
+ * @param mix   mix ratio in 0..32 range
+ * @return      the two mixed pixels
+ */
+static inline uint32_t LV_ATTRIBUTE_FAST_MEM px2_mix(uint32_t fg2, uint32_t bg2, uint32_t mix)
+{
+    uint32_t inv = 32 - mix;
+    uint32_t r = ((fg2 >> 11) & 0x001F001F) * mix + ((bg2 >> 11) & 0x001F001F) * inv;
+    uint32_t g = ((fg2 >> 5) & 0x003F003F) * mix + ((bg2 >> 5) & 0x003F003F) * inv;
+    uint32_t b = (fg2 & 0x001F001F) * mix + (bg2 & 0x001F001F) * inv;
+
+    /*Drop the 5 fractional bits and put the channels back to their place*/
+    return ((r << 6) & 0xF800F800) | (g & 0x07E007E0) | ((b >> 5) & 0x001F001F);
+}
+
+/*Get the 0..32 mix ratio of a pixel*/
+static inline uint32_t LV_ATTRIBUTE_FAST_MEM px_mix_ratio(const lv_opa_t * mask, int32_t x, lv_opa_t opa)
+{
+    if(mask == NULL) return MIX_TO_32(opa);
+    else if(opa < LV_OPA_MAX) return MIX_TO_32(LV_OPA_MIX2(mask[x], opa));
+    else return MIX_TO_32(mask[x]);
+}
+
+/*Get the 0..32 mix ratio of two pixels, one in each 16 bit lane*/
+static inline uint32_t LV_ATTRIBUTE_FAST_MEM px2_mix_ratio(const lv_opa_t * mask, int32_t x, lv_opa_t opa)
+{
+    if(mask == NULL) return MIX_TO_32(opa) * 0x00010001;
+
+    uint32_t mix2 = ((uint32_t)mask[x + 1] << 16) | mask[x];
+    if(opa < LV_OPA_MAX) mix2 = ((mix2 * opa) >> 8) & 0x00FF00FF;
+    return ((mix2 + 0x00040004) >> 3) & 0x003F003F;
+}
+
+/**
+ * Blend a color or an RGB565 image to an RGB565 buffer two pixels at a time
+ * @param dest          pointer to the first pixel
+ * @param w             width of the area
+ * @param h             height of the area
+ * @param dest_stride   stride of `dest` in bytes
+ * @param src           the image or NULL to blend `color`
+ * @param src_stride    stride of `src` in bytes
+ * @param color         the color to blend if `src == NULL`
+ * @param mask          mask to apply or NULL
+ * @param mask_stride   stride of `mask` in bytes
+ * @param opa           overall opacity, `LV_OPA_COVER` if only the mask should be used
+ */
+static inline void LV_ATTRIBUTE_FAST_MEM rgb565_blend(uint16_t * dest, int32_t w, int32_t h, int32_t dest_stride,
+                                                      const uint16_t * src, int32_t src_stride, uint16_t color,
+                                                      const lv_opa_t * mask, int32_t mask_stride, lv_opa_t opa)
+{
+    /*The pixels are little endian, so the first pixel is in the lower half of a word*/
+    uint32_t color2 = ((uint32_t)color << 16) | color;
+
+    int32_t x;
+    int32_t y;
+    for(y = 0; y < h; y++) {
+        x = 0;
+
+        /*Start on a word aligned pixel to read and write the destination by words*/
+        if((lv_uintptr_t)dest & 0x3) {
+            dest[0] = px_mix(src ? src[0] : color, dest[0], px_mix_ratio(mask, 0, opa));
+            x = 1;
+        }
+
+        for(; x < w - 1; x += 2) {
+            uint32_t mix2 = px2_mix_ratio(mask, x, opa);
+            if(mix2 == 0) continue;
+
+            uint32_t * dest32 = (uint32_t *)&dest[x];
+            uint32_t fg2 = src ? ((uint32_t)src[x + 1] << 16) | src[x] : color2;
+            if(mix2 == MIX2_COVER) {
+                *dest32 = fg2;
+                continue;
+            }
+
+            uint32_t bg2 = *dest32;
+            uint32_t mix_lo = mix2 & 0xFFFF;
+            uint32_t mix_hi = mix2 >> 16;
+            if(mix_lo == mix_hi) {
+                *dest32 = px2_mix(fg2, bg2, mix_lo);
+            }
+            else {
+                /*Different ratios can't be multiplied in one step, so mix the pixels one by one*/
+                *dest32 = px_mix(fg2 & 0xFFFF, bg2 & 0xFFFF, mix_lo) | (px_mix(fg2 >> 16, bg2 >> 16, mix_hi) << 16);
+            }
+        }
+
+        if(x < w) {
+            dest[x] = px_mix(src ? src[x] : color, dest[x], px_mix_ratio(mask, x, opa));
+        }
+
+        dest = drawbuf_next_row(dest, dest_stride);
+        if(src) src = drawbuf_next_row(src, src_stride);
+        if(mask) mask += mask_stride;
+    }
+}
+
+static inline void * LV_ATTRIBUTE_FAST_MEM drawbuf_next_row(const void * buf, uint32_t stride)
+{
+    return (void *)((uint8_t *)buf + stride);
+}
+
+#endif /*LV_USE_DRAW_SW && LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_SWAR && LV_DRAW_SW_SUPPORT_RGB565*/
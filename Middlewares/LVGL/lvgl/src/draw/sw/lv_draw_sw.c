@@ -12,6 +12,7 @@
 
 #include "../../core/lv_refr.h"
 #include "../../display/lv_display_private.h"
+#include "../../misc/lv_area_private.h"
 #include "../../stdlib/lv_string.h"
 #include "../../core/lv_global.h"
 
@@ -38,6 +39,10 @@
  *********************/
 #define DRAW_UNIT_ID_SW     1
 
+#if LV_DRAW_SW_TILE_SPLIT
+    #define tile_mutex LV_GLOBAL_DEFAULT()->sw_tile_mutex
+#endif
+
 #ifndef LV_DRAW_SW_RGB565_SWAP
     #define LV_DRAW_SW_RGB565_SWAP(...) LV_RESULT_INVALID
 #endif
@@ -101,7 +106,16 @@
     static void render_thread_cb(void * ptr);
 #endif
 
-static void execute_drawing(lv_draw_sw_unit_t * u);
+static void execute_drawing(lv_draw_sw_unit_t * u, lv_draw_task_t * t);
+
+#if LV_DRAW_SW_TILE_SPLIT
+    static bool split_task(lv_draw_sw_unit_t * u, lv_draw_task_t * t);
+    static bool image_is_used_directly(const lv_draw_image_dsc_t * dsc);
+    static bool has_own_task(lv_draw_sw_unit_t * u);
+    static bool has_tile(void);
+    static lv_draw_sw_unit_t * take_tile(lv_draw_sw_unit_t * u, lv_area_t * tile);
+    static void render_tiles(lv_draw_sw_unit_t * u);
+#endif
 
 static int32_t dispatch(lv_draw_unit_t * draw_unit, lv_layer_t * layer);
 static int32_t evaluate(lv_draw_unit_t * draw_unit, lv_draw_task_t * task);
@@ -168,6 +182,10 @@ void lv_draw_sw_init(void)
     lv_draw_sw_mask_init();
 #endif
 
+#if LV_DRAW_SW_TILE_SPLIT
+    lv_mutex_init(&tile_mutex);
+#endif
+
     uint32_t i;
     for(i = 0; i < LV_DRAW_SW_DRAW_UNIT_CNT; i++) {
         lv_draw_sw_unit_t * draw_sw_unit = lv_draw_create_unit(sizeof(lv_draw_sw_unit_t));
@@ -195,6 +213,23 @@ void lv_draw_sw_deinit(void)
 #if LV_DRAW_SW_COMPLEX == 1
     lv_draw_sw_mask_deinit();
 #endif
+
+#if LV_DRAW_SW_TILE_SPLIT
+    /*The render threads use the tile mutex until they exit, so stop them before deleting it.
+     *`lv_deinit()` calls this function twice and before deleting the draw units.*/
+    bool stopped = false;
+    lv_draw_unit_t * u = _draw_info.unit_head;
+    while(u) {
+        if(u->delete_cb == lv_draw_sw_delete) {
+            lv_draw_sw_delete(u);
+            u->delete_cb = NULL;
+            stopped = true;
+        }
+        u = u->next;
+    }
+
+    if(stopped) lv_mutex_delete(&tile_mutex);
+#endif
 }
 
 static int32_t lv_draw_sw_delete(lv_draw_unit_t * draw_unit)
@@ -380,7 +415,7 @@ void lv_draw_sw_rotate(const void * src, void * dest, int32_t src_width, int32_t
  **********************/
 static inline void execute_drawing_unit(lv_draw_sw_unit_t * u)
 {
-    execute_drawing(u);
+    execute_drawing(u, u->task_act);
 
     u->task_act->state = LV_DRAW_TASK_STATE_READY;
     u->task_act = NULL;
@@ -438,6 +473,14 @@ static int32_t dispatch(lv_draw_unit_t * draw_unit, lv_layer_t * layer)
         return 0;
     }
 
+#if LV_DRAW_SW_TILE_SPLIT
+    /*Or with a tile of an other unit's draw task*/
+    if(draw_sw_unit->tile_busy) {
+        LV_PROFILER_END;
+        return 0;
+    }
+#endif
+
     lv_draw_task_t * t = NULL;
     t = lv_draw_get_next_available_task(layer, NULL, DRAW_UNIT_ID_SW);
     if(t == NULL) {
@@ -451,11 +494,38 @@ static int32_t dispatch(lv_draw_unit_t * draw_unit, lv_layer_t * layer)
         return LV_DRAW_UNIT_IDLE;  /*Couldn't start rendering*/
     }
 
+#if LV_DRAW_SW_TILE_SPLIT
+    /*The render thread might have started a stolen tile since the check above*/
+    lv_mutex_lock(&tile_mutex);
+    if(draw_sw_unit->tile_busy) {
+        lv_mutex_unlock(&tile_mutex);
+        LV_PROFILER_END;
+        return 0;
+    }
+#endif
+
     t->state = LV_DRAW_TASK_STATE_IN_PROGRESS;
     draw_sw_unit->base_unit.target_layer = layer;
     draw_sw_unit->base_unit.clip_area = &t->clip_area;
     draw_sw_unit->task_act = t;
 
+#if LV_DRAW_SW_TILE_SPLIT
+    bool split = split_task(draw_sw_unit, t);
+    lv_mutex_unlock(&tile_mutex);
+
+    if(split) {
+        /*Wake up all the units to help rendering the tiles*/
+        lv_draw_unit_t * u = _draw_info.unit_head;
+        while(u) {
+            lv_draw_sw_unit_t * sw_u = (lv_draw_sw_unit_t *)u;
+            if(u->dispatch_cb == dispatch && sw_u->inited) lv_thread_sync_signal(&sw_u->sync);
+            u = u->next;
+        }
+        LV_PROFILER_END;
+        return 1;
+    }
+#endif
+
 #if LV_USE_OS
     /*Let the render thread work*/
     if(draw_sw_unit->inited) lv_thread_sync_signal(&draw_sw_unit->sync);
@@ -475,7 +545,11 @@ static void render_thread_cb(void * ptr)
     u->inited = true;
 
     while(1) {
+#if LV_DRAW_SW_TILE_SPLIT
+        while(!has_own_task(u) && !has_tile()) {
+#else
         while(u->task_act == NULL) {
+#endif
             if(u->exit_status) {
                 break;
             }
@@ -487,6 +561,13 @@ static void render_thread_cb(void * ptr)
             break;
         }
 
+#if LV_DRAW_SW_TILE_SPLIT
+        if(!has_own_task(u)) {
+            render_tiles(u);
+            continue;
+        }
+#endif
+
         execute_drawing_unit(u);
     }
 
@@ -496,11 +577,183 @@ static void render_thread_cb(void * ptr)
 }
 #endif
 
-static void execute_drawing(lv_draw_sw_unit_t * u)
+#if LV_DRAW_SW_TILE_SPLIT
+/**
+ * Split a large draw task into horizontal tiles and put them into the deque of the unit.
+ * Must be called with `tile_mutex` locked.
+ * @param u     the draw unit owning the draw task
+ * @param t     the draw task
+ * @return      true: the task was split; false: the task is small or can't be split
+ */
+static bool split_task(lv_draw_sw_unit_t * u, lv_draw_task_t * t)
+{
+    /*Every tile prepares its part from scratch. For these it's cheap: the radius masks are
+     *shared through the locked circle cache and layers are already rendered.*/
+    switch(t->type) {
+        case LV_DRAW_TASK_TYPE_FILL:
+        case LV_DRAW_TASK_TYPE_BORDER:
+        case LV_DRAW_TASK_TYPE_LAYER:
+            break;
+        case LV_DRAW_TASK_TYPE_IMAGE:
+            /*Each tile opens the image again so don't split images which would be decoded for each tile*/
+            if(!image_is_used_directly(t->draw_dsc)) return false;
+            break;
+        default:
+            return false;
+    }
+
+    lv_area_t draw_area;
+    if(!lv_area_intersect(&draw_area, &t->_real_area, &t->clip_area)) return false;
+    if(lv_area_get_size(&draw_area) < LV_DRAW_SW_TILE_SPLIT_THRESHOLD) return false;
+
+    int32_t h = lv_area_get_height(&draw_area);
+    int32_t tile_cnt = LV_MIN(h, LV_DRAW_SW_TILE_MAX);
+    if(tile_cnt < 2) return false;
+
+    int32_t i;
+    int32_t y = draw_area.y1;
+    for(i = 0; i < tile_cnt; i++) {
+        lv_area_t * tile = &u->tiles[i];
+        *tile = t->clip_area;
+        tile->y1 = y;
+        tile->y2 = draw_area.y1 + (h * (i + 1)) / tile_cnt - 1;
+        y = tile->y2 + 1;
+    }
+
+    u->tile_head = 0;
+    u->tile_tail = tile_cnt;
+    u->tile_pending = tile_cnt;
+    u->tile_layer = u->base_unit.target_layer;
+    u->task_split = true;
+
+    return true;
+}
+
+/**
+ * Check if an image can be drawn from its source data, i.e. opening it doesn't decode or copy it
+ * @param dsc   the draw descriptor of an image
+ * @return      true: the image is used directly
+ */
+static bool image_is_used_directly(const lv_draw_image_dsc_t * dsc)
+{
+    if(dsc->bitmap_mask_src) return false;
+    if(lv_image_src_get_type(dsc->src) != LV_IMAGE_SRC_VARIABLE) return false;
+
+    const lv_image_dsc_t * img = dsc->src;
+    if(img->header.flags & LV_IMAGE_FLAGS_COMPRESSED) return false;
+    if(LV_COLOR_FORMAT_IS_INDEXED(img->header.cf)) return false;
+    if(LV_COLOR_FORMAT_IS_ALPHA_ONLY(img->header.cf)) return false;
+
+    return true;
+}
+
+/**
+ * Check if the unit has a draw task which is not split into tiles
+ * @param u     pointer to a draw unit
+ * @return      true: the task can be rendered with `execute_drawing_unit`
+ */
+static bool has_own_task(lv_draw_sw_unit_t * u)
+{
+    lv_mutex_lock(&tile_mutex);
+    bool res = u->task_act && !u->task_split;
+    lv_mutex_unlock(&tile_mutex);
+    return res;
+}
+
+/**
+ * Check if any unit has a tile waiting for rendering
+ * @return      true: there is at least one tile to render
+ */
+static bool has_tile(void)
+{
+    bool res = false;
+    lv_mutex_lock(&tile_mutex);
+    lv_draw_unit_t * u = _draw_info.unit_head;
+    while(u && !res) {
+        lv_draw_sw_unit_t * sw_u = (lv_draw_sw_unit_t *)u;
+        if(u->dispatch_cb == dispatch && sw_u->tile_head != sw_u->tile_tail) res = true;
+        u = u->next;
+    }
+    lv_mutex_unlock(&tile_mutex);
+    return res;
+}
+
+/**
+ * Take a tile from the tail of the unit's own deque or steal one from the head of an other unit's deque.
+ * Must be called with `tile_mutex` locked.
+ * @param u     the draw unit looking for work
+ * @param tile  store the clip area of the tile here
+ * @return      the unit owning the draw task of the tile or NULL if there are no tiles
+ */
+static lv_draw_sw_unit_t * take_tile(lv_draw_sw_unit_t * u, lv_area_t * tile)
+{
+    if(u->tile_head != u->tile_tail) {
+        u->tile_tail--;
+        *tile = u->tiles[u->tile_tail];
+        return u;
+    }
+
+    lv_draw_unit_t * victim = _draw_info.unit_head;
+    while(victim) {
+        lv_draw_sw_unit_t * sw_victim = (lv_draw_sw_unit_t *)victim;
+        if(victim->dispatch_cb == dispatch && sw_victim->tile_head != sw_victim->tile_tail) {
+            *tile = sw_victim->tiles[sw_victim->tile_head];
+            sw_victim->tile_head++;
+            return sw_victim;
+        }
+        victim = victim->next;
+    }
+
+    return NULL;
+}
+
+/**
+ * Render tiles of split draw tasks while there are any.
+ * The unit which renders the last tile of a draw task marks the task ready.
+ * @param u     pointer to a draw unit
+ */
+static void render_tiles(lv_draw_sw_unit_t * u)
+{
+    while(1) {
+        lv_mutex_lock(&tile_mutex);
+        lv_draw_sw_unit_t * owner = NULL;
+        /*A draw task might have been assigned to this unit meanwhile. Render that first.*/
+        if(u->task_act == NULL || u->task_split) {
+            owner = take_tile(u, &u->tile_clip_area);
+            u->tile_busy = owner != NULL;
+        }
+        lv_mutex_unlock(&tile_mutex);
+
+        if(owner == NULL) break;
+
+        /*The owner's task and layer can't change until all of its tiles are ready*/
+        lv_draw_task_t * t = owner->task_act;
+        u->base_unit.target_layer = owner->tile_layer;
+        u->base_unit.clip_area = &u->tile_clip_area;
+        lv_area_intersect(&u->tile_clip_area, &u->tile_clip_area, &t->clip_area);
+        execute_drawing(u, t);
+
+        lv_mutex_lock(&tile_mutex);
+        u->tile_busy = false;
+        owner->tile_pending--;
+        bool last = owner->tile_pending == 0;
+        if(last) {
+            t->state = LV_DRAW_TASK_STATE_READY;
+            owner->task_split = false;
+            owner->task_act = NULL;
+        }
+        lv_mutex_unlock(&tile_mutex);
+    }
+
+    /*This unit (and maybe the owner of the last tile) is free now*/
+    lv_draw_dispatch_request();
+}
+#endif /*LV_DRAW_SW_TILE_SPLIT*/
+
+static void execute_drawing(lv_draw_sw_unit_t * u, lv_draw_task_t * t)
 {
     LV_PROFILER_BEGIN;
     /*Render the draw task*/
-    lv_draw_task_t * t = u->task_act;
     switch(t->type) {
         case LV_DRAW_TASK_TYPE_FILL:
             lv_draw_sw_fill((lv_draw_unit_t *)u, t->draw_dsc, &t->area);
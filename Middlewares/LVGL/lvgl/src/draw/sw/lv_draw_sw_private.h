@@ -23,6 +23,12 @@ extern "C" {
  *      DEFINES
  *********************/
 
+/** Large draw tasks are split into tiles only if more threads can render in parallel*/
+#define LV_DRAW_SW_TILE_SPLIT   (LV_USE_OS && LV_DRAW_SW_DRAW_UNIT_CNT > 1 && LV_DRAW_SW_TILE_SPLIT_THRESHOLD > 0)
+
+/** Max number of tiles a draw task is split into*/
+#define LV_DRAW_SW_TILE_MAX     (LV_DRAW_SW_DRAW_UNIT_CNT * 2)
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -39,6 +45,18 @@ struct lv_draw_sw_unit_t {
     lv_thread_t thread;
     volatile bool inited;
     volatile bool exit_status;
+#endif
+#if LV_DRAW_SW_TILE_SPLIT
+    /** Tiles of `task_act` waiting for rendering. The unit takes them from the tail
+     *  while the other units can steal them from the head. Protected by `sw_tile_mutex`*/
+    lv_area_t tiles[LV_DRAW_SW_TILE_MAX];
+    uint32_t tile_head;
+    uint32_t tile_tail;
+    uint32_t tile_pending;      /**< Tiles of `task_act` not rendered yet*/
+    lv_layer_t * tile_layer;    /**< Target layer of `task_act`*/
+    lv_area_t tile_clip_area;   /**< Clip area while rendering a tile (of any unit)*/
+    bool task_split;            /**< `task_act` is rendered in tiles*/
+    bool tile_busy;             /**< Rendering a tile so the unit can't get a new task*/
 #endif
     uint32_t idx;
 };
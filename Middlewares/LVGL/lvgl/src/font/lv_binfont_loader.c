@@ -121,6 +121,12 @@ void lv_binfont_destroy(lv_font_t * font)
     const lv_font_fmt_txt_dsc_t * dsc = font->dsc;
     if(dsc == NULL) return;
 
+#if LV_USE_FONT_COMPRESSED
+    /*The cached glyphs would be found by a new font allocated to the same address*/
+    if(dsc->bitmap_format != LV_FONT_FMT_TXT_PLAIN) lv_font_fmt_txt_cache_drop_all();
+#endif
+    lv_font_fmt_txt_lookup_release(font);
+
     if(dsc->kern_classes == 0) {
         const lv_font_fmt_txt_kern_pair_t * kern_dsc = dsc->kern_dsc;
         if(NULL != kern_dsc) {
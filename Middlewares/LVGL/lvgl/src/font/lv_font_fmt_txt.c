@@ -14,14 +14,43 @@
 #include "../misc/lv_log.h"
 #include "../misc/lv_utils.h"
 #include "../stdlib/lv_mem.h"
+#include "../stdlib/lv_string.h"
+#include "../misc/cache/lv_cache.h"
 
 /*********************
  *      DEFINES
  *********************/
 #if LV_USE_FONT_COMPRESSED
     #define font_rle LV_GLOBAL_DEFAULT()->font_fmt_rle
+    #define glyph_cache_p (LV_GLOBAL_DEFAULT()->font_fmt_txt_cache)
+    #define glyph_cache_stat (LV_GLOBAL_DEFAULT()->font_fmt_txt_cache_stat)
+    #define glyph_cache_stat_mutex (LV_GLOBAL_DEFAULT()->font_fmt_txt_cache_stat_mutex)
+    #define font_draw_buf_handlers &(LV_GLOBAL_DEFAULT()->font_draw_buf_handlers)
+    #define GLYPH_CACHE_NAME "FONT_FMT_TXT"
 #endif /*LV_USE_FONT_COMPRESSED*/
 
+#if LV_FONT_FMT_TXT_LETTER_CACHE_SIZE
+    #define letter_cache LV_GLOBAL_DEFAULT()->font_fmt_txt_letter_cache
+#endif
+
+/*The letter cache and the index are shared with the draw threads. Without an OS there are no other threads.*/
+#if (LV_FONT_FMT_TXT_LETTER_CACHE_SIZE || LV_USE_FONT_FMT_TXT_LOOKUP_INDEX) && LV_USE_OS != LV_OS_NONE
+    #define LOOKUP_LOCK 1
+    #define lookup_mutex LV_GLOBAL_DEFAULT()->font_fmt_txt_lookup_mutex
+#else
+    #define LOOKUP_LOCK 0
+#endif
+
+#if LV_USE_FONT_FMT_TXT_LOOKUP_INDEX
+    #define index_head LV_GLOBAL_DEFAULT()->font_fmt_txt_index_head
+
+    /*Sparse cmaps with shorter `unicode_list` are searched quickly enough with binary search*/
+    #define INDEX_MIN_LIST_LENGTH   64
+
+    /*Average number of `unicode_list` elements in a page (at most)*/
+    #define INDEX_PAGE_ELEMENTS     4
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -35,7 +64,15 @@ typedef struct {
  **********************/
 static uint32_t get_glyph_dsc_id(const lv_font_t * font, uint32_t letter);
 static int8_t get_kern_value(const lv_font_t * font, uint32_t gid_left, uint32_t gid_right);
+static uint32_t find_glyph_dsc_id(const lv_font_fmt_txt_dsc_t * fdsc, uint32_t letter);
+static int32_t unicode_list_find(const lv_font_fmt_txt_dsc_t * fdsc, uint32_t cmap_i, uint16_t rcp);
 static int unicode_list_compare(const void * ref, const void * element);
+#if LV_USE_FONT_FMT_TXT_LOOKUP_INDEX
+    static const lv_font_fmt_txt_index_t * index_get(const lv_font_fmt_txt_dsc_t * fdsc);
+    static lv_font_fmt_txt_index_t * index_create(const lv_font_fmt_txt_dsc_t * fdsc);
+    static bool index_is_needed(const lv_font_fmt_txt_cmap_t * cmap);
+    static uint8_t index_get_page_shift(const lv_font_fmt_txt_cmap_t * cmap);
+#endif
 static int kern_pair_8_compare(const void * ref, const void * element);
 static int kern_pair_16_compare(const void * ref, const void * element);
 
@@ -45,6 +82,13 @@ static int kern_pair_16_compare(const void * ref, const void * element);
     static inline uint8_t get_bits(const uint8_t * in, uint32_t bit_pos, uint8_t len);
     static inline void rle_init(const uint8_t * in,  uint8_t bpp);
     static inline uint8_t rle_next(void);
+    static const lv_draw_buf_t * glyph_cache_get(lv_font_glyph_dsc_t * g_dsc, const lv_font_fmt_txt_dsc_t * fdsc);
+    static void glyph_cache_add(const lv_font_glyph_dsc_t * g_dsc, const lv_font_fmt_txt_dsc_t * fdsc,
+                                const lv_draw_buf_t * draw_buf);
+    static lv_cache_compare_res_t glyph_cache_compare_cb(const lv_font_fmt_txt_cache_data_t * lhs,
+                                                         const lv_font_fmt_txt_cache_data_t * rhs);
+    static uint32_t glyph_cache_hash_cb(const lv_font_fmt_txt_cache_data_t * node);
+    static void glyph_cache_free_cb(lv_font_fmt_txt_cache_data_t * node, void * user_data);
 #endif /*LV_USE_FONT_COMPRESSED*/
 
 /**********************
@@ -151,9 +195,14 @@ const void * lv_font_get_bitmap_fmt_txt(lv_font_glyph_dsc_t * g_dsc, lv_draw_buf
     /*Handle compressed bitmap*/
     else {
 #if LV_USE_FONT_COMPRESSED
+        /*Decompressing is slow, so use the bitmap from the last time if it's still cached*/
+        const lv_draw_buf_t * cached = glyph_cache_get(g_dsc, fdsc);
+        if(cached) return cached;
+
         bool prefilter = fdsc->bitmap_format == LV_FONT_FMT_TXT_COMPRESSED;
         decompress(&fdsc->glyph_bitmap[gdsc->bitmap_index], bitmap_out, gdsc->box_w, gdsc->box_h,
                    (uint8_t)fdsc->bpp, prefilter);
+        glyph_cache_add(g_dsc, fdsc, draw_buf);
         return draw_buf;
 #else /*!LV_USE_FONT_COMPRESSED*/
         LV_LOG_WARN("Compressed fonts is used but LV_USE_FONT_COMPRESSED is not enabled in lv_conf.h");
@@ -204,12 +253,139 @@ bool lv_font_get_glyph_dsc_fmt_txt(const lv_font_t * font, lv_font_glyph_dsc_t *
     dsc_out->format = (uint8_t)fdsc->bpp;
     dsc_out->is_placeholder = false;
     dsc_out->gid.index = gid;
+    dsc_out->entry = NULL;
 
     if(is_tab) dsc_out->box_w = dsc_out->box_w * 2;
 
     return true;
 }
 
+#if LV_USE_FONT_COMPRESSED
+
+void lv_font_fmt_txt_release_glyph(const lv_font_t * font, lv_font_glyph_dsc_t * g_dsc)
+{
+    LV_UNUSED(font);
+
+    if(g_dsc->entry == NULL) return;
+
+    lv_cache_release(glyph_cache_p, g_dsc->entry, NULL);
+    g_dsc->entry = NULL;
+}
+
+void lv_font_fmt_txt_cache_get_stat(lv_font_fmt_txt_cache_stat_t * stat)
+{
+    LV_ASSERT_NULL(stat);
+
+    lv_mutex_lock(&glyph_cache_stat_mutex);
+    *stat = glyph_cache_stat;
+    lv_mutex_unlock(&glyph_cache_stat_mutex);
+    stat->size = glyph_cache_p ? (uint32_t)lv_cache_get_size(glyph_cache_p, NULL) : 0;
+}
+
+void lv_font_fmt_txt_cache_reset_stat(void)
+{
+    lv_mutex_lock(&glyph_cache_stat_mutex);
+    glyph_cache_stat.hit_cnt = 0;
+    glyph_cache_stat.miss_cnt = 0;
+    lv_mutex_unlock(&glyph_cache_stat_mutex);
+}
+
+void lv_font_fmt_txt_cache_drop_all(void)
+{
+    if(glyph_cache_p == NULL) return;
+
+    lv_cache_drop_all(glyph_cache_p, NULL);
+}
+
+void lv_font_fmt_txt_cache_init(void)
+{
+    /*Create the cache here as the draw units of other threads would race to create it on first use*/
+    lv_mutex_init(&glyph_cache_stat_mutex);
+    if(LV_FONT_FMT_TXT_CACHE_SIZE == 0) return;
+
+    glyph_cache_p = lv_cache_create(lv_cache_class_get(LV_FONT_FMT_TXT_CACHE_POLICY, true),
+    sizeof(lv_font_fmt_txt_cache_data_t), LV_FONT_FMT_TXT_CACHE_SIZE, (lv_cache_ops_t) {
+        .compare_cb = (lv_cache_compare_cb_t) glyph_cache_compare_cb,
+        .create_cb = NULL,
+        .free_cb = (lv_cache_free_cb_t) glyph_cache_free_cb,
+        .hash_cb = (lv_cache_hash_cb_t) glyph_cache_hash_cb,
+    });
+    if(glyph_cache_p == NULL) {
+        LV_LOG_WARN("couldn't create the glyph cache");
+        return;
+    }
+
+    lv_cache_set_name(glyph_cache_p, GLYPH_CACHE_NAME);
+}
+
+void lv_font_fmt_txt_cache_deinit(void)
+{
+    lv_mutex_delete(&glyph_cache_stat_mutex);
+    if(glyph_cache_p == NULL) return;
+
+    lv_cache_destroy(glyph_cache_p, NULL);
+    glyph_cache_p = NULL;
+}
+
+#endif /*LV_USE_FONT_COMPRESSED*/
+
+void lv_font_fmt_txt_lookup_init(void)
+{
+#if LOOKUP_LOCK
+    lv_mutex_init(&lookup_mutex);
+#endif
+}
+
+void lv_font_fmt_txt_lookup_release(const lv_font_t * font)
+{
+    LV_ASSERT_NULL(font);
+    const lv_font_fmt_txt_dsc_t * fdsc = font->dsc;
+    LV_UNUSED(fdsc);
+
+#if LOOKUP_LOCK
+    lv_mutex_lock(&lookup_mutex);
+#endif
+
+#if LV_FONT_FMT_TXT_LETTER_CACHE_SIZE
+    uint32_t i;
+    for(i = 0; i < LV_FONT_FMT_TXT_LETTER_CACHE_SIZE; i++) {
+        if(letter_cache[i].fdsc == fdsc) lv_memzero(&letter_cache[i], sizeof(letter_cache[i]));
+    }
+#endif
+
+#if LV_USE_FONT_FMT_TXT_LOOKUP_INDEX
+    lv_font_fmt_txt_index_t ** next_p = &index_head;
+    while(*next_p) {
+        lv_font_fmt_txt_index_t * index = *next_p;
+        if(index->fdsc == fdsc) {
+            *next_p = index->next;
+            lv_free(index);
+            break;
+        }
+        next_p = &index->next;
+    }
+#endif
+
+#if LOOKUP_LOCK
+    lv_mutex_unlock(&lookup_mutex);
+#endif
+}
+
+void lv_font_fmt_txt_lookup_deinit(void)
+{
+#if LV_USE_FONT_FMT_TXT_LOOKUP_INDEX
+    while(index_head) {
+        lv_font_fmt_txt_index_t * next = index_head->next;
+        lv_free(index_head);
+        index_head = next;
+    }
+#endif
+
+#if LOOKUP_LOCK
+    lv_mutex_delete(&lookup_mutex);
+#endif
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
@@ -218,8 +394,49 @@ static uint32_t get_glyph_dsc_id(const lv_font_t * font, uint32_t letter)
 {
     if(letter == '\0') return 0;
 
-    lv_font_fmt_txt_dsc_t * fdsc = (lv_font_fmt_txt_dsc_t *)font->dsc;
+    const lv_font_fmt_txt_dsc_t * fdsc = font->dsc;
+
+#if LV_FONT_FMT_TXT_LETTER_CACHE_SIZE || LV_USE_FONT_FMT_TXT_LOOKUP_INDEX
+    /*The letters of the first range (usually ASCII) are found directly, faster than through the cache*/
+    if(fdsc->cmap_num > 0 && fdsc->cmaps[0].type == LV_FONT_FMT_TXT_CMAP_FORMAT0_TINY) {
+        uint32_t rcp = letter - fdsc->cmaps[0].range_start;
+        if(rcp < fdsc->cmaps[0].range_length) return fdsc->cmaps[0].glyph_id_start + rcp;
+    }
+#endif
 
+#if LOOKUP_LOCK
+    /*The draw units of other threads look up letters too*/
+    lv_mutex_lock(&lookup_mutex);
+#endif
+
+#if LV_FONT_FMT_TXT_LETTER_CACHE_SIZE
+    /*Every letter is looked up at least twice: as `letter` and as `letter_next` for kerning.
+     *Texts also use only a few different letters, so remember the recent ones.*/
+    uint32_t slot = (letter ^ (uint32_t)((lv_uintptr_t)fdsc >> 4)) & (LV_FONT_FMT_TXT_LETTER_CACHE_SIZE - 1);
+    lv_font_fmt_txt_letter_cache_t * cached = &letter_cache[slot];
+    uint32_t gid;
+    if(cached->fdsc == fdsc && cached->letter == letter) {
+        gid = cached->gid;
+    }
+    else {
+        gid = find_glyph_dsc_id(fdsc, letter);
+        cached->fdsc = fdsc;
+        cached->letter = letter;
+        cached->gid = gid;
+    }
+#else
+    uint32_t gid = find_glyph_dsc_id(fdsc, letter);
+#endif
+
+#if LOOKUP_LOCK
+    lv_mutex_unlock(&lookup_mutex);
+#endif
+
+    return gid;
+}
+
+static uint32_t find_glyph_dsc_id(const lv_font_fmt_txt_dsc_t * fdsc, uint32_t letter)
+{
     uint16_t i;
     for(i = 0; i < fdsc->cmap_num; i++) {
 
@@ -235,22 +452,14 @@ static uint32_t get_glyph_dsc_id(const lv_font_t * font, uint32_t letter)
             glyph_id = fdsc->cmaps[i].glyph_id_start + gid_ofs_8[rcp];
         }
         else if(fdsc->cmaps[i].type == LV_FONT_FMT_TXT_CMAP_SPARSE_TINY) {
-            uint16_t key = rcp;
-            uint16_t * p = lv_utils_bsearch(&key, fdsc->cmaps[i].unicode_list, fdsc->cmaps[i].list_length,
-                                            sizeof(fdsc->cmaps[i].unicode_list[0]), unicode_list_compare);
-
-            if(p) {
-                lv_uintptr_t ofs = p - fdsc->cmaps[i].unicode_list;
+            int32_t ofs = unicode_list_find(fdsc, i, (uint16_t)rcp);
+            if(ofs >= 0) {
                 glyph_id = fdsc->cmaps[i].glyph_id_start + (uint32_t) ofs;
             }
         }
         else if(fdsc->cmaps[i].type == LV_FONT_FMT_TXT_CMAP_SPARSE_FULL) {
-            uint16_t key = rcp;
-            uint16_t * p = lv_utils_bsearch(&key, fdsc->cmaps[i].unicode_list, fdsc->cmaps[i].list_length,
-                                            sizeof(fdsc->cmaps[i].unicode_list[0]), unicode_list_compare);
-
-            if(p) {
-                lv_uintptr_t ofs = p - fdsc->cmaps[i].unicode_list;
+            int32_t ofs = unicode_list_find(fdsc, i, (uint16_t)rcp);
+            if(ofs >= 0) {
                 const uint16_t * gid_ofs_16 = fdsc->cmaps[i].glyph_id_ofs_list;
                 glyph_id = fdsc->cmaps[i].glyph_id_start + gid_ofs_16[ofs];
             }
@@ -263,6 +472,149 @@ static uint32_t get_glyph_dsc_id(const lv_font_t * font, uint32_t letter)
 
 }
 
+/**
+ * Find a relative code point in the `unicode_list` of a sparse cmap.
+ * @param fdsc      the font's descriptor
+ * @param cmap_i    index of the cmap
+ * @param rcp       the code point relative to `range_start`
+ * @return          index of `rcp` in `unicode_list` or -1 if not found
+ */
+static int32_t unicode_list_find(const lv_font_fmt_txt_dsc_t * fdsc, uint32_t cmap_i, uint16_t rcp)
+{
+    const lv_font_fmt_txt_cmap_t * cmap = &fdsc->cmaps[cmap_i];
+    const uint16_t * list = cmap->unicode_list;
+
+#if LV_USE_FONT_FMT_TXT_LOOKUP_INDEX
+    if(index_is_needed(cmap)) {
+        const lv_font_fmt_txt_index_t * index = index_get(fdsc);
+        if(index) {
+            /*Binary search only among the few elements of the page of `rcp`*/
+            const lv_font_fmt_txt_cmap_index_t * cmap_index = &index->cmaps[cmap_i];
+            uint32_t page = rcp >> cmap_index->page_shift;
+            int32_t min = cmap_index->page_start[page];
+            int32_t max = (int32_t)cmap_index->page_start[page + 1] - 1;
+            while(min <= max) {
+                int32_t mid = (min + max) >> 1;
+                if(list[mid] < rcp) min = mid + 1;
+                else if(list[mid] > rcp) max = mid - 1;
+                else return mid;
+            }
+            return -1;
+        }
+    }
+#endif
+
+    uint16_t key = rcp;
+    uint16_t * p = lv_utils_bsearch(&key, list, cmap->list_length, sizeof(list[0]), unicode_list_compare);
+    if(p == NULL) return -1;
+
+    return (int32_t)(p - list);
+}
+
+#if LV_USE_FONT_FMT_TXT_LOOKUP_INDEX
+/**
+ * Get the lookup index of a font and create it on first use.
+ * @param fdsc      the font's descriptor
+ * @return          the index or NULL if it couldn't be created
+ */
+static const lv_font_fmt_txt_index_t * index_get(const lv_font_fmt_txt_dsc_t * fdsc)
+{
+    lv_font_fmt_txt_index_t ** next_p = &index_head;
+    while(*next_p) {
+        lv_font_fmt_txt_index_t * index = *next_p;
+        if(index->fdsc == fdsc) {
+            /*Move it to the front as the same font will be probably used again*/
+            if(index != index_head) {
+                *next_p = index->next;
+                index->next = index_head;
+                index_head = index;
+            }
+            return index;
+        }
+        next_p = &index->next;
+    }
+
+    lv_font_fmt_txt_index_t * index = index_create(fdsc);
+    if(index == NULL) return NULL;
+
+    index->next = index_head;
+    index_head = index;
+    return index;
+}
+
+/**
+ * Create the page index of the large sparse cmaps of a font in one allocation.
+ * @param fdsc      the font's descriptor
+ * @return          the new index or NULL on out of memory
+ */
+static lv_font_fmt_txt_index_t * index_create(const lv_font_fmt_txt_dsc_t * fdsc)
+{
+    uint32_t size = sizeof(lv_font_fmt_txt_index_t) + fdsc->cmap_num * sizeof(lv_font_fmt_txt_cmap_index_t);
+    uint32_t i;
+    for(i = 0; i < fdsc->cmap_num; i++) {
+        const lv_font_fmt_txt_cmap_t * cmap = &fdsc->cmaps[i];
+        if(!index_is_needed(cmap)) continue;
+        uint32_t page_cnt = (((uint32_t)cmap->range_length - 1) >> index_get_page_shift(cmap)) + 1;
+        size += (page_cnt + 1) * sizeof(uint16_t);
+    }
+
+    lv_font_fmt_txt_index_t * index = lv_malloc(size);
+    LV_ASSERT_MALLOC(index);
+    if(index == NULL) return NULL;
+
+    index->fdsc = fdsc;
+    index->cmaps = (lv_font_fmt_txt_cmap_index_t *)(index + 1);
+    uint16_t * page_start = (uint16_t *)(index->cmaps + fdsc->cmap_num);
+
+    for(i = 0; i < fdsc->cmap_num; i++) {
+        const lv_font_fmt_txt_cmap_t * cmap = &fdsc->cmaps[i];
+        lv_font_fmt_txt_cmap_index_t * cmap_index = &index->cmaps[i];
+        if(!index_is_needed(cmap)) {
+            cmap_index->page_start = NULL;
+            cmap_index->page_shift = 0;
+            continue;
+        }
+
+        cmap_index->page_start = page_start;
+        cmap_index->page_shift = index_get_page_shift(cmap);
+
+        /*`unicode_list` is sorted so the elements of a page are after the previous page's elements*/
+        uint32_t page_cnt = (((uint32_t)cmap->range_length - 1) >> cmap_index->page_shift) + 1;
+        uint32_t page;
+        uint32_t e = 0;
+        for(page = 0; page <= page_cnt; page++) {
+            while(e < cmap->list_length && (uint32_t)(cmap->unicode_list[e] >> cmap_index->page_shift) < page) e++;
+            page_start[page] = (uint16_t)e;
+        }
+
+        page_start += page_cnt + 1;
+    }
+
+    return index;
+}
+
+/*Only the sparse cmaps with a long `unicode_list` are worth indexing*/
+static bool index_is_needed(const lv_font_fmt_txt_cmap_t * cmap)
+{
+    return (cmap->type == LV_FONT_FMT_TXT_CMAP_SPARSE_TINY || cmap->type == LV_FONT_FMT_TXT_CMAP_SPARSE_FULL) &&
+           cmap->list_length >= INDEX_MIN_LIST_LENGTH;
+}
+
+/**
+ * Get the size of the pages of a cmap so that a page has `INDEX_PAGE_ELEMENTS` elements on average.
+ * @param cmap      a sparse cmap
+ * @return          log2 of the page size
+ */
+static uint8_t index_get_page_shift(const lv_font_fmt_txt_cmap_t * cmap)
+{
+    uint32_t max_page_cnt = LV_MAX(cmap->list_length / INDEX_PAGE_ELEMENTS, 1);
+    uint8_t shift = 0;
+    while((((uint32_t)cmap->range_length - 1) >> shift) + 1 > max_page_cnt) shift++;
+
+    return shift;
+}
+#endif /*LV_USE_FONT_FMT_TXT_LOOKUP_INDEX*/
+
 static int8_t get_kern_value(const lv_font_t * font, uint32_t gid_left, uint32_t gid_right)
 {
     lv_font_fmt_txt_dsc_t * fdsc = (lv_font_fmt_txt_dsc_t *)font->dsc;
@@ -534,6 +886,103 @@ static inline uint8_t rle_next(void)
 
     return ret;
 }
+
+/**
+ * Get the decompressed bitmap of a glyph from the cache.
+ * The cache entry is stored in `g_dsc->entry` and it's kept acquired until
+ * `lv_font_fmt_txt_release_glyph()` is called.
+ * @param g_dsc     the glyph descriptor
+ * @param fdsc      the descriptor of the glyph's font
+ * @return          the cached A8 bitmap or NULL if the glyph is not cached
+ */
+static const lv_draw_buf_t * glyph_cache_get(lv_font_glyph_dsc_t * g_dsc, const lv_font_fmt_txt_dsc_t * fdsc)
+{
+    if(glyph_cache_p == NULL) return NULL;
+
+    lv_font_fmt_txt_cache_data_t search_key = {
+        .font = g_dsc->resolved_font,
+        .gid = g_dsc->gid.index,
+        .bpp = (uint8_t)fdsc->bpp,
+    };
+
+    lv_cache_entry_t * entry = lv_cache_acquire(glyph_cache_p, &search_key, NULL);
+
+    lv_mutex_lock(&glyph_cache_stat_mutex);
+    if(entry) glyph_cache_stat.hit_cnt++;
+    else glyph_cache_stat.miss_cnt++;
+    lv_mutex_unlock(&glyph_cache_stat_mutex);
+
+    if(entry == NULL) return NULL;
+
+    g_dsc->entry = entry;
+
+    lv_font_fmt_txt_cache_data_t * cached_data = lv_cache_entry_get_data(entry);
+    return cached_data->draw_buf;
+}
+
+/**
+ * Add a copy of a decompressed glyph to the cache.
+ * Glyphs larger than the whole cache are not added.
+ * @param g_dsc     the glyph descriptor
+ * @param fdsc      the descriptor of the glyph's font
+ * @param draw_buf  the decompressed A8 bitmap
+ */
+static void glyph_cache_add(const lv_font_glyph_dsc_t * g_dsc, const lv_font_fmt_txt_dsc_t * fdsc,
+                            const lv_draw_buf_t * draw_buf)
+{
+    if(glyph_cache_p == NULL) return;
+
+    const lv_font_fmt_txt_glyph_dsc_t * gdsc = &fdsc->glyph_dsc[g_dsc->gid.index];
+    uint32_t data_size = lv_draw_buf_width_to_stride(gdsc->box_w, LV_COLOR_FORMAT_A8) * gdsc->box_h;
+
+    lv_font_fmt_txt_cache_data_t search_key = {
+        .slot.size = data_size + sizeof(lv_draw_buf_t),
+        .font = g_dsc->resolved_font,
+        .gid = g_dsc->gid.index,
+        .bpp = (uint8_t)fdsc->bpp,
+    };
+
+    if(search_key.slot.size > lv_cache_get_max_size(glyph_cache_p, NULL)) return;
+
+    search_key.draw_buf = lv_draw_buf_create_ex(font_draw_buf_handlers, gdsc->box_w, gdsc->box_h,
+                                                LV_COLOR_FORMAT_A8, LV_STRIDE_AUTO);
+    if(search_key.draw_buf == NULL) return;
+
+    lv_memcpy(search_key.draw_buf->data, draw_buf->data, data_size);
+
+    lv_cache_entry_t * entry = lv_cache_add(glyph_cache_p, &search_key, NULL);
+    if(entry == NULL) {
+        /*All the cached glyphs are in use*/
+        lv_draw_buf_destroy(search_key.draw_buf);
+        return;
+    }
+
+    lv_cache_release(glyph_cache_p, entry, NULL);
+}
+
+static lv_cache_compare_res_t glyph_cache_compare_cb(const lv_font_fmt_txt_cache_data_t * lhs,
+                                                     const lv_font_fmt_txt_cache_data_t * rhs)
+{
+    if(lhs->font != rhs->font) return lhs->font > rhs->font ? 1 : -1;
+    if(lhs->gid != rhs->gid) return lhs->gid > rhs->gid ? 1 : -1;
+    if(lhs->bpp != rhs->bpp) return lhs->bpp > rhs->bpp ? 1 : -1;
+
+    return 0;
+}
+
+static uint32_t glyph_cache_hash_cb(const lv_font_fmt_txt_cache_data_t * node)
+{
+    uint32_t h = (uint32_t)(uintptr_t)node->font * 0x9E3779B1;
+    h ^= (node->gid << 4) ^ node->bpp;
+    return h * 0x01000193;
+}
+
+static void glyph_cache_free_cb(lv_font_fmt_txt_cache_data_t * node, void * user_data)
+{
+    LV_UNUSED(user_data);
+
+    lv_draw_buf_destroy(node->draw_buf);
+}
 #endif /*LV_USE_FONT_COMPRESSED*/
 
 /** Code Comparator.
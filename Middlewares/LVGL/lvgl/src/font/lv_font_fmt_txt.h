@@ -185,6 +185,15 @@ typedef struct {
     uint16_t bitmap_format  : 2;
 } lv_font_fmt_txt_dsc_t;
 
+#if LV_USE_FONT_COMPRESSED
+/** Statistics of the cache of decompressed glyphs */
+typedef struct {
+    uint32_t hit_cnt;       /**< Number of glyphs found in the cache */
+    uint32_t miss_cnt;      /**< Number of glyphs which needed to be decompressed */
+    uint32_t size;          /**< Current size of the cached bitmaps in bytes */
+} lv_font_fmt_txt_cache_stat_t;
+#endif
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -209,6 +218,29 @@ const void * lv_font_get_bitmap_fmt_txt(lv_font_glyph_dsc_t * g_dsc, lv_draw_buf
 bool lv_font_get_glyph_dsc_fmt_txt(const lv_font_t * font, lv_font_glyph_dsc_t * dsc_out, uint32_t unicode_letter,
                                    uint32_t unicode_letter_next);
 
+#if LV_USE_FONT_COMPRESSED
+
+/**
+ * Get the statistics of the cache of decompressed glyphs.
+ * The cache is enabled by `LV_FONT_FMT_TXT_CACHE_SIZE`.
+ * @param stat      store the statistics here
+ */
+void lv_font_fmt_txt_cache_get_stat(lv_font_fmt_txt_cache_stat_t * stat);
+
+/**
+ * Reset the hit and miss counters of the glyph cache
+ */
+void lv_font_fmt_txt_cache_reset_stat(void);
+
+/**
+ * Drop all decompressed glyphs from the cache.
+ * The glyphs are identified by the address of the font, so it needs to be called
+ * before a compressed font is freed (`lv_binfont_destroy()` does it).
+ */
+void lv_font_fmt_txt_cache_drop_all(void);
+
+#endif /*LV_USE_FONT_COMPRESSED*/
+
 /**********************
  *      MACROS
  **********************/
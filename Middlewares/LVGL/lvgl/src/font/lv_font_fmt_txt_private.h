@@ -15,6 +15,9 @@ extern "C" {
  *********************/
 
 #include "lv_font_fmt_txt.h"
+#if LV_USE_FONT_COMPRESSED
+#include "../misc/cache/lv_cache_private.h"
+#endif
 
 /*********************
  *      DEFINES
@@ -39,12 +42,88 @@ typedef struct {
     uint8_t count;
     lv_font_fmt_rle_state_t state;
 } lv_font_fmt_rle_t;
+
+/** A decompressed glyph in the glyph cache */
+typedef struct {
+    lv_cache_slot_size_t slot;      /**< Size of the entry in bytes, it must be the first field */
+    const lv_font_t * font;
+    uint32_t gid;
+    uint8_t bpp;
+    lv_draw_buf_t * draw_buf;       /**< The A8 bitmap of the glyph */
+} lv_font_fmt_txt_cache_data_t;
+#endif
+
+#if LV_FONT_FMT_TXT_LETTER_CACHE_SIZE
+/** A recently looked up letter and its glyph ID (0 if the font doesn't have it) */
+typedef struct {
+    const lv_font_fmt_txt_dsc_t * fdsc;
+    uint32_t letter;
+    uint32_t gid;
+} lv_font_fmt_txt_letter_cache_t;
+#endif
+
+#if LV_USE_FONT_FMT_TXT_LOOKUP_INDEX
+/**
+ * Split the range of a sparse cmap to pages of `1 << page_shift` code points
+ * to search only among the `unicode_list` elements of a single page.
+ */
+typedef struct {
+    uint16_t * page_start;          /**< Index of the first `unicode_list` element of each page and `list_length`.
+                                         NULL if the cmap is not indexed*/
+    uint8_t page_shift;
+} lv_font_fmt_txt_cmap_index_t;
+
+/** The page indexes of the large sparse cmaps of a font */
+typedef struct _lv_font_fmt_txt_index_t {
+    struct _lv_font_fmt_txt_index_t * next;
+    const lv_font_fmt_txt_dsc_t * fdsc;
+    lv_font_fmt_txt_cmap_index_t * cmaps;   /**< One for each cmap of the font*/
+} lv_font_fmt_txt_index_t;
 #endif
 
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
 
+#if LV_USE_FONT_COMPRESSED
+
+/**
+ * Release the cached bitmap returned by `lv_font_get_bitmap_fmt_txt()`.
+ * Called by `lv_font_glyph_release_draw_data()` as the fonts don't set `release_glyph`.
+ * @param font      the font of the glyph
+ * @param g_dsc     the glyph descriptor passed to `lv_font_get_bitmap_fmt_txt()`
+ */
+void lv_font_fmt_txt_release_glyph(const lv_font_t * font, lv_font_glyph_dsc_t * g_dsc);
+
+/**
+ * Create the glyph cache and the lock of its statistics
+ */
+void lv_font_fmt_txt_cache_init(void);
+
+/**
+ * Free the glyph cache
+ */
+void lv_font_fmt_txt_cache_deinit(void);
+
+#endif /*LV_USE_FONT_COMPRESSED*/
+
+/**
+ * Initialize the lock of the letter lookup cache and index
+ */
+void lv_font_fmt_txt_lookup_init(void);
+
+/**
+ * Forget the letters of a font looked up before and free its lookup index.
+ * Needs to be called before freeing a font created at runtime.
+ * @param font      pointer to a font
+ */
+void lv_font_fmt_txt_lookup_release(const lv_font_t * font);
+
+/**
+ * Free the lookup index of all fonts
+ */
+void lv_font_fmt_txt_lookup_deinit(void);
+
 /**********************
  *      MACROS
  **********************/
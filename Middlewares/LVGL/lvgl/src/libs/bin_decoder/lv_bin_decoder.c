@@ -930,7 +930,7 @@ static lv_result_t decode_compressed(lv_image_decoder_t * decoder, lv_image_deco
             return LV_RESULT_INVALID;
         }
 
-        file_buf = lv_malloc(compressed_len);
+        file_buf = lv_malloc_placed(compressed_len, LV_MEM_PLACEMENT_BULK);
         if(file_buf == NULL) {
             LV_LOG_WARN("No memory for compressed file");
             return LV_RESULT_INVALID;
@@ -27,8 +27,14 @@
 #define LV_DRAW_SW_ASM_NONE         0
 #define LV_DRAW_SW_ASM_NEON         1
 #define LV_DRAW_SW_ASM_HELIUM       2
+#define LV_DRAW_SW_ASM_SSE2         3
+#define LV_DRAW_SW_ASM_SWAR         4
 #define LV_DRAW_SW_ASM_CUSTOM       255
 
+#define LV_CACHE_POLICY_LRU         0
+#define LV_CACHE_POLICY_S3FIFO      1
+#define LV_CACHE_POLICY_ARC         2
+
 /* Handle special Kconfig options */
 #ifndef LV_KCONFIG_IGNORE
     #include "lv_conf_kconfig.h"
@@ -212,6 +218,36 @@
             #endif
         #endif
     #endif
+
+    /*Serve the allocations up to 64 bytes from free lists of 6 size classes carved from pages of this size.
+     *Small allocations and frees are O(1) and don't fragment the memory pool. 0: allocate everything with TLSF*/
+    #ifndef LV_MEM_SMALL_BLOCK_PAGE_SIZE
+        #ifdef CONFIG_LV_MEM_SMALL_BLOCK_PAGE_SIZE
+            #define LV_MEM_SMALL_BLOCK_PAGE_SIZE CONFIG_LV_MEM_SMALL_BLOCK_PAGE_SIZE
+        #else
+            #define LV_MEM_SMALL_BLOCK_PAGE_SIZE 0     /*[bytes]*/
+        #endif
+    #endif
+
+    /*Size of a second memory pool for large, sequentially accessed data (draw buffers, cached images, layers).
+     *Allocate them with `lv_malloc_placed(size, LV_MEM_PLACEMENT_BULK)` to keep them out of the main pool
+     *which can stay in fast internal RAM. 0: use a single pool for everything*/
+    #ifndef LV_MEM_BULK_SIZE
+        #ifdef CONFIG_LV_MEM_BULK_SIZE
+            #define LV_MEM_BULK_SIZE CONFIG_LV_MEM_BULK_SIZE
+        #else
+            #define LV_MEM_BULK_SIZE 0     /*[bytes]*/
+        #endif
+    #endif
+
+    /*Address of the bulk memory pool, e.g. in external SDRAM. 0: allocate it as a normal array*/
+    #ifndef LV_MEM_BULK_ADR
+        #ifdef CONFIG_LV_MEM_BULK_ADR
+            #define LV_MEM_BULK_ADR CONFIG_LV_MEM_BULK_ADR
+        #else
+            #define LV_MEM_BULK_ADR 0     /*0: unused*/
+        #endif
+    #endif
 #endif  /*LV_USE_STDLIB_MALLOC == LV_STDLIB_BUILTIN*/
 
 /*====================
@@ -237,6 +273,27 @@
     #endif
 #endif
 
+/*Estimated extra cost of refreshing one more invalidated area in pixels (object tree traversal, flush, etc).
+ *Two invalidated areas are joined if refreshing their bounding box is cheaper than refreshing both of them.
+ *0: join only overlapping areas if the joined area is smaller than the two areas together*/
+#ifndef LV_INV_AREA_COST
+    #ifdef CONFIG_LV_INV_AREA_COST
+        #define LV_INV_AREA_COST CONFIG_LV_INV_AREA_COST
+    #else
+        #define LV_INV_AREA_COST 0     /*[px]*/
+    #endif
+#endif
+
+/*Max. width and height of a tile in LV_DISPLAY_RENDER_MODE_TILED.
+ *As many tiles are rendered in parallel as fit into the draw buffer*/
+#ifndef LV_DISPLAY_TILE_SIZE
+    #ifdef CONFIG_LV_DISPLAY_TILE_SIZE
+        #define LV_DISPLAY_TILE_SIZE CONFIG_LV_DISPLAY_TILE_SIZE
+    #else
+        #define LV_DISPLAY_TILE_SIZE 64     /*[px]*/
+    #endif
+#endif
+
 /*=================
  * OPERATING SYSTEM
  *=================*/
@@ -337,6 +394,38 @@
     #endif
 #endif
 
+/*Keep the pixel buffers freed by the default draw buffer handlers (layers, decoded images)
+ *up to this total size and reuse them instead of allocating new ones in every frame.
+ *The buffers are allocated in size classes, at most 25% larger than requested.
+ *If any allocation fails the kept buffers are freed and it's tried again. 0: disable*/
+#ifndef LV_DRAW_BUF_POOL_SIZE
+    #ifdef CONFIG_LV_DRAW_BUF_POOL_SIZE
+        #define LV_DRAW_BUF_POOL_SIZE CONFIG_LV_DRAW_BUF_POOL_SIZE
+    #else
+        #define LV_DRAW_BUF_POOL_SIZE    0   /*[bytes]*/
+    #endif
+#endif
+
+/*Allocate the draw tasks and their descriptors from chunks of this size. They are freed at once
+ *when no draw task is pending. Larger or more allocations chain new chunks. 0: use lv_malloc for each*/
+#ifndef LV_DRAW_TASK_ARENA_SIZE
+    #ifdef CONFIG_LV_DRAW_TASK_ARENA_SIZE
+        #define LV_DRAW_TASK_ARENA_SIZE CONFIG_LV_DRAW_TASK_ARENA_SIZE
+    #else
+        #define LV_DRAW_TASK_ARENA_SIZE    0   /*[bytes]*/
+    #endif
+#endif
+
+/*Use at most this many chunks for the draw tasks. If they are full, e.g. because some draw tasks are
+ *never finished and the arena can't be reset, the draw tasks are allocated with lv_malloc. 0: no limit*/
+#ifndef LV_DRAW_TASK_ARENA_CHUNK_MAX
+    #ifdef CONFIG_LV_DRAW_TASK_ARENA_CHUNK_MAX
+        #define LV_DRAW_TASK_ARENA_CHUNK_MAX CONFIG_LV_DRAW_TASK_ARENA_CHUNK_MAX
+    #else
+        #define LV_DRAW_TASK_ARENA_CHUNK_MAX    4
+    #endif
+#endif
+
 /* The stack size of the drawing thread.
  * NOTE: If FreeType or ThorVG is enabled, it is recommended to set it to 32KB or more.
  */
@@ -483,6 +572,17 @@
         #endif
     #endif
 
+    /* With more draw units split large fill, border, image and layer draw tasks
+     * into horizontal tiles which can be rendered (and stolen) by any idle draw unit.
+     * Draw tasks covering fewer pixels than this are not split. 0: don't split */
+    #ifndef LV_DRAW_SW_TILE_SPLIT_THRESHOLD
+        #ifdef CONFIG_LV_DRAW_SW_TILE_SPLIT_THRESHOLD
+            #define LV_DRAW_SW_TILE_SPLIT_THRESHOLD CONFIG_LV_DRAW_SW_TILE_SPLIT_THRESHOLD
+        #else
+            #define LV_DRAW_SW_TILE_SPLIT_THRESHOLD (128 * 128)  /*[px]*/
+        #endif
+    #endif
+
     /* Use Arm-2D to accelerate the sw render */
     #ifndef LV_USE_DRAW_ARM2D_SYNC
         #ifdef CONFIG_LV_USE_DRAW_ARM2D_SYNC
@@ -693,6 +793,27 @@
     #endif
 #endif
 
+/* Use the DMA2D (Chrom-ART) of STM32 MCUs for fills, images and glyphs.
+ * The buffers have to be in memory DMA2D can access (e.g. not in CCM RAM)*/
+#ifndef LV_USE_DRAW_DMA2D
+    #ifdef CONFIG_LV_USE_DRAW_DMA2D
+        #define LV_USE_DRAW_DMA2D CONFIG_LV_USE_DRAW_DMA2D
+    #else
+        #define LV_USE_DRAW_DMA2D 0
+    #endif
+#endif
+
+#if LV_USE_DRAW_DMA2D
+    /* The header which defines the `DMA2D` registers, e.g. "stm32f4xx.h" */
+    #ifndef LV_DRAW_DMA2D_HAL_INCLUDE
+        #ifdef CONFIG_LV_DRAW_DMA2D_HAL_INCLUDE
+            #define LV_DRAW_DMA2D_HAL_INCLUDE CONFIG_LV_DRAW_DMA2D_HAL_INCLUDE
+        #else
+            #define LV_DRAW_DMA2D_HAL_INCLUDE "stm32f4xx.h"
+        #endif
+    #endif
+#endif
+
 /* Draw using cached SDL textures*/
 #ifndef LV_USE_DRAW_SDL
     #ifdef CONFIG_LV_USE_DRAW_SDL
@@ -1096,6 +1217,25 @@
     #endif
 #endif
 
+/*Eviction policy of the image cache and the image header cache.
+ *- LV_CACHE_POLICY_LRU: drop the least recently used image
+ *- LV_CACHE_POLICY_S3FIFO: drop the images used only once first. Good if many images are shown only once (e.g. carousels)
+ *- LV_CACHE_POLICY_ARC: balance between the recently and the frequently used images adaptively*/
+#ifndef LV_IMAGE_CACHE_POLICY
+    #ifdef CONFIG_LV_IMAGE_CACHE_POLICY
+        #define LV_IMAGE_CACHE_POLICY CONFIG_LV_IMAGE_CACHE_POLICY
+    #else
+        #define LV_IMAGE_CACHE_POLICY           LV_CACHE_POLICY_LRU
+    #endif
+#endif
+#ifndef LV_IMAGE_HEADER_CACHE_POLICY
+    #ifdef CONFIG_LV_IMAGE_HEADER_CACHE_POLICY
+        #define LV_IMAGE_HEADER_CACHE_POLICY CONFIG_LV_IMAGE_HEADER_CACHE_POLICY
+    #else
+        #define LV_IMAGE_HEADER_CACHE_POLICY    LV_CACHE_POLICY_LRU
+    #endif
+#endif
+
 /*Number of stops allowed per gradient. Increase this to allow more stops.
  *This adds (sizeof(lv_color_t) + 1) bytes per additional stop*/
 #ifndef LV_GRADIENT_MAX_STOPS
@@ -1125,6 +1265,70 @@
     #endif
 #endif
 
+/* Cache the resolved values of the most often used style properties (background, border, text, padding, opacity)
+ * for each part and state of an object. It needs ~140 bytes of heap for each part which was drawn. */
+#ifndef LV_OBJ_STYLE_VALUE_CACHE
+    #ifdef CONFIG_LV_OBJ_STYLE_VALUE_CACHE
+        #define LV_OBJ_STYLE_VALUE_CACHE CONFIG_LV_OBJ_STYLE_VALUE_CACHE
+    #else
+        #define LV_OBJ_STYLE_VALUE_CACHE    0
+    #endif
+#endif
+#if LV_OBJ_STYLE_VALUE_CACHE
+    /* Maximum number of cached parts (~150 bytes each). The parts drawn after the limit is reached are not cached. */
+    #ifndef LV_OBJ_STYLE_VALUE_CACHE_MAX_CNT
+        #ifdef CONFIG_LV_OBJ_STYLE_VALUE_CACHE_MAX_CNT
+            #define LV_OBJ_STYLE_VALUE_CACHE_MAX_CNT CONFIG_LV_OBJ_STYLE_VALUE_CACHE_MAX_CNT
+        #else
+            #define LV_OBJ_STYLE_VALUE_CACHE_MAX_CNT    32
+        #endif
+    #endif
+#endif
+
+/* Keep the properties of the styles sorted and add a bit for each built-in property to `lv_style_t`.
+ * A missing property is found with a single bit test and an existing one with binary search.
+ * It needs 20 bytes more in each `lv_style_t`. */
+#ifndef LV_STYLE_PROP_INDEX
+    #ifdef CONFIG_LV_STYLE_PROP_INDEX
+        #define LV_STYLE_PROP_INDEX CONFIG_LV_STYLE_PROP_INDEX
+    #else
+        #define LV_STYLE_PROP_INDEX     0
+    #endif
+#endif
+
+/* Allocate the objects, their attributes, style lists, local styles and event descriptors
+ * from pages of fixed size blocks instead of the heap.
+ * Allocating and freeing is O(1) and deleting and recreating screens doesn't fragment the heap,
+ * but partly used pages need some more memory in total. */
+#ifndef LV_USE_OBJ_SLAB
+    #ifdef CONFIG_LV_USE_OBJ_SLAB
+        #define LV_USE_OBJ_SLAB CONFIG_LV_USE_OBJ_SLAB
+    #else
+        #define LV_USE_OBJ_SLAB     0
+    #endif
+#endif
+#if LV_USE_OBJ_SLAB
+    /* Size of a page in bytes. Each block size which is in use takes at least one page. */
+    #ifndef LV_OBJ_SLAB_PAGE_SIZE
+        #ifdef CONFIG_LV_OBJ_SLAB_PAGE_SIZE
+            #define LV_OBJ_SLAB_PAGE_SIZE CONFIG_LV_OBJ_SLAB_PAGE_SIZE
+        #else
+            #define LV_OBJ_SLAB_PAGE_SIZE   512
+        #endif
+    #endif
+
+    /* Size of a region taken from the heap in `lv_init()` to allocate the pages from.
+     * This way the pages don't split the free memory of the heap between the other allocations.
+     * If the region is full the pages are allocated from the heap. 0: always use the heap. */
+    #ifndef LV_OBJ_SLAB_POOL_SIZE
+        #ifdef CONFIG_LV_OBJ_SLAB_POOL_SIZE
+            #define LV_OBJ_SLAB_POOL_SIZE CONFIG_LV_OBJ_SLAB_POOL_SIZE
+        #else
+            #define LV_OBJ_SLAB_POOL_SIZE   0
+        #endif
+    #endif
+#endif
+
 /* Add `id` field to `lv_obj_t` */
 #ifndef LV_USE_OBJ_ID
     #ifdef CONFIG_LV_USE_OBJ_ID
@@ -1635,6 +1839,48 @@
         #define LV_USE_FONT_COMPRESSED 0
     #endif
 #endif
+#if LV_USE_FONT_COMPRESSED
+    /*Size of the cache for decompressed glyphs in bytes. 0: disable the cache*/
+    #ifndef LV_FONT_FMT_TXT_CACHE_SIZE
+        #ifdef CONFIG_LV_FONT_FMT_TXT_CACHE_SIZE
+            #define LV_FONT_FMT_TXT_CACHE_SIZE CONFIG_LV_FONT_FMT_TXT_CACHE_SIZE
+        #else
+            #define LV_FONT_FMT_TXT_CACHE_SIZE 0
+        #endif
+    #endif
+    /*Eviction policy of the glyph cache. See `LV_IMAGE_CACHE_POLICY`*/
+    #ifndef LV_FONT_FMT_TXT_CACHE_POLICY
+        #ifdef CONFIG_LV_FONT_FMT_TXT_CACHE_POLICY
+            #define LV_FONT_FMT_TXT_CACHE_POLICY CONFIG_LV_FONT_FMT_TXT_CACHE_POLICY
+        #else
+            #define LV_FONT_FMT_TXT_CACHE_POLICY LV_CACHE_POLICY_LRU
+        #endif
+    #endif
+#endif
+
+/*Number of recently looked up letters to remember in lvgl's native font format.
+ *Must be a power of 2. 0: disable*/
+#ifndef LV_FONT_FMT_TXT_LETTER_CACHE_SIZE
+    #ifdef CONFIG_LV_FONT_FMT_TXT_LETTER_CACHE_SIZE
+        #define LV_FONT_FMT_TXT_LETTER_CACHE_SIZE CONFIG_LV_FONT_FMT_TXT_LETTER_CACHE_SIZE
+    #else
+        #define LV_FONT_FMT_TXT_LETTER_CACHE_SIZE 0
+    #endif
+#endif
+#if (LV_FONT_FMT_TXT_LETTER_CACHE_SIZE & (LV_FONT_FMT_TXT_LETTER_CACHE_SIZE - 1))
+    #error "LV_FONT_FMT_TXT_LETTER_CACHE_SIZE must be 0 or a power of 2"
+#endif
+
+/*Build a page index on first use for the large sparse character maps (e.g. CJK fonts)
+ *to search the letters only on a single page instead of the whole list.
+ *It needs about a quarter of the size of the character map's `unicode_list` in RAM.*/
+#ifndef LV_USE_FONT_FMT_TXT_LOOKUP_INDEX
+    #ifdef CONFIG_LV_USE_FONT_FMT_TXT_LOOKUP_INDEX
+        #define LV_USE_FONT_FMT_TXT_LOOKUP_INDEX CONFIG_LV_USE_FONT_FMT_TXT_LOOKUP_INDEX
+    #else
+        #define LV_USE_FONT_FMT_TXT_LOOKUP_INDEX 0
+    #endif
+#endif
 
 /*Enable drawing placeholders when glyph dsc is not found*/
 #ifndef LV_USE_FONT_PLACEHOLDER
@@ -2011,6 +2257,13 @@
             #define LV_LABEL_LONG_TXT_HINT 1  /*Store some extra info in labels to speed up drawing of very long texts*/
         #endif
     #endif
+    #ifndef LV_LABEL_LAYOUT_CACHE
+        #ifdef CONFIG_LV_LABEL_LAYOUT_CACHE
+            #define LV_LABEL_LAYOUT_CACHE CONFIG_LV_LABEL_LAYOUT_CACHE
+        #else
+            #define LV_LABEL_LAYOUT_CACHE 0  /*Store the line breaks of the text to not measure it again while drawing*/
+        #endif
+    #endif
     #ifndef LV_LABEL_WAIT_CHAR_COUNT
         #ifdef CONFIG_LV_LABEL_WAIT_CHAR_COUNT
             #define LV_LABEL_WAIT_CHAR_COUNT CONFIG_LV_LABEL_WAIT_CHAR_COUNT
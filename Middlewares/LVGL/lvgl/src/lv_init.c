@@ -10,11 +10,14 @@
 #include "misc/lv_timer_private.h"
 #include "misc/lv_profiler_builtin_private.h"
 #include "misc/lv_anim_private.h"
+#include "misc/lv_style_private.h"
 #include "draw/lv_image_decoder_private.h"
 #include "draw/lv_draw_buf_private.h"
 #include "core/lv_refr_private.h"
 #include "core/lv_obj_style_private.h"
+#include "core/lv_obj_class_private.h"
 #include "core/lv_group_private.h"
+#include "font/lv_font_fmt_txt_private.h"
 #include "lv_init.h"
 #include "core/lv_global.h"
 #include "core/lv_obj.h"
@@ -51,6 +54,9 @@
 #if LV_USE_DRAW_DAVE2D
     #include "draw/renesas/dave2d/lv_draw_dave2d.h"
 #endif
+#if LV_USE_DRAW_DMA2D
+    #include "draw/dma2d/lv_draw_dma2d.h"
+#endif
 #if LV_USE_DRAW_SDL
     #include "draw/sdl/lv_draw_sdl.h"
 #endif
@@ -106,6 +112,7 @@ static inline void lv_global_init(lv_global_t * global)
 
     lv_ll_init(&(global->disp_ll), sizeof(lv_display_t));
     lv_ll_init(&(global->indev_ll), sizeof(lv_indev_t));
+    lv_ll_init(&(global->style_intern_ll), sizeof(lv_style_t));
 
     global->memory_zero = ZERO_MEM_SENTINEL;
     global->style_refresh = true;
@@ -166,7 +173,10 @@ void lv_init(void)
 
     lv_mem_init();
 
+    lv_obj_slab_init();
+
     lv_draw_buf_init_handlers();
+    lv_draw_buf_pool_init();
 
 #if LV_USE_SPAN != 0
     lv_span_stack_init();
@@ -210,6 +220,10 @@ void lv_init(void)
     lv_draw_dave2d_init();
 #endif
 
+#if LV_USE_DRAW_DMA2D
+    lv_draw_dma2d_init();
+#endif
+
 #if LV_USE_DRAW_SDL
     lv_draw_sdl_init();
 #endif
@@ -228,6 +242,10 @@ void lv_init(void)
 #endif
 
     lv_image_decoder_init(LV_CACHE_DEF_SIZE, LV_IMAGE_HEADER_CACHE_DEF_CNT);
+#if LV_USE_FONT_COMPRESSED
+    lv_font_fmt_txt_cache_init();
+#endif
+    lv_font_fmt_txt_lookup_init();
     lv_bin_decoder_init();  /*LVGL built-in binary image decoder*/
 
 #if LV_USE_DRAW_VG_LITE
@@ -385,10 +403,17 @@ void lv_deinit(void)
 
     lv_image_decoder_deinit();
 
+#if LV_USE_FONT_COMPRESSED
+    lv_font_fmt_txt_cache_deinit();
+#endif
+    lv_font_fmt_txt_lookup_deinit();
+
     lv_refr_deinit();
 
     lv_obj_style_deinit();
 
+    lv_style_intern_deinit();
+
 #if LV_USE_PXP
 #if LV_USE_DRAW_PXP || LV_USE_ROTATE_PXP
     lv_draw_pxp_deinit();
@@ -399,6 +424,10 @@ void lv_deinit(void)
     lv_draw_vglite_deinit();
 #endif
 
+#if LV_USE_DRAW_DMA2D
+    lv_draw_dma2d_deinit();
+#endif
+
 #if LV_USE_DRAW_VG_LITE
     lv_draw_vg_lite_deinit();
 #endif
@@ -427,6 +456,10 @@ void lv_deinit(void)
     lv_objid_builtin_destroy();
 #endif
 
+    lv_draw_buf_pool_deinit();
+
+    lv_obj_slab_deinit();
+
     lv_mem_deinit();
 
     lv_initialized = false;
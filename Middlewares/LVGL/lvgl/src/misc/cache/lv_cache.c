@@ -282,6 +282,11 @@ void lv_cache_set_free_cb(lv_cache_t * cache, lv_cache_free_cb_t free_cb, void *
     LV_UNUSED(user_data);
     cache->ops.free_cb = free_cb;
 }
+void lv_cache_set_hash_cb(lv_cache_t * cache, lv_cache_hash_cb_t hash_cb, void * user_data)
+{
+    LV_UNUSED(user_data);
+    cache->ops.hash_cb = hash_cb;
+}
 void lv_cache_set_name(lv_cache_t * cache, const char * name)
 {
     if(cache == NULL) return;
@@ -291,6 +296,18 @@ const char * lv_cache_get_name(lv_cache_t * cache)
 {
     return cache->name;
 }
+const lv_cache_class_t * lv_cache_class_get(uint32_t policy, bool by_size)
+{
+    switch(policy) {
+        case LV_CACHE_POLICY_S3FIFO:
+            return by_size ? &lv_cache_class_s3fifo_size : &lv_cache_class_s3fifo_count;
+        case LV_CACHE_POLICY_ARC:
+            return by_size ? &lv_cache_class_arc_size : &lv_cache_class_arc_count;
+        case LV_CACHE_POLICY_LRU:
+        default:
+            return by_size ? &lv_cache_class_lru_rb_size : &lv_cache_class_lru_rb_count;
+    }
+}
 
 /**********************
  *   STATIC FUNCTIONS
@@ -18,6 +18,8 @@ extern "C" {
 #include "../lv_types.h"
 
 #include "lv_cache_lru_rb.h"
+#include "lv_cache_s3fifo.h"
+#include "lv_cache_arc.h"
 
 #include "lv_image_cache.h"
 #include "lv_image_header_cache.h"
@@ -35,13 +37,16 @@ extern "C" {
 
 /**
  * Create a cache object with the given parameters.
- * @param cache_class   The class of the cache. Currently only support one two builtin classes:
+ * @param cache_class   The class of the cache. The builtin classes are:
  *                        - lv_cache_class_lru_rb_count for LRU-based cache with count-based eviction policy.
  *                        - lv_cache_class_lru_rb_size for LRU-based cache with size-based eviction policy.
+ *                        - lv_cache_class_s3fifo_count / _size for S3-FIFO-based caches.
+ *                        - lv_cache_class_arc_count / _size for ARC-based caches.
+ *                      See lv_cache_class_get() to get them by the `LV_CACHE_POLICY_...` configs.
  * @param node_size     The node size is the size of the data stored in the cache..
  * @param max_size      The max size is the maximum amount of memory or count that the cache can hold.
- *                        - lv_cache_class_lru_rb_count: max_size is the maximum count of nodes in the cache.
- *                        - lv_cache_class_lru_rb_size: max_size is the maximum size of the cache in bytes.
+ *                        - ..._count classes: max_size is the maximum count of nodes in the cache.
+ *                        - ..._size classes: max_size is the maximum size of the cache in bytes.
  * @param ops           A set of operations that can be performed on the cache. See lv_cache_ops_t for details.
  * @return              Returns a pointer to the created cache object on success, `NULL` on error.
  */
@@ -201,6 +206,14 @@ void   lv_cache_set_create_cb(lv_cache_t * cache, lv_cache_create_cb_t alloc_cb,
  */
 void   lv_cache_set_free_cb(lv_cache_t * cache, lv_cache_free_cb_t free_cb, void * user_data);
 
+/**
+ * Set the hash callback of the cache. It's used only by the S3-FIFO and ARC classes.
+ * @param cache         The cache object pointer to set the hash callback.
+ * @param hash_cb       The hash callback to set.
+ * @param user_data     A user data pointer.
+ */
+void   lv_cache_set_hash_cb(lv_cache_t * cache, lv_cache_hash_cb_t hash_cb, void * user_data);
+
 /**
  * Give a name for a cache object. Only the pointer of the string is saved.
  * @param cache         The cache object pointer to set the name.
@@ -215,6 +228,14 @@ void lv_cache_set_name(lv_cache_t * cache, const char * name);
  */
 const char * lv_cache_get_name(lv_cache_t * cache);
 
+/**
+ * Get the builtin cache class of an eviction policy.
+ * @param policy        `LV_CACHE_POLICY_LRU`, `LV_CACHE_POLICY_S3FIFO` or `LV_CACHE_POLICY_ARC`
+ * @param by_size       true: limit the sum of the `lv_cache_slot_size_t` sizes of the nodes; false: limit the count of the nodes
+ * @return              Returns the cache class. The LRU class is returned for unknown policies.
+ */
+const lv_cache_class_t * lv_cache_class_get(uint32_t policy, bool by_size);
+
 /*************************
  *    GLOBAL VARIABLES
  *************************/
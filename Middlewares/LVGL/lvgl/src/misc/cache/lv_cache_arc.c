@@ -0,0 +1,523 @@
+/**
+* @file lv_cache_arc.c
+*
+*/
+
+/***************************************************************************\
+*                                                                           *
+*     B1 (ghost)       T1 (used once)       T2 (used again)     B2 (ghost)  *
+*   ┌────────────┐   ┌────────────────┐   ┌────────────────┐   ┌──────────┐ *
+*   │ LRU    MRU │◀──│ LRU        MRU │   │ MRU        LRU │──▶│ MRU  LRU │ *
+*   └────────────┘   └────────────────┘   └────────────────┘   └──────────┘ *
+*                    ◀─── p: target ──▶                                     *
+*                                                                           *
+*  A new key goes to T1 and a hit moves the entry to the MRU end of T2.     *
+*  The evicted keys are remembered in B1 or B2. A miss found in B1 means    *
+*  T1 was too small so `p` grows, a miss found in B2 means T2 was too       *
+*  small so `p` shrinks. Both kinds of ghost hits are inserted into T2.     *
+*                                                                           *
+\***************************************************************************/
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_cache_arc.h"
+#include "lv_cache_ghost.h"
+#include "../../stdlib/lv_sprintf.h"
+#include "../../stdlib/lv_string.h"
+#include "../lv_ll.h"
+#include "../lv_math.h"
+#include "../lv_rb_private.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+typedef uint32_t (get_data_size_cb_t)(const void * data);
+
+/*Stored after the cache entry in the rb node's data*/
+typedef struct {
+    void * ll_node;         /*Node in `t1` or `t2` pointing to the rb node*/
+    uint8_t in_t2;
+} arc_node_t;
+
+struct lv_arc_t {
+    lv_cache_t cache;
+
+    lv_rb_t rb;
+    lv_ll_t t1;             /*The most recently used first*/
+    lv_ll_t t2;             /*The most recently used first*/
+    lv_cache_ghost_t b1;    /*Keys evicted from `t1`*/
+    lv_cache_ghost_t b2;    /*Keys evicted from `t2`*/
+
+    uint32_t t1_size;
+    uint32_t t2_size;
+    uint32_t p;             /*Target size of `t1`*/
+
+    /*The entry returned by `get_victim_cb`. Its key is remembered when it's removed.*/
+    lv_cache_entry_t * victim;
+
+    get_data_size_cb_t * get_data_size_cb;
+};
+typedef struct lv_arc_t lv_arc_t_;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+
+static void * alloc_cb(void);
+static bool init_cnt_cb(lv_cache_t * cache);
+static bool init_size_cb(lv_cache_t * cache);
+static void  destroy_cb(lv_cache_t * cache, void * user_data);
+
+static lv_cache_entry_t * get_cb(lv_cache_t * cache, const void * key, void * user_data);
+static lv_cache_entry_t * add_cb(lv_cache_t * cache, const void * key, void * user_data);
+static void remove_cb(lv_cache_t * cache, lv_cache_entry_t * entry, void * user_data);
+static void drop_cb(lv_cache_t * cache, const void * key, void * user_data);
+static void drop_all_cb(lv_cache_t * cache, void * user_data);
+static lv_cache_entry_t * get_victim_cb(lv_cache_t * cache, void * user_data);
+static lv_cache_reserve_cond_res_t reserve_cond_cb(lv_cache_t * cache, const void * key, size_t reserved_size,
+                                                   void * user_data);
+
+static bool init_common(lv_arc_t_ * arc);
+static inline arc_node_t * get_arc_node(lv_arc_t_ * arc, lv_rb_node_t * node);
+static lv_cache_entry_t * find_unused_lru(lv_arc_t_ * arc, lv_ll_t * ll);
+static void adapt_on_ghost_hit(lv_arc_t_ * arc, const void * key, uint32_t data_size, bool * was_ghost);
+static void trim_ghosts(lv_arc_t_ * arc);
+static void unlink_node(lv_arc_t_ * arc, lv_rb_node_t * node);
+
+static uint32_t cnt_get_data_size_cb(const void * data);
+static uint32_t size_get_data_size_cb(const void * data);
+
+/**********************
+ *  GLOBAL VARIABLES
+ **********************/
+const lv_cache_class_t lv_cache_class_arc_count = {
+    .alloc_cb = alloc_cb,
+    .init_cb = init_cnt_cb,
+    .destroy_cb = destroy_cb,
+
+    .get_cb = get_cb,
+    .add_cb = add_cb,
+    .remove_cb = remove_cb,
+    .drop_cb = drop_cb,
+    .drop_all_cb = drop_all_cb,
+    .get_victim_cb = get_victim_cb,
+    .reserve_cond_cb = reserve_cond_cb
+};
+
+const lv_cache_class_t lv_cache_class_arc_size = {
+    .alloc_cb = alloc_cb,
+    .init_cb = init_size_cb,
+    .destroy_cb = destroy_cb,
+
+    .get_cb = get_cb,
+    .add_cb = add_cb,
+    .remove_cb = remove_cb,
+    .drop_cb = drop_cb,
+    .drop_all_cb = drop_all_cb,
+    .get_victim_cb = get_victim_cb,
+    .reserve_cond_cb = reserve_cond_cb
+};
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static void * alloc_cb(void)
+{
+    void * res = lv_malloc(sizeof(lv_arc_t_));
+    LV_ASSERT_MALLOC(res);
+    if(res == NULL) {
+        LV_LOG_ERROR("malloc failed");
+        return NULL;
+    }
+
+    lv_memzero(res, sizeof(lv_arc_t_));
+    return res;
+}
+
+static bool init_cnt_cb(lv_cache_t * cache)
+{
+    lv_arc_t_ * arc = (lv_arc_t_ *)cache;
+    if(!init_common(arc)) return false;
+
+    arc->get_data_size_cb = cnt_get_data_size_cb;
+    return true;
+}
+
+static bool init_size_cb(lv_cache_t * cache)
+{
+    lv_arc_t_ * arc = (lv_arc_t_ *)cache;
+    if(!init_common(arc)) return false;
+
+    arc->get_data_size_cb = size_get_data_size_cb;
+    return true;
+}
+
+static void destroy_cb(lv_cache_t * cache, void * user_data)
+{
+    LV_ASSERT_NULL(cache);
+
+    if(cache == NULL) {
+        return;
+    }
+
+    cache->clz->drop_all_cb(cache, user_data);
+}
+
+static lv_cache_entry_t * get_cb(lv_cache_t * cache, const void * key, void * user_data)
+{
+    LV_UNUSED(user_data);
+
+    lv_arc_t_ * arc = (lv_arc_t_ *)cache;
+
+    LV_ASSERT_NULL(arc);
+    LV_ASSERT_NULL(key);
+
+    if(arc == NULL || key == NULL) {
+        return NULL;
+    }
+
+    lv_rb_node_t * node = lv_rb_find(&arc->rb, key);
+    if(node == NULL) {
+        return NULL;
+    }
+
+    /*cache hit: it's used at least twice now so move it to the front of T2*/
+    arc_node_t * a_node = get_arc_node(arc, node);
+    if(a_node->in_t2) {
+        lv_ll_move_before(&arc->t2, a_node->ll_node, lv_ll_get_head(&arc->t2));
+    }
+    else {
+        uint32_t data_size = arc->get_data_size_cb(node->data);
+        lv_ll_chg_list(&arc->t1, &arc->t2, a_node->ll_node, true);
+        arc->t1_size -= data_size;
+        arc->t2_size += data_size;
+        a_node->in_t2 = 1;
+    }
+
+    return lv_cache_entry_get_entry(node->data, cache->node_size);
+}
+
+static lv_cache_entry_t * add_cb(lv_cache_t * cache, const void * key, void * user_data)
+{
+    LV_UNUSED(user_data);
+
+    lv_arc_t_ * arc = (lv_arc_t_ *)cache;
+
+    LV_ASSERT_NULL(arc);
+    LV_ASSERT_NULL(key);
+
+    if(arc == NULL || key == NULL) {
+        return NULL;
+    }
+
+    lv_rb_node_t * node = lv_rb_insert(&arc->rb, (void *)key);
+    if(node == NULL) {
+        return NULL;
+    }
+
+    uint32_t data_size = arc->get_data_size_cb(key);
+    bool was_ghost;
+    adapt_on_ghost_hit(arc, key, data_size, &was_ghost);
+
+    lv_ll_t * ll = was_ghost ? &arc->t2 : &arc->t1;
+    void * ll_node = lv_ll_ins_head(ll);
+    if(ll_node == NULL) {
+        lv_rb_drop_node(&arc->rb, node);
+        return NULL;
+    }
+    *(lv_rb_node_t **)ll_node = node;
+
+    lv_memcpy(node->data, key, cache->node_size);
+    lv_cache_entry_t * entry = lv_cache_entry_get_entry(node->data, cache->node_size);
+    lv_cache_entry_init(entry, cache, cache->node_size);
+
+    arc_node_t * a_node = get_arc_node(arc, node);
+    a_node->ll_node = ll_node;
+    a_node->in_t2 = was_ghost;
+
+    if(was_ghost) arc->t2_size += data_size;
+    else arc->t1_size += data_size;
+    cache->size += data_size;
+
+    return entry;
+}
+
+static void remove_cb(lv_cache_t * cache, lv_cache_entry_t * entry, void * user_data)
+{
+    LV_UNUSED(user_data);
+
+    lv_arc_t_ * arc = (lv_arc_t_ *)cache;
+
+    LV_ASSERT_NULL(arc);
+    LV_ASSERT_NULL(entry);
+
+    if(arc == NULL || entry == NULL) {
+        return;
+    }
+
+    void * data = lv_cache_entry_get_data(entry);
+    lv_rb_node_t * node = lv_rb_find(&arc->rb, data);
+    if(node == NULL) {
+        return;
+    }
+
+    bool evicted = entry == arc->victim;
+    bool in_t2 = get_arc_node(arc, node)->in_t2;
+    arc->victim = NULL;
+
+    unlink_node(arc, node);
+
+    /*Remember only the evicted keys. The dropped ones were invalidated by the user.*/
+    if(evicted && cache->ops.hash_cb) {
+        lv_cache_ghost_add(in_t2 ? &arc->b2 : &arc->b1, cache->ops.hash_cb(data), arc->get_data_size_cb(data));
+        trim_ghosts(arc);
+    }
+
+    lv_rb_remove_node(&arc->rb, node);
+}
+
+static void drop_cb(lv_cache_t * cache, const void * key, void * user_data)
+{
+    lv_arc_t_ * arc = (lv_arc_t_ *)cache;
+
+    LV_ASSERT_NULL(arc);
+    LV_ASSERT_NULL(key);
+
+    if(arc == NULL || key == NULL) {
+        return;
+    }
+
+    lv_rb_node_t * node = lv_rb_find(&arc->rb, key);
+    if(node == NULL) {
+        return;
+    }
+
+    void * data = node->data;
+
+    cache->ops.free_cb(data, user_data);
+    unlink_node(arc, node);
+
+    lv_cache_entry_t * entry = lv_cache_entry_get_entry(data, cache->node_size);
+    lv_rb_remove_node(&arc->rb, node);
+    lv_cache_entry_delete(entry);
+}
+
+static void drop_all_cb(lv_cache_t * cache, void * user_data)
+{
+    lv_arc_t_ * arc = (lv_arc_t_ *)cache;
+
+    LV_ASSERT_NULL(arc);
+
+    if(arc == NULL) {
+        return;
+    }
+
+    uint32_t used_cnt = 0;
+    lv_ll_t * lists[2] = {&arc->t1, &arc->t2};
+    uint32_t i;
+    for(i = 0; i < 2; i++) {
+        lv_rb_node_t ** node;
+        LV_LL_READ(lists[i], node) {
+            /*free user handled data and do other clean up*/
+            void * search_key = (*node)->data;
+            lv_cache_entry_t * entry = lv_cache_entry_get_entry(search_key, cache->node_size);
+            if(lv_cache_entry_get_ref(entry) == 0) {
+                cache->ops.free_cb(search_key, user_data);
+            }
+            else {
+                LV_LOG_WARN("entry (%p) is still referenced (%" LV_PRId32 ")", (void *)entry, lv_cache_entry_get_ref(entry));
+                used_cnt++;
+            }
+        }
+    }
+    if(used_cnt > 0) {
+        LV_LOG_WARN("%" LV_PRId32 " entries are still referenced", used_cnt);
+    }
+
+    lv_rb_destroy(&arc->rb);
+    lv_ll_clear(&arc->t1);
+    lv_ll_clear(&arc->t2);
+    lv_cache_ghost_clear(&arc->b1);
+    lv_cache_ghost_clear(&arc->b2);
+
+    arc->t1_size = 0;
+    arc->t2_size = 0;
+    arc->p = 0;
+    arc->victim = NULL;
+    cache->size = 0;
+}
+
+static lv_cache_entry_t * get_victim_cb(lv_cache_t * cache, void * user_data)
+{
+    LV_UNUSED(user_data);
+
+    lv_arc_t_ * arc = (lv_arc_t_ *)cache;
+
+    LV_ASSERT_NULL(arc);
+
+    /*Evict from T1 if it's larger than its target, else from T2.
+     *If all entries of the preferred list are in use try the other one.*/
+    bool t1_first = arc->t1_size > 0 && (arc->t1_size > LV_MIN(arc->p, cache->max_size) || arc->t2_size == 0);
+
+    lv_cache_entry_t * entry = find_unused_lru(arc, t1_first ? &arc->t1 : &arc->t2);
+    if(entry == NULL) entry = find_unused_lru(arc, t1_first ? &arc->t2 : &arc->t1);
+
+    arc->victim = entry;
+    return entry;
+}
+
+static lv_cache_reserve_cond_res_t reserve_cond_cb(lv_cache_t * cache, const void * key, size_t reserved_size,
+                                                   void * user_data)
+{
+    LV_UNUSED(user_data);
+
+    lv_arc_t_ * arc = (lv_arc_t_ *)cache;
+
+    LV_ASSERT_NULL(arc);
+
+    if(arc == NULL) {
+        return LV_CACHE_RESERVE_COND_ERROR;
+    }
+
+    uint32_t data_size = key ? arc->get_data_size_cb(key) : 0;
+    if(data_size > cache->max_size) {
+        LV_LOG_ERROR("data size (%" LV_PRIu32 ") is larger than max size (%" LV_PRIu32 ")", data_size, cache->max_size);
+        return LV_CACHE_RESERVE_COND_TOO_LARGE;
+    }
+
+    return cache->size + reserved_size + data_size > cache->max_size
+           ? LV_CACHE_RESERVE_COND_NEED_VICTIM
+           : LV_CACHE_RESERVE_COND_OK;
+}
+
+static bool init_common(lv_arc_t_ * arc)
+{
+    LV_ASSERT_NULL(arc->cache.ops.compare_cb);
+    LV_ASSERT_NULL(arc->cache.ops.free_cb);
+    LV_ASSERT(arc->cache.node_size > 0);
+
+    if(arc->cache.node_size <= 0 || arc->cache.ops.compare_cb == NULL || arc->cache.ops.free_cb == NULL) {
+        return false;
+    }
+
+    /*add the list state after the entry*/
+    if(!lv_rb_init(&arc->rb, arc->cache.ops.compare_cb,
+                   lv_cache_entry_get_size(arc->cache.node_size) + sizeof(arc_node_t))) {
+        return false;
+    }
+    lv_ll_init(&arc->t1, sizeof(void *));
+    lv_ll_init(&arc->t2, sizeof(void *));
+    lv_cache_ghost_init(&arc->b1);
+    lv_cache_ghost_init(&arc->b2);
+
+    return true;
+}
+
+static inline arc_node_t * get_arc_node(lv_arc_t_ * arc, lv_rb_node_t * node)
+{
+    return (arc_node_t *)((uint8_t *)node->data + lv_cache_entry_get_size(arc->cache.node_size));
+}
+
+static lv_cache_entry_t * find_unused_lru(lv_arc_t_ * arc, lv_ll_t * ll)
+{
+    lv_rb_node_t ** tail;
+    LV_LL_READ_BACK(ll, tail) {
+        lv_cache_entry_t * entry = lv_cache_entry_get_entry((*tail)->data, arc->cache.node_size);
+        if(lv_cache_entry_get_ref(entry) == 0) {
+            return entry;
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * Look up a new key in the ghost lists and move the target size of T1 toward the list that would have kept it.
+ * The victims for the new entry are already evicted at this point, so unlike the original algorithm
+ * the new target is used from the next eviction.
+ */
+static void adapt_on_ghost_hit(lv_arc_t_ * arc, const void * key, uint32_t data_size, bool * was_ghost)
+{
+    *was_ghost = false;
+    if(arc->cache.ops.hash_cb == NULL) return;
+
+    uint32_t hash = arc->cache.ops.hash_cb(key);
+    uint32_t b1_size = arc->b1.size;
+    uint32_t b2_size = arc->b2.size;
+
+    if(lv_cache_ghost_remove(&arc->b1, hash)) {
+        uint64_t delta = b1_size >= b2_size ? data_size : (uint64_t)data_size * (b2_size / b1_size);
+        arc->p = (uint32_t)LV_MIN(arc->p + delta, arc->cache.max_size);
+        *was_ghost = true;
+    }
+    else if(lv_cache_ghost_remove(&arc->b2, hash)) {
+        uint64_t delta = b2_size >= b1_size ? data_size : (uint64_t)data_size * (b1_size / b2_size);
+        arc->p = arc->p > delta ? (uint32_t)(arc->p - delta) : 0;
+        *was_ghost = true;
+    }
+}
+
+/**
+ * Keep T1 + B1 within the cache size and all lists within twice the cache size.
+ */
+static void trim_ghosts(lv_arc_t_ * arc)
+{
+    uint32_t max_size = arc->cache.max_size;
+
+    while(arc->t1_size + arc->b1.size > max_size) {
+        if(!lv_cache_ghost_remove_oldest(&arc->b1)) break;
+    }
+
+    while(arc->t1_size + arc->t2_size + arc->b1.size + arc->b2.size > 2 * max_size) {
+        if(!lv_cache_ghost_remove_oldest(&arc->b2)) {
+            if(!lv_cache_ghost_remove_oldest(&arc->b1)) break;
+        }
+    }
+}
+
+/**
+ * Remove a node from its list and update the sizes. The rb node is not changed.
+ */
+static void unlink_node(lv_arc_t_ * arc, lv_rb_node_t * node)
+{
+    arc_node_t * a_node = get_arc_node(arc, node);
+    uint32_t data_size = arc->get_data_size_cb(node->data);
+
+    lv_ll_t * ll = a_node->in_t2 ? &arc->t2 : &arc->t1;
+    lv_ll_remove(ll, a_node->ll_node);
+    lv_free(a_node->ll_node);
+    a_node->ll_node = NULL;
+
+    if(a_node->in_t2) arc->t2_size -= data_size;
+    else arc->t1_size -= data_size;
+    arc->cache.size -= data_size;
+}
+
+static uint32_t cnt_get_data_size_cb(const void * data)
+{
+    LV_UNUSED(data);
+    return 1;
+}
+
+static uint32_t size_get_data_size_cb(const void * data)
+{
+    lv_cache_slot_size_t * slot = (lv_cache_slot_size_t *)data;
+    return slot->size;
+}
@@ -0,0 +1,131 @@
+/**
+* @file lv_cache_ghost.c
+*
+*/
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_cache_ghost.h"
+#include "../lv_assert.h"
+#include "../../stdlib/lv_mem.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+typedef struct {
+    uint32_t hash;
+    uint32_t size;
+    void * ll_node;
+} ghost_record_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static lv_rb_compare_res_t record_compare_cb(const void * a, const void * b);
+static void record_remove(lv_cache_ghost_t * ghost, lv_rb_node_t * node);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_cache_ghost_init(lv_cache_ghost_t * ghost)
+{
+    LV_ASSERT_NULL(ghost);
+
+    lv_rb_init(&ghost->rb, record_compare_cb, sizeof(ghost_record_t));
+    lv_ll_init(&ghost->ll, sizeof(void *));
+    ghost->size = 0;
+}
+
+void lv_cache_ghost_clear(lv_cache_ghost_t * ghost)
+{
+    LV_ASSERT_NULL(ghost);
+
+    lv_rb_destroy(&ghost->rb);
+    lv_ll_clear(&ghost->ll);
+    ghost->size = 0;
+}
+
+void lv_cache_ghost_add(lv_cache_ghost_t * ghost, uint32_t hash, uint32_t size)
+{
+    LV_ASSERT_NULL(ghost);
+
+    lv_cache_ghost_remove(ghost, hash);
+
+    ghost_record_t key = {.hash = hash};
+    lv_rb_node_t * node = lv_rb_insert(&ghost->rb, &key);
+    if(node == NULL) return;
+
+    void * ll_node = lv_ll_ins_head(&ghost->ll);
+    if(ll_node == NULL) {
+        lv_rb_drop_node(&ghost->rb, node);
+        return;
+    }
+    *(lv_rb_node_t **)ll_node = node;
+
+    ghost_record_t * record = node->data;
+    record->hash = hash;
+    record->size = size;
+    record->ll_node = ll_node;
+
+    ghost->size += size;
+}
+
+bool lv_cache_ghost_remove(lv_cache_ghost_t * ghost, uint32_t hash)
+{
+    LV_ASSERT_NULL(ghost);
+
+    ghost_record_t key = {.hash = hash};
+    lv_rb_node_t * node = lv_rb_find(&ghost->rb, &key);
+    if(node == NULL) return false;
+
+    record_remove(ghost, node);
+    return true;
+}
+
+bool lv_cache_ghost_remove_oldest(lv_cache_ghost_t * ghost)
+{
+    LV_ASSERT_NULL(ghost);
+
+    lv_rb_node_t ** tail = lv_ll_get_tail(&ghost->ll);
+    if(tail == NULL) return false;
+
+    record_remove(ghost, *tail);
+    return true;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static lv_rb_compare_res_t record_compare_cb(const void * a, const void * b)
+{
+    const ghost_record_t * ra = a;
+    const ghost_record_t * rb = b;
+
+    if(ra->hash == rb->hash) return 0;
+    return ra->hash > rb->hash ? 1 : -1;
+}
+
+static void record_remove(lv_cache_ghost_t * ghost, lv_rb_node_t * node)
+{
+    ghost_record_t * record = node->data;
+    ghost->size -= record->size;
+
+    lv_ll_remove(&ghost->ll, record->ll_node);
+    lv_free(record->ll_node);
+    lv_rb_drop_node(&ghost->rb, node);
+}
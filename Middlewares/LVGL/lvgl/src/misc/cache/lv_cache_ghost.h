@@ -0,0 +1,89 @@
+/**
+* @file lv_cache_ghost.h
+*
+*/
+
+#ifndef LV_CACHE_GHOST_H
+#define LV_CACHE_GHOST_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../lv_types.h"
+#include "../lv_ll.h"
+#include "../lv_rb_private.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**
+ * A list of the recently evicted keys of a cache. Only the hash and the size of the keys are stored,
+ * so it's enough to tell whether a missed key was in the cache recently.
+ */
+typedef struct {
+    lv_rb_t rb;         /**< The records by hash*/
+    lv_ll_t ll;         /**< The rb nodes of the records, the most recent first*/
+    uint32_t size;      /**< Sum of the sizes of the records*/
+} lv_cache_ghost_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Initialize a ghost list
+ * @param ghost     pointer to a ghost list
+ */
+void lv_cache_ghost_init(lv_cache_ghost_t * ghost);
+
+/**
+ * Remove all records of a ghost list
+ * @param ghost     pointer to a ghost list
+ */
+void lv_cache_ghost_clear(lv_cache_ghost_t * ghost);
+
+/**
+ * Add a record as the most recent one. If a record with the same hash exists it's replaced.
+ * @param ghost     pointer to a ghost list
+ * @param hash      hash of the evicted key
+ * @param size      size of the evicted data
+ */
+void lv_cache_ghost_add(lv_cache_ghost_t * ghost, uint32_t hash, uint32_t size);
+
+/**
+ * Remove the record of a hash
+ * @param ghost     pointer to a ghost list
+ * @param hash      hash of a key
+ * @return          true: the hash was in the list and it's removed; false: not found
+ */
+bool lv_cache_ghost_remove(lv_cache_ghost_t * ghost, uint32_t hash);
+
+/**
+ * Remove the oldest record
+ * @param ghost     pointer to a ghost list
+ * @return          true: a record was removed; false: the list was empty
+ */
+bool lv_cache_ghost_remove_oldest(lv_cache_ghost_t * ghost);
+
+/*************************
+ *    GLOBAL VARIABLES
+ *************************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_CACHE_GHOST_H*/
@@ -49,6 +49,13 @@ typedef bool (*lv_cache_create_cb_t)(void * node, void * user_data);
 typedef void (*lv_cache_free_cb_t)(void * node, void * user_data);
 typedef lv_cache_compare_res_t (*lv_cache_compare_cb_t)(const void * a, const void * b);
 
+/**
+ * The hash function of the keys. Keys which are equal according to the compare function must have the same hash.
+ * It's used by the cache classes which remember the keys of the evicted entries (S3-FIFO and ARC),
+ * as the evicted data can't be compared anymore after it's freed.
+ */
+typedef uint32_t (*lv_cache_hash_cb_t)(const void * node);
+
 /**
  * The cache instance allocation function, used by the cache class to allocate memory for cache instances.
  * @return It should return a pointer to the allocated instance.
@@ -114,15 +121,19 @@ struct lv_cache_ops_t {
     lv_cache_compare_cb_t compare_cb;    /**< Compare function for keys */
     lv_cache_create_cb_t create_cb;      /**< Create function for nodes */
     lv_cache_free_cb_t free_cb;          /**< Free function for nodes */
+    lv_cache_hash_cb_t hash_cb;          /**< Hash function for keys. Optional, without it the S3-FIFO and
+                                          *   ARC classes don't remember the evicted keys */
 };
 
 /**
  * The cache entry struct
  */
 struct lv_cache_t {
-    const lv_cache_class_t * clz;     /**< Cache class. There are two built-in classes:
+    const lv_cache_class_t * clz;     /**< Cache class. The built-in classes are:
                                        * - lv_cache_class_lru_rb_count for LRU-based cache with count-based eviction policy.
-                                       * - lv_cache_class_lru_rb_size for LRU-based cache with size-based eviction policy. */
+                                       * - lv_cache_class_lru_rb_size for LRU-based cache with size-based eviction policy.
+                                       * - lv_cache_class_s3fifo_count / _size for S3-FIFO-based caches.
+                                       * - lv_cache_class_arc_count / _size for ARC-based caches. */
 
     uint32_t node_size;               /**< Size of a node */
 
@@ -142,6 +153,8 @@ struct lv_cache_t {
  * Examples:
  * - lv_cache_class_lru_rb_count for LRU-based cache with count-based eviction policy.
  * - lv_cache_class_lru_rb_size for LRU-based cache with size-based eviction policy.
+ * - lv_cache_class_s3fifo_count / _size for S3-FIFO-based caches.
+ * - lv_cache_class_arc_count / _size for ARC-based caches.
  */
 struct lv_cache_class_t {
     lv_cache_alloc_cb_t alloc_cb;                 /**< The allocation function for cache entries */
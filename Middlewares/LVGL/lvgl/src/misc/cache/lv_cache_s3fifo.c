@@ -0,0 +1,507 @@
+/**
+* @file lv_cache_s3fifo.c
+*
+*/
+
+/***************************************************************************\
+*                                                                           *
+*    insert                                                                 *
+*  (not a ghost)    ┌─────────────────┐  freq == 0                          *
+*  ───────────────▶ │   S (10% FIFO)  │ ───────────┬──────▶ evict            *
+*                   └─────────────────┘            │                        *
+*                            │ freq > 0            ▼                        *
+*                            ▼            ┌─────────────────┐               *
+*    insert         ┌─────────────────┐   │  G (ghost keys) │               *
+*  (was a ghost)    │   M (90% FIFO)  │   └─────────────────┘               *
+*  ───────────────▶ │                 │ ───────────────────────▶ evict       *
+*                   └─────────────────┘  freq == 0                          *
+*                        ▲       │                                          *
+*                        └───────┘ freq > 0: reinsert with freq - 1         *
+*                                                                           *
+*  A hit only increments the 2 bit frequency counter of the entry, the      *
+*  queues are reordered only when a victim is searched.                     *
+*                                                                           *
+\***************************************************************************/
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_cache_s3fifo.h"
+#include "lv_cache_ghost.h"
+#include "../../stdlib/lv_sprintf.h"
+#include "../../stdlib/lv_string.h"
+#include "../lv_ll.h"
+#include "../lv_rb_private.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+#define FREQ_MAX            3
+
+/*The small queue gets this part of the cache*/
+#define SMALL_RATIO_DIV     10
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+typedef uint32_t (get_data_size_cb_t)(const void * data);
+
+/*Stored after the cache entry in the rb node's data*/
+typedef struct {
+    void * ll_node;         /*Node in `small` or `main` pointing to the rb node*/
+    uint8_t in_main;
+    uint8_t freq;
+} s3fifo_node_t;
+
+struct lv_s3fifo_t {
+    lv_cache_t cache;
+
+    lv_rb_t rb;
+    lv_ll_t small;          /*The newest first*/
+    lv_ll_t main;           /*The newest first*/
+    lv_cache_ghost_t ghost;
+
+    uint32_t small_size;
+    uint32_t main_size;
+    uint32_t node_cnt;
+
+    /*The entry returned by `get_victim_cb`. Its key is remembered when it's removed.*/
+    lv_cache_entry_t * victim;
+
+    get_data_size_cb_t * get_data_size_cb;
+};
+typedef struct lv_s3fifo_t lv_s3fifo_t_;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+
+static void * alloc_cb(void);
+static bool init_cnt_cb(lv_cache_t * cache);
+static bool init_size_cb(lv_cache_t * cache);
+static void  destroy_cb(lv_cache_t * cache, void * user_data);
+
+static lv_cache_entry_t * get_cb(lv_cache_t * cache, const void * key, void * user_data);
+static lv_cache_entry_t * add_cb(lv_cache_t * cache, const void * key, void * user_data);
+static void remove_cb(lv_cache_t * cache, lv_cache_entry_t * entry, void * user_data);
+static void drop_cb(lv_cache_t * cache, const void * key, void * user_data);
+static void drop_all_cb(lv_cache_t * cache, void * user_data);
+static lv_cache_entry_t * get_victim_cb(lv_cache_t * cache, void * user_data);
+static lv_cache_reserve_cond_res_t reserve_cond_cb(lv_cache_t * cache, const void * key, size_t reserved_size,
+                                                   void * user_data);
+
+static bool init_common(lv_s3fifo_t_ * s3fifo);
+static inline s3fifo_node_t * get_s3fifo_node(lv_s3fifo_t_ * s3fifo, lv_rb_node_t * node);
+static void move_to_main(lv_s3fifo_t_ * s3fifo, lv_rb_node_t * node);
+static void unlink_node(lv_s3fifo_t_ * s3fifo, lv_rb_node_t * node);
+
+static uint32_t cnt_get_data_size_cb(const void * data);
+static uint32_t size_get_data_size_cb(const void * data);
+
+/**********************
+ *  GLOBAL VARIABLES
+ **********************/
+const lv_cache_class_t lv_cache_class_s3fifo_count = {
+    .alloc_cb = alloc_cb,
+    .init_cb = init_cnt_cb,
+    .destroy_cb = destroy_cb,
+
+    .get_cb = get_cb,
+    .add_cb = add_cb,
+    .remove_cb = remove_cb,
+    .drop_cb = drop_cb,
+    .drop_all_cb = drop_all_cb,
+    .get_victim_cb = get_victim_cb,
+    .reserve_cond_cb = reserve_cond_cb
+};
+
+const lv_cache_class_t lv_cache_class_s3fifo_size = {
+    .alloc_cb = alloc_cb,
+    .init_cb = init_size_cb,
+    .destroy_cb = destroy_cb,
+
+    .get_cb = get_cb,
+    .add_cb = add_cb,
+    .remove_cb = remove_cb,
+    .drop_cb = drop_cb,
+    .drop_all_cb = drop_all_cb,
+    .get_victim_cb = get_victim_cb,
+    .reserve_cond_cb = reserve_cond_cb
+};
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static void * alloc_cb(void)
+{
+    void * res = lv_malloc(sizeof(lv_s3fifo_t_));
+    LV_ASSERT_MALLOC(res);
+    if(res == NULL) {
+        LV_LOG_ERROR("malloc failed");
+        return NULL;
+    }
+
+    lv_memzero(res, sizeof(lv_s3fifo_t_));
+    return res;
+}
+
+static bool init_cnt_cb(lv_cache_t * cache)
+{
+    lv_s3fifo_t_ * s3fifo = (lv_s3fifo_t_ *)cache;
+    if(!init_common(s3fifo)) return false;
+
+    s3fifo->get_data_size_cb = cnt_get_data_size_cb;
+    return true;
+}
+
+static bool init_size_cb(lv_cache_t * cache)
+{
+    lv_s3fifo_t_ * s3fifo = (lv_s3fifo_t_ *)cache;
+    if(!init_common(s3fifo)) return false;
+
+    s3fifo->get_data_size_cb = size_get_data_size_cb;
+    return true;
+}
+
+static void destroy_cb(lv_cache_t * cache, void * user_data)
+{
+    LV_ASSERT_NULL(cache);
+
+    if(cache == NULL) {
+        return;
+    }
+
+    cache->clz->drop_all_cb(cache, user_data);
+}
+
+static lv_cache_entry_t * get_cb(lv_cache_t * cache, const void * key, void * user_data)
+{
+    LV_UNUSED(user_data);
+
+    lv_s3fifo_t_ * s3fifo = (lv_s3fifo_t_ *)cache;
+
+    LV_ASSERT_NULL(s3fifo);
+    LV_ASSERT_NULL(key);
+
+    if(s3fifo == NULL || key == NULL) {
+        return NULL;
+    }
+
+    lv_rb_node_t * node = lv_rb_find(&s3fifo->rb, key);
+    if(node == NULL) {
+        return NULL;
+    }
+
+    /*cache hit: only count it, the queues are not changed*/
+    s3fifo_node_t * s_node = get_s3fifo_node(s3fifo, node);
+    if(s_node->freq < FREQ_MAX) s_node->freq++;
+
+    return lv_cache_entry_get_entry(node->data, cache->node_size);
+}
+
+static lv_cache_entry_t * add_cb(lv_cache_t * cache, const void * key, void * user_data)
+{
+    LV_UNUSED(user_data);
+
+    lv_s3fifo_t_ * s3fifo = (lv_s3fifo_t_ *)cache;
+
+    LV_ASSERT_NULL(s3fifo);
+    LV_ASSERT_NULL(key);
+
+    if(s3fifo == NULL || key == NULL) {
+        return NULL;
+    }
+
+    lv_rb_node_t * node = lv_rb_insert(&s3fifo->rb, (void *)key);
+    if(node == NULL) {
+        return NULL;
+    }
+
+    /*Keys evicted recently are likely to be used again so they go to the main queue directly*/
+    bool was_ghost = false;
+    if(cache->ops.hash_cb) {
+        was_ghost = lv_cache_ghost_remove(&s3fifo->ghost, cache->ops.hash_cb(key));
+    }
+
+    lv_ll_t * ll = was_ghost ? &s3fifo->main : &s3fifo->small;
+    void * ll_node = lv_ll_ins_head(ll);
+    if(ll_node == NULL) {
+        lv_rb_drop_node(&s3fifo->rb, node);
+        return NULL;
+    }
+    *(lv_rb_node_t **)ll_node = node;
+
+    lv_memcpy(node->data, key, cache->node_size);
+    lv_cache_entry_t * entry = lv_cache_entry_get_entry(node->data, cache->node_size);
+    lv_cache_entry_init(entry, cache, cache->node_size);
+
+    s3fifo_node_t * s_node = get_s3fifo_node(s3fifo, node);
+    s_node->ll_node = ll_node;
+    s_node->in_main = was_ghost;
+    s_node->freq = 0;
+
+    uint32_t data_size = s3fifo->get_data_size_cb(key);
+    if(was_ghost) s3fifo->main_size += data_size;
+    else s3fifo->small_size += data_size;
+    s3fifo->node_cnt++;
+    cache->size += data_size;
+
+    return entry;
+}
+
+static void remove_cb(lv_cache_t * cache, lv_cache_entry_t * entry, void * user_data)
+{
+    LV_UNUSED(user_data);
+
+    lv_s3fifo_t_ * s3fifo = (lv_s3fifo_t_ *)cache;
+
+    LV_ASSERT_NULL(s3fifo);
+    LV_ASSERT_NULL(entry);
+
+    if(s3fifo == NULL || entry == NULL) {
+        return;
+    }
+
+    void * data = lv_cache_entry_get_data(entry);
+    lv_rb_node_t * node = lv_rb_find(&s3fifo->rb, data);
+    if(node == NULL) {
+        return;
+    }
+
+    /*Remember only the evicted keys. The dropped ones were invalidated by the user.*/
+    if(entry == s3fifo->victim && cache->ops.hash_cb) {
+        lv_cache_ghost_add(&s3fifo->ghost, cache->ops.hash_cb(data), s3fifo->get_data_size_cb(data));
+
+        /*The ghost queue remembers as many keys as fit into the main queue*/
+        uint32_t main_max = cache->max_size - cache->max_size / SMALL_RATIO_DIV;
+        while(s3fifo->ghost.size > main_max) {
+            lv_cache_ghost_remove_oldest(&s3fifo->ghost);
+        }
+    }
+    s3fifo->victim = NULL;
+
+    unlink_node(s3fifo, node);
+    lv_rb_remove_node(&s3fifo->rb, node);
+}
+
+static void drop_cb(lv_cache_t * cache, const void * key, void * user_data)
+{
+    lv_s3fifo_t_ * s3fifo = (lv_s3fifo_t_ *)cache;
+
+    LV_ASSERT_NULL(s3fifo);
+    LV_ASSERT_NULL(key);
+
+    if(s3fifo == NULL || key == NULL) {
+        return;
+    }
+
+    lv_rb_node_t * node = lv_rb_find(&s3fifo->rb, key);
+    if(node == NULL) {
+        return;
+    }
+
+    void * data = node->data;
+
+    cache->ops.free_cb(data, user_data);
+    unlink_node(s3fifo, node);
+
+    lv_cache_entry_t * entry = lv_cache_entry_get_entry(data, cache->node_size);
+    lv_rb_remove_node(&s3fifo->rb, node);
+    lv_cache_entry_delete(entry);
+}
+
+static void drop_all_cb(lv_cache_t * cache, void * user_data)
+{
+    lv_s3fifo_t_ * s3fifo = (lv_s3fifo_t_ *)cache;
+
+    LV_ASSERT_NULL(s3fifo);
+
+    if(s3fifo == NULL) {
+        return;
+    }
+
+    uint32_t used_cnt = 0;
+    lv_ll_t * lists[2] = {&s3fifo->small, &s3fifo->main};
+    uint32_t i;
+    for(i = 0; i < 2; i++) {
+        lv_rb_node_t ** node;
+        LV_LL_READ(lists[i], node) {
+            /*free user handled data and do other clean up*/
+            void * search_key = (*node)->data;
+            lv_cache_entry_t * entry = lv_cache_entry_get_entry(search_key, cache->node_size);
+            if(lv_cache_entry_get_ref(entry) == 0) {
+                cache->ops.free_cb(search_key, user_data);
+            }
+            else {
+                LV_LOG_WARN("entry (%p) is still referenced (%" LV_PRId32 ")", (void *)entry, lv_cache_entry_get_ref(entry));
+                used_cnt++;
+            }
+        }
+    }
+    if(used_cnt > 0) {
+        LV_LOG_WARN("%" LV_PRId32 " entries are still referenced", used_cnt);
+    }
+
+    lv_rb_destroy(&s3fifo->rb);
+    lv_ll_clear(&s3fifo->small);
+    lv_ll_clear(&s3fifo->main);
+    lv_cache_ghost_clear(&s3fifo->ghost);
+
+    s3fifo->small_size = 0;
+    s3fifo->main_size = 0;
+    s3fifo->node_cnt = 0;
+    s3fifo->victim = NULL;
+    cache->size = 0;
+}
+
+static lv_cache_entry_t * get_victim_cb(lv_cache_t * cache, void * user_data)
+{
+    LV_UNUSED(user_data);
+
+    lv_s3fifo_t_ * s3fifo = (lv_s3fifo_t_ *)cache;
+
+    LV_ASSERT_NULL(s3fifo);
+
+    uint32_t small_max = cache->max_size / SMALL_RATIO_DIV;
+
+    /*Each node can be moved from `small` to `main` once and reinserted into `main` FREQ_MAX times,
+     *referenced nodes are reinserted once more. If there is still no victim all nodes are referenced.*/
+    uint32_t step_max = s3fifo->node_cnt * (FREQ_MAX + 2);
+    uint32_t i;
+    for(i = 0; i < step_max; i++) {
+        bool from_small = s3fifo->small_size > 0 && (s3fifo->small_size >= small_max || s3fifo->main_size == 0);
+        lv_ll_t * ll = from_small ? &s3fifo->small : &s3fifo->main;
+
+        lv_rb_node_t ** tail = lv_ll_get_tail(ll);
+        if(tail == NULL) break;
+
+        lv_rb_node_t * node = *tail;
+        lv_cache_entry_t * entry = lv_cache_entry_get_entry(node->data, cache->node_size);
+        s3fifo_node_t * s_node = get_s3fifo_node(s3fifo, node);
+        bool used = lv_cache_entry_get_ref(entry) > 0;
+
+        if(from_small) {
+            /*Used again since it was added or it's in use now: keep it*/
+            if(s_node->freq > 0 || used) {
+                move_to_main(s3fifo, node);
+                continue;
+            }
+        }
+        else if(s_node->freq > 0 || used) {
+            if(!used) s_node->freq--;
+            lv_ll_chg_list(&s3fifo->main, &s3fifo->main, s_node->ll_node, true);
+            continue;
+        }
+
+        s3fifo->victim = entry;
+        return entry;
+    }
+
+    return NULL;
+}
+
+static lv_cache_reserve_cond_res_t reserve_cond_cb(lv_cache_t * cache, const void * key, size_t reserved_size,
+                                                   void * user_data)
+{
+    LV_UNUSED(user_data);
+
+    lv_s3fifo_t_ * s3fifo = (lv_s3fifo_t_ *)cache;
+
+    LV_ASSERT_NULL(s3fifo);
+
+    if(s3fifo == NULL) {
+        return LV_CACHE_RESERVE_COND_ERROR;
+    }
+
+    uint32_t data_size = key ? s3fifo->get_data_size_cb(key) : 0;
+    if(data_size > cache->max_size) {
+        LV_LOG_ERROR("data size (%" LV_PRIu32 ") is larger than max size (%" LV_PRIu32 ")", data_size, cache->max_size);
+        return LV_CACHE_RESERVE_COND_TOO_LARGE;
+    }
+
+    return cache->size + reserved_size + data_size > cache->max_size
+           ? LV_CACHE_RESERVE_COND_NEED_VICTIM
+           : LV_CACHE_RESERVE_COND_OK;
+}
+
+static bool init_common(lv_s3fifo_t_ * s3fifo)
+{
+    LV_ASSERT_NULL(s3fifo->cache.ops.compare_cb);
+    LV_ASSERT_NULL(s3fifo->cache.ops.free_cb);
+    LV_ASSERT(s3fifo->cache.node_size > 0);
+
+    if(s3fifo->cache.node_size <= 0 || s3fifo->cache.ops.compare_cb == NULL || s3fifo->cache.ops.free_cb == NULL) {
+        return false;
+    }
+
+    /*add the queue state after the entry*/
+    if(!lv_rb_init(&s3fifo->rb, s3fifo->cache.ops.compare_cb,
+                   lv_cache_entry_get_size(s3fifo->cache.node_size) + sizeof(s3fifo_node_t))) {
+        return false;
+    }
+    lv_ll_init(&s3fifo->small, sizeof(void *));
+    lv_ll_init(&s3fifo->main, sizeof(void *));
+    lv_cache_ghost_init(&s3fifo->ghost);
+
+    return true;
+}
+
+static inline s3fifo_node_t * get_s3fifo_node(lv_s3fifo_t_ * s3fifo, lv_rb_node_t * node)
+{
+    return (s3fifo_node_t *)((uint8_t *)node->data + lv_cache_entry_get_size(s3fifo->cache.node_size));
+}
+
+static void move_to_main(lv_s3fifo_t_ * s3fifo, lv_rb_node_t * node)
+{
+    s3fifo_node_t * s_node = get_s3fifo_node(s3fifo, node);
+    uint32_t data_size = s3fifo->get_data_size_cb(node->data);
+
+    lv_ll_chg_list(&s3fifo->small, &s3fifo->main, s_node->ll_node, true);
+    s3fifo->small_size -= data_size;
+    s3fifo->main_size += data_size;
+    s_node->in_main = 1;
+    s_node->freq = 0;
+}
+
+/**
+ * Remove a node from its queue and update the sizes. The rb node is not changed.
+ */
+static void unlink_node(lv_s3fifo_t_ * s3fifo, lv_rb_node_t * node)
+{
+    s3fifo_node_t * s_node = get_s3fifo_node(s3fifo, node);
+    uint32_t data_size = s3fifo->get_data_size_cb(node->data);
+
+    lv_ll_t * ll = s_node->in_main ? &s3fifo->main : &s3fifo->small;
+    lv_ll_remove(ll, s_node->ll_node);
+    lv_free(s_node->ll_node);
+    s_node->ll_node = NULL;
+
+    if(s_node->in_main) s3fifo->main_size -= data_size;
+    else s3fifo->small_size -= data_size;
+    s3fifo->node_cnt--;
+    s3fifo->cache.size -= data_size;
+}
+
+static uint32_t cnt_get_data_size_cb(const void * data)
+{
+    LV_UNUSED(data);
+    return 1;
+}
+
+static uint32_t size_get_data_size_cb(const void * data)
+{
+    lv_cache_slot_size_t * slot = (lv_cache_slot_size_t *)data;
+    return slot->size;
+}
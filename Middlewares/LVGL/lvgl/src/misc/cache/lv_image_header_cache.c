@@ -31,6 +31,7 @@
 
 static lv_cache_compare_res_t image_header_cache_compare_cb(const lv_image_header_cache_data_t * lhs,
                                                             const lv_image_header_cache_data_t * rhs);
+static uint32_t image_header_cache_hash_cb(const lv_image_header_cache_data_t * node);
 static void image_header_cache_free_cb(lv_image_header_cache_data_t * entry, void * user_data);
 
 /**********************
@@ -55,11 +56,12 @@ lv_result_t lv_image_header_cache_init(uint32_t count)
         return LV_RESULT_OK;
     }
 
-    img_header_cache_p = lv_cache_create(&lv_cache_class_lru_rb_count,
+    img_header_cache_p = lv_cache_create(lv_cache_class_get(LV_IMAGE_HEADER_CACHE_POLICY, false),
     sizeof(lv_image_header_cache_data_t), count, (lv_cache_ops_t) {
         .compare_cb = (lv_cache_compare_cb_t) image_header_cache_compare_cb,
         .create_cb = NULL,
-        .free_cb = (lv_cache_free_cb_t) image_header_cache_free_cb
+        .free_cb = (lv_cache_free_cb_t) image_header_cache_free_cb,
+        .hash_cb = (lv_cache_hash_cb_t) image_header_cache_hash_cb,
     });
 
     lv_cache_set_name(img_header_cache_p, CACHE_NAME);
@@ -118,6 +120,23 @@ inline static lv_cache_compare_res_t image_cache_common_compare(const void * lhs
     return lhs_src_type > rhs_src_type ? 1 : -1;
 }
 
+inline static uint32_t image_cache_common_hash(const void * src, lv_image_src_t src_type)
+{
+    /*Hash the same things which are compared*/
+    uint32_t h = 0x811C9DC5 ^ (uint32_t)src_type;
+    if(src_type == LV_IMAGE_SRC_FILE) {
+        const uint8_t * s = src;
+        while(*s) {
+            h = (h ^ *s) * 0x01000193;
+            s++;
+        }
+    }
+    else if(src_type == LV_IMAGE_SRC_VARIABLE) {
+        h ^= (uint32_t)(uintptr_t)src * 0x9E3779B1;
+    }
+    return h;
+}
+
 static lv_cache_compare_res_t image_header_cache_compare_cb(
     const lv_image_header_cache_data_t * lhs,
     const lv_image_header_cache_data_t * rhs)
@@ -125,6 +144,11 @@ static lv_cache_compare_res_t image_header_cache_compare_cb(
     return image_cache_common_compare(lhs->src, lhs->src_type, rhs->src, rhs->src_type);
 }
 
+static uint32_t image_header_cache_hash_cb(const lv_image_header_cache_data_t * node)
+{
+    return image_cache_common_hash(node->src, node->src_type);
+}
+
 static void image_header_cache_free_cb(lv_image_header_cache_data_t * entry, void * user_data)
 {
     LV_UNUSED(user_data); /*Unused*/
@@ -0,0 +1,196 @@
+/**
+ * @file lv_arena.c
+ * Allocate short living memories by moving a pointer and free all of them at once.
+ *
+ * The chunks are linked in allocation order. An allocation is served from the current chunk
+ * and if it doesn't fit a new chunk is chained after it. A reset frees the chained chunks
+ * and rewinds the first one.
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_arena.h"
+#include "lv_assert.h"
+#include "lv_math.h"
+#include "../stdlib/lv_mem.h"
+#include "../stdlib/lv_string.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+#define ALIGN_PTR(x)        (((x) + sizeof(void *) - 1) & ~(sizeof(void *) - 1))
+#define CHUNK_HEADER_SIZE   ALIGN_PTR(sizeof(lv_arena_chunk_t))
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+struct lv_arena_chunk_t {
+    lv_arena_chunk_t * next;
+    size_t size;                /*Usable size*/
+    size_t used;
+};
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static lv_arena_chunk_t * chunk_create(lv_arena_t * arena, size_t size);
+static void chunk_list_free(lv_arena_t * arena, lv_arena_chunk_t * chunk);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_arena_init(lv_arena_t * arena, uint32_t chunk_size)
+{
+    LV_ASSERT_NULL(arena);
+
+    lv_memzero(arena, sizeof(lv_arena_t));
+    arena->chunk_size = ALIGN_PTR(chunk_size);
+}
+
+void lv_arena_set_chunk_max(lv_arena_t * arena, uint32_t chunk_max)
+{
+    LV_ASSERT_NULL(arena);
+
+    arena->chunk_max = chunk_max;
+}
+
+void lv_arena_destroy(lv_arena_t * arena)
+{
+    LV_ASSERT_NULL(arena);
+
+    chunk_list_free(arena, arena->head);
+    arena->head = NULL;
+    arena->cur = NULL;
+    arena->used_size = 0;
+}
+
+void * lv_arena_alloc(lv_arena_t * arena, size_t size)
+{
+    LV_ASSERT_NULL(arena);
+
+    if(size == 0) return NULL;
+    size = ALIGN_PTR(size);
+
+    lv_arena_chunk_t * chunk = arena->cur;
+    if(chunk == NULL || chunk->size - chunk->used < size) {
+        if(arena->chunk_max && arena->chunk_cnt >= arena->chunk_max) {
+            arena->full_cnt++;
+            return NULL;
+        }
+
+        chunk = chunk_create(arena, LV_MAX(size, arena->chunk_size));
+        if(chunk == NULL) return NULL;
+
+        if(arena->cur) {
+            arena->cur->next = chunk;
+            arena->chain_cnt++;
+        }
+        else {
+            arena->head = chunk;
+        }
+        arena->cur = chunk;
+    }
+
+    void * p = (uint8_t *)chunk + CHUNK_HEADER_SIZE + chunk->used;
+    chunk->used += size;
+
+    arena->used_size += size;
+    if(arena->used_size > arena->max_used) arena->max_used = arena->used_size;
+    arena->alloc_cnt++;
+
+    return p;
+}
+
+void lv_arena_reset(lv_arena_t * arena)
+{
+    LV_ASSERT_NULL(arena);
+
+    if(arena->head == NULL) return;
+
+    /*Keep only the first chunk as the chained ones are needed only if the arena was used more than usual.
+     *If the first chunk was allocated for a single large memory free it too.*/
+    if(arena->head->size > arena->chunk_size) {
+        chunk_list_free(arena, arena->head);
+        arena->head = NULL;
+    }
+    else {
+        chunk_list_free(arena, arena->head->next);
+        arena->head->next = NULL;
+        arena->head->used = 0;
+    }
+
+    arena->cur = arena->head;
+    arena->used_size = 0;
+    arena->reset_cnt++;
+}
+
+void lv_arena_get_stat(lv_arena_t * arena, lv_arena_stat_t * stat)
+{
+    LV_ASSERT_NULL(arena);
+    LV_ASSERT_NULL(stat);
+
+    lv_memzero(stat, sizeof(lv_arena_stat_t));
+
+    lv_arena_chunk_t * chunk = arena->head;
+    while(chunk) {
+        stat->total_size += chunk->size;
+        chunk = chunk->next;
+    }
+
+    stat->used_size = arena->used_size;
+    stat->max_used = arena->max_used;
+    stat->chunk_cnt = arena->chunk_cnt;
+    stat->alloc_cnt = arena->alloc_cnt;
+    stat->chain_cnt = arena->chain_cnt;
+    stat->reset_cnt = arena->reset_cnt;
+    stat->full_cnt = arena->full_cnt;
+}
+
+void lv_arena_reset_stat(lv_arena_t * arena)
+{
+    LV_ASSERT_NULL(arena);
+
+    arena->max_used = arena->used_size;
+    arena->alloc_cnt = 0;
+    arena->chain_cnt = 0;
+    arena->reset_cnt = 0;
+    arena->full_cnt = 0;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static lv_arena_chunk_t * chunk_create(lv_arena_t * arena, size_t size)
+{
+    lv_arena_chunk_t * chunk = lv_malloc(CHUNK_HEADER_SIZE + size);
+    if(chunk == NULL) return NULL;
+
+    chunk->next = NULL;
+    chunk->size = size;
+    chunk->used = 0;
+    arena->chunk_cnt++;
+
+    return chunk;
+}
+
+static void chunk_list_free(lv_arena_t * arena, lv_arena_chunk_t * chunk)
+{
+    while(chunk) {
+        lv_arena_chunk_t * next = chunk->next;
+        lv_free(chunk);
+        arena->chunk_cnt--;
+        chunk = next;
+    }
+}
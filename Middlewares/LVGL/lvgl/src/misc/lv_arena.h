@@ -0,0 +1,118 @@
+/**
+ * @file lv_arena.h
+ * Allocate short living memories by moving a pointer and free all of them at once.
+ */
+
+#ifndef LV_ARENA_H
+#define LV_ARENA_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../lv_conf_internal.h"
+#include "lv_types.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+typedef struct lv_arena_chunk_t lv_arena_chunk_t;
+
+/** Description of an arena*/
+typedef struct {
+    lv_arena_chunk_t * head;    /**< The first chunk. It's kept when the arena is reset.*/
+    lv_arena_chunk_t * cur;     /**< The chunk where the next allocation is tried*/
+    uint32_t chunk_size;        /**< Usable size of a chunk in bytes*/
+    uint32_t chunk_cnt;
+    uint32_t chunk_max;         /**< At most this many chunks are allocated, 0: no limit*/
+    size_t used_size;           /**< Allocated bytes since the last reset*/
+    size_t max_used;            /**< The largest `used_size` since the last stat reset*/
+    uint32_t alloc_cnt;         /**< Number of allocations since the last stat reset*/
+    uint32_t chain_cnt;         /**< Number of overflow chunks allocated since the last stat reset*/
+    uint32_t reset_cnt;         /**< Number of resets since the last stat reset*/
+    uint32_t full_cnt;          /**< Number of allocations refused because of `chunk_max` since the last stat reset*/
+} lv_arena_t;
+
+typedef struct {
+    size_t total_size;          /**< Usable size of the chunks in bytes*/
+    size_t used_size;
+    size_t max_used;
+    uint32_t chunk_cnt;
+    uint32_t alloc_cnt;
+    uint32_t chain_cnt;
+    uint32_t reset_cnt;
+    uint32_t full_cnt;
+} lv_arena_stat_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Initialize an arena. The chunks are allocated with `lv_malloc` when they are first needed.
+ * @param arena         pointer to an `lv_arena_t` variable
+ * @param chunk_size    usable size of a chunk in bytes. Larger allocations get a chunk of their own.
+ */
+void lv_arena_init(lv_arena_t * arena, uint32_t chunk_size);
+
+/**
+ * Limit the number of chunks of an arena. When all are full `lv_arena_alloc` returns NULL until the next reset.
+ * The chunks already allocated are kept.
+ * @param arena     pointer to an arena
+ * @param chunk_max the maximum number of chunks, 0: no limit
+ */
+void lv_arena_set_chunk_max(lv_arena_t * arena, uint32_t chunk_max);
+
+/**
+ * Free all chunks of an arena
+ * @param arena     pointer to an arena
+ */
+void lv_arena_destroy(lv_arena_t * arena);
+
+/**
+ * Allocate pointer aligned memory from an arena. If the current chunk is full a new one is chained to it.
+ * The memory can't be freed alone, only with `lv_arena_reset`.
+ * @param arena     pointer to an arena
+ * @param size      size of the memory in bytes
+ * @return          pointer to the memory or NULL if there is not enough memory, the chunk limit is reached
+ *                  or `size` is 0
+ */
+void * lv_arena_alloc(lv_arena_t * arena, size_t size);
+
+/**
+ * Free all memories allocated from an arena. The first chunk is kept for the next allocations,
+ * the chained ones are freed.
+ * @param arena     pointer to an arena
+ */
+void lv_arena_reset(lv_arena_t * arena);
+
+/**
+ * Get the statistics of an arena
+ * @param arena     pointer to an arena
+ * @param stat      store the result here
+ */
+void lv_arena_get_stat(lv_arena_t * arena, lv_arena_stat_t * stat);
+
+/**
+ * Reset the counters of an arena
+ * @param arena     pointer to an arena
+ */
+void lv_arena_reset_stat(lv_arena_t * arena);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_ARENA_H*/
@@ -8,6 +8,7 @@
  *********************/
 #include "lv_event_private.h"
 #include "../core/lv_global.h"
+#include "../core/lv_obj_class_private.h"
 #include "../stdlib/lv_mem.h"
 #include "lv_assert.h"
 #include "lv_types.h"
@@ -88,7 +89,7 @@ lv_result_t lv_event_send(lv_event_list_t * list, lv_event_t * e, bool preproces
 lv_event_dsc_t * lv_event_add(lv_event_list_t * list, lv_event_cb_t cb, lv_event_code_t filter,
                               void * user_data)
 {
-    lv_event_dsc_t * dsc = lv_malloc(sizeof(lv_event_dsc_t));
+    lv_event_dsc_t * dsc = lv_obj_slab_alloc(sizeof(lv_event_dsc_t));
     LV_ASSERT_NULL(dsc);
 
     dsc->cb = cb;
@@ -113,7 +114,7 @@ bool lv_event_remove_dsc(lv_event_list_t * list, lv_event_dsc_t * dsc)
     lv_event_dsc_t ** events = lv_array_front(list);
     for(int i = 0; i < size; i++) {
         if(events[i] == dsc) {
-            lv_free(dsc);
+            lv_obj_slab_free(dsc);
             lv_array_remove(list, i);
             return true;
         }
@@ -153,7 +154,7 @@ bool lv_event_remove(lv_event_list_t * list, uint32_t index)
 {
     LV_ASSERT_NULL(list);
     lv_event_dsc_t * dsc = lv_event_get_dsc(list, index);
-    lv_free(dsc);
+    lv_obj_slab_free(dsc);
     return lv_array_remove(list, index);
 }
 
@@ -163,7 +164,7 @@ void lv_event_remove_all(lv_event_list_t * list)
     int size = lv_array_size(list);
     lv_event_dsc_t ** dsc = lv_array_front(list);
     for(int i = 0; i < size; i++) {
-        lv_free(dsc[i]);
+        lv_obj_slab_free(dsc[i]);
     }
     lv_array_deinit(list);
 }
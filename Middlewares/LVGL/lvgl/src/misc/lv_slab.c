@@ -0,0 +1,415 @@
+/**
+ * @file lv_slab.c
+ * Allocate fixed size blocks from pages. The pages are allocated by a user provided function.
+ *
+ * Each block starts with a pointer sized header. For allocated blocks it stores `page | 1`, so freeing
+ * doesn't need to search for the page of the block. Blocks larger than the largest class are allocated directly
+ * and their header stores `size << 1`. The pages are pointer aligned so the lowest bit tells them apart.
+ * For free blocks the header links the free blocks of the page.
+ *
+ * A used TLSF block is preceded by its size with the lowest (free) bit cleared, so a memory allocator can mix
+ * the class blocks with blocks allocated by TLSF directly and tell them apart with `lv_slab_is_class_block()`.
+ *
+ * The pages can be taken from a dedicated region too. It's split into pages of equal size and the first
+ * pointer of the free pages links them.
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_slab.h"
+#include "lv_assert.h"
+#include "lv_math.h"
+#include "../stdlib/lv_string.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+#define ALIGN_PTR(x)        (((x) + sizeof(void *) - 1) & ~(sizeof(void *) - 1))
+#define PAGE_HEADER_SIZE    ALIGN_PTR(sizeof(lv_slab_page_t))
+#define BLOCK_HEADER_SIZE   sizeof(lv_uintptr_t)
+#define CLASS_BLOCK_BIT     ((lv_uintptr_t)1)
+#define HEADER_TO_PAGE(h)   ((lv_slab_page_t *)((h) & ~CLASS_BLOCK_BIT))
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+struct lv_slab_page_t {
+    lv_slab_page_t * prev;
+    lv_slab_page_t * next;
+    lv_slab_class_t * class_p;
+    lv_uintptr_t * free_list;   /*Header of the first free block*/
+    uint32_t used_cnt;
+    uint32_t unused_idx;        /*The blocks from this index were never allocated*/
+};
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static lv_slab_class_t * find_class(lv_slab_t * slab, size_t size);
+static lv_slab_page_t * page_create(lv_slab_t * slab, lv_slab_class_t * class_p);
+static void page_delete(lv_slab_t * slab, lv_slab_page_t * page);
+static void page_list_insert(lv_slab_page_t ** head, lv_slab_page_t * page);
+static void page_list_remove(lv_slab_page_t ** head, lv_slab_page_t * page);
+static void page_list_free(lv_slab_t * slab, lv_slab_page_t * head);
+static void * large_alloc(lv_slab_t * slab, size_t size);
+static void large_free(lv_slab_t * slab, lv_uintptr_t * block);
+static void * large_realloc(lv_slab_t * slab, lv_uintptr_t * block, size_t new_size);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_slab_init(lv_slab_t * slab, lv_slab_class_t * classes, const uint16_t * sizes, uint32_t class_cnt,
+                  uint32_t page_size, lv_slab_page_alloc_cb_t page_alloc_cb, lv_slab_page_free_cb_t page_free_cb)
+{
+    LV_ASSERT_NULL(slab);
+    LV_ASSERT_NULL(page_alloc_cb);
+    LV_ASSERT_NULL(page_free_cb);
+
+    lv_memzero(slab, sizeof(lv_slab_t));
+    lv_memzero(classes, sizeof(lv_slab_class_t) * class_cnt);
+    slab->classes = classes;
+    slab->class_cnt = class_cnt;
+    slab->page_alloc_cb = page_alloc_cb;
+    slab->page_free_cb = page_free_cb;
+    slab->page_size = ALIGN_PTR(page_size);
+
+    uint32_t i;
+    for(i = 0; i < class_cnt; i++) {
+        LV_ASSERT(i == 0 || sizes[i] > sizes[i - 1]);
+
+        lv_slab_class_t * class_p = &classes[i];
+        class_p->size = ALIGN_PTR(sizes[i]);
+        class_p->block_size = BLOCK_HEADER_SIZE + class_p->size;
+        if(page_size > PAGE_HEADER_SIZE) class_p->block_per_page = (page_size - PAGE_HEADER_SIZE) / class_p->block_size;
+        if(class_p->block_per_page < 2) class_p->block_per_page = 2;
+    }
+}
+
+void lv_slab_set_realloc_cb(lv_slab_t * slab, lv_slab_page_realloc_cb_t page_realloc_cb)
+{
+    slab->page_realloc_cb = page_realloc_cb;
+}
+
+void lv_slab_set_page_pool(lv_slab_t * slab, void * mem, size_t size)
+{
+    LV_ASSERT_NULL(slab);
+
+    slab->pool = NULL;
+    slab->pool_end = NULL;
+    slab->pool_free = NULL;
+    if(mem == NULL || slab->page_size < PAGE_HEADER_SIZE) return;
+
+    uint32_t page_cnt = size / slab->page_size;
+    if(page_cnt == 0) return;
+
+    slab->pool = mem;
+    slab->pool_end = slab->pool + page_cnt * slab->page_size;
+
+    /*Link the pages in address order*/
+    uint32_t i;
+    for(i = page_cnt; i > 0; i--) {
+        void ** page = (void **)(slab->pool + (i - 1) * slab->page_size);
+        *page = slab->pool_free;
+        slab->pool_free = page;
+    }
+}
+
+void lv_slab_destroy(lv_slab_t * slab)
+{
+    uint32_t i;
+    for(i = 0; i < slab->class_cnt; i++) {
+        lv_slab_class_t * class_p = &slab->classes[i];
+        page_list_free(slab, class_p->partial);
+        page_list_free(slab, class_p->full);
+        class_p->partial = NULL;
+        class_p->full = NULL;
+        class_p->page_cnt = 0;
+        class_p->used_cnt = 0;
+    }
+}
+
+void * lv_slab_alloc(lv_slab_t * slab, size_t size)
+{
+    if(size == 0) return NULL;
+
+    lv_slab_class_t * class_p = find_class(slab, size);
+    if(class_p == NULL) return large_alloc(slab, size);
+
+    lv_slab_page_t * page = class_p->partial;
+    if(page == NULL) {
+        page = page_create(slab, class_p);
+        if(page == NULL) return NULL;
+    }
+
+    lv_uintptr_t * block = page->free_list;
+    if(block) {
+        page->free_list = (lv_uintptr_t *)*block;
+    }
+    else {
+        block = (lv_uintptr_t *)((uint8_t *)page + PAGE_HEADER_SIZE + page->unused_idx * class_p->block_size);
+        page->unused_idx++;
+    }
+
+    *block = (lv_uintptr_t)page | CLASS_BLOCK_BIT;
+    page->used_cnt++;
+    class_p->used_cnt++;
+    class_p->alloc_cnt++;
+
+    if(page->used_cnt == class_p->block_per_page) {
+        page_list_remove(&class_p->partial, page);
+        page_list_insert(&class_p->full, page);
+    }
+
+    return block + 1;
+}
+
+void lv_slab_free(lv_slab_t * slab, void * p)
+{
+    if(p == NULL) return;
+
+    lv_uintptr_t * block = (lv_uintptr_t *)p - 1;
+    if((*block & CLASS_BLOCK_BIT) == 0) {
+        large_free(slab, block);
+        return;
+    }
+
+    lv_slab_page_t * page = HEADER_TO_PAGE(*block);
+    lv_slab_class_t * class_p = page->class_p;
+
+    if(page->used_cnt == class_p->block_per_page) {
+        page_list_remove(&class_p->full, page);
+        page_list_insert(&class_p->partial, page);
+    }
+
+    *block = (lv_uintptr_t)page->free_list;
+    page->free_list = block;
+    page->used_cnt--;
+    class_p->used_cnt--;
+
+    /*Keep the page if it's the only one with free blocks.
+     *This way allocating and freeing a block at a page boundary doesn't create and free a page each time.*/
+    if(page->used_cnt == 0 && (class_p->partial != page || page->next != NULL)) {
+        page_list_remove(&class_p->partial, page);
+        page_delete(slab, page);
+        class_p->page_cnt--;
+    }
+}
+
+void * lv_slab_realloc(lv_slab_t * slab, void * p, size_t new_size)
+{
+    if(p == NULL) return lv_slab_alloc(slab, new_size);
+
+    if(new_size == 0) {
+        lv_slab_free(slab, p);
+        return NULL;
+    }
+
+    lv_uintptr_t header = *((lv_uintptr_t *)p - 1);
+    lv_slab_class_t * new_class_p = find_class(slab, new_size);
+    if(header & CLASS_BLOCK_BIT) {
+        lv_slab_page_t * page = HEADER_TO_PAGE(header);
+        if(new_class_p == page->class_p) return p;
+    }
+    else if(new_class_p == NULL && slab->page_realloc_cb) {
+        return large_realloc(slab, (lv_uintptr_t *)p - 1, new_size);
+    }
+
+    void * new_p = lv_slab_alloc(slab, new_size);
+    if(new_p == NULL) return NULL;
+
+    lv_memcpy(new_p, p, LV_MIN(lv_slab_get_size(slab, p), new_size));
+    lv_slab_free(slab, p);
+
+    return new_p;
+}
+
+size_t lv_slab_get_size(lv_slab_t * slab, const void * p)
+{
+    LV_UNUSED(slab);
+
+    lv_uintptr_t header = *((const lv_uintptr_t *)p - 1);
+    if(header & CLASS_BLOCK_BIT) return HEADER_TO_PAGE(header)->class_p->size;
+    else return header >> 1;
+}
+
+bool lv_slab_is_class_block(const void * p)
+{
+    return (*((const lv_uintptr_t *)p - 1) & CLASS_BLOCK_BIT) != 0;
+}
+
+void lv_slab_get_stat(lv_slab_t * slab, lv_slab_stat_t * stat)
+{
+    lv_memzero(stat, sizeof(lv_slab_stat_t));
+
+    uint32_t i;
+    for(i = 0; i < slab->class_cnt; i++) {
+        lv_slab_stat_t class_stat;
+        lv_slab_get_class_stat(slab, i, &class_stat);
+        stat->total_size += class_stat.total_size;
+        stat->used_size += class_stat.used_size;
+        stat->page_cnt += class_stat.page_cnt;
+        stat->used_cnt += class_stat.used_cnt;
+        stat->alloc_cnt += class_stat.alloc_cnt;
+    }
+
+    stat->total_size += slab->large_size + slab->large_cnt * BLOCK_HEADER_SIZE;
+    stat->used_size += slab->large_size;
+    stat->used_cnt += slab->large_cnt;
+    stat->alloc_cnt += slab->large_alloc_cnt;
+    stat->large_cnt = slab->large_cnt;
+}
+
+void lv_slab_get_class_stat(lv_slab_t * slab, uint32_t class_idx, lv_slab_stat_t * stat)
+{
+    lv_memzero(stat, sizeof(lv_slab_stat_t));
+    if(class_idx >= slab->class_cnt) return;
+
+    lv_slab_class_t * class_p = &slab->classes[class_idx];
+    stat->size = class_p->size;
+    stat->total_size = class_p->page_cnt * (PAGE_HEADER_SIZE + class_p->block_per_page * class_p->block_size);
+    stat->used_size = class_p->used_cnt * class_p->size;
+    stat->page_cnt = class_p->page_cnt;
+    stat->used_cnt = class_p->used_cnt;
+    stat->alloc_cnt = class_p->alloc_cnt;
+}
+
+void lv_slab_reset_stat(lv_slab_t * slab)
+{
+    uint32_t i;
+    for(i = 0; i < slab->class_cnt; i++) {
+        slab->classes[i].alloc_cnt = 0;
+    }
+
+    slab->large_alloc_cnt = 0;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Find the smallest class for a size
+ * @param slab      pointer to a slab allocator
+ * @param size      the required size in bytes
+ * @return          pointer to the class or NULL if `size` is larger than the largest class
+ */
+static lv_slab_class_t * find_class(lv_slab_t * slab, size_t size)
+{
+    uint32_t i;
+    for(i = 0; i < slab->class_cnt; i++) {
+        if(size <= slab->classes[i].size) return &slab->classes[i];
+    }
+
+    return NULL;
+}
+
+/**
+ * Allocate a new page for a class and add it to the pages with free blocks.
+ * The blocks are not initialized, they are taken one by one by `lv_slab_alloc`.
+ * @param slab      pointer to a slab allocator
+ * @param class_p   the class of the page
+ * @return          pointer to the new page or NULL if there is not enough memory
+ */
+static lv_slab_page_t * page_create(lv_slab_t * slab, lv_slab_class_t * class_p)
+{
+    size_t page_size = PAGE_HEADER_SIZE + class_p->block_per_page * class_p->block_size;
+    lv_slab_page_t * page;
+    if(slab->pool_free && page_size <= slab->page_size) {
+        page = slab->pool_free;
+        slab->pool_free = *(void **)page;
+    }
+    else {
+        page = slab->page_alloc_cb(page_size);
+        if(page == NULL) return NULL;
+    }
+
+    page->class_p = class_p;
+    page->free_list = NULL;
+    page->used_cnt = 0;
+    page->unused_idx = 0;
+    page_list_insert(&class_p->partial, page);
+    class_p->page_cnt++;
+
+    return page;
+}
+
+static void page_delete(lv_slab_t * slab, lv_slab_page_t * page)
+{
+    uint8_t * p = (uint8_t *)page;
+    if(p >= slab->pool && p < slab->pool_end) {
+        *(void **)page = slab->pool_free;
+        slab->pool_free = page;
+    }
+    else {
+        slab->page_free_cb(page);
+    }
+}
+
+static void page_list_insert(lv_slab_page_t ** head, lv_slab_page_t * page)
+{
+    page->prev = NULL;
+    page->next = *head;
+    if(*head) (*head)->prev = page;
+    *head = page;
+}
+
+static void page_list_remove(lv_slab_page_t ** head, lv_slab_page_t * page)
+{
+    if(page->prev) page->prev->next = page->next;
+    else *head = page->next;
+
+    if(page->next) page->next->prev = page->prev;
+}
+
+static void page_list_free(lv_slab_t * slab, lv_slab_page_t * head)
+{
+    while(head) {
+        lv_slab_page_t * next = head->next;
+        page_delete(slab, head);
+        head = next;
+    }
+}
+
+static void * large_alloc(lv_slab_t * slab, size_t size)
+{
+    lv_uintptr_t * block = slab->page_alloc_cb(BLOCK_HEADER_SIZE + size);
+    if(block == NULL) return NULL;
+
+    *block = (lv_uintptr_t)size << 1;
+    slab->large_cnt++;
+    slab->large_size += size;
+    slab->large_alloc_cnt++;
+
+    return block + 1;
+}
+
+static void large_free(lv_slab_t * slab, lv_uintptr_t * block)
+{
+    slab->large_cnt--;
+    slab->large_size -= *block >> 1;
+    slab->page_free_cb(block);
+}
+
+static void * large_realloc(lv_slab_t * slab, lv_uintptr_t * block, size_t new_size)
+{
+    size_t old_size = *block >> 1;
+    block = slab->page_realloc_cb(block, BLOCK_HEADER_SIZE + new_size);
+    if(block == NULL) return NULL;
+
+    *block = (lv_uintptr_t)new_size << 1;
+    slab->large_size -= old_size;
+    slab->large_size += new_size;
+
+    return block + 1;
+}
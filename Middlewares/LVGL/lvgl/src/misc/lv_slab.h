@@ -0,0 +1,187 @@
+/**
+ * @file lv_slab.h
+ * Allocate fixed size blocks from pages. The pages are allocated by a user provided function.
+ */
+
+#ifndef LV_SLAB_H
+#define LV_SLAB_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../lv_conf_internal.h"
+#include "lv_types.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+typedef struct lv_slab_page_t lv_slab_page_t;
+
+typedef void * (*lv_slab_page_alloc_cb_t)(size_t size);
+
+typedef void (*lv_slab_page_free_cb_t)(void * p);
+
+typedef void * (*lv_slab_page_realloc_cb_t)(void * p, size_t new_size);
+
+/** Blocks of the same size and the pages holding them*/
+typedef struct {
+    lv_slab_page_t * partial;   /**< Pages with at least one free block*/
+    lv_slab_page_t * full;      /**< Pages without free blocks*/
+    uint32_t size;              /**< Usable size of a block in bytes*/
+    uint32_t block_size;        /**< Size of a block with its header in bytes*/
+    uint32_t block_per_page;
+    uint32_t page_cnt;
+    uint32_t used_cnt;          /**< Number of allocated blocks*/
+    uint32_t alloc_cnt;         /**< Number of allocations since the last stat reset*/
+} lv_slab_class_t;
+
+/** Description of a slab allocator*/
+typedef struct {
+    lv_slab_class_t * classes;  /**< Block size classes in ascending order*/
+    uint32_t class_cnt;
+    lv_slab_page_alloc_cb_t page_alloc_cb;
+    lv_slab_page_free_cb_t page_free_cb;
+    lv_slab_page_realloc_cb_t page_realloc_cb;
+    uint32_t large_cnt;         /**< Number of allocated blocks larger than the largest class*/
+    size_t large_size;          /**< Total size of the allocated large blocks*/
+    uint32_t large_alloc_cnt;   /**< Number of large allocations since the last stat reset*/
+    uint32_t page_size;         /**< Size of the pages in the page pool*/
+    uint8_t * pool;             /**< Memory of the page pool or NULL if it's not used*/
+    uint8_t * pool_end;
+    void * pool_free;           /**< The first free page of the pool, the free pages are linked*/
+} lv_slab_t;
+
+typedef struct {
+    uint32_t size;              /**< Usable size of the blocks of a class, 0 for the whole allocator*/
+    size_t total_size;          /**< Size of the pages and large blocks in bytes*/
+    size_t used_size;           /**< Usable size of the allocated blocks in bytes*/
+    uint32_t page_cnt;
+    uint32_t used_cnt;          /**< Number of allocated blocks*/
+    uint32_t alloc_cnt;         /**< Number of allocations since the last stat reset*/
+    uint32_t large_cnt;         /**< Number of allocated blocks served directly by `page_alloc_cb`*/
+} lv_slab_stat_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Initialize a slab allocator
+ * @param slab              pointer to an `lv_slab_t` variable
+ * @param classes           array of `class_cnt` `lv_slab_class_t` elements. It needs to live as long as `slab`
+ * @param sizes             usable size of the blocks in each class in ascending order
+ * @param class_cnt         number of the size classes
+ * @param page_size         size of a page in bytes. The pages of the large classes hold at least 2 blocks.
+ * @param page_alloc_cb     function to allocate the pages and the blocks larger than the largest class
+ * @param page_free_cb      function to free the memory allocated by `page_alloc_cb`
+ */
+void lv_slab_init(lv_slab_t * slab, lv_slab_class_t * classes, const uint16_t * sizes, uint32_t class_cnt,
+                  uint32_t page_size, lv_slab_page_alloc_cb_t page_alloc_cb, lv_slab_page_free_cb_t page_free_cb);
+
+/**
+ * Set a function to resize the blocks larger than the largest class in place.
+ * Without it they are resized by allocating a new block and copying the data.
+ * @param slab              pointer to a slab allocator
+ * @param page_realloc_cb   function to resize a memory allocated by `page_alloc_cb`
+ */
+void lv_slab_set_realloc_cb(lv_slab_t * slab, lv_slab_page_realloc_cb_t page_realloc_cb);
+
+/**
+ * Take the pages from a dedicated memory region first. The region is split into pages of `page_size`,
+ * so the pages don't split the free memory of the heap between the other allocations.
+ * If the region is full or a page is larger than `page_size`, `page_alloc_cb` is used.
+ * The blocks larger than the largest class are always allocated by `page_alloc_cb`.
+ * @param slab      pointer to a slab allocator without allocated pages
+ * @param mem       pointer aligned memory for the pages. It needs to live as long as `slab`
+ * @param size      size of `mem` in bytes
+ */
+void lv_slab_set_page_pool(lv_slab_t * slab, void * mem, size_t size);
+
+/**
+ * Free all pages of a slab allocator. The blocks larger than the largest class are not freed.
+ * @param slab      pointer to a slab allocator
+ */
+void lv_slab_destroy(lv_slab_t * slab);
+
+/**
+ * Allocate a block from the smallest class which is large enough.
+ * Larger blocks are allocated by `page_alloc_cb` directly.
+ * @param slab      pointer to a slab allocator
+ * @param size      size of the block in bytes
+ * @return          pointer to the block or NULL if there is not enough memory or `size` is 0
+ */
+void * lv_slab_alloc(lv_slab_t * slab, size_t size);
+
+/**
+ * Free a block allocated by `lv_slab_alloc` or `lv_slab_realloc`
+ * @param slab      pointer to the slab allocator of the block
+ * @param p         pointer to the block. NULL is ignored
+ */
+void lv_slab_free(lv_slab_t * slab, void * p);
+
+/**
+ * Resize a block. If the new size belongs to the same class the block is not moved.
+ * @param slab      pointer to the slab allocator of the block
+ * @param p         pointer to the block or NULL to allocate a new block
+ * @param new_size  the new size in bytes. 0 frees the block.
+ * @return          pointer to the resized block or NULL if there is not enough memory
+ *                  (`p` is kept then) or `new_size` is 0
+ */
+void * lv_slab_realloc(lv_slab_t * slab, void * p, size_t new_size);
+
+/**
+ * Get the usable size of a block
+ * @param slab      pointer to the slab allocator of the block
+ * @param p         pointer to the block
+ * @return          the size in bytes which can be used without reallocation
+ */
+size_t lv_slab_get_size(lv_slab_t * slab, const void * p);
+
+/**
+ * Check if a block was allocated from the pages of a class.
+ * It's false for the blocks larger than the largest class and for used TLSF blocks,
+ * so the class blocks can be mixed with blocks allocated by TLSF without a header.
+ * @param p         pointer to an allocated block
+ * @return          true: `p` is a class block
+ */
+bool lv_slab_is_class_block(const void * p);
+
+/**
+ * Get the statistics of a slab allocator
+ * @param slab      pointer to a slab allocator
+ * @param stat      store the result here
+ */
+void lv_slab_get_stat(lv_slab_t * slab, lv_slab_stat_t * stat);
+
+/**
+ * Get the statistics of a single size class
+ * @param slab      pointer to a slab allocator
+ * @param class_idx index of the class
+ * @param stat      store the result here. The large blocks are not included.
+ */
+void lv_slab_get_class_stat(lv_slab_t * slab, uint32_t class_idx, lv_slab_stat_t * stat);
+
+/**
+ * Reset the allocation counters of a slab allocator
+ * @param slab      pointer to a slab allocator
+ */
+void lv_slab_reset_stat(lv_slab_t * slab);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_SLAB_H*/
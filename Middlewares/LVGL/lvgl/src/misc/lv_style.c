@@ -18,7 +18,9 @@
  *********************/
 #define lv_style_custom_prop_flag_lookup_table_size LV_GLOBAL_DEFAULT()->style_custom_table_size
 #define lv_style_custom_prop_flag_lookup_table LV_GLOBAL_DEFAULT()->style_custom_prop_flag_lookup_table
+#define style_value_cache_gen LV_GLOBAL_DEFAULT()->style_value_cache_gen
 #define last_custom_prop_id LV_GLOBAL_DEFAULT()->style_last_custom_prop_id
+#define style_intern_ll_p &(LV_GLOBAL_DEFAULT()->style_intern_ll)
 
 /**********************
  *      TYPEDEFS
@@ -28,6 +30,13 @@
  *  STATIC PROTOTYPES
  **********************/
 
+#if LV_STYLE_PROP_INDEX
+    static uint32_t find_prop_pos(const lv_style_prop_t * props, uint32_t prop_cnt, lv_style_prop_t prop);
+#endif
+static bool style_is_equal(const lv_style_t * style1, const lv_style_t * style2);
+static bool style_value_is_equal(lv_style_prop_t prop, lv_style_value_t v1, lv_style_value_t v2);
+static void style_copy(lv_style_t * dest, const lv_style_t * src);
+
 /**********************
  *  GLOBAL VARIABLES
  **********************/
@@ -193,6 +202,9 @@ void lv_style_reset(lv_style_t * style)
 
     if(style->prop_cnt != 255) lv_free(style->values_and_props);
     lv_memzero(style, sizeof(lv_style_t));
+#if LV_OBJ_STYLE_VALUE_CACHE
+    style_value_cache_gen++;
+#endif
 #if LV_USE_ASSERT_STYLE
     style->sentinel = LV_STYLE_SENTINEL_VALUE;
 #endif
@@ -277,6 +289,15 @@ bool lv_style_remove_prop(lv_style_t * style, lv_style_prop_t prop)
             }
 
             lv_free(old_values);
+#if LV_STYLE_PROP_INDEX
+            /*The order of the remaining properties is kept so they are still sorted*/
+            if(prop < LV_STYLE_NUM_BUILT_IN_PROPS) {
+                style->has_prop[prop >> 5] &= ~((uint32_t)1 << (prop & 0x1F));
+            }
+#endif
+#if LV_OBJ_STYLE_VALUE_CACHE
+            style_value_cache_gen++;
+#endif
             return true;
         }
     }
@@ -295,9 +316,27 @@ void lv_style_set_prop(lv_style_t * style, lv_style_prop_t prop, lv_style_value_
 
     LV_ASSERT(prop != LV_STYLE_PROP_INV);
 
+#if LV_OBJ_STYLE_VALUE_CACHE
+    /*The objects using this style might have cached the old value*/
+    style_value_cache_gen++;
+#endif
+
     lv_style_prop_t * props;
     int32_t i;
 
+#if LV_STYLE_PROP_INDEX
+    /*Index of the property if it's already set or where it should be inserted to keep the order*/
+    uint32_t pos = 0;
+    if(style->values_and_props) {
+        props = (lv_style_prop_t *)style->values_and_props + style->prop_cnt * sizeof(lv_style_value_t);
+        pos = find_prop_pos(props, style->prop_cnt, prop);
+        if(pos < style->prop_cnt && props[pos] == prop) {
+            lv_style_value_t * values = (lv_style_value_t *)style->values_and_props;
+            values[pos] = value;
+            return;
+        }
+    }
+#else
     if(style->values_and_props) {
         props = (lv_style_prop_t *)style->values_and_props + style->prop_cnt * sizeof(lv_style_value_t);
         for(i = style->prop_cnt - 1; i >= 0; i--) {
@@ -308,6 +347,7 @@ void lv_style_set_prop(lv_style_t * style, lv_style_prop_t prop, lv_style_value_
             }
         }
     }
+#endif
 
     size_t size = (style->prop_cnt + 1) * (sizeof(lv_style_value_t) + sizeof(lv_style_prop_t));
     uint8_t * values_and_props = lv_realloc(style->values_and_props, size);
@@ -325,9 +365,24 @@ void lv_style_set_prop(lv_style_t * style, lv_style_prop_t prop, lv_style_value_
     props = values_and_props + style->prop_cnt * sizeof(lv_style_value_t);
     lv_style_value_t * values = (lv_style_value_t *)values_and_props;
 
+#if LV_STYLE_PROP_INDEX
+    /*Make place for the new property at its sorted position*/
+    for(i = style->prop_cnt - 1; i > (int32_t)pos; i--) {
+        props[i] = props[i - 1];
+        values[i] = values[i - 1];
+    }
+
+    props[pos] = prop;
+    values[pos] = value;
+
+    if(prop < LV_STYLE_NUM_BUILT_IN_PROPS) {
+        style->has_prop[prop >> 5] |= (uint32_t)1 << (prop & 0x1F);
+    }
+#else
     /*Set the new property and value*/
     props[style->prop_cnt - 1] = prop;
     values[style->prop_cnt - 1] = value;
+#endif
 
     uint32_t group = lv_style_get_prop_group(prop);
     style->has_group |= (uint32_t)1 << group;
@@ -417,6 +472,52 @@ lv_style_value_t lv_style_prop_get_default(lv_style_prop_t prop)
     }
 }
 
+const lv_style_t * lv_style_intern(const lv_style_t * style)
+{
+    LV_ASSERT_STYLE(style);
+
+    lv_style_t * shared;
+    LV_LL_READ(style_intern_ll_p, shared) {
+        if(style_is_equal(shared, style)) return shared;
+    }
+
+    shared = lv_ll_ins_tail(style_intern_ll_p);
+    LV_ASSERT_MALLOC(shared);
+    if(shared == NULL) return NULL;
+
+#if LV_OBJ_STYLE_VALUE_CACHE
+    /*No object uses the new style yet, so setting its properties can't change any cached value*/
+    uint32_t gen = style_value_cache_gen;
+#endif
+
+    lv_style_init(shared);
+    style_copy(shared, style);
+
+    /*Not all properties could be copied*/
+    if(!style_is_equal(shared, style)) {
+        lv_style_reset(shared);
+        lv_ll_remove(style_intern_ll_p, shared);
+        lv_free(shared);
+        shared = NULL;
+    }
+
+#if LV_OBJ_STYLE_VALUE_CACHE
+    style_value_cache_gen = gen;
+#endif
+
+    return shared;
+}
+
+void lv_style_intern_deinit(void)
+{
+    lv_style_t * shared;
+    LV_LL_READ(style_intern_ll_p, shared) {
+        lv_style_reset(shared);
+    }
+
+    lv_ll_clear(style_intern_ll_p);
+}
+
 bool lv_style_is_empty(const lv_style_t * style)
 {
     LV_ASSERT_STYLE(style);
@@ -440,3 +541,134 @@ uint8_t lv_style_prop_lookup_flags(lv_style_prop_t prop)
 /**********************
  *   STATIC FUNCTIONS
  **********************/
+
+#if LV_STYLE_PROP_INDEX
+/**
+ * Find a property in the sorted property list of a style
+ * @param props     the sorted properties
+ * @param prop_cnt  number of properties
+ * @param prop      the property to find
+ * @return          index of `prop` if it's set, else the index where it should be inserted
+ */
+static uint32_t find_prop_pos(const lv_style_prop_t * props, uint32_t prop_cnt, lv_style_prop_t prop)
+{
+    uint32_t min = 0;
+    uint32_t max = prop_cnt;
+    while(min < max) {
+        uint32_t mid = (min + max) >> 1;
+        if(props[mid] < prop) min = mid + 1;
+        else max = mid;
+    }
+
+    return min;
+}
+#endif
+
+/**
+ * Check if two styles have the same properties with the same values
+ * @param style1    pointer to a style
+ * @param style2    pointer to an other style
+ * @return          true: the styles are identical
+ */
+static bool style_is_equal(const lv_style_t * style1, const lv_style_t * style2)
+{
+    lv_style_value_t v1;
+    lv_style_value_t v2;
+    uint32_t cnt1 = 0;
+    uint32_t cnt2 = 0;
+    uint32_t i;
+
+    if(lv_style_is_const(style1)) {
+        const lv_style_const_prop_t * props = style1->values_and_props;
+        for(i = 0; props[i].prop != LV_STYLE_PROP_INV; i++) cnt1++;
+    }
+    else cnt1 = style1->prop_cnt;
+
+    /*Look up the properties of `style2` in `style1`. If all are found and the counts match the styles are equal.*/
+    if(lv_style_is_const(style2)) {
+        const lv_style_const_prop_t * props = style2->values_and_props;
+        for(i = 0; props[i].prop != LV_STYLE_PROP_INV; i++) {
+            if(lv_style_get_prop(style1, props[i].prop, &v1) != LV_STYLE_RES_FOUND) return false;
+            v2 = props[i].value;
+            if(!style_value_is_equal(props[i].prop, v1, v2)) return false;
+            cnt2++;
+        }
+    }
+    else {
+        const lv_style_prop_t * props = (lv_style_prop_t *)style2->values_and_props + style2->prop_cnt * sizeof(
+                                            lv_style_value_t);
+        const lv_style_value_t * values = style2->values_and_props;
+        for(i = 0; i < style2->prop_cnt; i++) {
+            if(lv_style_get_prop(style1, props[i], &v1) != LV_STYLE_RES_FOUND) return false;
+            v2 = values[i];
+            if(!style_value_is_equal(props[i], v1, v2)) return false;
+            cnt2++;
+        }
+    }
+
+    return cnt1 == cnt2;
+}
+
+/**
+ * Compare two values of a property by the type of the property.
+ * Only the member of the union which was set is compared as the rest of the bytes can be anything.
+ * @param prop      the property of the values
+ * @param v1        a value
+ * @param v2        an other value
+ * @return          true: the values are equal
+ */
+static bool style_value_is_equal(lv_style_prop_t prop, lv_style_value_t v1, lv_style_value_t v2)
+{
+    switch(prop) {
+        case LV_STYLE_BG_COLOR:
+        case LV_STYLE_BG_GRAD_COLOR:
+        case LV_STYLE_BG_IMAGE_RECOLOR:
+        case LV_STYLE_BORDER_COLOR:
+        case LV_STYLE_OUTLINE_COLOR:
+        case LV_STYLE_SHADOW_COLOR:
+        case LV_STYLE_IMAGE_RECOLOR:
+        case LV_STYLE_LINE_COLOR:
+        case LV_STYLE_ARC_COLOR:
+        case LV_STYLE_TEXT_COLOR:
+            return lv_color_eq(v1.color, v2.color);
+        case LV_STYLE_BG_GRAD:
+        case LV_STYLE_BG_IMAGE_SRC:
+        case LV_STYLE_ARC_IMAGE_SRC:
+        case LV_STYLE_TEXT_FONT:
+        case LV_STYLE_COLOR_FILTER_DSC:
+        case LV_STYLE_ANIM:
+        case LV_STYLE_TRANSITION:
+        case LV_STYLE_BITMAP_MASK_SRC:
+        case LV_STYLE_GRID_ROW_DSC_ARRAY:
+        case LV_STYLE_GRID_COLUMN_DSC_ARRAY:
+            return v1.ptr == v2.ptr;
+        default:
+            /*The type of the custom properties is unknown, so all bytes need to match.
+             *At worst an equal style is not shared.*/
+            if(prop >= LV_STYLE_NUM_BUILT_IN_PROPS) return lv_memcmp(&v1, &v2, sizeof(lv_style_value_t)) == 0;
+            return v1.num == v2.num;
+    }
+}
+
+/**
+ * Set all properties of a style in an other style
+ * @param dest      pointer to an initialized, non-constant style
+ * @param src       the style to copy
+ */
+static void style_copy(lv_style_t * dest, const lv_style_t * src)
+{
+    uint32_t i;
+    if(lv_style_is_const(src)) {
+        const lv_style_const_prop_t * props = src->values_and_props;
+        for(i = 0; props[i].prop != LV_STYLE_PROP_INV; i++) {
+            lv_style_set_prop(dest, props[i].prop, props[i].value);
+        }
+    }
+    else {
+        const lv_style_prop_t * props = (lv_style_prop_t *)src->values_and_props + src->prop_cnt * sizeof(lv_style_value_t);
+        const lv_style_value_t * values = src->values_and_props;
+        for(i = 0; i < src->prop_cnt; i++) {
+            lv_style_set_prop(dest, props[i], values[i]);
+        }
+    }
+}
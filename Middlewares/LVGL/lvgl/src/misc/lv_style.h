@@ -361,6 +361,11 @@ typedef struct {
     lv_style_value_t value;
 } lv_style_const_prop_t;
 
+#if LV_STYLE_PROP_INDEX
+/** Number of 32 bit words to store a bit for each built-in property*/
+#define LV_STYLE_PROP_BITMAP_WORDS  ((LV_STYLE_NUM_BUILT_IN_PROPS + 31) / 32)
+#endif
+
 /**
  * Descriptor of a style (a collection of properties and values).
  */
@@ -373,6 +378,10 @@ typedef struct {
     void * values_and_props;
 
     uint32_t has_group;
+#if LV_STYLE_PROP_INDEX
+    uint32_t has_prop[LV_STYLE_PROP_BITMAP_WORDS];  /**< Bit `n` is set if the built-in property `n` is set.
+                                                     *   Not used in constant styles.*/
+#endif
     uint8_t prop_cnt;   /**< 255 means it's a constant style*/
 } lv_style_t;
 
@@ -509,6 +518,28 @@ static inline lv_style_res_t lv_style_get_prop_inlined(const lv_style_t * style,
     }
     else {
         lv_style_prop_t * props = (lv_style_prop_t *)style->values_and_props + style->prop_cnt * sizeof(lv_style_value_t);
+#if LV_STYLE_PROP_INDEX
+        /*Most of the properties are not set, tell it with a single bit test*/
+        if(prop < LV_STYLE_NUM_BUILT_IN_PROPS &&
+           (style->has_prop[prop >> 5] & ((uint32_t)1 << (prop & 0x1F))) == 0) {
+            return LV_STYLE_RES_NOT_FOUND;
+        }
+
+        /*The properties are sorted so use binary search*/
+        uint32_t min = 0;
+        uint32_t max = style->prop_cnt;
+        while(min < max) {
+            uint32_t mid = (min + max) >> 1;
+            if(props[mid] < prop) min = mid + 1;
+            else max = mid;
+        }
+
+        if(min < style->prop_cnt && props[min] == prop) {
+            lv_style_value_t * values = (lv_style_value_t *)style->values_and_props;
+            *value = values[min];
+            return LV_STYLE_RES_FOUND;
+        }
+#else
         uint32_t i;
         for(i = 0; i < style->prop_cnt; i++) {
             if(props[i] == prop) {
@@ -517,10 +548,24 @@ static inline lv_style_res_t lv_style_get_prop_inlined(const lv_style_t * style,
                 return LV_STYLE_RES_FOUND;
             }
         }
+#endif
     }
     return LV_STYLE_RES_NOT_FOUND;
 }
 
+/**
+ * Get a shared style with the same properties and values as `style`.
+ * Styles with identical properties are stored only once, so objects which would need
+ * separate but identical styles can all use the same one.
+ * It saves only memory: getting the properties is not faster and each call searches the shared styles linearly.
+ * `style` is only compared and copied, so it can be a temporary style which is reset after the call.
+ * A constant temporary (`LV_STYLE_CONST_INIT`) is cheaper as resetting a style drops the cached style values.
+ * The shared styles are kept until `lv_deinit()`.
+ * @param style     a style with the required properties, can be a constant style too
+ * @return          the shared style or NULL if there is not enough memory. It must not be modified or reset.
+ */
+const lv_style_t * lv_style_intern(const lv_style_t * style);
+
 /**
  * Checks if a style is empty (has no properties)
  * @param style pointer to a style
@@ -28,6 +28,12 @@ extern "C" {
  * GLOBAL PROTOTYPES
  **********************/
 
+/**
+ * Free the shared styles created by `lv_style_intern()`.
+ * Called by LVGL in `lv_deinit()`
+ */
+void lv_style_intern_deinit(void);
+
 /**********************
  *      MACROS
  **********************/
@@ -151,6 +151,8 @@ typedef struct lv_grad_t lv_grad_t;
 
 typedef struct lv_draw_label_hint_t lv_draw_label_hint_t;
 
+typedef struct lv_draw_label_layout_t lv_draw_label_layout_t;
+
 typedef struct lv_draw_glyph_dsc_t lv_draw_glyph_dsc_t;
 
 typedef struct lv_draw_image_sup_t lv_draw_image_sup_t;
@@ -161,6 +163,8 @@ typedef struct lv_obj_style_t lv_obj_style_t;
 
 typedef struct lv_obj_style_transition_dsc_t lv_obj_style_transition_dsc_t;
 
+typedef struct lv_obj_style_value_cache_t lv_obj_style_value_cache_t;
+
 typedef struct lv_hit_test_info_t lv_hit_test_info_t;
 
 typedef struct lv_cover_check_info_t lv_cover_check_info_t;
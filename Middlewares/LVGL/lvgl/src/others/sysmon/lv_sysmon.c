@@ -322,12 +322,26 @@ static void mem_observer_cb(lv_observer_t * observer, lv_subject_t * subject)
     size_t used_kb_tenth = (used_size - (used_kb * 1024)) / 102;
     size_t max_used_kb = mon->max_used / 1024;
     size_t max_used_kb_tenth = (mon->max_used - (max_used_kb * 1024)) / 102;
+#if LV_DRAW_BUF_POOL_SIZE
+    /*The draw buffers can be in a different memory pool, so show them separately*/
+    lv_draw_buf_pool_stat_t pool_stat;
+    lv_draw_buf_pool_get_stat(&pool_stat);
+    uint32_t alloc_cnt = pool_stat.hit_cnt + pool_stat.miss_cnt;
+    uint32_t reuse_pct = alloc_cnt ? (uint64_t)pool_stat.hit_cnt * 100 / alloc_cnt : 0;
+#endif
     lv_label_set_text_fmt(label,
                           "%zu.%zu kB (%d%%)\n"
-                          "%zu.%zu kB max, %d%% frag.",
-                          used_kb, used_kb_tenth, mon->used_pct,
+                          "%zu.%zu kB max, %d%% frag."
+#if LV_DRAW_BUF_POOL_SIZE
+                          "\n%zu kB draw buf, %zu kB idle, %" LV_PRIu32 "%% reused"
+#endif
+                          , used_kb, used_kb_tenth, mon->used_pct,
                           max_used_kb, max_used_kb_tenth,
-                          mon->frag_pct);
+                          mon->frag_pct
+#if LV_DRAW_BUF_POOL_SIZE
+                          , pool_stat.used_size / 1024, pool_stat.idle_size / 1024, reuse_pct
+#endif
+                         );
 }
 
 #endif
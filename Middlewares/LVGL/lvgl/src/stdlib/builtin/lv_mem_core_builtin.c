@@ -37,6 +37,12 @@
     #define ALIGN_MASK       0x3
 #endif
 #define state LV_GLOBAL_DEFAULT()->tlsf_state
+#define fast_heap (&state.heaps[LV_MEM_PLACEMENT_FAST])
+
+#define OTHER_PLACEMENT(p)  ((p) == LV_MEM_PLACEMENT_FAST ? LV_MEM_PLACEMENT_BULK : LV_MEM_PLACEMENT_FAST)
+
+/*The largest size served by the small block classes*/
+#define SMALL_BLOCK_MAX_SIZE    (small_block_sizes[LV_MEM_SMALL_BLOCK_CLASS_CNT - 1])
 
 /**********************
  *      TYPEDEFS
@@ -46,10 +52,29 @@
  *  STATIC PROTOTYPES
  **********************/
 static void lv_mem_walker(void * ptr, size_t size, int used, void * user);
+static void heap_create(lv_tlsf_heap_t * heap, void * mem, size_t bytes);
+static lv_mem_pool_t heap_add_pool(lv_tlsf_heap_t * heap, void * mem, size_t bytes);
+static void * heap_alloc(lv_mem_placement_t placement, size_t size);
+static void * heap_realloc(lv_mem_placement_t placement, void * p, size_t new_size);
+static void heap_free(lv_mem_placement_t placement, void * p);
+static inline size_t heap_block_size(lv_mem_placement_t placement, const void * p);
+static inline lv_mem_placement_t get_placement(const void * p);
+static void * malloc_placed(size_t size, lv_mem_placement_t placement);
+static void monitor_placed(lv_mem_monitor_t * mon_p, lv_mem_placement_t placement);
+static void * tlsf_alloc(lv_tlsf_heap_t * heap, size_t size);
+static void * tlsf_realloc(lv_tlsf_heap_t * heap, void * p, size_t new_size);
+static void tlsf_free(lv_tlsf_heap_t * heap, void * p);
+#if LV_MEM_SMALL_BLOCK_PAGE_SIZE
+static void * small_block_page_alloc(size_t size);
+static void small_block_page_free(void * p);
+#endif
 
 /**********************
  *  STATIC VARIABLES
  **********************/
+#if LV_MEM_SMALL_BLOCK_PAGE_SIZE
+static const uint16_t small_block_sizes[LV_MEM_SMALL_BLOCK_CLASS_CNT] = {8, 16, 24, 32, 48, 64};
+#endif
 
 /**********************
  *      MACROS
@@ -76,22 +101,42 @@ void lv_mem_init(void)
 
 #if LV_MEM_ADR == 0
 #ifdef LV_MEM_POOL_ALLOC
-    state.tlsf = lv_tlsf_create_with_pool((void *)LV_MEM_POOL_ALLOC(LV_MEM_SIZE), LV_MEM_SIZE);
+    heap_create(fast_heap, (void *)LV_MEM_POOL_ALLOC(LV_MEM_SIZE), LV_MEM_SIZE);
 #else
     /*Allocate a large array to store the dynamically allocated data*/
     static LV_ATTRIBUTE_LARGE_RAM_ARRAY MEM_UNIT work_mem_int[LV_MEM_SIZE / sizeof(MEM_UNIT)];
-    state.tlsf = lv_tlsf_create_with_pool((void *)work_mem_int, LV_MEM_SIZE);
+    heap_create(fast_heap, (void *)work_mem_int, LV_MEM_SIZE);
 #endif
 #else
-    state.tlsf = lv_tlsf_create_with_pool((void *)LV_MEM_ADR, LV_MEM_SIZE);
+    heap_create(fast_heap, (void *)LV_MEM_ADR, LV_MEM_SIZE);
 #endif
 
-    lv_ll_init(&state.pool_ll, sizeof(lv_pool_t));
+#if LV_MEM_SMALL_BLOCK_PAGE_SIZE
+    /*Carve the small blocks from pages allocated by TLSF.
+     *Larger blocks are allocated by TLSF directly, without an extra header.*/
+    lv_slab_init(&state.small_blocks, state.small_block_classes, small_block_sizes, LV_MEM_SMALL_BLOCK_CLASS_CNT,
+                 LV_MEM_SMALL_BLOCK_PAGE_SIZE, small_block_page_alloc, small_block_page_free);
+#endif
 
-    /*Record the first pool*/
-    lv_pool_t * pool_p = lv_ll_ins_tail(&state.pool_ll);
-    LV_ASSERT_MALLOC(pool_p);
-    *pool_p = lv_tlsf_get_pool(state.tlsf);
+#if LV_MEM_BULK_SIZE
+#if LV_MEM_BULK_ADR == 0
+    static LV_ATTRIBUTE_LARGE_RAM_ARRAY MEM_UNIT bulk_mem_int[LV_MEM_BULK_SIZE / sizeof(MEM_UNIT)];
+    heap_create(&state.heaps[LV_MEM_PLACEMENT_BULK], (void *)bulk_mem_int, LV_MEM_BULK_SIZE);
+#else
+    heap_create(&state.heaps[LV_MEM_PLACEMENT_BULK], (void *)LV_MEM_BULK_ADR, LV_MEM_BULK_SIZE);
+#endif
+#endif
+
+    /*Record the first pools. The lists are allocated in the fast heap so it has to be ready.*/
+    uint32_t i;
+    for(i = 0; i < LV_TLSF_HEAP_CNT; i++) {
+        lv_tlsf_heap_t * heap = &state.heaps[i];
+        lv_ll_init(&heap->pool_ll, sizeof(lv_pool_t));
+
+        lv_pool_t * pool_p = lv_ll_ins_tail(&heap->pool_ll);
+        LV_ASSERT_MALLOC(pool_p);
+        *pool_p = lv_tlsf_get_pool(heap->tlsf);
+    }
 
 #if LV_MEM_ADD_JUNK
     LV_LOG_WARN("LV_MEM_ADD_JUNK is enabled which makes LVGL much slower");
@@ -100,8 +145,15 @@ void lv_mem_init(void)
 
 void lv_mem_deinit(void)
 {
-    lv_ll_clear(&state.pool_ll);
-    lv_tlsf_destroy(state.tlsf);
+    uint32_t i;
+    for(i = 0; i < LV_TLSF_HEAP_CNT; i++) {
+        lv_ll_clear(&state.heaps[i].pool_ll);
+    }
+
+    /*Destroy the fast heap last as it was created first*/
+    for(i = LV_TLSF_HEAP_CNT; i > 0; i--) {
+        lv_tlsf_destroy(state.heaps[i - 1].tlsf);
+    }
 #if LV_USE_OS
     lv_mutex_delete(&state.mutex);
 #endif
@@ -109,28 +161,22 @@ void lv_mem_deinit(void)
 
 lv_mem_pool_t lv_mem_add_pool(void * mem, size_t bytes)
 {
-    lv_mem_pool_t new_pool = lv_tlsf_add_pool(state.tlsf, mem, bytes);
-    if(!new_pool) {
-        LV_LOG_WARN("failed to add memory pool, address: %p, size: %zu", mem, bytes);
-        return NULL;
-    }
-
-    lv_pool_t * pool_p = lv_ll_ins_tail(&state.pool_ll);
-    LV_ASSERT_MALLOC(pool_p);
-    *pool_p = new_pool;
-
-    return new_pool;
+    return heap_add_pool(fast_heap, mem, bytes);
 }
 
 void lv_mem_remove_pool(lv_mem_pool_t pool)
 {
-    lv_pool_t * pool_p;
-    LV_LL_READ(&state.pool_ll, pool_p) {
-        if(*pool_p == pool) {
-            lv_ll_remove(&state.pool_ll, pool_p);
-            lv_free(pool_p);
-            lv_tlsf_remove_pool(state.tlsf, pool);
-            return;
+    uint32_t i;
+    for(i = 0; i < LV_TLSF_HEAP_CNT; i++) {
+        lv_tlsf_heap_t * heap = &state.heaps[i];
+        lv_pool_t * pool_p;
+        LV_LL_READ(&heap->pool_ll, pool_p) {
+            if(*pool_p == pool) {
+                lv_ll_remove(&heap->pool_ll, pool_p);
+                lv_free(pool_p);
+                lv_tlsf_remove_pool(heap->tlsf, pool);
+                return;
+            }
         }
     }
     LV_LOG_WARN("invalid pool: %p", pool);
@@ -138,20 +184,7 @@ void lv_mem_remove_pool(lv_mem_pool_t pool)
 
 void * lv_malloc_core(size_t size)
 {
-#if LV_USE_OS
-    lv_mutex_lock(&state.mutex);
-#endif
-    void * p = lv_tlsf_malloc(state.tlsf, size);
-
-    if(p) {
-        state.cur_used += lv_tlsf_block_size(p);
-        state.max_used = LV_MAX(state.cur_used, state.max_used);
-    }
-
-#if LV_USE_OS
-    lv_mutex_unlock(&state.mutex);
-#endif
-    return p;
+    return malloc_placed(size, LV_MEM_PLACEMENT_FAST);
 }
 
 void * lv_realloc_core(void * p, size_t new_size)
@@ -160,14 +193,23 @@ void * lv_realloc_core(void * p, size_t new_size)
     lv_mutex_lock(&state.mutex);
 #endif
 
-    size_t old_size = lv_tlsf_block_size(p);
-    void * p_new = lv_tlsf_realloc(state.tlsf, p, new_size);
-
-    if(p_new) {
-        state.cur_used -= old_size;
-        state.cur_used += lv_tlsf_block_size(p_new);
-        state.max_used = LV_MAX(state.cur_used, state.max_used);
+    lv_mem_placement_t placement = get_placement(p);
+    void * p_new = heap_realloc(placement, p, new_size);
+
+#if LV_MEM_BULK_SIZE
+    if(p_new == NULL) {
+        /*Move the data to the other heap. It's slower (or smaller) but better than failing.*/
+        p_new = heap_alloc(OTHER_PLACEMENT(placement), new_size);
+        if(p_new) {
+            state.heaps[placement].fallback_cnt++;
+            if(p) {
+                lv_memcpy(p_new, p, LV_MIN(heap_block_size(placement, p), new_size));
+                heap_free(placement, p);
+            }
+        }
     }
+#endif
+
 #if LV_USE_OS
     lv_mutex_unlock(&state.mutex);
 #endif
@@ -181,13 +223,7 @@ void lv_free_core(void * p)
     lv_mutex_lock(&state.mutex);
 #endif
 
-#if LV_MEM_ADD_JUNK
-    lv_memset(p, 0xbb, lv_tlsf_block_size(data));
-#endif
-    size_t size = lv_tlsf_block_size(p);
-    lv_tlsf_free(state.tlsf, p);
-    if(state.cur_used > size) state.cur_used -= size;
-    else state.cur_used = 0;
+    heap_free(get_placement(p), p);
 
 #if LV_USE_OS
     lv_mutex_unlock(&state.mutex);
@@ -196,50 +232,56 @@ void lv_free_core(void * p)
 
 void lv_mem_monitor_core(lv_mem_monitor_t * mon_p)
 {
-    /*Init the data*/
-    lv_memzero(mon_p, sizeof(lv_mem_monitor_t));
-    LV_TRACE_MEM("begin");
+    monitor_placed(mon_p, LV_MEM_PLACEMENT_FAST);
+}
 
-    lv_pool_t * pool_p;
-    LV_LL_READ(&state.pool_ll, pool_p) {
-        lv_tlsf_walk_pool(*pool_p, lv_mem_walker, mon_p);
-    }
+#if LV_MEM_BULK_SIZE
+void * lv_malloc_placed_core(size_t size, lv_mem_placement_t placement)
+{
+    return malloc_placed(size, placement);
+}
 
-    mon_p->used_pct = 100 - (uint64_t)100U * mon_p->free_size / mon_p->total_size;
-    if(mon_p->free_size > 0) {
-        mon_p->frag_pct = (uint64_t)mon_p->free_biggest_size * 100U / mon_p->free_size;
-        mon_p->frag_pct = 100 - mon_p->frag_pct;
-    }
-    else {
-        mon_p->frag_pct = 0; /*no fragmentation if all the RAM is used*/
-    }
+lv_mem_pool_t lv_mem_add_pool_placed_core(void * mem, size_t bytes, lv_mem_placement_t placement)
+{
+    return heap_add_pool(&state.heaps[placement], mem, bytes);
+}
 
-    mon_p->max_used = state.max_used;
+void lv_mem_monitor_placed_core(lv_mem_monitor_t * mon_p, lv_mem_placement_t placement)
+{
+    monitor_placed(mon_p, placement);
+}
 
-    LV_TRACE_MEM("finished");
+lv_mem_placement_t lv_mem_get_placement_core(const void * p)
+{
+    return get_placement(p);
 }
+#endif
 
 lv_result_t lv_mem_test_core(void)
 {
 #if LV_USE_OS
     lv_mutex_lock(&state.mutex);
 #endif
-    if(lv_tlsf_check(state.tlsf)) {
-        LV_LOG_WARN("failed");
+    uint32_t i;
+    for(i = 0; i < LV_TLSF_HEAP_CNT; i++) {
+        lv_tlsf_heap_t * heap = &state.heaps[i];
+        if(lv_tlsf_check(heap->tlsf)) {
+            LV_LOG_WARN("failed");
 #if LV_USE_OS
-        lv_mutex_unlock(&state.mutex);
+            lv_mutex_unlock(&state.mutex);
 #endif
-        return LV_RESULT_INVALID;
-    }
+            return LV_RESULT_INVALID;
+        }
 
-    lv_pool_t * pool_p;
-    LV_LL_READ(&state.pool_ll, pool_p) {
-        if(lv_tlsf_check_pool(*pool_p)) {
-            LV_LOG_WARN("pool failed");
+        lv_pool_t * pool_p;
+        LV_LL_READ(&heap->pool_ll, pool_p) {
+            if(lv_tlsf_check_pool(*pool_p)) {
+                LV_LOG_WARN("pool failed");
 #if LV_USE_OS
-            lv_mutex_unlock(&state.mutex);
+                lv_mutex_unlock(&state.mutex);
 #endif
-            return LV_RESULT_INVALID;
+                return LV_RESULT_INVALID;
+            }
         }
     }
 
@@ -270,4 +312,222 @@ static void lv_mem_walker(void * ptr, size_t size, int used, void * user)
             mon_p->free_biggest_size = size;
     }
 }
+
+static void heap_create(lv_tlsf_heap_t * heap, void * mem, size_t bytes)
+{
+    heap->tlsf = lv_tlsf_create_with_pool(mem, bytes);
+#if LV_MEM_BULK_SIZE
+    heap->start = (lv_uintptr_t)mem;
+    heap->end = (lv_uintptr_t)mem + bytes;
+#endif
+}
+
+static lv_mem_pool_t heap_add_pool(lv_tlsf_heap_t * heap, void * mem, size_t bytes)
+{
+#if LV_MEM_BULK_SIZE
+    /*The heap of a memory is found by its address, so the pools of the heaps can't be interleaved*/
+    lv_uintptr_t start = LV_MIN(heap->start, (lv_uintptr_t)mem);
+    lv_uintptr_t end = LV_MAX(heap->end, (lv_uintptr_t)mem + bytes);
+    uint32_t i;
+    for(i = 0; i < LV_TLSF_HEAP_CNT; i++) {
+        lv_tlsf_heap_t * other = &state.heaps[i];
+        if(other != heap && start < other->end && end > other->start) {
+            LV_LOG_WARN("memory pool at %p is interleaved with the pools of an other placement", mem);
+            return NULL;
+        }
+    }
+#endif
+
+    lv_mem_pool_t new_pool = lv_tlsf_add_pool(heap->tlsf, mem, bytes);
+    if(!new_pool) {
+        LV_LOG_WARN("failed to add memory pool, address: %p, size: %zu", mem, bytes);
+        return NULL;
+    }
+
+    lv_pool_t * pool_p = lv_ll_ins_tail(&heap->pool_ll);
+    LV_ASSERT_MALLOC(pool_p);
+    *pool_p = new_pool;
+
+#if LV_MEM_BULK_SIZE
+    heap->start = start;
+    heap->end = end;
+#endif
+
+    return new_pool;
+}
+
+static void * heap_alloc(lv_mem_placement_t placement, size_t size)
+{
+#if LV_MEM_SMALL_BLOCK_PAGE_SIZE
+    /*Only the fast heap has small blocks*/
+    if(placement == LV_MEM_PLACEMENT_FAST && size <= SMALL_BLOCK_MAX_SIZE) {
+        return lv_slab_alloc(&state.small_blocks, size);
+    }
+#endif
+    return tlsf_alloc(&state.heaps[placement], size);
+}
+
+static void * heap_realloc(lv_mem_placement_t placement, void * p, size_t new_size)
+{
+#if LV_MEM_SMALL_BLOCK_PAGE_SIZE
+    if(p == NULL) return heap_alloc(placement, new_size);
+
+    if(placement == LV_MEM_PLACEMENT_FAST && lv_slab_is_class_block(p)) {
+        if(new_size <= SMALL_BLOCK_MAX_SIZE) return lv_slab_realloc(&state.small_blocks, p, new_size);
+
+        /*Grown out of the small blocks*/
+        void * p_new = tlsf_alloc(fast_heap, new_size);
+        if(p_new == NULL) return NULL;
+        lv_memcpy(p_new, p, lv_slab_get_size(&state.small_blocks, p));
+        heap_free(placement, p);
+        return p_new;
+    }
+#endif
+    /*Blocks shrunk to a small size stay in TLSF*/
+    return tlsf_realloc(&state.heaps[placement], p, new_size);
+}
+
+/*Every freed block passes here, also the ones moved by realloc, so all of them get the junk*/
+static void heap_free(lv_mem_placement_t placement, void * p)
+{
+#if LV_MEM_ADD_JUNK
+    lv_memset(p, 0xbb, heap_block_size(placement, p));
+#endif
+#if LV_MEM_SMALL_BLOCK_PAGE_SIZE
+    if(placement == LV_MEM_PLACEMENT_FAST && lv_slab_is_class_block(p)) {
+        lv_slab_free(&state.small_blocks, p);
+        return;
+    }
+#endif
+    tlsf_free(&state.heaps[placement], p);
+}
+
+static inline size_t heap_block_size(lv_mem_placement_t placement, const void * p)
+{
+#if LV_MEM_SMALL_BLOCK_PAGE_SIZE
+    if(placement == LV_MEM_PLACEMENT_FAST && lv_slab_is_class_block(p)) return lv_slab_get_size(&state.small_blocks, p);
+#else
+    LV_UNUSED(placement);
+#endif
+    return lv_tlsf_block_size((void *)p);
+}
+
+/*Find the heap of an allocated memory. Everything outside of the bulk pools is in the fast heap.*/
+static inline lv_mem_placement_t get_placement(const void * p)
+{
+#if LV_MEM_BULK_SIZE
+    lv_tlsf_heap_t * bulk_heap = &state.heaps[LV_MEM_PLACEMENT_BULK];
+    if((lv_uintptr_t)p >= bulk_heap->start && (lv_uintptr_t)p < bulk_heap->end) return LV_MEM_PLACEMENT_BULK;
+#else
+    LV_UNUSED(p);
+#endif
+    return LV_MEM_PLACEMENT_FAST;
+}
+
+static void * malloc_placed(size_t size, lv_mem_placement_t placement)
+{
+#if LV_USE_OS
+    lv_mutex_lock(&state.mutex);
+#endif
+
+    void * p = heap_alloc(placement, size);
+
+#if LV_MEM_BULK_SIZE
+    if(p == NULL) {
+        /*The other heap is slower (or smaller) but it's better than failing*/
+        p = heap_alloc(OTHER_PLACEMENT(placement), size);
+        if(p) state.heaps[placement].fallback_cnt++;
+    }
+#endif
+
+#if LV_USE_OS
+    lv_mutex_unlock(&state.mutex);
+#endif
+    return p;
+}
+
+static void monitor_placed(lv_mem_monitor_t * mon_p, lv_mem_placement_t placement)
+{
+    /*Init the data*/
+    lv_memzero(mon_p, sizeof(lv_mem_monitor_t));
+    LV_TRACE_MEM("begin");
+
+    lv_tlsf_heap_t * heap = &state.heaps[placement];
+    lv_pool_t * pool_p;
+    LV_LL_READ(&heap->pool_ll, pool_p) {
+        lv_tlsf_walk_pool(*pool_p, lv_mem_walker, mon_p);
+    }
+
+    mon_p->used_pct = 100 - (uint64_t)100U * mon_p->free_size / mon_p->total_size;
+    if(mon_p->free_size > 0) {
+        mon_p->frag_pct = (uint64_t)mon_p->free_biggest_size * 100U / mon_p->free_size;
+        mon_p->frag_pct = 100 - mon_p->frag_pct;
+    }
+    else {
+        mon_p->frag_pct = 0; /*no fragmentation if all the RAM is used*/
+    }
+
+    mon_p->max_used = heap->max_used;
+
+#if LV_MEM_SMALL_BLOCK_PAGE_SIZE
+    if(placement == LV_MEM_PLACEMENT_FAST) {
+        uint32_t i;
+        for(i = 0; i < LV_MEM_SMALL_BLOCK_CLASS_CNT; i++) {
+            lv_slab_get_class_stat(&state.small_blocks, i, &mon_p->small_blocks[i]);
+        }
+    }
+#endif
+
+#if LV_MEM_BULK_SIZE
+    mon_p->fallback_cnt = heap->fallback_cnt;
+#endif
+
+    LV_TRACE_MEM("finished");
+}
+
+static void * tlsf_alloc(lv_tlsf_heap_t * heap, size_t size)
+{
+    void * p = lv_tlsf_malloc(heap->tlsf, size);
+
+    if(p) {
+        heap->cur_used += lv_tlsf_block_size(p);
+        heap->max_used = LV_MAX(heap->cur_used, heap->max_used);
+    }
+
+    return p;
+}
+
+static void * tlsf_realloc(lv_tlsf_heap_t * heap, void * p, size_t new_size)
+{
+    size_t old_size = lv_tlsf_block_size(p);
+    void * p_new = lv_tlsf_realloc(heap->tlsf, p, new_size);
+
+    if(p_new) {
+        heap->cur_used -= old_size;
+        heap->cur_used += lv_tlsf_block_size(p_new);
+        heap->max_used = LV_MAX(heap->cur_used, heap->max_used);
+    }
+
+    return p_new;
+}
+
+static void tlsf_free(lv_tlsf_heap_t * heap, void * p)
+{
+    size_t size = lv_tlsf_block_size(p);
+    lv_tlsf_free(heap->tlsf, p);
+    if(heap->cur_used > size) heap->cur_used -= size;
+    else heap->cur_used = 0;
+}
+
+#if LV_MEM_SMALL_BLOCK_PAGE_SIZE
+static void * small_block_page_alloc(size_t size)
+{
+    return tlsf_alloc(fast_heap, size);
+}
+
+static void small_block_page_free(void * p)
+{
+    tlsf_free(fast_heap, p);
+}
+#endif
 #endif /*LV_STDLIB_BUILTIN*/
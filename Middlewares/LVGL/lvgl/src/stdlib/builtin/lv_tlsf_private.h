@@ -17,23 +17,46 @@ extern "C" {
  *********************/
 
 #include "lv_tlsf.h"
+#include "../lv_mem.h"
+#include "../../misc/lv_slab.h"
 
 /*********************
  *      DEFINES
  *********************/
 
+/*One heap for each `lv_mem_placement_t` if there is a bulk memory pool*/
+#if LV_MEM_BULK_SIZE
+    #define LV_TLSF_HEAP_CNT    LV_MEM_PLACEMENT_CNT
+#else
+    #define LV_TLSF_HEAP_CNT    1
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
 
+/** A TLSF instance with its memory pools*/
 typedef struct {
-#if LV_USE_OS
-    lv_mutex_t mutex;
-#endif
     lv_tlsf_t tlsf;
     size_t cur_used;
     size_t max_used;
     lv_ll_t  pool_ll;
+#if LV_MEM_BULK_SIZE
+    lv_uintptr_t start;     /**< Lowest address of the pools*/
+    lv_uintptr_t end;       /**< Address after the end of the highest pool*/
+    size_t fallback_cnt;    /**< Number of allocations placed in the other heap because this one was full*/
+#endif
+} lv_tlsf_heap_t;
+
+typedef struct {
+#if LV_USE_OS
+    lv_mutex_t mutex;
+#endif
+    lv_tlsf_heap_t heaps[LV_TLSF_HEAP_CNT];     /**< Indexed by `lv_mem_placement_t`*/
+#if LV_MEM_SMALL_BLOCK_PAGE_SIZE
+    lv_slab_t small_blocks;
+    lv_slab_class_t small_block_classes[LV_MEM_SMALL_BLOCK_CLASS_CNT];
+#endif
 } lv_tlsf_state_t;
 
 /**********************
@@ -24,6 +24,7 @@
 #endif
 
 #define zero_mem LV_GLOBAL_DEFAULT()->memory_zero
+#define mem_reclaim_cb LV_GLOBAL_DEFAULT()->mem_reclaim_cb
 
 /**********************
  *      TYPEDEFS
@@ -32,6 +33,8 @@
 /**********************
  *  STATIC PROTOTYPES
  **********************/
+static inline void * malloc_core(size_t size, lv_mem_placement_t placement);
+static bool reclaim(void);
 
 /**********************
  *  GLOBAL PROTOTYPES
@@ -60,6 +63,11 @@ lv_result_t lv_mem_test_core(void);
  **********************/
 
 void * lv_malloc(size_t size)
+{
+    return lv_malloc_placed(size, LV_MEM_PLACEMENT_FAST);
+}
+
+void * lv_malloc_placed(size_t size, lv_mem_placement_t placement)
 {
     LV_TRACE_MEM("allocating %lu bytes", (unsigned long)size);
     if(size == 0) {
@@ -67,13 +75,14 @@ void * lv_malloc(size_t size)
         return &zero_mem;
     }
 
-    void * alloc = lv_malloc_core(size);
+    void * alloc = malloc_core(size, placement);
+    if(alloc == NULL && reclaim()) alloc = malloc_core(size, placement);
 
     if(alloc == NULL) {
         LV_LOG_INFO("couldn't allocate memory (%lu bytes)", (unsigned long)size);
 #if LV_LOG_LEVEL <= LV_LOG_LEVEL_INFO
         lv_mem_monitor_t mon;
-        lv_mem_monitor(&mon);
+        lv_mem_monitor_placed(&mon, placement);
         LV_LOG_INFO("used: %zu (%3d %%), frag: %3d %%, biggest free: %zu",
                     mon.total_size - mon.free_size, mon.used_pct, mon.frag_pct,
                     mon.free_biggest_size);
@@ -98,6 +107,7 @@ void * lv_malloc_zeroed(size_t size)
     }
 
     void * alloc = lv_malloc_core(size);
+    if(alloc == NULL && reclaim()) alloc = lv_malloc_core(size);
     if(alloc == NULL) {
         LV_LOG_INFO("couldn't allocate memory (%lu bytes)", (unsigned long)size);
 #if LV_LOG_LEVEL <= LV_LOG_LEVEL_INFO
@@ -137,6 +147,7 @@ void * lv_realloc(void * data_p, size_t new_size)
     if(data_p == &zero_mem) return lv_malloc(new_size);
 
     void * new_p = lv_realloc_core(data_p, new_size);
+    if(new_p == NULL && reclaim()) new_p = lv_realloc_core(data_p, new_size);
 
     if(new_p == NULL) {
         LV_LOG_ERROR("couldn't reallocate memory");
@@ -147,6 +158,11 @@ void * lv_realloc(void * data_p, size_t new_size)
     return new_p;
 }
 
+void lv_mem_set_reclaim_cb(lv_mem_reclaim_cb_t reclaim_cb)
+{
+    mem_reclaim_cb = reclaim_cb;
+}
+
 lv_result_t lv_mem_test(void)
 {
     if(zero_mem != ZERO_MEM_SENTINEL) {
@@ -163,6 +179,56 @@ void lv_mem_monitor(lv_mem_monitor_t * mon_p)
     lv_mem_monitor_core(mon_p);
 }
 
+void lv_mem_monitor_placed(lv_mem_monitor_t * mon_p, lv_mem_placement_t placement)
+{
+    lv_memzero(mon_p, sizeof(lv_mem_monitor_t));
+#if LV_USE_STDLIB_MALLOC == LV_STDLIB_BUILTIN && LV_MEM_BULK_SIZE
+    lv_mem_monitor_placed_core(mon_p, placement);
+#else
+    /*There is only one pool and it belongs to the fast placement*/
+    if(placement == LV_MEM_PLACEMENT_FAST) lv_mem_monitor_core(mon_p);
+#endif
+}
+
+lv_mem_placement_t lv_mem_get_placement(const void * p)
+{
+#if LV_USE_STDLIB_MALLOC == LV_STDLIB_BUILTIN && LV_MEM_BULK_SIZE
+    return lv_mem_get_placement_core(p);
+#else
+    LV_UNUSED(p);
+    return LV_MEM_PLACEMENT_FAST;
+#endif
+}
+
+lv_mem_pool_t lv_mem_add_pool_placed(void * mem, size_t bytes, lv_mem_placement_t placement)
+{
+#if LV_USE_STDLIB_MALLOC == LV_STDLIB_BUILTIN && LV_MEM_BULK_SIZE
+    return lv_mem_add_pool_placed_core(mem, bytes, placement);
+#else
+    LV_UNUSED(placement);
+    return lv_mem_add_pool(mem, bytes);
+#endif
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
+
+static inline void * malloc_core(size_t size, lv_mem_placement_t placement)
+{
+#if LV_USE_STDLIB_MALLOC == LV_STDLIB_BUILTIN && LV_MEM_BULK_SIZE
+    return lv_malloc_placed_core(size, placement);
+#else
+    LV_UNUSED(placement);
+    return lv_malloc_core(size);
+#endif
+}
+
+/**
+ * Let the registered module free its kept memory after a failed allocation
+ * @return true: something was freed, try the allocation again
+ */
+static bool reclaim(void)
+{
+    return mem_reclaim_cb && mem_reclaim_cb();
+}
@@ -18,17 +18,39 @@ extern "C" {
 #include "lv_string.h"
 
 #include "../misc/lv_types.h"
+#include "../misc/lv_slab.h"
 
 /*********************
  *      DEFINES
  *********************/
 
+#if LV_USE_STDLIB_MALLOC == LV_STDLIB_BUILTIN && LV_MEM_SMALL_BLOCK_PAGE_SIZE
+/** Number of the size classes of the small allocations (8, 16, 24, 32, 48 and 64 bytes)*/
+#define LV_MEM_SMALL_BLOCK_CLASS_CNT    6
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
 
 typedef void * lv_mem_pool_t;
 
+/**
+ * Free memory which is kept only to be reused, e.g. cached buffers.
+ * @return true: something was freed and the failed allocation can be tried again
+ */
+typedef bool (*lv_mem_reclaim_cb_t)(void);
+
+/**
+ * Where to place an allocation if there are memories with different speed.
+ * Without `LV_MEM_BULK_SIZE` all allocations are placed in the same pool.
+ */
+typedef enum {
+    LV_MEM_PLACEMENT_FAST,  /**< Small and often used data, e.g. objects, styles and draw tasks. Used by `lv_malloc()`*/
+    LV_MEM_PLACEMENT_BULK,  /**< Large, sequentially accessed data, e.g. draw buffers, cached images and layers*/
+    LV_MEM_PLACEMENT_CNT,
+} lv_mem_placement_t;
+
 /**
  * Heap information structure.
  */
@@ -41,6 +63,13 @@ typedef struct {
     size_t max_used;    /**< Max size of Heap memory used */
     uint8_t used_pct;   /**< Percentage used */
     uint8_t frag_pct;   /**< Amount of fragmentation */
+#if LV_USE_STDLIB_MALLOC == LV_STDLIB_BUILTIN && LV_MEM_SMALL_BLOCK_PAGE_SIZE
+    /** Usage of the size classes of the small allocations. Their pages are counted as used memory above.*/
+    lv_slab_stat_t small_blocks[LV_MEM_SMALL_BLOCK_CLASS_CNT];
+#endif
+#if LV_USE_STDLIB_MALLOC == LV_STDLIB_BUILTIN && LV_MEM_BULK_SIZE
+    size_t fallback_cnt;    /**< Number of allocations placed in the other pool because this one was full*/
+#endif
 } lv_mem_monitor_t;
 
 /**********************
@@ -59,8 +88,25 @@ void lv_mem_deinit(void);
 
 lv_mem_pool_t lv_mem_add_pool(void * mem, size_t bytes);
 
+/**
+ * Add memory to the pool of a placement
+ * @param mem       pointer to the memory to add
+ * @param bytes     size of the memory in bytes
+ * @param placement the allocations with this placement will use the memory too.
+ *                  The memories of different placements can't be interleaved in the address space.
+ * @return          the new pool or NULL on failure
+ */
+lv_mem_pool_t lv_mem_add_pool_placed(void * mem, size_t bytes, lv_mem_placement_t placement);
+
 void lv_mem_remove_pool(lv_mem_pool_t pool);
 
+/**
+ * Set a function which is called when an allocation fails to free the memory kept by other modules.
+ * If it frees anything the allocation is tried again.
+ * @param reclaim_cb    the function or NULL to not retry the failed allocations
+ */
+void lv_mem_set_reclaim_cb(lv_mem_reclaim_cb_t reclaim_cb);
+
 /**
  * Allocate memory dynamically
  * @param size requested size in bytes
@@ -68,6 +114,16 @@ void lv_mem_remove_pool(lv_mem_pool_t pool);
  */
 void * lv_malloc(size_t size);
 
+/**
+ * Allocate memory dynamically in the pool of a placement.
+ * If that pool is full the memory is allocated in the other pool.
+ * The memory can be freed and reallocated by `lv_free()` and `lv_realloc()` as usual.
+ * @param size      requested size in bytes
+ * @param placement where to place the memory
+ * @return pointer to allocated uninitialized memory, or NULL on failure
+ */
+void * lv_malloc_placed(size_t size, lv_mem_placement_t placement);
+
 /**
  * Allocate zeroed memory dynamically
  * @param size requested size in bytes
@@ -115,6 +171,36 @@ void * lv_realloc_core(void * p, size_t new_size);
  */
 void lv_mem_monitor_core(lv_mem_monitor_t * mon_p);
 
+#if LV_USE_STDLIB_MALLOC == LV_STDLIB_BUILTIN && LV_MEM_BULK_SIZE
+/**
+ * Used internally to allocate memory in the pool of a placement
+ * @param size      size in bytes to allocate
+ * @param placement where to place the memory
+ */
+void * lv_malloc_placed_core(size_t size, lv_mem_placement_t placement);
+
+/**
+ * Used internally to add memory to the pool of a placement
+ * @param mem       pointer to the memory to add
+ * @param bytes     size of the memory in bytes
+ * @param placement the placement which will use the memory
+ */
+lv_mem_pool_t lv_mem_add_pool_placed_core(void * mem, size_t bytes, lv_mem_placement_t placement);
+
+/**
+ * Used internally by lv_mem_monitor_placed() to gather the state of the pool of a placement
+ * @param mon_p     pointer to lv_mem_monitor_t object to be populated.
+ * @param placement the placement to check
+ */
+void lv_mem_monitor_placed_core(lv_mem_monitor_t * mon_p, lv_mem_placement_t placement);
+
+/**
+ * Used internally by lv_mem_get_placement() to find the pool of an allocated memory
+ * @param p         pointer to an allocated memory
+ */
+lv_mem_placement_t lv_mem_get_placement_core(const void * p);
+#endif
+
 lv_result_t lv_mem_test_core(void);
 
 /**
@@ -130,6 +216,22 @@ lv_result_t lv_mem_test(void);
  */
 void lv_mem_monitor(lv_mem_monitor_t * mon_p);
 
+/**
+ * Give information about the memory used by the allocations of a placement
+ * @param mon_p     pointer to a lv_mem_monitor_t variable,
+ *                  the result of the analysis will be stored here
+ * @param placement `LV_MEM_PLACEMENT_FAST` gives the same result as `lv_mem_monitor()`.
+ *                  Without `LV_MEM_BULK_SIZE` the result of `LV_MEM_PLACEMENT_BULK` is all zero.
+ */
+void lv_mem_monitor_placed(lv_mem_monitor_t * mon_p, lv_mem_placement_t placement);
+
+/**
+ * Get in which pool an allocated memory is. It differs from the requested placement if that pool was full.
+ * @param p         pointer to an allocated memory
+ * @return          the placement of the pool. Without `LV_MEM_BULK_SIZE` always `LV_MEM_PLACEMENT_FAST`.
+ */
+lv_mem_placement_t lv_mem_get_placement(const void * p);
+
 /**********************
  *      MACROS
  **********************/
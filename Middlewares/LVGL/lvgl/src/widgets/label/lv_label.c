@@ -58,6 +58,8 @@ static void set_ofs_y_anim(void * obj, int32_t v);
 static size_t get_text_length(const char * text);
 static void copy_text_to_label(lv_label_t * label, const char * text);
 static lv_text_flag_t get_label_flags(lv_label_t * label);
+static void get_unwrapped_size(lv_label_t * label, const lv_draw_label_dsc_t * dsc, lv_text_flag_t flag,
+                               lv_point_t * size);
 static void calculate_x_coordinate(int32_t * x, const lv_text_align_t align, const char * txt,
                                    uint32_t length, const lv_font_t * font, int32_t letter_space, lv_area_t * txt_coords);
 
@@ -692,6 +694,10 @@ static void lv_label_constructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
     label->hint.y          = 0;
 #endif
 
+#if LV_LABEL_LAYOUT_CACHE
+    lv_draw_label_layout_init(&label->layout);
+#endif
+
 #if LV_LABEL_TEXT_SELECTION
     label->sel_start = LV_DRAW_LABEL_NO_TXT_SEL;
     label->sel_end   = LV_DRAW_LABEL_NO_TXT_SEL;
@@ -714,6 +720,10 @@ static void lv_label_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
     lv_label_dot_tmp_free(obj);
     if(!label->static_txt) lv_free(label->text);
     label->text = NULL;
+
+#if LV_LABEL_LAYOUT_CACHE
+    lv_draw_label_layout_free(&label->layout);
+#endif
 }
 
 static void lv_label_event(const lv_obj_class_t * class_p, lv_event_t * e)
@@ -795,6 +805,13 @@ static void draw_main(lv_event_t * e)
     lv_obj_init_draw_label_dsc(obj, LV_PART_MAIN, &label_draw_dsc);
     lv_bidi_calculate_align(&label_draw_dsc.align, &label_draw_dsc.bidi_dir, label->text);
 
+#if LV_LABEL_LAYOUT_CACHE
+    /*It's usually measured already in `lv_label_refr_text()`*/
+    lv_draw_label_layout_update(&label->layout, label->text, label_draw_dsc.font, label_draw_dsc.letter_space,
+                                lv_area_get_width(&txt_coords), flag);
+    label_draw_dsc.layout = &label->layout;
+#endif
+
     label_draw_dsc.sel_start = lv_label_get_text_selection_start(obj);
     label_draw_dsc.sel_end = lv_label_get_text_selection_end(obj);
     if(label_draw_dsc.sel_start != LV_DRAW_LABEL_NO_TXT_SEL && label_draw_dsc.sel_end != LV_DRAW_LABEL_NO_TXT_SEL) {
@@ -807,8 +824,7 @@ static void draw_main(lv_event_t * e)
     if((label->long_mode == LV_LABEL_LONG_SCROLL || label->long_mode == LV_LABEL_LONG_SCROLL_CIRCULAR) &&
        (label_draw_dsc.align == LV_TEXT_ALIGN_CENTER || label_draw_dsc.align == LV_TEXT_ALIGN_RIGHT)) {
         lv_point_t size;
-        lv_text_get_size(&size, label->text, label_draw_dsc.font, label_draw_dsc.letter_space, label_draw_dsc.line_space,
-                         LV_COORD_MAX, flag);
+        get_unwrapped_size(label, &label_draw_dsc, flag, &size);
         if(size.x > lv_area_get_width(&txt_coords)) {
             label_draw_dsc.align = LV_TEXT_ALIGN_LEFT;
         }
@@ -840,8 +856,7 @@ static void draw_main(lv_event_t * e)
 
     if(label->long_mode == LV_LABEL_LONG_SCROLL_CIRCULAR) {
         lv_point_t size;
-        lv_text_get_size(&size, label->text, label_draw_dsc.font, label_draw_dsc.letter_space, label_draw_dsc.line_space,
-                         LV_COORD_MAX, flag);
+        get_unwrapped_size(label, &label_draw_dsc, flag, &size);
 
         /*Draw the text again on label to the original to make a circular effect */
         if(size.x > lv_area_get_width(&txt_coords)) {
@@ -913,7 +928,20 @@ static void lv_label_refr_text(lv_obj_t * obj)
     lv_point_t size;
     lv_text_flag_t flag = get_label_flags(label);
 
+#if LV_LABEL_LAYOUT_CACHE
+    /*Measure the lines here once and use them for drawing too.
+     *The text might have been modified in place so always measure it again.*/
+    lv_draw_label_layout_invalidate(&label->layout);
+    lv_draw_label_layout_update(&label->layout, label->text, font, letter_space, max_w, flag);
+    if(lv_draw_label_layout_is_valid(&label->layout, label->text, font, letter_space, max_w, flag)) {
+        lv_draw_label_layout_get_size(&label->layout, line_space, &size);
+    }
+    else {
+        lv_text_get_size(&size, label->text, font, letter_space, line_space, max_w, flag);
+    }
+#else
     lv_text_get_size(&size, label->text, font, letter_space, line_space, max_w, flag);
+#endif
 
     lv_obj_refresh_self_size(obj);
 
@@ -1165,6 +1193,9 @@ static void lv_label_refr_text(lv_obj_t * obj)
                 }
                 label->text[byte_id_ori + LV_LABEL_DOT_NUM] = '\0';
                 label->dot_end                              = letter_id + LV_LABEL_DOT_NUM;
+#if LV_LABEL_LAYOUT_CACHE
+                lv_draw_label_layout_invalidate(&label->layout);
+#endif
             }
         }
     }
@@ -1197,6 +1228,10 @@ static void lv_label_revert_dots(lv_obj_t * obj)
     lv_label_dot_tmp_free(obj);
 
     label->dot_end = LV_LABEL_DOT_END_INV;
+
+#if LV_LABEL_LAYOUT_CACHE
+    lv_draw_label_layout_invalidate(&label->layout);
+#endif
 }
 
 /**
@@ -1313,6 +1348,28 @@ static lv_text_flag_t get_label_flags(lv_label_t * label)
     return flag;
 }
 
+/**
+ * Get the size of the text without wrapping its lines
+ * @param label     pointer to a label object
+ * @param dsc       the label's draw descriptor
+ * @param flag      the label's text flags
+ * @param size      store the result here
+ */
+static void get_unwrapped_size(lv_label_t * label, const lv_draw_label_dsc_t * dsc, lv_text_flag_t flag,
+                               lv_point_t * size)
+{
+#if LV_LABEL_LAYOUT_CACHE
+    /*With EXPAND the lines are not wrapped anyway, so the layout has the same size*/
+    if((flag & LV_TEXT_FLAG_EXPAND) &&
+       lv_draw_label_layout_is_valid(&label->layout, label->text, dsc->font, dsc->letter_space, LV_COORD_MAX, flag)) {
+        lv_draw_label_layout_get_size(&label->layout, dsc->line_space, size);
+        return;
+    }
+#endif
+
+    lv_text_get_size(size, label->text, dsc->font, dsc->letter_space, dsc->line_space, LV_COORD_MAX, flag);
+}
+
 /* Function created because of this pattern be used in multiple functions */
 static void calculate_x_coordinate(int32_t * x, const lv_text_align_t align, const char * txt, uint32_t length,
                                    const lv_font_t * font, int32_t letter_space, lv_area_t * txt_coords)
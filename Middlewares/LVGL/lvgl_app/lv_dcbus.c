@@ -18,6 +18,7 @@
  #include "./SYSTEM/usart/usart.h"
  #include "./BSP/CAN/can.h"
  #include "lv_dcbus.h"
+ #include "lv_numlabel.h"
 
  
  /************************ 变量声明 ********************** */
@@ -54,6 +55,8 @@
  void lvgl_timer_1_cb(lv_timer_t *timer);
  void btn_to_main_page_cb(lv_event_t *e);
  void lvgl_timer_2_cb(lv_timer_t *timer);
+ static const lv_style_t *get_font_style(const lv_font_t *font);
+ static void add_font_style(lv_obj_t *obj, const lv_font_t *font);
  
  /************************ 结构体声明 ********************** */
  
@@ -63,6 +66,29 @@
  
  /************************ 页面相关函数  ********************** */
  
+ /* 获取只设置了字体的共享样式, 使用相同字体的对象共用同一个样式 */
+ static const lv_style_t *get_font_style(const lv_font_t *font) {
+     /* 临时样式只用于比较和复制, 常量样式无需 reset, 不会清空样式值缓存 */
+     lv_style_const_prop_t props[] = {
+         LV_STYLE_CONST_TEXT_FONT(font),
+         LV_STYLE_CONST_PROPS_END
+     };
+     LV_STYLE_CONST_INIT(style, props);
+ 
+     return lv_style_intern(&style);        /* 查找或创建属性相同的共享样式, 内存不足时返回 NULL */
+ }
+ 
+ /* 设置对象的字体, 共享样式创建失败时退回到对象的本地样式 */
+ static void add_font_style(lv_obj_t *obj, const lv_font_t *font) {
+     const lv_style_t *style = get_font_style(font);
+ 
+     if (style != NULL) {
+         lv_obj_add_style(obj, style, 0);
+     } else {
+         lv_obj_set_style_text_font(obj, font, 0);
+     }
+ }
+ 
  /* 创建欢迎屏幕（开机界面） */
  void create_welcome_scr(void) {
      /* 创建屏幕父类对象 */
@@ -72,10 +98,7 @@
      /* 创建"Welcome"label对象 */
      welcome_label = lv_label_create(welcome_scr);
      lv_label_set_text(welcome_label, "Welcome");
-     static lv_style_t style_welcome_label;
-     lv_style_init(&style_welcome_label);
-     lv_style_set_text_font(&style_welcome_label, &lv_font_montserrat_40);
-     lv_obj_add_style(welcome_label, &style_welcome_label, 0);
+     add_font_style(welcome_label, &lv_font_montserrat_40);
      lv_obj_align(welcome_label, LV_ALIGN_CENTER, 0, 0);
  
      /* 创建 "Start" button对象 */
@@ -87,10 +110,7 @@
      btn_welcome_label = lv_label_create(btn_welcome);
      lv_label_set_text(btn_welcome_label, "Start");
      lv_obj_align(btn_welcome_label, LV_ALIGN_CENTER, 0, 0);
-     static lv_style_t style_btn_welcome_label;
-     lv_style_init(&style_btn_welcome_label);
-     lv_style_set_text_font(&style_btn_welcome_label, &lv_font_montserrat_32);
-     lv_obj_add_style(btn_welcome_label, &style_btn_welcome_label, 0);
+     add_font_style(btn_welcome_label, &lv_font_montserrat_32);
      lv_obj_clear_flag(btn_welcome, LV_OBJ_FLAG_SCROLLABLE);
      lv_obj_set_style_bg_color(btn_welcome, lv_palette_main(LV_PALETTE_GREY),NULL);
      lv_obj_add_event_cb(btn_welcome, btn_welcome_event_cb, LV_EVENT_CLICKED, NULL);
@@ -113,10 +133,7 @@
      /* 创建标题label */
      main_label = lv_label_create(main_scr);
      lv_label_set_text(main_label, "MVDC IPS Fault Detection System"); 
-     static lv_style_t style_main_label;
-     lv_style_init(&style_main_label);
-     lv_style_set_text_font(&style_main_label, &lv_font_montserrat_32);
-     lv_obj_add_style(main_label, &style_main_label, 0);
+     add_font_style(main_label, &lv_font_montserrat_32);
      lv_obj_align(main_label, LV_ALIGN_TOP_MID, 0, 0);
  
      /* 创建 "Next Page" button */
@@ -128,10 +145,7 @@
      lv_obj_t *btn_to_dcbus_voltage_page_label = lv_label_create(btn_to_dcbus_voltage_page);
      lv_label_set_text(btn_to_dcbus_voltage_page_label, "Next");
      lv_obj_align(btn_to_dcbus_voltage_page_label, LV_ALIGN_CENTER, 0, 0);
-     static lv_style_t style_to_dcbus_voltage_page_label;
-     lv_style_init(&style_to_dcbus_voltage_page_label);
-     lv_style_set_text_font(&style_to_dcbus_voltage_page_label, &lv_font_montserrat_24);
-     lv_obj_add_style(btn_to_dcbus_voltage_page_label, &style_to_dcbus_voltage_page_label, 0);
+     add_font_style(btn_to_dcbus_voltage_page_label, &lv_font_montserrat_24);
      lv_obj_clear_flag(btn_to_dcbus_voltage_page, LV_OBJ_FLAG_SCROLLABLE);
      lv_obj_set_style_bg_color(btn_to_dcbus_voltage_page, lv_palette_main(LV_PALETTE_GREY),NULL);
      lv_obj_add_event_cb(btn_to_dcbus_voltage_page, btn_to_dcbus_voltage_page_cb, LV_EVENT_CLICKED, NULL);
@@ -145,10 +159,7 @@
      lv_obj_t *btn_to_connection_status_page_label = lv_label_create(btn_to_connection_status_page);
      lv_label_set_text(btn_to_connection_status_page_label, "STATUS");
      lv_obj_align(btn_to_connection_status_page_label, LV_ALIGN_CENTER, 0, 0);
-     static lv_style_t style_to_connection_status_page_label;
-     lv_style_init(&style_to_connection_status_page_label);
-     lv_style_set_text_font(&style_to_connection_status_page_label, &lv_font_montserrat_24);
-     lv_obj_add_style(btn_to_connection_status_page_label, &style_to_connection_status_page_label, 0);
+     add_font_style(btn_to_connection_status_page_label, &lv_font_montserrat_24);
      lv_obj_clear_flag(btn_to_connection_status_page, LV_OBJ_FLAG_SCROLLABLE);
      lv_obj_set_style_bg_color(btn_to_connection_status_page, lv_palette_main(LV_PALETTE_GREY),NULL);
      lv_obj_add_event_cb(btn_to_connection_status_page, btn_to_system_connection_status_cb, LV_EVENT_CLICKED, NULL);
@@ -165,47 +176,37 @@
      /* 创建标题 label */
      lv_obj_t * dc_bus_voltage_title_label = lv_label_create(dc_bus_voltage_page);
      lv_label_set_text(dc_bus_voltage_title_label, "DC Bus Voltage Detection");
-     static lv_style_t style_dc_bus_voltage_title_label;
-     lv_style_init(&style_dc_bus_voltage_title_label);
-     lv_style_set_text_font(&style_dc_bus_voltage_title_label, &lv_font_montserrat_32);
-     lv_obj_add_style(dc_bus_voltage_title_label, &style_dc_bus_voltage_title_label, 0);
+     add_font_style(dc_bus_voltage_title_label, &lv_font_montserrat_32);
      lv_obj_align(dc_bus_voltage_title_label, LV_ALIGN_TOP_MID, 0, 0);
  
      /* 创建电压label */
-     voltage_label = lv_label_create(dc_bus_voltage_page);
-     lv_label_set_text(voltage_label, "Voltage: ");
+     voltage_label = lv_numlabel_create(dc_bus_voltage_page);
+     lv_numlabel_set_affix(voltage_label, "Voltage: ", "V");
+     /* 数值 0~255, 在 3 个字符格中右对齐, 单位的位置不随数值变化 */
+     lv_numlabel_set_digits(voltage_label, 3);
      lv_obj_align(voltage_label, LV_ALIGN_TOP_LEFT, 50, 60);
-     static lv_style_t style_voltage_label;
-     lv_style_init(&style_voltage_label);
-     lv_style_set_text_font(&style_voltage_label, &lv_font_montserrat_28);
-     lv_obj_add_style(voltage_label, &style_voltage_label, 0);
+     add_font_style(voltage_label, &lv_font_montserrat_28);
  
      /* 创建电流label */
-     dcbus_current_label = lv_label_create(dc_bus_voltage_page);
-     lv_label_set_text(dcbus_current_label, "Current: ");
+     dcbus_current_label = lv_numlabel_create(dc_bus_voltage_page);
+     lv_numlabel_set_affix(dcbus_current_label, "Current: ", "A");
+     lv_numlabel_set_digits(dcbus_current_label, 3);
      lv_obj_align(dcbus_current_label, LV_ALIGN_TOP_LEFT, 50, 100);
-     static lv_style_t style_dcbus_current_label;
-     lv_style_init(&style_dcbus_current_label);
-     lv_style_set_text_font(&style_dcbus_current_label, &lv_font_montserrat_28);
-     lv_obj_add_style(dcbus_current_label, &style_dcbus_current_label, 0);
+     add_font_style(dcbus_current_label, &lv_font_montserrat_28);
  
      /* 创建功率label */
-     power_label = lv_label_create(dc_bus_voltage_page);
-     lv_label_set_text(power_label, "Power: ");
+     power_label = lv_numlabel_create(dc_bus_voltage_page);
+     lv_numlabel_set_affix(power_label, "Power: ", "W");
+     lv_numlabel_set_digits(power_label, 3);
      lv_obj_align(power_label, LV_ALIGN_TOP_LEFT, 50, 140);
-     static lv_style_t style_power_label;
-     lv_style_init(&style_power_label);
-     lv_style_set_text_font(&style_power_label, &lv_font_montserrat_28);
-     lv_obj_add_style(power_label, &style_power_label, 0);
+     add_font_style(power_label, &lv_font_montserrat_28);
  
      /* 创建励磁电流label */
-     excitation_current_label = lv_label_create(dc_bus_voltage_page);
-     lv_label_set_text(excitation_current_label, "Excitation Current: ");
+     excitation_current_label = lv_numlabel_create(dc_bus_voltage_page);
+     lv_numlabel_set_affix(excitation_current_label, "Excitation Current: ", "A");
+     lv_numlabel_set_digits(excitation_current_label, 3);
      lv_obj_align(excitation_current_label, LV_ALIGN_TOP_LEFT, 50, 180);
-     static lv_style_t style_excitation_current_label;
-     lv_style_init(&style_excitation_current_label);
-     lv_style_set_text_font(&style_excitation_current_label, &lv_font_montserrat_28);
-     lv_obj_add_style(excitation_current_label, &style_excitation_current_label, 0);
+     add_font_style(excitation_current_label, &lv_font_montserrat_28);
  
      /* 创建返回main页面的button对象 */
      lv_obj_t *btn_from_dc_bus_to_main_page = lv_btn_create(dc_bus_voltage_page);
@@ -216,10 +217,7 @@
      lv_obj_t *btn_from_dc_bus_to_main_page_label = lv_label_create(btn_from_dc_bus_to_main_page);
      lv_label_set_text(btn_from_dc_bus_to_main_page_label, "Back");
      lv_obj_align(btn_from_dc_bus_to_main_page_label, LV_ALIGN_CENTER, 0, 0);
-     static lv_style_t style_btn_from_dc_bus_to_main_page_label;
-     lv_style_init(&style_btn_from_dc_bus_to_main_page_label);
-     lv_style_set_text_font(&style_btn_from_dc_bus_to_main_page_label, &lv_font_montserrat_24);
-     lv_obj_add_style(btn_from_dc_bus_to_main_page_label, &style_btn_from_dc_bus_to_main_page_label, 0);
+     add_font_style(btn_from_dc_bus_to_main_page_label, &lv_font_montserrat_24);
      lv_obj_clear_flag(btn_from_dc_bus_to_main_page, LV_OBJ_FLAG_SCROLLABLE);
      lv_obj_set_style_bg_color(btn_from_dc_bus_to_main_page, lv_palette_main(LV_PALETTE_GREY),NULL);
      lv_obj_add_event_cb(btn_from_dc_bus_to_main_page, btn_from_dc_bus_to_main_page_cb, LV_EVENT_CLICKED, NULL);
@@ -238,19 +236,13 @@
      /* 创建标题label */
      lv_obj_t * connection_status_title_label = lv_label_create(connection_status_page);
      lv_label_set_text(connection_status_title_label, "System Connection Status");
-     static lv_style_t style_connection_status_title_label;
-     lv_style_init(&style_connection_status_title_label);
-     lv_style_set_text_font(&style_connection_status_title_label, &lv_font_montserrat_32);
-     lv_obj_add_style(connection_status_title_label, &style_connection_status_title_label, 0);
+     add_font_style(connection_status_title_label, &lv_font_montserrat_32);
      lv_obj_align(connection_status_title_label, LV_ALIGN_TOP_MID, 0, 0);
  
      /* 创建 CAN bus status label */
      CAN_label = lv_label_create(connection_status_page);
      lv_label_set_text(CAN_label, "CAN: Getting status...");
-     static lv_style_t style_CAN_label;
-     lv_style_init(&style_CAN_label);
-     lv_style_set_text_font(&style_CAN_label, &lv_font_montserrat_28);
-     lv_obj_add_style(CAN_label, &style_CAN_label, 0);
+     add_font_style(CAN_label, &lv_font_montserrat_28);
      lv_obj_align(CAN_label, LV_ALIGN_TOP_LEFT, 50, 60);
  
      /* 创建"Back"button */
@@ -262,10 +254,7 @@
      lv_obj_t *btn_to_main_page_label = lv_label_create(btn_to_main_page);
      lv_label_set_text(btn_to_main_page_label, "Back");
      lv_obj_align(btn_to_main_page_label, LV_ALIGN_CENTER, 0, 0);
-     static lv_style_t style_to_main_page_label;
-     lv_style_init(&style_to_main_page_label);
-     lv_style_set_text_font(&style_to_main_page_label, &lv_font_montserrat_24);
-     lv_obj_add_style(btn_to_main_page_label, &style_to_main_page_label, 0);
+     add_font_style(btn_to_main_page_label, &lv_font_montserrat_24);
      lv_obj_clear_flag(btn_to_main_page, LV_OBJ_FLAG_SCROLLABLE);
      lv_obj_set_style_bg_color(btn_to_main_page, lv_palette_main(LV_PALETTE_GREY),NULL);
      lv_obj_add_event_cb(btn_to_main_page, btn_to_main_page_cb, LV_EVENT_CLICKED, NULL);
@@ -419,9 +408,9 @@
  extern uint8_t canbuf[4];
  void lvgl_timer_2_cb(lv_timer_t *timer)
  {
-     /* 更新数据至label */
-     lv_label_set_text_fmt(voltage_label, "Voltage: %dV", canbuf[0]);
-     lv_label_set_text_fmt(dcbus_current_label, "Current: %dA", canbuf[1]);
-     lv_label_set_text_fmt(power_label, "Power: %dW", canbuf[2]);
-     lv_label_set_text_fmt(excitation_current_label, "Excitation Current: %dA", canbuf[3]);
+     /* 更新数据至label, 只重绘变化的数字 */
+     lv_numlabel_set_value(voltage_label, canbuf[0]);
+     lv_numlabel_set_value(dcbus_current_label, canbuf[1]);
+     lv_numlabel_set_value(power_label, canbuf[2]);
+     lv_numlabel_set_value(excitation_current_label, canbuf[3]);
  }
\ No newline at end of file
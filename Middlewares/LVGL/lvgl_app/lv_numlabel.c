@@ -0,0 +1,369 @@
+/**
+ ****************************************************************************************************
+ * @file        lv_numlabel.c
+ * @author      Aki
+ * @version     V1.0
+ * @date        2026-10-17
+ * @brief       数值显示控件
+ ****************************************************************************************************
+ * @attention
+ *              lv_label_set_text_fmt() 每次更新都要格式化、重新分配文本、重新测量整行文字，
+ *              并且刷新整个 label。本控件把文字分成固定的前缀、数值、后缀三部分:
+ *              - 前缀和后缀只在设置或样式改变时测量一次;
+ *              - 数值的每个字符占用一个等宽的字符格 (宽度取 '0'~'9' 和 '-' 的最大宽度),
+ *                数值变化时控件大小不变, 只刷新内容改变的字符格;
+ *              - 数值保存在控件内部的固定缓冲区中, 更新时不申请内存。
+ *              与 lv_label 的区别: 数值在字符格中右对齐, 每个数字在字符格中居中;
+ *              第一次设置数值之前只显示前缀。
+ *
+ ****************************************************************************************************
+ */
+
+#include "lv_numlabel.h"
+#include "src/lvgl_private.h"
+
+
+/************************ 宏定义 ********************** */
+
+#define MY_CLASS (&lv_numlabel_class)
+
+/************************ 结构体声明 ********************** */
+
+typedef struct {
+    lv_obj_t obj;
+    const char * prefix;                            /* 前缀, 不复制 */
+    const char * suffix;                            /* 后缀, 不复制 */
+    char cells[LV_NUMLABEL_DIGITS_MAX + 1];         /* 右对齐的数值字符, 空格表示空字符格 */
+    uint8_t digits;                                 /* 字符格数量 */
+    int32_t value;
+    bool value_set;                                 /* 是否已设置过数值, 之前只显示前缀 */
+    int32_t prefix_w;                               /* 前缀宽度, 包括与数值之间的字间距 */
+    int32_t suffix_w;                               /* 后缀宽度 */
+    int32_t cell_w;                                 /* 字符格宽度, 包括字间距 */
+} lv_numlabel_t;
+
+/************************ 函数声明 ********************** */
+
+static void lv_numlabel_constructor(const lv_obj_class_t * class_p, lv_obj_t * obj);
+static void lv_numlabel_event(const lv_obj_class_t * class_p, lv_event_t * e);
+static void draw_main(lv_event_t * e);
+static void refr_metrics(lv_obj_t * obj);
+static uint8_t get_value_len(int32_t value);
+static void format_cells(char * cells, uint8_t digits, int32_t value);
+static int32_t get_glyph_x(lv_obj_t * obj, char c, int32_t cell_x1, lv_area_t * box);
+static void get_cell_area(lv_obj_t * obj, uint32_t idx, char old_c, char new_c, lv_area_t * area);
+
+/************************ 变量声明 ********************** */
+
+const lv_obj_class_t lv_numlabel_class = {
+    .base_class = &lv_obj_class,
+    .constructor_cb = lv_numlabel_constructor,
+    .event_cb = lv_numlabel_event,
+    .width_def = LV_SIZE_CONTENT,
+    .height_def = LV_SIZE_CONTENT,
+    .instance_size = sizeof(lv_numlabel_t),
+    .name = "numlabel",
+};
+
+
+/************************ 对外接口 ********************** */
+
+lv_obj_t * lv_numlabel_create(lv_obj_t * parent)
+{
+    lv_obj_t * obj = lv_obj_class_create_obj(MY_CLASS, parent);
+    lv_obj_class_init_obj(obj);
+    return obj;
+}
+
+void lv_numlabel_set_affix(lv_obj_t * obj, const char * prefix, const char * suffix)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+    lv_numlabel_t * numlabel = (lv_numlabel_t *)obj;
+
+    numlabel->prefix = prefix;
+    numlabel->suffix = suffix;
+    refr_metrics(obj);
+}
+
+void lv_numlabel_set_digits(lv_obj_t * obj, uint8_t digits)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+    lv_numlabel_t * numlabel = (lv_numlabel_t *)obj;
+
+    if(digits < 1) digits = 1;
+    if(digits > LV_NUMLABEL_DIGITS_MAX) digits = LV_NUMLABEL_DIGITS_MAX;
+
+    /* 不能少于当前数值需要的位数 */
+    uint8_t len = get_value_len(numlabel->value);
+    if(digits < len) digits = len;
+    if(digits == numlabel->digits) return;
+
+    numlabel->digits = digits;
+    format_cells(numlabel->cells, digits, numlabel->value);
+    lv_obj_refresh_self_size(obj);
+    lv_obj_invalidate(obj);
+}
+
+void lv_numlabel_set_value(lv_obj_t * obj, int32_t value)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+    lv_numlabel_t * numlabel = (lv_numlabel_t *)obj;
+
+    if(numlabel->value_set && numlabel->value == value) return;
+    numlabel->value = value;
+
+    uint8_t len = get_value_len(value);
+    if(!numlabel->value_set) {
+        /* 第一次设置, 数值和后缀第一次显示, 整体刷新 */
+        numlabel->value_set = true;
+        if(len > numlabel->digits) {
+            numlabel->digits = len;
+            lv_obj_refresh_self_size(obj);
+        }
+        format_cells(numlabel->cells, numlabel->digits, value);
+        lv_obj_invalidate(obj);
+        return;
+    }
+
+    if(len > numlabel->digits) {
+        /* 字符格不够, 控件大小改变, 整体刷新 */
+        numlabel->digits = len;
+        format_cells(numlabel->cells, len, value);
+        lv_obj_refresh_self_size(obj);
+        lv_obj_invalidate(obj);
+        return;
+    }
+
+    /* 只刷新内容改变的字符格 */
+    char cells[LV_NUMLABEL_DIGITS_MAX + 1];
+    format_cells(cells, numlabel->digits, value);
+    uint32_t i;
+    for(i = 0; i < numlabel->digits; i++) {
+        if(cells[i] == numlabel->cells[i]) continue;
+
+        lv_area_t area;
+        get_cell_area(obj, i, numlabel->cells[i], cells[i], &area);
+        numlabel->cells[i] = cells[i];
+        lv_obj_invalidate_area(obj, &area);
+    }
+}
+
+int32_t lv_numlabel_get_value(const lv_obj_t * obj)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+    const lv_numlabel_t * numlabel = (const lv_numlabel_t *)obj;
+
+    return numlabel->value;
+}
+
+
+/************************ 内部函数 ********************** */
+
+static void lv_numlabel_constructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
+{
+    LV_UNUSED(class_p);
+    lv_numlabel_t * numlabel = (lv_numlabel_t *)obj;
+
+    numlabel->prefix = NULL;
+    numlabel->suffix = NULL;
+    numlabel->digits = 1;
+    numlabel->value = 0;
+    numlabel->value_set = false;
+    format_cells(numlabel->cells, numlabel->digits, numlabel->value);
+
+    lv_obj_remove_flag(obj, LV_OBJ_FLAG_CLICKABLE);
+    lv_obj_remove_flag(obj, LV_OBJ_FLAG_SCROLLABLE);
+    lv_obj_remove_flag(obj, LV_OBJ_FLAG_SCROLL_ON_FOCUS);
+
+    refr_metrics(obj);
+}
+
+static void lv_numlabel_event(const lv_obj_class_t * class_p, lv_event_t * e)
+{
+    LV_UNUSED(class_p);
+
+    /* 先调用基类的事件处理 */
+    lv_result_t res = lv_obj_event_base(MY_CLASS, e);
+    if(res != LV_RESULT_OK) return;
+
+    lv_event_code_t code = lv_event_get_code(e);
+    lv_obj_t * obj = lv_event_get_current_target(e);
+    lv_numlabel_t * numlabel = (lv_numlabel_t *)obj;
+
+    if(code == LV_EVENT_STYLE_CHANGED) {
+        /* 字体或字间距可能改变, 重新测量 */
+        refr_metrics(obj);
+    }
+    else if(code == LV_EVENT_REFR_EXT_DRAW_SIZE) {
+        /* 与 lv_label 相同, 给超出行高的字形留出空间 */
+        const lv_font_t * font = lv_obj_get_style_text_font(obj, LV_PART_MAIN);
+        int32_t font_h = lv_font_get_line_height(font);
+        lv_event_set_ext_draw_size(e, font_h / 4);
+    }
+    else if(code == LV_EVENT_GET_SELF_SIZE) {
+        lv_point_t * size = lv_event_get_param(e);
+        const lv_font_t * font = lv_obj_get_style_text_font(obj, LV_PART_MAIN);
+        int32_t w = numlabel->prefix_w + numlabel->digits * numlabel->cell_w + numlabel->suffix_w;
+        size->x = LV_MAX(size->x, w);
+        size->y = LV_MAX(size->y, lv_font_get_line_height(font));
+    }
+    else if(code == LV_EVENT_DRAW_MAIN) {
+        draw_main(e);
+    }
+}
+
+static void draw_main(lv_event_t * e)
+{
+    lv_obj_t * obj = lv_event_get_current_target(e);
+    lv_numlabel_t * numlabel = (lv_numlabel_t *)obj;
+    lv_layer_t * layer = lv_event_get_layer(e);
+
+    lv_area_t coords;
+    lv_obj_get_content_coords(obj, &coords);
+
+    lv_draw_label_dsc_t dsc;
+    lv_draw_label_dsc_init(&dsc);
+    lv_obj_init_draw_label_dsc(obj, LV_PART_MAIN, &dsc);
+    dsc.base.layer = layer;
+
+    lv_area_t area = coords;
+
+    /* 前缀 */
+    if(numlabel->prefix && numlabel->prefix[0] != '\0') {
+        area.x2 = area.x1 + numlabel->prefix_w - 1;
+        dsc.text = numlabel->prefix;
+        dsc.text_local = 0;
+        lv_draw_label(layer, &dsc, &area);
+    }
+    area.x1 += numlabel->prefix_w;
+
+    /* 还没有数值 */
+    if(!numlabel->value_set) return;
+
+    /* 数值, 每个字符在字符格中居中 */
+    uint32_t i;
+    for(i = 0; i < numlabel->digits; i++) {
+        char c = numlabel->cells[i];
+        if(c != ' ') {
+            lv_point_t pos;
+            pos.x = get_glyph_x(obj, c, area.x1, NULL);
+            pos.y = area.y1;
+            lv_draw_character(layer, &dsc, &pos, (uint32_t)c);
+        }
+        area.x1 += numlabel->cell_w;
+    }
+
+    /* 后缀 */
+    if(numlabel->suffix && numlabel->suffix[0] != '\0') {
+        area.x2 = area.x1 + numlabel->suffix_w - 1;
+        dsc.text = numlabel->suffix;
+        dsc.text_local = 0;
+        lv_draw_label(layer, &dsc, &area);
+    }
+}
+
+/* 测量前缀、后缀和字符格的宽度 */
+static void refr_metrics(lv_obj_t * obj)
+{
+    lv_numlabel_t * numlabel = (lv_numlabel_t *)obj;
+    const lv_font_t * font = lv_obj_get_style_text_font(obj, LV_PART_MAIN);
+    int32_t letter_space = lv_obj_get_style_text_letter_space(obj, LV_PART_MAIN);
+
+    numlabel->prefix_w = 0;
+    if(numlabel->prefix && numlabel->prefix[0] != '\0') {
+        numlabel->prefix_w = lv_text_get_width(numlabel->prefix, lv_strlen(numlabel->prefix), font, letter_space) +
+                             letter_space;
+    }
+
+    numlabel->suffix_w = 0;
+    if(numlabel->suffix && numlabel->suffix[0] != '\0') {
+        numlabel->suffix_w = lv_text_get_width(numlabel->suffix, lv_strlen(numlabel->suffix), font, letter_space);
+    }
+
+    /* 比例字体的数字宽度不同, 按最宽的字符确定字符格宽度, 保证数值变化时控件大小不变 */
+    const char * chars = "0123456789-";
+    int32_t cell_w = 0;
+    while(*chars) {
+        int32_t w = lv_font_get_glyph_width(font, (uint32_t)*chars, 0);
+        cell_w = LV_MAX(cell_w, w);
+        chars++;
+    }
+    numlabel->cell_w = cell_w + letter_space;
+
+    lv_obj_refresh_self_size(obj);
+    lv_obj_invalidate(obj);
+}
+
+/* 获取数值需要的字符格数量, 包括负号 */
+static uint8_t get_value_len(int32_t value)
+{
+    uint32_t u = value < 0 ? 0U - (uint32_t)value : (uint32_t)value;
+    uint8_t len = value < 0 ? 2 : 1;
+    while(u >= 10) {
+        u /= 10;
+        len++;
+    }
+    return len;
+}
+
+/* 把数值右对齐写入 digits 个字符格, 调用前需保证位数足够 */
+static void format_cells(char * cells, uint8_t digits, int32_t value)
+{
+    uint32_t u = value < 0 ? 0U - (uint32_t)value : (uint32_t)value;
+    int32_t i = digits;
+
+    cells[i] = '\0';
+    do {
+        cells[--i] = (char)('0' + u % 10);
+        u /= 10;
+    } while(u);
+
+    if(value < 0) cells[--i] = '-';
+    while(i > 0) cells[--i] = ' ';
+}
+
+/* 获取字符在字符格中的绘制x坐标, box不为NULL时返回字形的水平范围 (字形可能超出字符格, 例如字间距为负时) */
+static int32_t get_glyph_x(lv_obj_t * obj, char c, int32_t cell_x1, lv_area_t * box)
+{
+    lv_numlabel_t * numlabel = (lv_numlabel_t *)obj;
+    const lv_font_t * font = lv_obj_get_style_text_font(obj, LV_PART_MAIN);
+    int32_t letter_space = lv_obj_get_style_text_letter_space(obj, LV_PART_MAIN);
+
+    lv_font_glyph_dsc_t g;
+    lv_font_get_glyph_dsc(font, &g, (uint32_t)c, 0);
+    int32_t x = cell_x1 + (numlabel->cell_w - letter_space - g.adv_w) / 2;
+
+    if(box) {
+        box->x1 = x + g.ofs_x;
+        box->x2 = box->x1 + g.box_w - 1;
+    }
+
+    return x;
+}
+
+/* 获取一个字符格需要刷新的区域 (屏幕坐标), 包括新旧字形超出字符格的部分 */
+static void get_cell_area(lv_obj_t * obj, uint32_t idx, char old_c, char new_c, lv_area_t * area)
+{
+    lv_numlabel_t * numlabel = (lv_numlabel_t *)obj;
+
+    lv_obj_get_content_coords(obj, area);
+    int32_t cell_x1 = area->x1 + numlabel->prefix_w + (int32_t)idx * numlabel->cell_w;
+    area->x1 = cell_x1;
+    area->x2 = cell_x1 + numlabel->cell_w - 1;
+
+    char chars[2] = {old_c, new_c};
+    uint32_t i;
+    for(i = 0; i < 2; i++) {
+        if(chars[i] == ' ') continue;
+
+        lv_area_t box;
+        get_glyph_x(obj, chars[i], cell_x1, &box);
+        area->x1 = LV_MIN(area->x1, box.x1);
+        area->x2 = LV_MAX(area->x2, box.x2);
+    }
+
+    /* 字形可能超出行高, 与 LV_EVENT_REFR_EXT_DRAW_SIZE 中的范围一致 */
+    int32_t ext = lv_obj_get_ext_draw_size(obj);
+    area->y1 = obj->coords.y1 - ext;
+    area->y2 = obj->coords.y2 + ext;
+}
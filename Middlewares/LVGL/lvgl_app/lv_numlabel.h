@@ -0,0 +1,69 @@
+/**
+ ****************************************************************************************************
+ * @file        lv_numlabel.h
+ * @author      Aki
+ * @version     V1.0
+ * @date        2026-10-17
+ * @brief       数值显示控件
+ ****************************************************************************************************
+ * @attention
+ *              显示 "前缀 + 数值 + 后缀"，例如 "Voltage: 123V"。
+ *              前缀和后缀只在设置时测量一次，数值的每一位占用固定宽度的字符格，
+ *              数值变化时只重绘发生变化的字符格，不重新分配和测量整个字符串。
+ *              与 lv_label 显示的不同: 数值在字符格中右对齐 (例如 3 个字符格时 "Voltage:  12V")，
+ *              第一次调用 lv_numlabel_set_value() 之前只显示前缀。
+ *
+ ****************************************************************************************************
+ */
+
+#ifndef LV_NUMLABEL_H
+#define LV_NUMLABEL_H
+
+#include "lvgl.h"
+
+/* 字符格的最大数量, 足够显示 int32_t 的最小值 "-2147483648" */
+#define LV_NUMLABEL_DIGITS_MAX      11
+
+/**
+ * @brief       创建数值显示控件
+ * @param       parent: 父对象
+ * @retval      新创建的控件
+ */
+lv_obj_t * lv_numlabel_create(lv_obj_t * parent);
+
+/**
+ * @brief       设置前缀和后缀
+ * @note        字符串不会被复制, 必须在控件的整个生命周期内有效 (例如字符串常量)
+ * @param       obj   : 数值显示控件
+ * @param       prefix: 数值前显示的文字, NULL: 无前缀
+ * @param       suffix: 数值后显示的文字, NULL: 无后缀
+ * @retval      无
+ */
+void lv_numlabel_set_affix(lv_obj_t * obj, const char * prefix, const char * suffix);
+
+/**
+ * @brief       设置数值的最少位数 (字符格数量)
+ * @note        数值右对齐, 位数不足时前面留空。数值更长时字符格数量自动增加。
+ * @param       obj   : 数值显示控件
+ * @param       digits: 字符格数量, 1..LV_NUMLABEL_DIGITS_MAX
+ * @retval      无
+ */
+void lv_numlabel_set_digits(lv_obj_t * obj, uint8_t digits);
+
+/**
+ * @brief       设置显示的数值
+ * @note        只刷新内容发生变化的字符格
+ * @param       obj  : 数值显示控件
+ * @param       value: 新的数值
+ * @retval      无
+ */
+void lv_numlabel_set_value(lv_obj_t * obj, int32_t value);
+
+/**
+ * @brief       获取显示的数值
+ * @param       obj: 数值显示控件
+ * @retval      当前数值
+ */
+int32_t lv_numlabel_get_value(const lv_obj_t * obj);
+
+#endif /* LV_NUMLABEL_H */
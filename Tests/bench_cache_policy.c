@@ -0,0 +1,275 @@
+/**
+ * @file bench_cache_policy.c
+ * Hit rate and time per operation of the LRU, S3-FIFO and ARC cache classes on replayed access traces.
+ * Each access is a `lv_cache_acquire_or_create()` and a `lv_cache_release()`, like in the image and glyph caches.
+ *
+ * The traces are generated with a fixed seed, so the hit rates are the same in every run:
+ * - carousel: 8 icons on every frame and one of 40 carousel images after each other
+ * - scrolling text: the glyphs of a short text on every frame and the glyphs of a long text scrolled through once
+ * - zipf + scans: Zipf 0.8 popularity with a scan through 400 new keys after each 2000 accesses
+ * - zipf sized: Zipf 1.0 popularity, the entries have different sizes
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "test_common.h"
+#include "src/misc/cache/lv_cache_private.h"
+#include <math.h>
+#include <stdlib.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+#define POLICY_CNT      3
+#define ZIPF_KEY_MAX    4000
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/*The first member is the size for the `_size` classes*/
+typedef struct {
+    size_t size;
+    uint32_t key;
+} node_t;
+
+typedef struct {
+    const char * name;
+    bool by_size;
+    uint32_t max_size;
+    void (*next_cb)(uint32_t i, node_t * node);
+} trace_t;
+
+typedef struct {
+    uint32_t hit_cnt;
+    uint64_t ns;
+} result_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void replay(const trace_t * trace, uint32_t policy, uint32_t access_cnt, result_t * res);
+static void trace_carousel(uint32_t i, node_t * node);
+static void trace_text(uint32_t i, node_t * node);
+static void trace_zipf_scan(uint32_t i, node_t * node);
+static void trace_zipf_sized(uint32_t i, node_t * node);
+static void zipf_init(double s, uint32_t key_cnt);
+static uint32_t zipf_next(void);
+static bool create_cb(node_t * node, void * user_data);
+static void free_cb(node_t * node, void * user_data);
+static lv_cache_compare_res_t compare_cb(const node_t * a, const node_t * b);
+static uint32_t hash_cb(const node_t * node);
+static uint32_t rnd(void);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static const trace_t traces[] = {
+    {"carousel", false, 24, trace_carousel},
+    {"scrolling text", true, 4096, trace_text},
+    {"zipf + scans", false, 200, trace_zipf_scan},
+    {"zipf sized", true, 32768, trace_zipf_sized},
+};
+
+static const char * const policy_names[POLICY_CNT] = {"LRU", "S3-FIFO", "ARC"};
+
+static double zipf_cdf[ZIPF_KEY_MAX];
+static uint32_t zipf_key_cnt;
+static uint32_t rnd_state;
+static uint32_t create_cnt;
+static uint32_t free_cnt;
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+int main(int argc, char ** argv)
+{
+    test_init(argc, argv);
+
+    uint32_t access_cnt = test_quick() ? 20000 : 400000;
+    uint32_t trace_cnt = sizeof(traces) / sizeof(traces[0]);
+
+    printf("%u accesses per trace\n", (unsigned)access_cnt);
+    printf("%-16s", "");
+    uint32_t p;
+    for(p = 0; p < POLICY_CNT; p++) printf("%20s", policy_names[p]);
+    printf("\n");
+
+    result_t res[sizeof(traces) / sizeof(traces[0])][POLICY_CNT];
+    uint32_t t;
+    for(t = 0; t < trace_cnt; t++) {
+        printf("%-16s", traces[t].name);
+        for(p = 0; p < POLICY_CNT; p++) {
+            /*The first replay warms up the heap, the second is measured*/
+            replay(&traces[t], p, access_cnt, &res[t][p]);
+            lv_mem_monitor_t mon_start;
+            lv_mem_monitor(&mon_start);
+
+            lv_memzero(&res[t][p], sizeof(result_t));
+            replay(&traces[t], p, access_cnt, &res[t][p]);
+            printf("%11.1f%% %5.0fns", res[t][p].hit_cnt * 100.0 / access_cnt, (double)res[t][p].ns / access_cnt);
+
+            /*Every created node was freed with the cache, also the ghost records.
+             *TLSF can split the free memory a little differently, allow a few block headers.*/
+            lv_mem_monitor_t mon_end;
+            lv_mem_monitor(&mon_end);
+            TEST_ASSERT_EQUAL(create_cnt, free_cnt);
+            TEST_ASSERT((int64_t)mon_start.free_size - (int64_t)mon_end.free_size <= 64);
+        }
+        printf("\n");
+    }
+
+    /*The carousel images are used only once, the scans too: they must not push out the often used entries*/
+    for(p = 1; p < POLICY_CNT; p++) {
+        TEST_ASSERT(res[0][p].hit_cnt >= res[0][0].hit_cnt);
+        TEST_ASSERT(res[2][p].hit_cnt > res[2][0].hit_cnt);
+    }
+
+    return test_finish("bench_cache_policy");
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static void replay(const trace_t * trace, uint32_t policy, uint32_t access_cnt, result_t * res)
+{
+    static const uint32_t policies[POLICY_CNT] = {LV_CACHE_POLICY_LRU, LV_CACHE_POLICY_S3FIFO, LV_CACHE_POLICY_ARC};
+
+    lv_cache_t * cache = lv_cache_create(lv_cache_class_get(policies[policy], trace->by_size), sizeof(node_t),
+    trace->max_size, (lv_cache_ops_t) {
+        .compare_cb = (lv_cache_compare_cb_t) compare_cb,
+        .create_cb = (lv_cache_create_cb_t) create_cb,
+        .free_cb = (lv_cache_free_cb_t) free_cb,
+        .hash_cb = (lv_cache_hash_cb_t) hash_cb,
+    });
+    TEST_ASSERT(cache != NULL);
+
+    /*The same trace for each policy*/
+    rnd_state = 0x12345678;
+    create_cnt = 0;
+    free_cnt = 0;
+
+    uint64_t start = test_time_ns();
+    uint32_t i;
+    for(i = 0; i < access_cnt; i++) {
+        node_t key;
+        trace->next_cb(i, &key);
+
+        uint32_t create_cnt_prev = create_cnt;
+        lv_cache_entry_t * entry = lv_cache_acquire_or_create(cache, &key, NULL);
+        if(entry == NULL) {
+            TEST_ASSERT(false);
+            break;
+        }
+
+        if(create_cnt == create_cnt_prev) res->hit_cnt++;
+        lv_cache_release(cache, entry, NULL);
+    }
+    res->ns = test_time_ns() - start;
+
+    TEST_ASSERT(lv_cache_get_size(cache, NULL) <= trace->max_size);
+    lv_cache_destroy(cache, NULL);
+}
+
+/*One key per frame (9 accesses): the icons 0..7, then the next carousel image*/
+static void trace_carousel(uint32_t i, node_t * node)
+{
+    uint32_t frame_ofs = i % 9;
+    node->key = frame_ofs < 8 ? frame_ofs : 100 + (i / 9) % 40;
+    node->size = 1;
+}
+
+/*A short text of 40 glyphs in 4 frames, then 40 glyphs of the long text. The glyphs use 24..120 bytes.*/
+static void trace_text(uint32_t i, node_t * node)
+{
+    uint32_t block = i / 40;
+    if(block % 5 == 4) node->key = 1000 + ((block / 5) * 40 + i % 40) % 3000;
+    else node->key = (i * 7) % 40;
+
+    node->size = 24 + (node->key * 37) % 97;
+}
+
+static void trace_zipf_scan(uint32_t i, node_t * node)
+{
+    if(i == 0) zipf_init(0.8, 2000);
+
+    if(i % 2400 >= 2000) node->key = 100000 + i;
+    else node->key = zipf_next();
+
+    node->size = 1;
+}
+
+/*The sizes are 16..2047 bytes, the popular keys are not the smaller ones*/
+static void trace_zipf_sized(uint32_t i, node_t * node)
+{
+    if(i == 0) zipf_init(1.0, ZIPF_KEY_MAX);
+
+    node->key = zipf_next();
+    node->size = 16 + (node->key * 2654435761u >> 8) % 2032;
+}
+
+static void zipf_init(double s, uint32_t key_cnt)
+{
+    double sum = 0;
+    uint32_t k;
+    for(k = 0; k < key_cnt; k++) {
+        sum += 1.0 / pow(k + 1, s);
+        zipf_cdf[k] = sum;
+    }
+
+    for(k = 0; k < key_cnt; k++) zipf_cdf[k] /= sum;
+    zipf_key_cnt = key_cnt;
+}
+
+static uint32_t zipf_next(void)
+{
+    double r = rnd() / 4294967296.0;
+    uint32_t lo = 0;
+    uint32_t hi = zipf_key_cnt - 1;
+    while(lo < hi) {
+        uint32_t mid = (lo + hi) / 2;
+        if(zipf_cdf[mid] < r) lo = mid + 1;
+        else hi = mid;
+    }
+
+    /*Scatter the ranks over the keys*/
+    return (lo * 2654435761u) % 1000003;
+}
+
+static bool create_cb(node_t * node, void * user_data)
+{
+    LV_UNUSED(node);
+    LV_UNUSED(user_data);
+    create_cnt++;
+    return true;
+}
+
+static void free_cb(node_t * node, void * user_data)
+{
+    LV_UNUSED(node);
+    LV_UNUSED(user_data);
+    free_cnt++;
+}
+
+static lv_cache_compare_res_t compare_cb(const node_t * a, const node_t * b)
+{
+    if(a->key == b->key) return 0;
+    return a->key > b->key ? 1 : -1;
+}
+
+static uint32_t hash_cb(const node_t * node)
+{
+    return node->key * 2654435761u;
+}
+
+/*xorshift32*/
+static uint32_t rnd(void)
+{
+    rnd_state ^= rnd_state << 13;
+    rnd_state ^= rnd_state >> 17;
+    rnd_state ^= rnd_state << 5;
+    return rnd_state;
+}
@@ -0,0 +1,226 @@
+/**
+ * @file bench_draw_buf_pool.c
+ * Scenes with layers in every frame, with the draw buffer pool (LV_DRAW_BUF_POOL_SIZE) and without it
+ * (`HOST_DRAW_BUF_POOL_SIZE=0`):
+ * - opacity: panels drawn on half transparent layers, their opacity changes in every frame
+ * - transform: rotated and scaled panels, their angle and scale change in every frame
+ *
+ * The time per frame, the allocations of pixel buffers of at least 1 kB per frame and the fragmentation of the bulk pool are printed.
+ * The build without the pool writes the last frame of each scene with `--write <file>`,
+ * the build with the pool must render the same (`--compare <file>`).
+ * With the pool the statistics are also checked on the memory monitor of sysmon.
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "test_common.h"
+#include "src/display/lv_display_private.h"
+#include <stdlib.h>
+#include <string.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+#define HOR_RES     480
+#define VER_RES     272
+#define PANEL_CNT   6
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+typedef struct {
+    const char * name;
+    void (*update_cb)(lv_obj_t * panel, uint32_t i, uint32_t frame);
+} scene_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+void * __real_lv_malloc_placed(size_t size, lv_mem_placement_t placement);
+void * __wrap_lv_malloc_placed(size_t size, lv_mem_placement_t placement);
+
+static void scene_create(lv_obj_t * scr, lv_obj_t ** panels);
+static void opacity_update(lv_obj_t * panel, uint32_t i, uint32_t frame);
+static void transform_update(lv_obj_t * panel, uint32_t i, uint32_t frame);
+static void check_sysmon(lv_display_t * disp);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static const scene_t scenes[] = {
+    {"opacity", opacity_update},
+    {"transform", transform_update},
+};
+
+static uint32_t placed_alloc_cnt;
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+int main(int argc, char ** argv)
+{
+    const char * write_path = NULL;
+    const char * compare_path = NULL;
+    int i;
+    for(i = 1; i + 1 < argc; i++) {
+        if(strcmp(argv[i], "--write") == 0) write_path = argv[i + 1];
+        if(strcmp(argv[i], "--compare") == 0) compare_path = argv[i + 1];
+    }
+
+    test_init(argc, argv);
+
+    uint32_t frame_cnt = test_quick() ? 10 : 200;
+    size_t fb_size = HOR_RES * VER_RES * sizeof(uint16_t);
+
+    FILE * f = NULL;
+    if(write_path) f = fopen(write_path, "wb");
+    if(compare_path) f = fopen(compare_path, "rb");
+    TEST_ASSERT(f != NULL || (write_path == NULL && compare_path == NULL));
+    uint16_t * ref = malloc(fb_size);
+
+    lv_display_t * disp = test_display_create(HOR_RES, VER_RES);
+
+    printf("LV_DRAW_BUF_POOL_SIZE %d, %u frames per scene\n", LV_DRAW_BUF_POOL_SIZE, (unsigned)frame_cnt);
+
+    uint32_t s;
+    for(s = 0; s < sizeof(scenes) / sizeof(scenes[0]); s++) {
+        lv_obj_t * scr = lv_obj_create(NULL);
+        lv_obj_t * panels[PANEL_CNT];
+        scene_create(scr, panels);
+        lv_screen_load(scr);
+
+        /*The first frame allocates the buffers (and fills the pool)*/
+        uint32_t j;
+        for(j = 0; j < PANEL_CNT; j++) scenes[s].update_cb(panels[j], j, 0);
+        lv_refr_now(disp);
+
+#if LV_DRAW_BUF_POOL_SIZE
+        lv_draw_buf_pool_reset_stat();
+#endif
+        placed_alloc_cnt = 0;
+        uint64_t start = test_time_ns();
+        uint32_t frame;
+        for(frame = 1; frame <= frame_cnt; frame++) {
+            for(j = 0; j < PANEL_CNT; j++) scenes[s].update_cb(panels[j], j, frame);
+            test_tick_inc(33);
+            lv_timer_handler();
+            lv_refr_now(disp);
+        }
+        uint64_t ns = test_time_ns() - start;
+
+        lv_mem_monitor_t mon;
+        lv_mem_monitor_placed(&mon, LV_MEM_PLACEMENT_BULK);
+        printf("%-10s %8.3f ms/frame, %5.1f buffer allocations (>= 1 kB)/frame, bulk pool %u%% fragmentation\n",
+               scenes[s].name, ns / 1e6 / frame_cnt, (double)placed_alloc_cnt / frame_cnt, (unsigned)mon.frag_pct);
+
+#if LV_DRAW_BUF_POOL_SIZE
+        lv_draw_buf_pool_stat_t stat;
+        lv_draw_buf_pool_get_stat(&stat);
+        printf("%-10s %u hits, %u misses, %u kB idle\n", "", (unsigned)stat.hit_cnt, (unsigned)stat.miss_cnt,
+               (unsigned)(stat.idle_size / 1024));
+        /*The layers of the same size are reused, the transformed ones change their size, most are still reused*/
+        if(s == 0) TEST_ASSERT_EQUAL(0, stat.miss_cnt);
+        TEST_ASSERT(stat.hit_cnt > stat.miss_cnt);
+        TEST_ASSERT_EQUAL(stat.miss_cnt, placed_alloc_cnt);
+#else
+        TEST_ASSERT(placed_alloc_cnt >= frame_cnt);
+#endif
+
+        if(f && write_path) {
+            TEST_ASSERT_EQUAL(fb_size, fwrite(test_display_pixels(disp), 1, fb_size, f));
+        }
+        else if(f && compare_path) {
+            TEST_ASSERT_EQUAL(fb_size, fread(ref, 1, fb_size, f));
+            if(memcmp(ref, test_display_pixels(disp), fb_size)) {
+                printf("%s: the frame is different from the reference\n", scenes[s].name);
+                TEST_ASSERT(false);
+            }
+        }
+    }
+
+    check_sysmon(disp);
+
+    if(f) fclose(f);
+    free(ref);
+
+    return test_finish("bench_draw_buf_pool");
+}
+
+/*The pixel buffers of the default draw buffer handlers are allocated here.
+ *Count only the ones large enough for the pool, not e.g. the glyph bitmaps.*/
+void * __wrap_lv_malloc_placed(size_t size, lv_mem_placement_t placement)
+{
+    if(size >= 1024) placed_alloc_cnt++;
+    return __real_lv_malloc_placed(size, placement);
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static void scene_create(lv_obj_t * scr, lv_obj_t ** panels)
+{
+    lv_obj_set_style_bg_color(scr, lv_palette_lighten(LV_PALETTE_GREY, 3), 0);
+
+    uint32_t i;
+    for(i = 0; i < PANEL_CNT; i++) {
+        lv_obj_t * panel = lv_obj_create(scr);
+        lv_obj_set_size(panel, 130, 100);
+        lv_obj_set_pos(panel, 20 + (i % 3) * 150, 20 + (i / 3) * 125);
+        lv_obj_set_style_bg_color(panel, lv_palette_main((lv_palette_t)(LV_PALETTE_BLUE + i)), 0);
+        lv_obj_set_style_shadow_width(panel, 12, 0);
+        lv_obj_remove_flag(panel, LV_OBJ_FLAG_SCROLLABLE);
+
+        lv_obj_t * label = lv_label_create(panel);
+        lv_label_set_text_fmt(label, "Panel %u\n220.%u V", (unsigned)i, (unsigned)i);
+        lv_obj_t * btn = lv_button_create(panel);
+        lv_obj_align(btn, LV_ALIGN_BOTTOM_RIGHT, 0, 0);
+        lv_obj_set_size(btn, 40, 24);
+
+        panels[i] = panel;
+    }
+}
+
+static void opacity_update(lv_obj_t * panel, uint32_t i, uint32_t frame)
+{
+    lv_obj_set_style_opa_layered(panel, LV_OPA_30 + (i * 20 + frame * 7) % 150, 0);
+}
+
+static void transform_update(lv_obj_t * panel, uint32_t i, uint32_t frame)
+{
+    lv_obj_set_style_transform_pivot_x(panel, 65, 0);
+    lv_obj_set_style_transform_pivot_y(panel, 50, 0);
+    lv_obj_set_style_transform_rotation(panel, (i * 300 + frame * 15) % 3600, 0);
+    lv_obj_set_style_transform_scale(panel, 200 + (frame * 3 + i * 10) % 56, 0);
+}
+
+/*The memory monitor shows the pool in a third line with the statistics of the pool*/
+static void check_sysmon(lv_display_t * disp)
+{
+#if LV_USE_SYSMON && LV_USE_MEM_MONITOR
+    /*Let the monitor's timer update the label*/
+    uint32_t t;
+    for(t = 0; t < 20; t++) {
+        test_tick_inc(50);
+        lv_timer_handler();
+    }
+
+    const char * text = lv_label_get_text(disp->mem_label);
+#if LV_DRAW_BUF_POOL_SIZE
+    lv_draw_buf_pool_stat_t stat;
+    lv_draw_buf_pool_get_stat(&stat);
+    char line[64];
+    lv_snprintf(line, sizeof(line), "%u kB draw buf, %u kB idle, %u%% reused", (unsigned)(stat.used_size / 1024),
+                (unsigned)(stat.idle_size / 1024), (unsigned)(stat.hit_cnt * 100 / (stat.hit_cnt + stat.miss_cnt)));
+    printf("sysmon: %s\n", strrchr(text, '\n') ? strrchr(text, '\n') + 1 : text);
+    TEST_ASSERT(strstr(text, line) != NULL);
+#else
+    TEST_ASSERT(strstr(text, "draw buf") == NULL);
+#endif
+#else
+    LV_UNUSED(disp);
+#endif
+}
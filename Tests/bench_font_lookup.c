@@ -0,0 +1,100 @@
+/**
+ * @file bench_font_lookup.c
+ * Time of `lv_font_get_glyph_dsc()` for Latin, CJK and mixed texts with the SimSun 16 CJK font.
+ * Built with the board configuration (no OS: the letter lookup takes no lock) and with pthread
+ * (`lvgl_host_mt1`: every lookup outside the first range locks the lookup mutex).
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "test_common.h"
+#include "src/misc/lv_text_private.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+#define LETTER_MAX      128
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+typedef struct {
+    const char * name;
+    const char * text;
+} text_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static uint32_t text_decode(const char * text, uint32_t * letters);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static const text_t texts[] = {
+    {"latin", "DC Bus Voltage: 220V Current: 12A Power: 2640W Excitation Current: 3A"},
+    {"cjk",   "直流母电系统返回主画面数值温度电流功能时日期中文字体大小上下左右"},
+    {"mixed", "直流母电 Voltage: 220V 电流 Current: 12A 功能 Power: 2640W 温度 35C"},
+};
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+int main(int argc, char ** argv)
+{
+    test_init(argc, argv);
+
+    const lv_font_t * font = &lv_font_simsun_16_cjk;
+    uint32_t round_cnt = test_quick() ? 200 : 20000;
+
+    printf("LV_USE_OS %d: %s\n", LV_USE_OS, LV_USE_OS ? "the lookups take the lock" : "no lock");
+
+    uint32_t t;
+    for(t = 0; t < sizeof(texts) / sizeof(texts[0]); t++) {
+        uint32_t letters[LETTER_MAX + 1];
+        uint32_t letter_cnt = text_decode(texts[t].text, letters);
+
+        /*The reference: every letter must be in the font, also when looked up again from the cache*/
+        lv_font_glyph_dsc_t ref[LETTER_MAX];
+        uint32_t i;
+        for(i = 0; i < letter_cnt; i++) {
+            TEST_ASSERT(lv_font_get_glyph_dsc(font, &ref[i], letters[i], letters[i + 1]));
+        }
+
+        uint64_t start = test_time_ns();
+        uint32_t r;
+        for(r = 0; r < round_cnt; r++) {
+            for(i = 0; i < letter_cnt; i++) {
+                lv_font_glyph_dsc_t g;
+                lv_font_get_glyph_dsc(font, &g, letters[i], letters[i + 1]);
+                if(r == 0) TEST_ASSERT(g.gid.index == ref[i].gid.index && g.adv_w == ref[i].adv_w);
+            }
+        }
+        uint64_t ns = test_time_ns() - start;
+
+        printf("%-6s %3u letters: %6.1f ns per lookup\n", texts[t].name, (unsigned)letter_cnt,
+               (double)ns / round_cnt / letter_cnt);
+    }
+
+    return test_finish("bench_font_lookup");
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/*Decode the UTF-8 text, the last letter is followed by 0*/
+static uint32_t text_decode(const char * text, uint32_t * letters)
+{
+    uint32_t cnt = 0;
+    uint32_t ofs = 0;
+    while(text[ofs] != '\0' && cnt < LETTER_MAX) {
+        letters[cnt++] = lv_text_encoded_next(text, &ofs);
+    }
+
+    letters[cnt] = 0;
+    return cnt;
+}
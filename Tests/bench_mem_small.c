@@ -0,0 +1,204 @@
+/**
+ * @file bench_mem_small.c
+ * Allocation heavy workloads with the small allocation size classes (LV_MEM_SMALL_BLOCK_PAGE_SIZE)
+ * and with TLSF only (`HOST_MEM_SMALL_BLOCK_PAGE_SIZE=0`):
+ * - random 8..64 byte `lv_malloc`/`lv_free` pairs with 200 live blocks
+ * - creating and deleting buttons with labels
+ * - updating the texts of labels
+ *
+ * The time is given per alloc/free pair, per widget and per text update, also in TSC cycles on x86.
+ * The fragmentation of the heap is checked after each workload.
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "test_common.h"
+#if defined(__x86_64__) || defined(__i386__)
+    #include <x86intrin.h>
+    #define CYCLES()    __rdtsc()
+#else
+    #define CYCLES()    0
+#endif
+
+/*********************
+ *      DEFINES
+ *********************/
+#define LIVE_CNT        200
+#define LABEL_CNT       16
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+typedef struct {
+    uint64_t ns;
+    uint64_t cycles;
+} cost_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void bench_pairs(uint32_t pair_cnt);
+static void bench_widgets(uint32_t cycle_cnt);
+static void bench_labels(uint32_t update_cnt);
+static void cost_start(cost_t * c);
+static void cost_end(cost_t * c, const char * name, uint32_t cnt, const char * unit);
+static void heap_report(size_t used_before);
+static uint32_t rnd(uint32_t max);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static uint32_t rnd_state = 99;
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+int main(int argc, char ** argv)
+{
+    test_init(argc, argv);
+    test_display_create(320, 240);
+
+    uint32_t scale = test_quick() ? 1 : 50;
+    printf("LV_MEM_SMALL_BLOCK_PAGE_SIZE %d\n", LV_MEM_SMALL_BLOCK_PAGE_SIZE);
+
+    bench_pairs(20000 * scale);
+    bench_widgets(20 * scale);
+    bench_labels(2000 * scale);
+
+#if LV_MEM_SMALL_BLOCK_PAGE_SIZE
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    uint32_t i;
+    for(i = 0; i < LV_MEM_SMALL_BLOCK_CLASS_CNT; i++) {
+        lv_slab_stat_t * s = &mon.small_blocks[i];
+        printf("class %2u bytes: %2u pages, %3u blocks used, %7u allocations\n", (unsigned)s->size,
+               (unsigned)s->page_cnt, (unsigned)s->used_cnt, (unsigned)s->alloc_cnt);
+    }
+#endif
+
+    return test_finish("bench_mem_small");
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static void bench_pairs(uint32_t pair_cnt)
+{
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    size_t used_before = mon.total_size - mon.free_size;
+
+    static void * live[LIVE_CNT];
+    uint32_t i;
+    for(i = 0; i < LIVE_CNT; i++) live[i] = lv_malloc(8 + rnd(57));
+
+    cost_t c;
+    cost_start(&c);
+    for(i = 0; i < pair_cnt; i++) {
+        uint32_t idx = rnd(LIVE_CNT);
+        lv_free(live[idx]);
+        live[idx] = lv_malloc(8 + rnd(57));
+        TEST_ASSERT(live[idx] != NULL);
+    }
+    cost_end(&c, "8..64 byte pairs", pair_cnt, "pair");
+
+    lv_mem_monitor(&mon);
+    printf("%-20s %u%% fragmentation, largest free block %u bytes with the live blocks\n", "", (unsigned)mon.frag_pct,
+           (unsigned)mon.free_biggest_size);
+
+    for(i = 0; i < LIVE_CNT; i++) lv_free(live[i]);
+    heap_report(used_before);
+}
+
+static void bench_widgets(uint32_t cycle_cnt)
+{
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    size_t used_before = mon.total_size - mon.free_size;
+
+    lv_obj_t * cont = lv_obj_create(lv_screen_active());
+    lv_obj_set_size(cont, 300, 220);
+    lv_obj_set_flex_flow(cont, LV_FLEX_FLOW_ROW_WRAP);
+
+    cost_t c;
+    cost_start(&c);
+    uint32_t i;
+    for(i = 0; i < cycle_cnt; i++) {
+        uint32_t j;
+        for(j = 0; j < 10; j++) {
+            lv_obj_t * btn = lv_button_create(cont);
+            lv_obj_t * label = lv_label_create(btn);
+            lv_label_set_text_fmt(label, "Item %u", (unsigned)j);
+        }
+        lv_obj_update_layout(cont);
+        lv_obj_clean(cont);
+    }
+    cost_end(&c, "buttons with labels", cycle_cnt * 10, "widget");
+
+    lv_obj_delete(cont);
+    heap_report(used_before);
+}
+
+static void bench_labels(uint32_t update_cnt)
+{
+    lv_obj_t * labels[LABEL_CNT];
+    uint32_t i;
+    for(i = 0; i < LABEL_CNT; i++) labels[i] = lv_label_create(lv_screen_active());
+
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    size_t used_before = mon.total_size - mon.free_size;
+
+    /*The texts change their length, so they are reallocated*/
+    cost_t c;
+    cost_start(&c);
+    for(i = 0; i < update_cnt; i++) {
+        lv_label_set_text_fmt(labels[i % LABEL_CNT], "%u.%u V", (unsigned)rnd(100000), (unsigned)rnd(10));
+    }
+    cost_end(&c, "label texts", update_cnt, "update");
+
+    for(i = 0; i < LABEL_CNT; i++) lv_label_set_text_static(labels[i], "");
+    heap_report(used_before);
+
+    for(i = 0; i < LABEL_CNT; i++) lv_obj_delete(labels[i]);
+}
+
+static void cost_start(cost_t * c)
+{
+    c->ns = test_time_ns();
+    c->cycles = CYCLES();
+}
+
+static void cost_end(cost_t * c, const char * name, uint32_t cnt, const char * unit)
+{
+    uint64_t ns = test_time_ns() - c->ns;
+    uint64_t cycles = CYCLES() - c->cycles;
+    printf("%-20s %8.1f ns/%s, %7.0f cycles/%s\n", name, (double)ns / cnt, unit, (double)cycles / cnt, unit);
+}
+
+/*The memory of the workload is freed, only the fragmentation stays*/
+static void heap_report(size_t used_before)
+{
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    size_t used = mon.total_size - mon.free_size;
+    printf("%-20s %u%% fragmentation, largest free block %u bytes, used %u -> %u bytes\n", "", (unsigned)mon.frag_pct,
+           (unsigned)mon.free_biggest_size, (unsigned)used_before, (unsigned)used);
+
+    /*The size class pages of the freed blocks can be kept*/
+    size_t used_max = used_before + 512;
+#if LV_MEM_SMALL_BLOCK_PAGE_SIZE
+    used_max += LV_MEM_SMALL_BLOCK_CLASS_CNT * LV_MEM_SMALL_BLOCK_PAGE_SIZE;
+#endif
+    TEST_ASSERT(used <= used_max);
+}
+
+static uint32_t rnd(uint32_t max)
+{
+    rnd_state = rnd_state * 1103515245 + 12345;
+    return (rnd_state >> 16) % max;
+}
@@ -0,0 +1,229 @@
+/**
+ * @file bench_numlabel.c
+ * Updating the four values of the DC bus page with `lv_label_set_text_fmt()` and with `lv_numlabel_set_value()`.
+ * Measured per update: the allocations, the invalidated pixels and the rendering time.
+ *
+ * After each update the partly redrawn frame must be the same as a full redraw, also with a negative
+ * letter space where the glyphs reach out of their cells.
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "test_common.h"
+#include "lv_numlabel.h"
+#include <stdlib.h>
+#include <string.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+#define HOR_RES         1024
+#define VER_RES         600
+
+#define VALUE_CNT       4
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+typedef enum {
+    VARIANT_LABEL,
+    VARIANT_NUMLABEL,
+    VARIANT_NUMLABEL_NARROW,    /**< Negative letter space: the glyphs are wider than the cells*/
+    VARIANT_CNT,
+} variant_t;
+
+typedef struct {
+    uint32_t alloc_cnt;
+    uint64_t inv_px;
+    uint64_t render_ns;
+    uint32_t mismatch_cnt;
+} result_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+void * __real_lv_malloc(size_t size);
+void * __wrap_lv_malloc(size_t size);
+void * __real_lv_malloc_zeroed(size_t size);
+void * __wrap_lv_malloc_zeroed(size_t size);
+void * __real_lv_realloc(void * data_p, size_t new_size);
+void * __wrap_lv_realloc(void * data_p, size_t new_size);
+
+static void page_create(lv_obj_t * scr, variant_t variant, lv_obj_t ** labels);
+static void values_set(variant_t variant, lv_obj_t ** labels, const uint8_t * values);
+static void invalidate_event_cb(lv_event_t * e);
+static uint32_t rnd(uint32_t max);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static const char * const names[VARIANT_CNT] = {"lv_label", "lv_numlabel", "lv_numlabel, letter space -4"};
+static const char * const prefixes[VALUE_CNT] = {"Voltage: ", "Current: ", "Power: ", "Excitation Current: "};
+static const char * const suffixes[VALUE_CNT] = {"V", "A", "W", "A"};
+
+static bool alloc_counting;
+static bool inv_counting;
+static uint32_t alloc_cnt;
+static uint64_t inv_px;
+static uint32_t rnd_state = 1;
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+int main(int argc, char ** argv)
+{
+    test_init(argc, argv);
+
+    uint32_t update_cnt = test_quick() ? 50 : 1000;
+    size_t fb_size = HOR_RES * VER_RES * sizeof(uint16_t);
+    uint16_t * partial = malloc(fb_size);
+
+    lv_display_t * disp = test_display_create(HOR_RES, VER_RES);
+    lv_display_add_event_cb(disp, invalidate_event_cb, LV_EVENT_INVALIDATE_AREA, NULL);
+
+    /*The same values for each variant: the CAN data changes a little in each 100 ms*/
+    uint8_t * values = malloc(update_cnt * VALUE_CNT);
+    uint32_t i;
+    uint32_t v;
+    for(v = 0; v < VALUE_CNT; v++) {
+        int32_t x = 20 + rnd(200);
+        for(i = 0; i < update_cnt; i++) {
+            x += (int32_t)rnd(7) - 3;
+            x = LV_CLAMP(0, x, 255);
+            values[i * VALUE_CNT + v] = (uint8_t)x;
+        }
+    }
+
+    result_t res[VARIANT_CNT];
+    lv_memzero(res, sizeof(res));
+
+    variant_t variant;
+    for(variant = 0; variant < VARIANT_CNT; variant++) {
+        lv_obj_t * old = lv_screen_active();
+        lv_obj_t * scr = lv_obj_create(NULL);
+        lv_obj_t * labels[VALUE_CNT];
+        page_create(scr, variant, labels);
+        lv_screen_load(scr);
+        lv_obj_delete(old);
+        values_set(variant, labels, values);
+        test_display_redraw(disp);
+
+        result_t * r = &res[variant];
+        for(i = 1; i < update_cnt; i++) {
+            alloc_cnt = 0;
+            inv_px = 0;
+            alloc_counting = true;
+            inv_counting = true;
+            values_set(variant, labels, &values[i * VALUE_CNT]);
+            alloc_counting = false;
+
+            /*The labels invalidate their new size in the layout update too*/
+            uint64_t start = test_time_ns();
+            lv_refr_now(disp);
+            r->render_ns += test_time_ns() - start;
+            inv_counting = false;
+
+            r->alloc_cnt += alloc_cnt;
+            r->inv_px += inv_px;
+
+            /*Only the invalidated areas were redrawn, they must cover every change*/
+            memcpy(partial, test_display_pixels(disp), fb_size);
+            test_display_redraw(disp);
+            if(memcmp(partial, test_display_pixels(disp), fb_size)) r->mismatch_cnt++;
+        }
+    }
+
+    printf("%u updates of %d values\n", (unsigned)update_cnt - 1, VALUE_CNT);
+    printf("%-30s %12s %18s %14s\n", "", "allocations", "invalidated px", "render us");
+    for(variant = 0; variant < VARIANT_CNT; variant++) {
+        result_t * r = &res[variant];
+        printf("%-30s %12.2f %18.0f %14.1f\n", names[variant], (double)r->alloc_cnt / (update_cnt - 1),
+               (double)r->inv_px / (update_cnt - 1), r->render_ns / 1e3 / (update_cnt - 1));
+    }
+
+    for(variant = 0; variant < VARIANT_CNT; variant++) {
+        TEST_ASSERT_EQUAL(0, res[variant].mismatch_cnt);
+    }
+
+    TEST_ASSERT_EQUAL(0, res[VARIANT_NUMLABEL].alloc_cnt);
+    TEST_ASSERT_EQUAL(0, res[VARIANT_NUMLABEL_NARROW].alloc_cnt);
+    TEST_ASSERT(res[VARIANT_NUMLABEL].inv_px < res[VARIANT_LABEL].inv_px);
+
+    free(values);
+    free(partial);
+
+    return test_finish("bench_numlabel");
+}
+
+void * __wrap_lv_malloc(size_t size)
+{
+    if(alloc_counting) alloc_cnt++;
+    return __real_lv_malloc(size);
+}
+
+void * __wrap_lv_malloc_zeroed(size_t size)
+{
+    if(alloc_counting) alloc_cnt++;
+    return __real_lv_malloc_zeroed(size);
+}
+
+void * __wrap_lv_realloc(void * data_p, size_t new_size)
+{
+    if(alloc_counting) alloc_cnt++;
+    return __real_lv_realloc(data_p, new_size);
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/*The value labels of `create_dc_bus_voltage_page()`*/
+static void page_create(lv_obj_t * scr, variant_t variant, lv_obj_t ** labels)
+{
+    uint32_t i;
+    for(i = 0; i < VALUE_CNT; i++) {
+        if(variant == VARIANT_LABEL) {
+            labels[i] = lv_label_create(scr);
+            lv_label_set_text(labels[i], prefixes[i]);
+        }
+        else {
+            labels[i] = lv_numlabel_create(scr);
+            lv_numlabel_set_affix(labels[i], prefixes[i], suffixes[i]);
+            lv_numlabel_set_digits(labels[i], 3);
+        }
+
+        lv_obj_align(labels[i], LV_ALIGN_TOP_LEFT, 50, 60 + i * 40);
+        lv_obj_set_style_text_font(labels[i], &lv_font_montserrat_28, 0);
+        if(variant == VARIANT_NUMLABEL_NARROW) lv_obj_set_style_text_letter_space(labels[i], -4, 0);
+    }
+}
+
+static void values_set(variant_t variant, lv_obj_t ** labels, const uint8_t * values)
+{
+    uint32_t i;
+    for(i = 0; i < VALUE_CNT; i++) {
+        if(variant == VARIANT_LABEL) {
+            lv_label_set_text_fmt(labels[i], "%s%d%s", prefixes[i], values[i], suffixes[i]);
+        }
+        else {
+            lv_numlabel_set_value(labels[i], values[i]);
+        }
+    }
+}
+
+static void invalidate_event_cb(lv_event_t * e)
+{
+    if(!inv_counting) return;
+
+    const lv_area_t * area = lv_event_get_param(e);
+    inv_px += lv_area_get_size(area);
+}
+
+static uint32_t rnd(uint32_t max)
+{
+    rnd_state = rnd_state * 1103515245 + 12345;
+    return (rnd_state >> 16) % max;
+}
@@ -0,0 +1,184 @@
+/**
+ * @file bench_obj_slab.c
+ * Heap fragmentation after creating and deleting screens, built with and without `LV_USE_OBJ_SLAB`
+ * (`HOST_OBJ_SLAB`).
+ *
+ * Each cycle creates a new screen with a random number of buttons, labels, sliders and list items,
+ * loads it, renders it and deletes the previous screen. A status label on the top layer changes its
+ * text in every cycle, so long lived allocations are mixed with the objects of the screens.
+ * After each cycle the TLSF heap is checked: the largest free block, the fragmentation and the used size.
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "test_common.h"
+#include "src/core/lv_obj_class_private.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+#define HOR_RES         320
+#define VER_RES         240
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+typedef struct {
+    size_t biggest_min;     /**< The smallest of the largest free blocks*/
+    size_t biggest_sum;
+    size_t used_max;
+    uint32_t frag_max;
+    uint32_t frag_sum;
+} heap_stat_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static lv_obj_t * screen_create(void);
+static void screen_replace(lv_obj_t * scr, lv_display_t * disp);
+static void click_event_cb(lv_event_t * e);
+static void heap_sample(heap_stat_t * stat);
+static uint32_t rnd(uint32_t max);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static uint32_t rnd_state = 12345;
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+int main(int argc, char ** argv)
+{
+    test_init(argc, argv);
+
+    uint32_t cycle_cnt = test_quick() ? 20 : 500;
+    lv_display_t * disp = test_display_create(HOR_RES, VER_RES);
+
+    lv_obj_t * status = lv_label_create(lv_layer_top());
+    lv_obj_align(status, LV_ALIGN_BOTTOM_RIGHT, 0, 0);
+
+    /*Warm up: the first screens allocate the theme styles, the caches and the first pages*/
+    uint32_t i;
+    for(i = 0; i < 5; i++) {
+        screen_replace(screen_create(), disp);
+    }
+
+    /*Measure the memory used by the screens with an empty screen before and after them*/
+    screen_replace(lv_obj_create(NULL), disp);
+    lv_mem_monitor_t mon_start;
+    lv_mem_monitor(&mon_start);
+
+    heap_stat_t stat = {.biggest_min = SIZE_MAX};
+    uint64_t start = test_time_ns();
+    for(i = 0; i < cycle_cnt; i++) {
+        lv_obj_t * old = lv_screen_active();
+        lv_screen_load(screen_create());
+        lv_label_set_text_fmt(status, "Cycle %u of %u%*s", (unsigned)i, (unsigned)cycle_cnt, (int)rnd(24), "");
+        lv_obj_delete(old);
+        test_display_redraw(disp);
+
+        heap_sample(&stat);
+    }
+    uint64_t ns = test_time_ns() - start;
+
+    screen_replace(lv_obj_create(NULL), disp);
+    lv_mem_monitor_t mon_end;
+    lv_mem_monitor(&mon_end);
+
+    printf("LV_USE_OBJ_SLAB %d, %u screens\n", LV_USE_OBJ_SLAB, (unsigned)cycle_cnt);
+    printf("largest free block: %u bytes average, %u bytes minimum (heap: %u bytes)\n",
+           (unsigned)(stat.biggest_sum / cycle_cnt), (unsigned)stat.biggest_min, (unsigned)mon_end.total_size);
+    printf("fragmentation:      %u%% average, %u%% maximum\n",
+           (unsigned)(stat.frag_sum / cycle_cnt), (unsigned)stat.frag_max);
+    printf("used:               %u bytes at most, %u -> %u bytes with an empty screen\n",
+           (unsigned)stat.used_max, (unsigned)(mon_start.total_size - mon_start.free_size),
+           (unsigned)(mon_end.total_size - mon_end.free_size));
+#if LV_USE_OBJ_SLAB
+    lv_slab_stat_t slab;
+    lv_obj_slab_get_stat(&slab);
+    printf("object slab:        %u pages, %u of %u bytes used, %u large blocks\n", (unsigned)slab.page_cnt,
+           (unsigned)slab.used_size, (unsigned)slab.total_size, (unsigned)slab.large_cnt);
+#endif
+    printf("time:               %.1f us per screen\n", ns / 1e3 / cycle_cnt);
+
+    /*The same kind of screens come and go, the memory used after them must not grow.
+     *The slab can keep a partly used page in each class.*/
+    size_t used_max = mon_start.total_size - mon_start.free_size + 1024;
+#if LV_USE_OBJ_SLAB
+    used_max += LV_OBJ_SLAB_CLASS_CNT * LV_OBJ_SLAB_PAGE_SIZE;
+#endif
+    TEST_ASSERT(mon_end.total_size - mon_end.free_size <= used_max);
+
+    return test_finish("bench_obj_slab");
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static lv_obj_t * screen_create(void)
+{
+    lv_obj_t * scr = lv_obj_create(NULL);
+    lv_obj_set_flex_flow(scr, LV_FLEX_FLOW_ROW_WRAP);
+
+    uint32_t cnt = 2 + rnd(6);
+    uint32_t i;
+    for(i = 0; i < cnt; i++) {
+        lv_obj_t * btn = lv_button_create(scr);
+        lv_obj_t * label = lv_label_create(btn);
+        lv_label_set_text_fmt(label, "Button %u%*s", (unsigned)i, (int)rnd(16), "");
+
+        if(rnd(2)) lv_obj_set_style_bg_color(btn, lv_palette_main(rnd(LV_PALETTE_LAST)), 0);
+        if(rnd(3) == 0) lv_obj_add_event_cb(btn, click_event_cb, LV_EVENT_CLICKED, NULL);
+
+        lv_obj_t * slider = lv_slider_create(scr);
+        lv_obj_set_width(slider, 100);
+        lv_slider_set_value(slider, rnd(100), LV_ANIM_OFF);
+    }
+
+    lv_obj_t * list = lv_list_create(scr);
+    lv_obj_set_size(list, lv_pct(100), 120);
+    cnt = rnd(10);
+    for(i = 0; i < cnt; i++) {
+        lv_list_add_button(list, LV_SYMBOL_FILE, "Item");
+    }
+
+    return scr;
+}
+
+static void screen_replace(lv_obj_t * scr, lv_display_t * disp)
+{
+    lv_obj_t * old = lv_screen_active();
+    lv_screen_load(scr);
+    lv_obj_delete(old);
+    test_display_redraw(disp);
+}
+
+static void click_event_cb(lv_event_t * e)
+{
+    LV_UNUSED(e);
+}
+
+static void heap_sample(heap_stat_t * stat)
+{
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+
+    size_t used = mon.total_size - mon.free_size;
+    if(mon.free_biggest_size < stat->biggest_min) stat->biggest_min = mon.free_biggest_size;
+    if(used > stat->used_max) stat->used_max = used;
+    if(mon.frag_pct > stat->frag_max) stat->frag_max = mon.frag_pct;
+    stat->biggest_sum += mon.free_biggest_size;
+    stat->frag_sum += mon.frag_pct;
+}
+
+/*A fixed sequence, the same screens with and without the slab*/
+static uint32_t rnd(uint32_t max)
+{
+    rnd_state = rnd_state * 1103515245 + 12345;
+    return (rnd_state >> 16) % max;
+}
@@ -0,0 +1,198 @@
+/**
+ * @file bench_style_lookup.c
+ * Time of `lv_style_get_prop()` with the property index (LV_STYLE_PROP_INDEX) in styles of 4, 10 and 16
+ * properties. The same lookups are timed with a linear search of the property list (as without the index)
+ * and in constant styles.
+ *
+ * Before that a random sequence of setting, removing and resetting built-in and custom properties
+ * is checked against a reference table.
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "test_common.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+#define CUSTOM_CNT      4
+#define PROP_MAX        (LV_STYLE_NUM_BUILT_IN_PROPS + CUSTOM_CNT)
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void test_random_ops(void);
+static void bench_lookup(uint32_t prop_cnt, uint32_t round_cnt);
+static lv_style_res_t linear_get_prop(const lv_style_t * style, lv_style_prop_t prop, lv_style_value_t * value);
+static lv_style_prop_t rnd_prop(void);
+static uint32_t rnd(uint32_t max);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static lv_style_prop_t custom_props[CUSTOM_CNT];
+static uint32_t rnd_state = 7;
+static volatile uint32_t sink;
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+int main(int argc, char ** argv)
+{
+    test_init(argc, argv);
+
+    uint32_t i;
+    for(i = 0; i < CUSTOM_CNT; i++) {
+        custom_props[i] = lv_style_register_prop(LV_STYLE_PROP_FLAG_NONE);
+        TEST_ASSERT(custom_props[i] < PROP_MAX);
+    }
+
+    test_random_ops();
+
+    uint32_t round_cnt = test_quick() ? 200 : 20000;
+    printf("LV_STYLE_PROP_INDEX %d, ns per lookup of each built-in property (hits and misses)\n",
+           LV_STYLE_PROP_INDEX);
+    printf("%-16s %10s %10s %10s\n", "", "indexed", "linear", "constant");
+    bench_lookup(4, round_cnt);
+    bench_lookup(10, round_cnt);
+    bench_lookup(16, round_cnt);
+
+    return test_finish("bench_style_lookup");
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static void test_random_ops(void)
+{
+    static bool ref_set[PROP_MAX];
+    static int32_t ref_value[PROP_MAX];
+
+    lv_style_t style;
+    lv_style_init(&style);
+
+    uint32_t op_cnt = test_quick() ? 5000 : 100000;
+    uint32_t i;
+    for(i = 0; i < op_cnt; i++) {
+        uint32_t op = rnd(100);
+        lv_style_prop_t prop = rnd_prop();
+        if(op < 60) {
+            lv_style_value_t v = {.num = (int32_t)rnd(1000)};
+            lv_style_set_prop(&style, prop, v);
+            ref_set[prop] = true;
+            ref_value[prop] = v.num;
+        }
+        else if(op < 99) {
+            TEST_ASSERT_EQUAL(ref_set[prop], lv_style_remove_prop(&style, prop));
+            ref_set[prop] = false;
+        }
+        else {
+            lv_style_reset(&style);
+            lv_memzero(ref_set, sizeof(ref_set));
+        }
+
+        /*Check all properties from time to time, else only a few*/
+        lv_style_prop_t p;
+        for(p = 1; p < PROP_MAX; p++) {
+            if(i % 64 != 0 && p % 16 != i % 16) continue;
+
+            lv_style_value_t v;
+            lv_style_res_t res = lv_style_get_prop(&style, p, &v);
+            TEST_ASSERT_EQUAL(ref_set[p] ? LV_STYLE_RES_FOUND : LV_STYLE_RES_NOT_FOUND, res);
+            if(res == LV_STYLE_RES_FOUND) TEST_ASSERT_EQUAL(ref_value[p], v.num);
+        }
+    }
+
+    lv_style_reset(&style);
+}
+
+static void bench_lookup(uint32_t prop_cnt, uint32_t round_cnt)
+{
+    lv_style_t style;
+    lv_style_init(&style);
+
+    /*The same properties in a constant style too*/
+    lv_style_const_prop_t const_props[16 + 1];
+    uint32_t i;
+    for(i = 0; i < prop_cnt; i++) {
+        lv_style_prop_t prop;
+        lv_style_value_t v;
+        do {
+            prop = 1 + rnd(LV_STYLE_NUM_BUILT_IN_PROPS - 1);
+        } while(lv_style_get_prop(&style, prop, &v) == LV_STYLE_RES_FOUND);
+
+        v.num = (int32_t)i;
+        lv_style_set_prop(&style, prop, v);
+        const_props[i].prop = prop;
+        const_props[i].value = v;
+    }
+    const_props[prop_cnt].prop = LV_STYLE_PROP_INV;
+    LV_STYLE_CONST_INIT(const_style, const_props);
+
+    uint64_t ns[3] = {0};
+    uint32_t found_cnt[3] = {0};
+    uint32_t method;
+    for(method = 0; method < 3; method++) {
+        uint64_t start = test_time_ns();
+        uint32_t r;
+        for(r = 0; r < round_cnt; r++) {
+            lv_style_prop_t p;
+            for(p = 1; p < LV_STYLE_NUM_BUILT_IN_PROPS; p++) {
+                lv_style_value_t v;
+                lv_style_res_t res;
+                if(method == 0) res = lv_style_get_prop(&style, p, &v);
+                else if(method == 1) res = linear_get_prop(&style, p, &v);
+                else res = lv_style_get_prop(&const_style, p, &v);
+
+                if(res == LV_STYLE_RES_FOUND) found_cnt[method] += 1 + v.num;
+            }
+        }
+        ns[method] = test_time_ns() - start;
+    }
+
+    sink = found_cnt[0];
+
+    /*All methods find the same*/
+    TEST_ASSERT_EQUAL(found_cnt[0], found_cnt[1]);
+    TEST_ASSERT_EQUAL(found_cnt[0], found_cnt[2]);
+
+    uint32_t lookup_cnt = round_cnt * (LV_STYLE_NUM_BUILT_IN_PROPS - 1);
+    char name[32];
+    lv_snprintf(name, sizeof(name), "%u properties", (unsigned)prop_cnt);
+    printf("%-16s %10.2f %10.2f %10.2f\n", name, (double)ns[0] / lookup_cnt, (double)ns[1] / lookup_cnt,
+           (double)ns[2] / lookup_cnt);
+
+    lv_style_reset(&style);
+}
+
+/*The search without the index: compare each property of the list*/
+static lv_style_res_t linear_get_prop(const lv_style_t * style, lv_style_prop_t prop, lv_style_value_t * value)
+{
+    const lv_style_prop_t * props = (const lv_style_prop_t *)style->values_and_props +
+                                    style->prop_cnt * sizeof(lv_style_value_t);
+    uint32_t i;
+    for(i = 0; i < style->prop_cnt; i++) {
+        if(props[i] == prop) {
+            *value = ((const lv_style_value_t *)style->values_and_props)[i];
+            return LV_STYLE_RES_FOUND;
+        }
+    }
+
+    return LV_STYLE_RES_NOT_FOUND;
+}
+
+/*Mostly built-in properties, sometimes a custom one*/
+static lv_style_prop_t rnd_prop(void)
+{
+    if(rnd(8) == 0) return custom_props[rnd(CUSTOM_CNT)];
+    return 1 + rnd(LV_STYLE_NUM_BUILT_IN_PROPS - 1);
+}
+
+static uint32_t rnd(uint32_t max)
+{
+    rnd_state = rnd_state * 1103515245 + 12345;
+    return (rnd_state >> 16) % max;
+}
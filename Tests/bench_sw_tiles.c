@@ -0,0 +1,282 @@
+/**
+ * @file bench_sw_tiles.c
+ * Rendering time of scenes with large fill, border, image and layer draw tasks, built with
+ * 1, 2, 4 and 8 software draw units (`HOST_DRAW_THREADS`). With more than one unit these tasks
+ * are split into tiles which the idle units steal.
+ *
+ * The frames are the same for every unit count: the 1 unit build writes them with `--write <file>`,
+ * the others compare their frames bit by bit with `--compare <file>`.
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "test_common.h"
+#include "src/draw/sw/lv_draw_sw_private.h"
+#include <stdlib.h>
+#include <string.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+#define HOR_RES         1024
+#define VER_RES         600
+
+#define IMG_W           480
+#define IMG_H           320
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+typedef struct {
+    const char * name;
+    void (*create_cb)(lv_obj_t * scr);
+} scene_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+void __real_lv_draw_sw_fill(lv_draw_unit_t * u, lv_draw_fill_dsc_t * dsc, const lv_area_t * coords);
+void __wrap_lv_draw_sw_fill(lv_draw_unit_t * u, lv_draw_fill_dsc_t * dsc, const lv_area_t * coords);
+void __real_lv_draw_sw_border(lv_draw_unit_t * u, const lv_draw_border_dsc_t * dsc, const lv_area_t * coords);
+void __wrap_lv_draw_sw_border(lv_draw_unit_t * u, const lv_draw_border_dsc_t * dsc, const lv_area_t * coords);
+void __real_lv_draw_sw_image(lv_draw_unit_t * u, const lv_draw_image_dsc_t * dsc, const lv_area_t * coords);
+void __wrap_lv_draw_sw_image(lv_draw_unit_t * u, const lv_draw_image_dsc_t * dsc, const lv_area_t * coords);
+void __real_lv_draw_sw_layer(lv_draw_unit_t * u, const lv_draw_image_dsc_t * dsc, const lv_area_t * coords);
+void __wrap_lv_draw_sw_layer(lv_draw_unit_t * u, const lv_draw_image_dsc_t * dsc, const lv_area_t * coords);
+
+static void tile_count(lv_draw_unit_t * u);
+static void images_init(void);
+static void scene_fills(lv_obj_t * scr);
+static void scene_images(lv_obj_t * scr);
+static void scene_layer(lv_obj_t * scr);
+static void scene_widgets(lv_obj_t * scr);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static const scene_t scenes[] = {
+    {"fills", scene_fills},
+    {"images", scene_images},
+    {"layer", scene_layer},
+    {"widgets", scene_widgets},
+};
+
+static uint32_t tile_cnt;
+static lv_image_dsc_t img_rgb565;
+static lv_image_dsc_t img_argb8888;
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+int main(int argc, char ** argv)
+{
+    const char * write_path = NULL;
+    const char * compare_path = NULL;
+    int i;
+    for(i = 1; i + 1 < argc; i++) {
+        if(strcmp(argv[i], "--write") == 0) write_path = argv[i + 1];
+        if(strcmp(argv[i], "--compare") == 0) compare_path = argv[i + 1];
+    }
+
+    test_init(argc, argv);
+    images_init();
+
+    uint32_t frame_cnt = test_quick() ? 3 : 50;
+    size_t fb_size = HOR_RES * VER_RES * sizeof(uint16_t);
+
+    FILE * f = NULL;
+    if(write_path) f = fopen(write_path, "wb");
+    if(compare_path) f = fopen(compare_path, "rb");
+    TEST_ASSERT(f != NULL || (write_path == NULL && compare_path == NULL));
+    uint16_t * ref = malloc(fb_size);
+
+    lv_display_t * disp = test_display_create(HOR_RES, VER_RES);
+
+    printf("%d software draw unit(s), %u frames per scene\n", LV_DRAW_SW_DRAW_UNIT_CNT, (unsigned)frame_cnt);
+
+    uint64_t total_ns = 0;
+    uint32_t s;
+    for(s = 0; s < sizeof(scenes) / sizeof(scenes[0]); s++) {
+        lv_obj_t * scr = lv_obj_create(NULL);
+        scenes[s].create_cb(scr);
+        lv_screen_load(scr);
+        test_display_redraw(disp);
+
+        __atomic_store_n(&tile_cnt, 0, __ATOMIC_RELAXED);
+        uint64_t start = test_time_ns();
+        uint32_t j;
+        for(j = 0; j < frame_cnt; j++) {
+            test_display_redraw(disp);
+        }
+        uint64_t ns = test_time_ns() - start;
+        total_ns += ns;
+
+        printf("%-8s %8.3f ms/frame, %5u tiles/frame\n", scenes[s].name, ns / 1e6 / frame_cnt,
+               (unsigned)(__atomic_load_n(&tile_cnt, __ATOMIC_RELAXED) / frame_cnt));
+
+        /*Large tasks are split only with more units*/
+        if(LV_DRAW_SW_DRAW_UNIT_CNT == 1) TEST_ASSERT_EQUAL(0, tile_cnt);
+        else if(s != 3) TEST_ASSERT(tile_cnt > 0);
+
+        if(f && write_path) {
+            TEST_ASSERT_EQUAL(fb_size, fwrite(test_display_pixels(disp), 1, fb_size, f));
+        }
+        else if(f && compare_path) {
+            TEST_ASSERT_EQUAL(fb_size, fread(ref, 1, fb_size, f));
+            if(memcmp(ref, test_display_pixels(disp), fb_size)) {
+                printf("%s: the frame is different from the reference\n", scenes[s].name);
+                TEST_ASSERT(false);
+            }
+        }
+    }
+
+    printf("total    %8.3f ms/frame\n", total_ns / 1e6 / frame_cnt / (sizeof(scenes) / sizeof(scenes[0])));
+
+    if(f) fclose(f);
+    free(ref);
+
+    return test_finish("bench_sw_tiles");
+}
+
+/*The draw functions of the task types which can be split*/
+void __wrap_lv_draw_sw_fill(lv_draw_unit_t * u, lv_draw_fill_dsc_t * dsc, const lv_area_t * coords)
+{
+    tile_count(u);
+    __real_lv_draw_sw_fill(u, dsc, coords);
+}
+
+void __wrap_lv_draw_sw_border(lv_draw_unit_t * u, const lv_draw_border_dsc_t * dsc, const lv_area_t * coords)
+{
+    tile_count(u);
+    __real_lv_draw_sw_border(u, dsc, coords);
+}
+
+void __wrap_lv_draw_sw_image(lv_draw_unit_t * u, const lv_draw_image_dsc_t * dsc, const lv_area_t * coords)
+{
+    tile_count(u);
+    __real_lv_draw_sw_image(u, dsc, coords);
+}
+
+void __wrap_lv_draw_sw_layer(lv_draw_unit_t * u, const lv_draw_image_dsc_t * dsc, const lv_area_t * coords)
+{
+    tile_count(u);
+    __real_lv_draw_sw_layer(u, dsc, coords);
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static void tile_count(lv_draw_unit_t * u)
+{
+#if LV_DRAW_SW_TILE_SPLIT
+    /*Called from the render threads*/
+    if(((lv_draw_sw_unit_t *)u)->tile_busy) __atomic_fetch_add(&tile_cnt, 1, __ATOMIC_RELAXED);
+#else
+    LV_UNUSED(u);
+#endif
+}
+
+static void images_init(void)
+{
+    uint16_t * rgb565 = malloc(IMG_W * IMG_H * 2);
+    uint32_t * argb8888 = malloc(IMG_W * IMG_H * 4);
+
+    int32_t x, y;
+    for(y = 0; y < IMG_H; y++) {
+        for(x = 0; x < IMG_W; x++) {
+            rgb565[y * IMG_W + x] = (uint16_t)(((x >> 4) << 11) | ((y >> 3) << 5) | ((x + y) & 0x1F));
+            argb8888[y * IMG_W + x] = ((uint32_t)(x * 255 / IMG_W) << 24) | ((uint32_t)(y & 0xFF) << 16) |
+                                      ((uint32_t)(x & 0xFF) << 8) | 0x40;
+        }
+    }
+
+    img_rgb565.header.magic = LV_IMAGE_HEADER_MAGIC;
+    img_rgb565.header.cf = LV_COLOR_FORMAT_RGB565;
+    img_rgb565.header.w = IMG_W;
+    img_rgb565.header.h = IMG_H;
+    img_rgb565.header.stride = IMG_W * 2;
+    img_rgb565.data_size = IMG_W * IMG_H * 2;
+    img_rgb565.data = (const uint8_t *)rgb565;
+
+    img_argb8888 = img_rgb565;
+    img_argb8888.header.cf = LV_COLOR_FORMAT_ARGB8888;
+    img_argb8888.header.stride = IMG_W * 4;
+    img_argb8888.data_size = IMG_W * IMG_H * 4;
+    img_argb8888.data = (const uint8_t *)argb8888;
+}
+
+static void scene_fills(lv_obj_t * scr)
+{
+    lv_obj_set_style_bg_color(scr, lv_color_hex(0x204060), 0);
+    lv_obj_set_style_bg_grad_color(scr, lv_color_hex(0x80a0c0), 0);
+    lv_obj_set_style_bg_grad_dir(scr, LV_GRAD_DIR_VER, 0);
+
+    int32_t i;
+    for(i = 0; i < 6; i++) {
+        lv_obj_t * obj = lv_obj_create(scr);
+        lv_obj_remove_style_all(obj);
+        lv_obj_set_size(obj, 420, 260);
+        lv_obj_set_pos(obj, 40 + (i % 3) * 270, 30 + (i / 3) * 290);
+        lv_obj_set_style_radius(obj, 10 + i * 8, 0);
+        lv_obj_set_style_bg_color(obj, lv_palette_main(LV_PALETTE_RED + i * 2), 0);
+        lv_obj_set_style_bg_opa(obj, LV_OPA_50 + i * 30, 0);
+        lv_obj_set_style_border_width(obj, 6, 0);
+        lv_obj_set_style_border_color(obj, lv_color_white(), 0);
+        lv_obj_set_style_border_opa(obj, LV_OPA_70, 0);
+    }
+}
+
+static void scene_images(lv_obj_t * scr)
+{
+    lv_obj_t * img = lv_image_create(scr);
+    lv_image_set_src(img, &img_rgb565);
+    lv_obj_set_pos(img, 20, 20);
+
+    img = lv_image_create(scr);
+    lv_image_set_src(img, &img_rgb565);
+    lv_obj_set_pos(img, 520, 260);
+    lv_obj_set_style_image_opa(img, LV_OPA_70, 0);
+
+    img = lv_image_create(scr);
+    lv_image_set_src(img, &img_argb8888);
+    lv_obj_set_pos(img, 260, 140);
+}
+
+static void scene_layer(lv_obj_t * scr)
+{
+    lv_obj_t * cont = lv_obj_create(scr);
+    lv_obj_set_size(cont, 760, 480);
+    lv_obj_center(cont);
+    lv_obj_set_style_opa_layered(cont, LV_OPA_60, 0);
+    lv_obj_set_style_bg_color(cont, lv_palette_main(LV_PALETTE_TEAL), 0);
+
+    int32_t i;
+    for(i = 0; i < 8; i++) {
+        lv_obj_t * label = lv_label_create(cont);
+        lv_label_set_text_fmt(label, "Layered label %d", (int)i);
+        lv_obj_set_pos(label, 20 + (i % 2) * 360, 20 + (i / 2) * 100);
+    }
+}
+
+static void scene_widgets(lv_obj_t * scr)
+{
+    int32_t i;
+    for(i = 0; i < 24; i++) {
+        lv_obj_t * btn = lv_button_create(scr);
+        lv_obj_set_size(btn, 150, 60);
+        lv_obj_set_pos(btn, 20 + (i % 6) * 165, 20 + (i / 6) * 145);
+
+        lv_obj_t * label = lv_label_create(btn);
+        lv_label_set_text_fmt(label, "Button %d", (int)i);
+        lv_obj_center(label);
+
+        lv_obj_t * slider = lv_slider_create(scr);
+        lv_obj_set_size(slider, 140, 10);
+        lv_obj_set_pos(slider, 25 + (i % 6) * 165, 100 + (i / 6) * 145);
+        lv_slider_set_value(slider, (i * 17) % 100, LV_ANIM_OFF);
+    }
+}
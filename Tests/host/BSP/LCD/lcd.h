@@ -0,0 +1,45 @@
+/**
+ * @file lcd.h
+ * Host stand-in of the LCD driver: the functions used by `lv_port_disp.c`, see `lcd_host.c`.
+ */
+
+#ifndef LCD_HOST_H
+#define LCD_HOST_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "./BSP/LCD/ltdc.h"
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Initialize the panel. The host has the 1024x600 RGB panel of the board.
+ */
+void lcd_init(void);
+
+/**
+ * Set the orientation
+ * @param dir   0: portrait, 1: landscape
+ */
+void lcd_display_dir(uint8_t dir);
+
+/**
+ * Copy pixels to an area of the panel and wait until it's done
+ * @param sx,sy     start coordinates
+ * @param ex,ey     end coordinates (inclusive)
+ * @param color     the RGB565 pixels of the area
+ */
+void lcd_color_fill(uint16_t sx, uint16_t sy, uint16_t ex, uint16_t ey, uint16_t * color);
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LCD_HOST_H*/
@@ -0,0 +1,85 @@
+/**
+ * @file ltdc.h
+ * Host stand-in of the LTDC driver. The framebuffers are in host memory and
+ * the transfers go through the real DMA2D driver (`Drivers/BSP/DMA2D`) to the register model.
+ */
+
+#ifndef LTDC_HOST_H
+#define LTDC_HOST_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "./SYSTEM/sys/sys.h"
+#include "./BSP/DMA2D/dma2d.h"
+#include <stdbool.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+#define LTDC_PIXFORMAT_RGB565           0X02
+#define LTDC_PIXFORMAT                  LTDC_PIXFORMAT_RGB565
+
+/*The framebuffers are allocated on the host, but keep the board's address range for the checks of lv_port_disp.c*/
+#define LTDC_FRAME_BUF_ADDR             0XC0000000
+#define LTDC_FRAME_BUF_SIZE             (1280 * 800 * 2)
+#define LTDC_FRAME_BUF_END              (LTDC_FRAME_BUF_ADDR + 2 * LTDC_FRAME_BUF_SIZE)
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+typedef struct {
+    uint32_t pwidth;        /**< Width of the panel, 0: no RGB panel*/
+    uint32_t pheight;       /**< Height of the panel*/
+    uint8_t activelayer;    /**< The layer drawn by the driver: 0/1*/
+    uint8_t dir;            /**< 0: portrait, 1: landscape*/
+    uint16_t width;         /**< Width in the current orientation*/
+    uint16_t height;        /**< Height in the current orientation*/
+    uint32_t pixsize;       /**< Bytes per pixel*/
+} _ltdc_dev;
+
+typedef dma2d_done_cb_t ltdc_dma2d_cb_t;
+typedef void (*ltdc_reload_cb_t)(void);
+
+/**
+ * Called at the vertical blanking with the framebuffer which is shown:
+ * before and, if the framebuffers are swapped, after the swap
+ */
+typedef void (*ltdc_host_vblank_cb_t)(const uint16_t * shown);
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+extern _ltdc_dev lcdltdc;
+extern uint32_t * g_ltdc_framebuf[2];
+
+uint8_t ltdc_color_fill(uint16_t sx, uint16_t sy, uint16_t ex, uint16_t ey, uint16_t * color);
+uint8_t ltdc_color_fill_async(uint16_t sx, uint16_t sy, uint16_t ex, uint16_t ey, uint16_t * color,
+                              ltdc_dma2d_cb_t done_cb);
+uint8_t ltdc_dma2d_wait(void);
+void ltdc_framebuf_swap(uint8_t bufx, ltdc_reload_cb_t done_cb);
+
+/**
+ * Start the vertical blanking interrupts, which make `ltdc_framebuf_swap()` take effect
+ * @param period_us     frame period in microseconds, 0: stop
+ * @param cb            called at each blanking, can be NULL
+ */
+void ltdc_host_set_vblank(uint32_t period_us, ltdc_host_vblank_cb_t cb);
+
+/**
+ * Get the framebuffer shown on the panel
+ * @return      pointer to `g_ltdc_framebuf[0]` or `g_ltdc_framebuf[1]`
+ */
+uint16_t * ltdc_host_front_buf(void);
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LTDC_HOST_H*/
@@ -0,0 +1,15 @@
+/**
+ * @file sys.h
+ * Host stand-in of the board's system header: the device header and the HAL definitions used by the BSP drivers.
+ */
+
+#ifndef SYS_HOST_H
+#define SYS_HOST_H
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "stm32f4xx.h"
+#include "stm32f4xx_hal.h"
+
+#endif /*SYS_HOST_H*/
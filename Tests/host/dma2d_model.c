@@ -0,0 +1,471 @@
+/**
+ * @file dma2d_model.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "dma2d_model.h"
+#include <assert.h>
+#include <stddef.h>
+#include <string.h>
+#include <signal.h>
+#include <time.h>
+#include <sys/time.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+#define MODE_M2M            0x0UL
+#define MODE_M2M_PFC        0x1UL
+#define MODE_M2M_BLEND      0x2UL
+#define MODE_R2M            0x3UL
+
+#define CM_ARGB8888         0x0UL
+#define CM_RGB888           0x1UL
+#define CM_RGB565           0x2UL
+#define CM_ARGB1555         0x3UL
+#define CM_ARGB4444         0x4UL
+#define CM_A8               0x9UL
+
+#define AM_NONE             0x0UL
+#define AM_REPLACE          0x1UL
+#define AM_MULTIPLY         0x2UL
+
+/*Each handle of `dma2d_model_addr` addresses 16 MB*/
+#define ADDR_SLOT_SHIFT     24
+#define ADDR_SLOT_CNT       256
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+typedef struct {
+    uint8_t a;
+    uint8_t r;
+    uint8_t g;
+    uint8_t b;
+} argb_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void run_transfer(void);
+
+static uint64_t transfer_ns(void);
+
+static uint64_t now_ns(void);
+
+static void alarm_handler(int sig);
+
+static bool cm_supported(uint32_t cm, bool output);
+
+static uint32_t cm_px_size(uint32_t cm);
+
+static argb_t read_px(const uint8_t * p, uint32_t pfccr, uint32_t colr);
+
+static void write_px(uint8_t * p, uint32_t cm, argb_t c);
+
+static argb_t blend(argb_t fg, argb_t bg);
+
+static uint8_t * mem(uint32_t addr);
+
+static void call_irq_handler(void);
+
+/**********************
+ *  GLOBAL VARIABLES
+ **********************/
+DMA2D_TypeDef dma2d_model;
+
+/*The application can leave the interrupt handler undefined*/
+#pragma weak DMA2D_IRQHandler
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static uintptr_t addr_slots[ADDR_SLOT_CNT];
+static uint32_t addr_slot_cnt;
+static volatile bool in_sync;
+static dma2d_model_stat_t stat;
+static uint32_t speed_px_per_us;
+static bool running;
+static uint64_t finish_ns;
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void dma2d_model_sync(void)
+{
+    /*The interrupt handler accesses the registers too*/
+    if(in_sync) return;
+    in_sync = true;
+
+    DMA2D_TypeDef * d = &dma2d_model;
+
+    d->ISR &= ~d->IFCR;
+    d->IFCR = 0;
+
+    if(d->CR & DMA2D_CR_ABORT) {
+        if(d->CR & DMA2D_CR_START) stat.abort_cnt++;
+        d->CR &= ~(DMA2D_CR_START | DMA2D_CR_ABORT);
+        running = false;
+    }
+
+    if(d->CR & DMA2D_CR_START) {
+        if(!running) {
+            running = true;
+            finish_ns = now_ns() + transfer_ns();
+        }
+
+        if(now_ns() >= finish_ns) {
+            run_transfer();
+            d->CR &= ~DMA2D_CR_START;
+            running = false;
+        }
+    }
+
+    call_irq_handler();
+
+    in_sync = false;
+}
+
+uint32_t dma2d_model_addr(const void * p)
+{
+    uintptr_t a = (uintptr_t)p;
+    uintptr_t hi = a >> ADDR_SLOT_SHIFT;
+    uint32_t lo = a & ((1UL << ADDR_SLOT_SHIFT) - 1);
+
+    /*Only the first slot of the pairs, so a buffer can always continue in the next slot*/
+    uint32_t i;
+    for(i = 0; i < addr_slot_cnt; i += 2) {
+        if(addr_slots[i] == hi) return (i << ADDR_SLOT_SHIFT) | lo;
+    }
+
+    /*Map the next 16 MB too, so a buffer can cross the boundary*/
+    assert(addr_slot_cnt + 2 <= ADDR_SLOT_CNT);
+    addr_slots[addr_slot_cnt] = hi;
+    addr_slots[addr_slot_cnt + 1] = hi + 1;
+    addr_slot_cnt += 2;
+
+    return ((addr_slot_cnt - 2) << ADDR_SLOT_SHIFT) | lo;
+}
+
+void dma2d_model_get_stat(dma2d_model_stat_t * s)
+{
+    *s = stat;
+}
+
+void dma2d_model_reset_stat(void)
+{
+    memset(&stat, 0, sizeof(stat));
+}
+
+void dma2d_model_set_speed(uint32_t px_per_us)
+{
+    speed_px_per_us = px_per_us;
+}
+
+void dma2d_model_set_async(uint32_t period_us)
+{
+    struct itimerval t;
+    memset(&t, 0, sizeof(t));
+    t.it_interval.tv_usec = period_us;
+    t.it_value.tv_usec = period_us;
+
+    if(period_us) {
+        struct sigaction sa;
+        memset(&sa, 0, sizeof(sa));
+        sa.sa_handler = alarm_handler;
+        sa.sa_flags = SA_RESTART;
+        sigemptyset(&sa.sa_mask);
+        sigaction(SIGALRM, &sa, NULL);
+    }
+
+    /*A zero period stops the timer*/
+    setitimer(ITIMER_REAL, &t, NULL);
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static void run_transfer(void)
+{
+    DMA2D_TypeDef * d = &dma2d_model;
+
+    uint32_t mode = (d->CR & DMA2D_CR_MODE) >> 16;
+    uint32_t w = (d->NLR >> 16) & 0x3FFF;
+    uint32_t h = d->NLR & 0xFFFF;
+    uint32_t fg_cm = d->FGPFCCR & 0xF;
+    uint32_t bg_cm = d->BGPFCCR & 0xF;
+    uint32_t out_cm = d->OPFCCR & 0x7;
+
+    bool valid = cm_supported(out_cm, true);
+    if(mode != MODE_R2M) valid = valid && cm_supported(fg_cm, false);
+    if(mode == MODE_M2M_BLEND) valid = valid && cm_supported(bg_cm, false);
+    /*Memory to memory mode copies the pixels without conversion*/
+    if(mode == MODE_M2M) valid = valid && fg_cm == out_cm;
+
+    if(!valid) {
+        d->ISR |= DMA2D_ISR_CEIF;
+        stat.error_cnt++;
+        return;
+    }
+
+    uint32_t out_px_size = cm_px_size(out_cm);
+    uint32_t fg_px_size = cm_px_size(fg_cm);
+    uint32_t bg_px_size = cm_px_size(bg_cm);
+
+    uint32_t y;
+    for(y = 0; y < h; y++) {
+        uint8_t * out = mem(d->OMAR + (y * (w + (d->OOR & 0x3FFF))) * out_px_size);
+        const uint8_t * fg = NULL;
+        const uint8_t * bg = NULL;
+        if(mode != MODE_R2M) fg = mem(d->FGMAR + (y * (w + (d->FGOR & 0x3FFF))) * fg_px_size);
+        if(mode == MODE_M2M_BLEND) bg = mem(d->BGMAR + (y * (w + (d->BGOR & 0x3FFF))) * bg_px_size);
+
+        uint32_t x;
+        for(x = 0; x < w; x++) {
+            switch(mode) {
+                case MODE_R2M:
+                    /*OCOLR is already in the output format*/
+                    memcpy(out, (const void *)&d->OCOLR, out_px_size);
+                    break;
+                case MODE_M2M:
+                    memcpy(out, fg, out_px_size);
+                    break;
+                case MODE_M2M_PFC:
+                    write_px(out, out_cm, read_px(fg, d->FGPFCCR, d->FGCOLR));
+                    break;
+                default:
+                    write_px(out, out_cm, blend(read_px(fg, d->FGPFCCR, d->FGCOLR), read_px(bg, d->BGPFCCR, d->BGCOLR)));
+                    break;
+            }
+
+            out += out_px_size;
+            if(fg) fg += fg_px_size;
+            if(bg) bg += bg_px_size;
+        }
+    }
+
+    d->ISR |= DMA2D_ISR_TCIF;
+    stat.transfer_cnt++;
+    stat.px_cnt += (uint64_t)w * h;
+}
+
+/**
+ * The time a transfer takes with the configured speed. The configuration is read when it starts.
+ */
+static uint64_t transfer_ns(void)
+{
+    if(speed_px_per_us == 0) return 0;
+
+    DMA2D_TypeDef * d = &dma2d_model;
+    uint64_t px = (uint64_t)((d->NLR >> 16) & 0x3FFF) * (d->NLR & 0xFFFF);
+    return px * 1000 / speed_px_per_us;
+}
+
+static uint64_t now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+/**
+ * The timer plays the role of the bus clock: it finishes the transfers and raises the interrupt
+ * while the application does something else
+ */
+static void alarm_handler(int sig)
+{
+    (void)sig;
+    dma2d_model_sync();
+}
+
+/**
+ * The color lookup table formats (L8, AL44, AL88, L4) and A4 are not modelled
+ */
+static bool cm_supported(uint32_t cm, bool output)
+{
+    switch(cm) {
+        case CM_ARGB8888:
+        case CM_RGB888:
+        case CM_RGB565:
+        case CM_ARGB1555:
+        case CM_ARGB4444:
+            return true;
+        case CM_A8:
+            return !output;
+        default:
+            return false;
+    }
+}
+
+static uint32_t cm_px_size(uint32_t cm)
+{
+    switch(cm) {
+        case CM_ARGB8888:
+            return 4;
+        case CM_RGB888:
+            return 3;
+        case CM_RGB565:
+        case CM_ARGB1555:
+        case CM_ARGB4444:
+            return 2;
+        default:
+            return 1;
+    }
+}
+
+/**
+ * Read a pixel and convert it to ARGB8888 like the pixel format converter:
+ * the missing low bits are filled with the high bits, then the alpha mode is applied.
+ */
+static argb_t read_px(const uint8_t * p, uint32_t pfccr, uint32_t colr)
+{
+    argb_t c;
+    uint32_t v;
+
+    switch(pfccr & 0xF) {
+        case CM_ARGB8888:
+            c.b = p[0];
+            c.g = p[1];
+            c.r = p[2];
+            c.a = p[3];
+            break;
+        case CM_RGB888:
+            c.b = p[0];
+            c.g = p[1];
+            c.r = p[2];
+            c.a = 0xFF;
+            break;
+        case CM_RGB565:
+            v = p[0] | (p[1] << 8);
+            c.r = ((v >> 11) << 3) | (v >> 13);
+            c.g = (((v >> 5) & 0x3F) << 2) | ((v >> 9) & 0x3);
+            c.b = ((v & 0x1F) << 3) | ((v >> 2) & 0x7);
+            c.a = 0xFF;
+            break;
+        case CM_ARGB1555:
+            v = p[0] | (p[1] << 8);
+            c.r = (((v >> 10) & 0x1F) << 3) | ((v >> 12) & 0x7);
+            c.g = (((v >> 5) & 0x1F) << 3) | ((v >> 7) & 0x7);
+            c.b = ((v & 0x1F) << 3) | ((v >> 2) & 0x7);
+            c.a = (v & 0x8000) ? 0xFF : 0;
+            break;
+        case CM_ARGB4444:
+            v = p[0] | (p[1] << 8);
+            c.r = ((v >> 8) & 0xF) * 0x11;
+            c.g = ((v >> 4) & 0xF) * 0x11;
+            c.b = (v & 0xF) * 0x11;
+            c.a = (v >> 12) * 0x11;
+            break;
+        default:
+            /*A8: the color comes from the color register*/
+            c.r = (colr >> 16) & 0xFF;
+            c.g = (colr >> 8) & 0xFF;
+            c.b = colr & 0xFF;
+            c.a = p[0];
+            break;
+    }
+
+    uint32_t alpha = pfccr >> 24;
+    switch((pfccr >> 16) & 0x3) {
+        case AM_REPLACE:
+            c.a = alpha;
+            break;
+        case AM_MULTIPLY:
+            c.a = (c.a * alpha) / 255;
+            break;
+        default:
+            break;
+    }
+
+    return c;
+}
+
+/**
+ * Convert an ARGB8888 color to the output format. The low bits are truncated.
+ */
+static void write_px(uint8_t * p, uint32_t cm, argb_t c)
+{
+    uint32_t v;
+
+    switch(cm) {
+        case CM_ARGB8888:
+            p[0] = c.b;
+            p[1] = c.g;
+            p[2] = c.r;
+            p[3] = c.a;
+            break;
+        case CM_RGB888:
+            p[0] = c.b;
+            p[1] = c.g;
+            p[2] = c.r;
+            break;
+        case CM_RGB565:
+            v = ((c.r >> 3) << 11) | ((c.g >> 2) << 5) | (c.b >> 3);
+            p[0] = v & 0xFF;
+            p[1] = v >> 8;
+            break;
+        case CM_ARGB1555:
+            v = ((c.a >> 7) << 15) | ((c.r >> 3) << 10) | ((c.g >> 3) << 5) | (c.b >> 3);
+            p[0] = v & 0xFF;
+            p[1] = v >> 8;
+            break;
+        default:
+            v = ((c.a >> 4) << 12) | ((c.r >> 4) << 8) | ((c.g >> 4) << 4) | (c.b >> 4);
+            p[0] = v & 0xFF;
+            p[1] = v >> 8;
+            break;
+    }
+}
+
+/**
+ * The blender of RM0090:
+ * a_mult = a_fg * a_bg / 255, a_out = a_fg + a_bg - a_mult,
+ * c_out = (c_fg * a_fg + c_bg * a_bg - c_bg * a_mult) / a_out
+ */
+static argb_t blend(argb_t fg, argb_t bg)
+{
+    uint32_t a_mult = (fg.a * bg.a) / 255;
+    uint32_t a_out = fg.a + bg.a - a_mult;
+
+    argb_t c;
+    c.a = a_out;
+    if(a_out == 0) {
+        c.r = 0;
+        c.g = 0;
+        c.b = 0;
+        return c;
+    }
+
+    c.r = (fg.r * fg.a + bg.r * bg.a - bg.r * a_mult) / a_out;
+    c.g = (fg.g * fg.a + bg.g * bg.a - bg.g * a_mult) / a_out;
+    c.b = (fg.b * fg.a + bg.b * bg.a - bg.b * a_mult) / a_out;
+    return c;
+}
+
+static uint8_t * mem(uint32_t addr)
+{
+    uintptr_t hi = addr_slots[addr >> ADDR_SLOT_SHIFT];
+    return (uint8_t *)((hi << ADDR_SLOT_SHIFT) | (addr & ((1UL << ADDR_SLOT_SHIFT) - 1)));
+}
+
+static void call_irq_handler(void)
+{
+    DMA2D_TypeDef * d = &dma2d_model;
+
+    /*The interrupt enable bits are at the positions of the flags + 8*/
+    uint32_t pending = d->ISR & (d->CR >> 8) & 0x3F;
+    if(pending == 0 || DMA2D_IRQHandler == NULL) return;
+
+    stat.irq_cnt++;
+    DMA2D_IRQHandler();
+
+    /*The handler cleared the flags*/
+    d->ISR &= ~d->IFCR;
+    d->IFCR = 0;
+}
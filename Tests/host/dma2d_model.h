@@ -0,0 +1,93 @@
+/**
+ * @file dma2d_model.h
+ * Register level model of the DMA2D (Chrom-ART) of the STM32F429.
+ *
+ * A transfer is started by setting `CR.START`, then it runs on the next access of the registers:
+ * the pixels are converted and blended as described in RM0090, `CR.START` is cleared and
+ * `ISR.TCIF` is set. A configuration which is not modelled sets `ISR.CEIF` instead.
+ * If the interrupt of a flag is enabled `DMA2D_IRQHandler` is called.
+ *
+ * With `dma2d_model_set_speed()` a transfer finishes only on the first access after its duration,
+ * and with `dma2d_model_set_async()` a timer signal accesses the registers periodically,
+ * so the transfers finish and the interrupt handler runs asynchronously to the application.
+ */
+
+#ifndef DMA2D_MODEL_H
+#define DMA2D_MODEL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "stm32f4xx.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+typedef struct {
+    uint32_t transfer_cnt;  /**< Number of finished transfers*/
+    uint32_t error_cnt;     /**< Number of transfers which failed with a configuration error*/
+    uint32_t abort_cnt;     /**< Number of aborted transfers*/
+    uint32_t irq_cnt;       /**< Number of `DMA2D_IRQHandler` calls*/
+    uint64_t px_cnt;        /**< Number of written pixels*/
+} dma2d_model_stat_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+extern DMA2D_TypeDef dma2d_model;
+
+/**
+ * Let the model run: apply the cleared flags, start or finish a transfer and call the interrupt handler.
+ * It's called by every access of the registers through `DMA2D`.
+ */
+void dma2d_model_sync(void);
+
+/**
+ * Get the 32 bit address of a host pointer which can be written to the address registers
+ * @param p     pointer to a buffer
+ * @return      the address of `p` as seen by the model
+ */
+uint32_t dma2d_model_addr(const void * p);
+
+/**
+ * Get the statistics of the transfers
+ * @param stat  store the statistics here
+ */
+void dma2d_model_get_stat(dma2d_model_stat_t * stat);
+
+/**
+ * Clear the statistics of the transfers
+ */
+void dma2d_model_reset_stat(void);
+
+/**
+ * Set how fast the transfers are. The pixels are written at once when the duration has elapsed.
+ * @param px_per_us     written pixels per microsecond, 0: finish on the next access (default)
+ */
+void dma2d_model_set_speed(uint32_t px_per_us);
+
+/**
+ * Let the model run periodically from a `SIGALRM` timer, like the real DMA2D runs independently of the CPU.
+ * `DMA2D_IRQHandler` is called from the signal handler then.
+ * @param period_us     period of the timer in microseconds (less than 1 s), 0: stop the timer
+ */
+void dma2d_model_set_async(uint32_t period_us);
+
+/**
+ * The interrupt handler of the application. The model calls it if the application defines it.
+ */
+void DMA2D_IRQHandler(void);
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*DMA2D_MODEL_H*/
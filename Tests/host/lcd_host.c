@@ -0,0 +1,198 @@
+/**
+ * @file lcd_host.c
+ * Host stand-in of the LCD and LTDC drivers of the board.
+ * The coordinates are converted as in `ltdc.c`, the copies go through the DMA2D driver.
+ * The vertical blanking comes from a timer signal, see `ltdc_host_set_vblank()`.
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "./BSP/LCD/lcd.h"
+#include <string.h>
+#include <signal.h>
+#include <time.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+#define PANEL_WIDTH     1024
+#define PANEL_HEIGHT    600
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void color_xfer(uint16_t sx, uint16_t sy, uint16_t ex, uint16_t ey, uint16_t * color, dma2d_xfer_t * xfer);
+
+static uint16_t * draw_framebuf(void);
+
+static void vblank_handler(int sig);
+
+/**********************
+ *  GLOBAL VARIABLES
+ **********************/
+_ltdc_dev lcdltdc;
+uint32_t * g_ltdc_framebuf[2];
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+/*The SDRAM framebuffers of the board*/
+static uint16_t framebuf[2][LTDC_FRAME_BUF_SIZE / 2];
+static volatile uint8_t front_buf;
+static volatile uint8_t back_buf;
+
+static volatile bool swap_pending;
+static volatile uint8_t swap_buf;
+static volatile ltdc_reload_cb_t reload_cb;
+static ltdc_host_vblank_cb_t vblank_cb;
+static timer_t vblank_timer;
+static bool vblank_timer_created;
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lcd_init(void)
+{
+    memset(framebuf, 0, sizeof(framebuf));
+    g_ltdc_framebuf[0] = (uint32_t *)framebuf[0];
+    g_ltdc_framebuf[1] = (uint32_t *)framebuf[1];
+    front_buf = 0;
+    back_buf = 0;
+
+    lcdltdc.pwidth = PANEL_WIDTH;
+    lcdltdc.pheight = PANEL_HEIGHT;
+    lcdltdc.activelayer = 0;
+    lcdltdc.pixsize = 2;
+    lcd_display_dir(0);
+}
+
+void lcd_display_dir(uint8_t dir)
+{
+    lcdltdc.dir = dir;
+    lcdltdc.width = dir ? lcdltdc.pwidth : lcdltdc.pheight;
+    lcdltdc.height = dir ? lcdltdc.pheight : lcdltdc.pwidth;
+}
+
+void lcd_color_fill(uint16_t sx, uint16_t sy, uint16_t ex, uint16_t ey, uint16_t * color)
+{
+    ltdc_color_fill(sx, sy, ex, ey, color);
+}
+
+uint8_t ltdc_color_fill(uint16_t sx, uint16_t sy, uint16_t ex, uint16_t ey, uint16_t * color)
+{
+    dma2d_xfer_t xfer = {0};
+    color_xfer(sx, sy, ex, ey, color, &xfer);
+    return dma2d_transfer(&xfer);
+}
+
+uint8_t ltdc_color_fill_async(uint16_t sx, uint16_t sy, uint16_t ex, uint16_t ey, uint16_t * color,
+                              ltdc_dma2d_cb_t done_cb)
+{
+    dma2d_xfer_t xfer = {0};
+    color_xfer(sx, sy, ex, ey, color, &xfer);
+    return dma2d_transfer_async(&xfer, done_cb);
+}
+
+uint8_t ltdc_dma2d_wait(void)
+{
+    return dma2d_wait();
+}
+
+void ltdc_framebuf_swap(uint8_t bufx, ltdc_reload_cb_t done_cb)
+{
+    /*Like `HAL_LTDC_Reload(LTDC_RELOAD_VERTICAL_BLANKING)`: the address is used from the next blanking*/
+    reload_cb = done_cb;
+    swap_buf = bufx;
+    swap_pending = true;
+}
+
+void ltdc_host_set_vblank(uint32_t period_us, ltdc_host_vblank_cb_t cb)
+{
+    vblank_cb = cb;
+
+    if(!vblank_timer_created) {
+        struct sigaction sa;
+        memset(&sa, 0, sizeof(sa));
+        sa.sa_handler = vblank_handler;
+        sa.sa_flags = SA_RESTART;
+        sigemptyset(&sa.sa_mask);
+        sigaction(SIGUSR1, &sa, NULL);
+
+        struct sigevent sev;
+        memset(&sev, 0, sizeof(sev));
+        sev.sigev_notify = SIGEV_SIGNAL;
+        sev.sigev_signo = SIGUSR1;
+        timer_create(CLOCK_MONOTONIC, &sev, &vblank_timer);
+        vblank_timer_created = true;
+    }
+
+    /*A zero period stops the timer*/
+    struct itimerspec t;
+    memset(&t, 0, sizeof(t));
+    t.it_interval.tv_sec = period_us / 1000000;
+    t.it_interval.tv_nsec = (period_us % 1000000) * 1000;
+    t.it_value = t.it_interval;
+    timer_settime(vblank_timer, 0, &t, NULL);
+}
+
+uint16_t * ltdc_host_front_buf(void)
+{
+    return framebuf[front_buf];
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static void color_xfer(uint16_t sx, uint16_t sy, uint16_t ex, uint16_t ey, uint16_t * color, dma2d_xfer_t * xfer)
+{
+    uint32_t psx, psy, pex, pey;
+
+    /*The panel's coordinates don't change with the orientation*/
+    if(lcdltdc.dir) {
+        psx = sx;
+        psy = sy;
+        pex = ex;
+        pey = ey;
+    }
+    else {
+        psx = sy;
+        psy = lcdltdc.pheight - ex - 1;
+        pex = ey;
+        pey = lcdltdc.pheight - sx - 1;
+    }
+
+    xfer->mode = DMA2D_M2M;
+    xfer->pixformat = LTDC_PIXFORMAT;
+    xfer->src = color;
+    xfer->dst = draw_framebuf() + lcdltdc.pwidth * psy + psx;
+    xfer->width = pex - psx + 1;
+    xfer->height = pey - psy + 1;
+    xfer->src_offline = 0;
+    xfer->dst_offline = lcdltdc.pwidth - (pex - psx + 1);
+}
+
+/*The vertical blanking: apply the new address like the LTDC reload interrupt does*/
+static void vblank_handler(int sig)
+{
+    (void)sig;
+
+    if(vblank_cb) vblank_cb(framebuf[front_buf]);
+    if(!swap_pending) return;
+
+    front_buf = swap_buf;
+    back_buf = swap_buf ^ 1;
+    swap_pending = false;
+    if(vblank_cb) vblank_cb(framebuf[front_buf]);
+
+    ltdc_reload_cb_t cb = reload_cb;
+    reload_cb = NULL;
+    if(cb) cb();
+}
+
+static uint16_t * draw_framebuf(void)
+{
+    return framebuf[lcdltdc.activelayer == 0 ? back_buf : lcdltdc.activelayer];
+}
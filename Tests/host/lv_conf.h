@@ -0,0 +1,69 @@
+/**
+ * @file lv_conf.h
+ * Configuration of the host tests: the board's `lv_conf.h` with the settings
+ * which need the STM32F429 replaced. Everything else is tested as it's shipped.
+ * DMA2D is used through the register model of `stm32f4xx.h`.
+ */
+
+#ifndef LV_CONF_HOST_H
+#define LV_CONF_HOST_H
+
+#include "../../Middlewares/LVGL/lv_conf.h"
+
+/*There is no SDRAM at 0xC0000000, allocate the bulk pool as a normal array*/
+#undef LV_MEM_BULK_ADR
+#define LV_MEM_BULK_ADR 0
+
+/*Report the problems instead of halting*/
+#undef LV_USE_LOG
+#define LV_USE_LOG 1
+#undef LV_LOG_LEVEL
+#define LV_LOG_LEVEL LV_LOG_LEVEL_WARN
+#undef LV_LOG_PRINTF
+#define LV_LOG_PRINTF 1
+
+/*A font with a large sparse character map for the font lookup benchmark*/
+#undef LV_FONT_SIMSUN_16_CJK
+#define LV_FONT_SIMSUN_16_CJK 1
+
+/*HOST_DRAW_THREADS=<n>: render with n software draw units, each on its own pthread.
+ *Only the software units are measured then, DMA2D would take the fills and images.*/
+#ifdef HOST_DRAW_THREADS
+#undef LV_USE_OS
+#define LV_USE_OS LV_OS_PTHREAD
+#undef LV_DRAW_SW_DRAW_UNIT_CNT
+#define LV_DRAW_SW_DRAW_UNIT_CNT HOST_DRAW_THREADS
+#undef LV_USE_DRAW_DMA2D
+#define LV_USE_DRAW_DMA2D 0
+#endif
+
+/*HOST_OBJ_SLAB=<0/1>: build with or without the object slab*/
+#ifdef HOST_OBJ_SLAB
+#undef LV_USE_OBJ_SLAB
+#define LV_USE_OBJ_SLAB HOST_OBJ_SLAB
+#endif
+
+/*HOST_DRAW_SW_ASM=<LV_DRAW_SW_ASM_...>: blend with another backend than the board's LV_DRAW_SW_ASM_SWAR*/
+#ifdef HOST_DRAW_SW_ASM
+#undef LV_USE_DRAW_SW_ASM
+#define LV_USE_DRAW_SW_ASM HOST_DRAW_SW_ASM
+#endif
+
+/*HOST_MEM_SMALL_BLOCK_PAGE_SIZE=<bytes>: another page size of the small allocation size classes, 0: TLSF only*/
+#ifdef HOST_MEM_SMALL_BLOCK_PAGE_SIZE
+#undef LV_MEM_SMALL_BLOCK_PAGE_SIZE
+#define LV_MEM_SMALL_BLOCK_PAGE_SIZE HOST_MEM_SMALL_BLOCK_PAGE_SIZE
+#endif
+
+/*HOST_DRAW_BUF_POOL_SIZE=<bytes>: another budget of the draw buffer pool, 0: allocate the buffers in every frame*/
+#ifdef HOST_DRAW_BUF_POOL_SIZE
+#undef LV_DRAW_BUF_POOL_SIZE
+#define LV_DRAW_BUF_POOL_SIZE HOST_DRAW_BUF_POOL_SIZE
+#endif
+
+#undef LV_ASSERT_HANDLER_INCLUDE
+#define LV_ASSERT_HANDLER_INCLUDE <stdlib.h>
+#undef LV_ASSERT_HANDLER
+#define LV_ASSERT_HANDLER abort();
+
+#endif /*LV_CONF_HOST_H*/
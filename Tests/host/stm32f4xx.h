@@ -0,0 +1,95 @@
+/**
+ * @file stm32f4xx.h
+ * Host stand-in of the device header: only the DMA2D registers, backed by `dma2d_model.c`.
+ * The layout and the bits are the same as in the CMSIS header of the STM32F429.
+ */
+
+#ifndef STM32F4XX_HOST_H
+#define STM32F4XX_HOST_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include <stdint.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+#define __IO    volatile
+
+#define DMA2D_CR_START          (0x1UL << 0)
+#define DMA2D_CR_SUSP           (0x1UL << 1)
+#define DMA2D_CR_ABORT          (0x1UL << 2)
+#define DMA2D_CR_TEIE           (0x1UL << 8)
+#define DMA2D_CR_TCIE           (0x1UL << 9)
+#define DMA2D_CR_TWIE           (0x1UL << 10)
+#define DMA2D_CR_CAEIE          (0x1UL << 11)
+#define DMA2D_CR_CTCIE          (0x1UL << 12)
+#define DMA2D_CR_CEIE           (0x1UL << 13)
+#define DMA2D_CR_MODE           (0x3UL << 16)
+
+#define DMA2D_ISR_TEIF          (0x1UL << 0)
+#define DMA2D_ISR_TCIF          (0x1UL << 1)
+#define DMA2D_ISR_TWIF          (0x1UL << 2)
+#define DMA2D_ISR_CAEIF         (0x1UL << 3)
+#define DMA2D_ISR_CTCIF         (0x1UL << 4)
+#define DMA2D_ISR_CEIF          (0x1UL << 5)
+
+#define DMA2D_IFCR_CTEIF        (0x1UL << 0)
+#define DMA2D_IFCR_CTCIF        (0x1UL << 1)
+#define DMA2D_IFCR_CTWIF        (0x1UL << 2)
+#define DMA2D_IFCR_CAECIF       (0x1UL << 3)
+#define DMA2D_IFCR_CCTCIF       (0x1UL << 4)
+#define DMA2D_IFCR_CCEIF        (0x1UL << 5)
+
+/*Every access of the registers lets the model run first, like time passes on the real bus*/
+#define DMA2D   ((DMA2D_TypeDef *)(dma2d_model_sync(), &dma2d_model))
+
+/*DMA2D has 32 bit address registers, map the host pointers to 32 bit handles*/
+#define DMA2D_ADDR(p)   dma2d_model_addr(p)
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+typedef struct {
+    __IO uint32_t CR;
+    __IO uint32_t ISR;
+    __IO uint32_t IFCR;
+    __IO uint32_t FGMAR;
+    __IO uint32_t FGOR;
+    __IO uint32_t BGMAR;
+    __IO uint32_t BGOR;
+    __IO uint32_t FGPFCCR;
+    __IO uint32_t FGCOLR;
+    __IO uint32_t BGPFCCR;
+    __IO uint32_t BGCOLR;
+    __IO uint32_t FGCMAR;
+    __IO uint32_t BGCMAR;
+    __IO uint32_t OPFCCR;
+    __IO uint32_t OCOLR;
+    __IO uint32_t OMAR;
+    __IO uint32_t OOR;
+    __IO uint32_t NLR;
+    __IO uint32_t LWR;
+    __IO uint32_t AMTCR;
+    uint32_t RESERVED[236];
+    __IO uint32_t FGCLUT[256];
+    __IO uint32_t BGCLUT[256];
+} DMA2D_TypeDef;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+#include "dma2d_model.h"
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*STM32F4XX_HOST_H*/
@@ -0,0 +1,30 @@
+/**
+ * @file stm32f4xx_hal.h
+ * Host stand-in of the HAL: only the DMA2D definitions used by the BSP drivers.
+ * The values are the same as in `stm32f4xx_hal_dma2d.h`.
+ */
+
+#ifndef STM32F4XX_HAL_HOST_H
+#define STM32F4XX_HAL_HOST_H
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "stm32f4xx.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+#define DMA2D_M2M               0x00000000UL
+#define DMA2D_M2M_PFC           (0x1UL << 16)
+#define DMA2D_M2M_BLEND         (0x2UL << 16)
+#define DMA2D_R2M               DMA2D_CR_MODE
+
+#define DMA2D_FLAG_CE           DMA2D_ISR_CEIF
+#define DMA2D_FLAG_TC           DMA2D_ISR_TCIF
+#define DMA2D_FLAG_TE           DMA2D_ISR_TEIF
+
+/*The model has no clock gating*/
+#define __HAL_RCC_DMA2D_CLK_ENABLE()    do {} while(0)
+
+#endif /*STM32F4XX_HAL_HOST_H*/
@@ -0,0 +1,241 @@
+/**
+ * @file test_blend_asm.c
+ * The blend backends of `LV_USE_DRAW_SW_ASM` must give the same pixels as the plain C blending.
+ * The libraries are built with `HOST_DRAW_SW_ASM` (see host/lv_conf.h).
+ *
+ * Random fills and images are blended with random sizes, strides, alignments, opacities and masks.
+ * The C build writes a hash of the destination buffer of each case with `--write <file>`,
+ * the others compare theirs with `--compare <file>`. The buffers are hashed with the bytes around
+ * the blend area, so writing out of the area is found too.
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "test_common.h"
+#include "src/draw/sw/blend/lv_draw_sw_blend_private.h"
+#include "src/draw/sw/blend/lv_draw_sw_blend_to_rgb565.h"
+#include "src/draw/sw/blend/lv_draw_sw_blend_to_argb8888.h"
+#include "src/draw/sw/blend/lv_draw_sw_blend_to_rgb888.h"
+#include <string.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+#define AREA_W_MAX      70
+#define AREA_H_MAX      8
+#define ALIGN_MAX       4   /**< The buffers start 0..3 pixels after an aligned address*/
+#define STRIDE_EXTRA    6   /**< Unused pixels at the end of the lines*/
+
+#define BUF_SIZE        ((ALIGN_MAX + (AREA_W_MAX + STRIDE_EXTRA) * AREA_H_MAX) * 4)
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+typedef enum {
+    DEST_RGB565,
+    DEST_ARGB8888,
+    DEST_RGB888,
+    DEST_XRGB8888,
+    DEST_CNT,
+} dest_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void case_run(uint32_t idx, uint8_t * dest, uint8_t * src, uint8_t * mask);
+static uint32_t dest_px_size(dest_t dest);
+static uint64_t hash(const uint8_t * buf, uint32_t size);
+static void rnd_fill(uint8_t * buf, uint32_t size);
+static uint32_t rnd(uint32_t max);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static const lv_color_format_t src_cfs[] = {
+    LV_COLOR_FORMAT_RGB565, LV_COLOR_FORMAT_RGB888, LV_COLOR_FORMAT_XRGB8888, LV_COLOR_FORMAT_ARGB8888
+};
+
+static uint32_t rnd_state = 0x2545F491;
+static uint32_t case_fill_cnt;
+static uint32_t case_image_cnt;
+static uint64_t blend_ns;
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+int main(int argc, char ** argv)
+{
+    const char * write_path = NULL;
+    const char * compare_path = NULL;
+    int i;
+    for(i = 1; i + 1 < argc; i++) {
+        if(strcmp(argv[i], "--write") == 0) write_path = argv[i + 1];
+        if(strcmp(argv[i], "--compare") == 0) compare_path = argv[i + 1];
+    }
+
+    test_init(argc, argv);
+
+    FILE * f = NULL;
+    if(write_path) f = fopen(write_path, "wb");
+    if(compare_path) f = fopen(compare_path, "rb");
+    TEST_ASSERT(f != NULL || (write_path == NULL && compare_path == NULL));
+
+    /*64 bit aligned, the cases add the alignment offset*/
+    static uint64_t dest_buf[BUF_SIZE / 8];
+    static uint64_t src_buf[BUF_SIZE / 8];
+    static uint8_t mask_buf[(AREA_W_MAX + STRIDE_EXTRA) * AREA_H_MAX];
+
+    uint32_t case_cnt = test_quick() ? 20000 : 300000;
+    uint32_t mismatch_cnt = 0;
+    uint32_t c;
+    for(c = 0; c < case_cnt; c++) {
+        case_run(c, (uint8_t *)dest_buf, (uint8_t *)src_buf, mask_buf);
+
+        uint64_t h = hash((uint8_t *)dest_buf, BUF_SIZE);
+        if(f && write_path) {
+            TEST_ASSERT_EQUAL(sizeof(h), fwrite(&h, 1, sizeof(h), f));
+        }
+        else if(f && compare_path) {
+            uint64_t ref = 0;
+            TEST_ASSERT_EQUAL(sizeof(ref), fread(&ref, 1, sizeof(ref), f));
+            if(ref != h) {
+                if(mismatch_cnt < 10) printf("case %u: the pixels are different from the C blending\n", (unsigned)c);
+                mismatch_cnt++;
+            }
+        }
+    }
+
+    printf("LV_USE_DRAW_SW_ASM %d: %u fills, %u images, %.1f ms blending\n", LV_USE_DRAW_SW_ASM,
+           (unsigned)case_fill_cnt, (unsigned)case_image_cnt, blend_ns / 1e6);
+    TEST_ASSERT_EQUAL(0, mismatch_cnt);
+
+    if(f) fclose(f);
+
+    return test_finish("test_blend_asm");
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static void case_run(uint32_t idx, uint8_t * dest, uint8_t * src, uint8_t * mask)
+{
+    /*Every case starts from random pixels, the same ones in each build*/
+    rnd_fill(dest, BUF_SIZE);
+
+    dest_t dest_type = idx % DEST_CNT;
+    uint32_t px_size = dest_px_size(dest_type);
+    int32_t w = 1 + rnd(AREA_W_MAX);
+    int32_t h = 1 + rnd(AREA_H_MAX);
+    int32_t dest_stride = (w + rnd(STRIDE_EXTRA)) * px_size;
+    uint8_t * dest_start = dest + rnd(ALIGN_MAX) * px_size;
+
+    /*Mostly partly transparent, but the opaque special cases too*/
+    lv_opa_t opa = rnd(3) == 0 ? LV_OPA_COVER : (lv_opa_t)(LV_OPA_MIN + 1 + rnd(LV_OPA_COVER - LV_OPA_MIN));
+
+    /*Many 0 and 255 mask values: they are handled separately*/
+    const lv_opa_t * mask_start = NULL;
+    int32_t mask_stride = 0;
+    if(rnd(3)) {
+        mask_stride = w + rnd(STRIDE_EXTRA);
+        uint32_t i;
+        for(i = 0; i < (uint32_t)(mask_stride * h); i++) {
+            uint32_t r = rnd(4);
+            mask[i] = r == 0 ? LV_OPA_TRANSP : r == 1 ? LV_OPA_COVER : (lv_opa_t)rnd(256);
+        }
+        mask_start = mask;
+    }
+
+    if(rnd(2)) {
+        lv_draw_sw_blend_fill_dsc_t dsc;
+        lv_memzero(&dsc, sizeof(dsc));
+        dsc.dest_buf = dest_start;
+        dsc.dest_w = w;
+        dsc.dest_h = h;
+        dsc.dest_stride = dest_stride;
+        dsc.mask_buf = mask_start;
+        dsc.mask_stride = mask_stride;
+        dsc.color = lv_color_hex(rnd(0x1000000));
+        dsc.opa = opa;
+        lv_area_set(&dsc.relative_area, 0, 0, w - 1, h - 1);
+
+        uint64_t start = test_time_ns();
+        if(dest_type == DEST_RGB565) lv_draw_sw_blend_color_to_rgb565(&dsc);
+        else if(dest_type == DEST_ARGB8888) lv_draw_sw_blend_color_to_argb8888(&dsc);
+        else lv_draw_sw_blend_color_to_rgb888(&dsc, px_size);
+        blend_ns += test_time_ns() - start;
+        case_fill_cnt++;
+    }
+    else {
+        lv_color_format_t cf = src_cfs[rnd(sizeof(src_cfs) / sizeof(src_cfs[0]))];
+        uint32_t src_px_size = lv_color_format_get_size(cf);
+        int32_t src_stride = (w + rnd(STRIDE_EXTRA)) * src_px_size;
+        rnd_fill(src, BUF_SIZE);
+
+        lv_draw_sw_blend_image_dsc_t dsc;
+        lv_memzero(&dsc, sizeof(dsc));
+        dsc.dest_buf = dest_start;
+        dsc.dest_w = w;
+        dsc.dest_h = h;
+        dsc.dest_stride = dest_stride;
+        dsc.mask_buf = mask_start;
+        dsc.mask_stride = mask_stride;
+        dsc.src_buf = src + rnd(ALIGN_MAX) * src_px_size;
+        dsc.src_stride = src_stride;
+        dsc.src_color_format = cf;
+        dsc.opa = opa;
+        dsc.blend_mode = LV_BLEND_MODE_NORMAL;
+        lv_area_set(&dsc.relative_area, 0, 0, w - 1, h - 1);
+        lv_area_set(&dsc.src_area, 0, 0, w - 1, h - 1);
+
+        uint64_t start = test_time_ns();
+        if(dest_type == DEST_RGB565) lv_draw_sw_blend_image_to_rgb565(&dsc);
+        else if(dest_type == DEST_ARGB8888) lv_draw_sw_blend_image_to_argb8888(&dsc);
+        else lv_draw_sw_blend_image_to_rgb888(&dsc, px_size);
+        blend_ns += test_time_ns() - start;
+        case_image_cnt++;
+    }
+}
+
+static uint32_t dest_px_size(dest_t dest)
+{
+    switch(dest) {
+        case DEST_RGB565:
+            return 2;
+        case DEST_RGB888:
+            return 3;
+        default:
+            return 4;
+    }
+}
+
+/*FNV-1a*/
+static uint64_t hash(const uint8_t * buf, uint32_t size)
+{
+    uint64_t h = 0xcbf29ce484222325ULL;
+    uint32_t i;
+    for(i = 0; i < size; i++) {
+        h ^= buf[i];
+        h *= 0x100000001b3ULL;
+    }
+
+    return h;
+}
+
+static void rnd_fill(uint8_t * buf, uint32_t size)
+{
+    uint32_t i;
+    for(i = 0; i < size; i++) buf[i] = (uint8_t)rnd(256);
+}
+
+/*xorshift32*/
+static uint32_t rnd(uint32_t max)
+{
+    rnd_state ^= rnd_state << 13;
+    rnd_state ^= rnd_state >> 17;
+    rnd_state ^= rnd_state << 5;
+    return rnd_state % max;
+}
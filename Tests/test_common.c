@@ -0,0 +1,132 @@
+/**
+ * @file test_common.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "test_common.h"
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static uint32_t tick_get_cb(void);
+
+static void flush_cb(lv_display_t * disp, const lv_area_t * area, uint8_t * px_map);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static uint32_t tick;
+static int fail_cnt;
+static bool quick;
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void test_init(int argc, char ** argv)
+{
+    int i;
+    for(i = 1; i < argc; i++) {
+        if(strcmp(argv[i], "--quick") == 0) quick = true;
+    }
+
+    lv_init();
+    lv_tick_set_cb(tick_get_cb);
+}
+
+int test_finish(const char * name)
+{
+    lv_deinit();
+
+    if(fail_cnt) {
+        printf("%s: %d assertion(s) failed\n", name, fail_cnt);
+        return 1;
+    }
+
+    printf("%s: passed\n", name);
+    return 0;
+}
+
+bool test_quick(void)
+{
+    return quick;
+}
+
+void test_tick_inc(uint32_t ms)
+{
+    tick += ms;
+}
+
+lv_display_t * test_display_create(int32_t w, int32_t h)
+{
+    uint32_t buf_size = w * h * sizeof(uint16_t);
+    uint16_t * buf = malloc(buf_size);
+    memset(buf, 0, buf_size);
+
+    lv_display_t * disp = lv_display_create(w, h);
+    lv_display_set_color_format(disp, LV_COLOR_FORMAT_RGB565);
+    lv_display_set_flush_cb(disp, flush_cb);
+    lv_display_set_buffers(disp, buf, NULL, buf_size, LV_DISPLAY_RENDER_MODE_DIRECT);
+    lv_display_set_driver_data(disp, buf);
+
+#if LV_USE_SYSMON
+    /*The numbers change from run to run, don't draw them*/
+    lv_sysmon_hide_performance(disp);
+    lv_sysmon_hide_memory(disp);
+#endif
+
+    return disp;
+}
+
+uint16_t * test_display_pixels(lv_display_t * disp)
+{
+    return lv_display_get_driver_data(disp);
+}
+
+void test_display_redraw(lv_display_t * disp)
+{
+    lv_obj_invalidate(lv_display_get_screen_active(disp));
+    lv_refr_now(disp);
+}
+
+uint64_t test_time_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+void test_fail(const char * file, int line, const char * expr)
+{
+    printf("%s:%d: assertion failed: %s\n", file, line, expr);
+    fail_cnt++;
+}
+
+void test_fail_equal(const char * file, int line, const char * expr, long long expected, long long actual)
+{
+    printf("%s:%d: %s is %lld, expected %lld\n", file, line, expr, actual, expected);
+    fail_cnt++;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static uint32_t tick_get_cb(void)
+{
+    return tick;
+}
+
+static void flush_cb(lv_display_t * disp, const lv_area_t * area, uint8_t * px_map)
+{
+    LV_UNUSED(area);
+    LV_UNUSED(px_map);
+
+    lv_display_flush_ready(disp);
+}
@@ -0,0 +1,103 @@
+/**
+ * @file test_common.h
+ * Helpers shared by the host tests and benchmarks
+ */
+
+#ifndef TEST_COMMON_H
+#define TEST_COMMON_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lvgl.h"
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+
+#define TEST_ASSERT(cond) \
+    do { \
+        if(!(cond)) test_fail(__FILE__, __LINE__, #cond); \
+    } while(0)
+
+#define TEST_ASSERT_EQUAL(expected, actual) \
+    do { \
+        long long e_ = (long long)(expected); \
+        long long a_ = (long long)(actual); \
+        if(e_ != a_) test_fail_equal(__FILE__, __LINE__, #actual, e_, a_); \
+    } while(0)
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Initialize LVGL with a manual tick. Parses `--quick` from the arguments.
+ * @param argc  argument count of `main`
+ * @param argv  arguments of `main`
+ */
+void test_init(int argc, char ** argv);
+
+/**
+ * Deinitialize LVGL and report the result
+ * @param name  name of the test to print
+ * @return      exit code for `main`: 0 if all assertions passed
+ */
+int test_finish(const char * name);
+
+/**
+ * Check if the benchmark should run a short workload (ctest passes `--quick`)
+ * @return      true: run less iterations
+ */
+bool test_quick(void);
+
+/**
+ * Advance the tick seen by LVGL
+ * @param ms    milliseconds to add
+ */
+void test_tick_inc(uint32_t ms);
+
+/**
+ * Create a display which renders into a single screen sized RGB565 buffer in direct mode.
+ * The system monitors are hidden.
+ * @param w     horizontal resolution
+ * @param h     vertical resolution
+ * @return      the new display
+ */
+lv_display_t * test_display_create(int32_t w, int32_t h);
+
+/**
+ * Get the pixels of a display created by `test_display_create()`
+ * @param disp  pointer to a display
+ * @return      the RGB565 pixels, `w * h` of them
+ */
+uint16_t * test_display_pixels(lv_display_t * disp);
+
+/**
+ * Redraw the whole display now
+ * @param disp  pointer to a display
+ */
+void test_display_redraw(lv_display_t * disp);
+
+/**
+ * Get a monotonic time stamp
+ * @return      time in nanoseconds
+ */
+uint64_t test_time_ns(void);
+
+void test_fail(const char * file, int line, const char * expr);
+
+void test_fail_equal(const char * file, int line, const char * expr, long long expected, long long actual);
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*TEST_COMMON_H*/
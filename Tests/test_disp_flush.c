@@ -0,0 +1,280 @@
+/**
+ * @file test_disp_flush.c
+ * The asynchronous DMA2D flush of `lv_port_disp.c` on the RGB panel.
+ * DMA2D is the register model, finishing the transfers from a timer signal like the real one does
+ * in the background, and `DMA2D_IRQHandler` of the DMA2D driver calls `lv_display_flush_ready()`.
+ *
+ * Checked:
+ * - `lv_display_flush_ready()` is called once per flush and only when the area is in the framebuffer;
+ * - LVGL renders the next area while DMA2D copies the previous one;
+ * - the framebuffer is the same as with flushes which wait for DMA2D.
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "test_common.h"
+#include "lv_port_disp.h"
+#include "dma2d_model.h"
+#include "./BSP/LCD/ltdc.h"
+#include "src/display/lv_display_private.h"
+#include <stdlib.h>
+#include <string.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+#define HOR_RES             1024
+#define VER_RES             600
+
+/*About the speed of DMA2D copying from SRAM to SDRAM in RGB565 (~2 cycles per pixel at 180 MHz)*/
+#define DMA2D_PX_PER_US     90
+#define DMA2D_TICK_US       20
+
+#define REDRAW_CNT          3
+#define FLUSH_MAX           (REDRAW_CNT * (VER_RES / 10 + 1) + 16)
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+typedef struct {
+    lv_area_t area;
+    const uint8_t * px_map;
+    uint64_t finish_ns;         /**< `flush_cb` returned, the transfer is running*/
+    uint64_t render_end_ns;     /**< LVGL started to wait for the transfer: for the flush or for DMA2D*/
+    uint64_t ready_ns;          /**< `lv_display_flush_ready()` was called*/
+    volatile uint32_t ready_cnt;
+    volatile bool ready_in_fb;  /**< The area was in the framebuffer when it became ready*/
+} flush_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+void __real_lv_display_flush_ready(lv_display_t * disp);
+void __wrap_lv_display_flush_ready(lv_display_t * disp);
+uint8_t __real_ltdc_dma2d_wait(void);
+uint8_t __wrap_ltdc_dma2d_wait(void);
+
+static void scene_create(lv_obj_t * scr);
+static void event_cb(lv_event_t * e);
+static void render_end_mark(flush_t * f);
+static void flush_wait_dma2d_cb(lv_display_t * disp, const lv_area_t * area, uint8_t * px_map);
+static uint64_t redraw(lv_display_t * disp, uint32_t cnt);
+static bool area_in_fb(const lv_area_t * area, const uint8_t * px_map);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static flush_t flushes[FLUSH_MAX];
+static volatile uint32_t flush_cnt;
+static volatile uint32_t ready_without_flush;
+static bool logging;
+static lv_display_flush_cb_t port_flush_cb;
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+int main(int argc, char ** argv)
+{
+    test_init(argc, argv);
+
+    lv_port_disp_init();
+    lv_display_t * disp = lv_display_get_default();
+    TEST_ASSERT(disp != NULL);
+    TEST_ASSERT(lv_display_is_double_buffered(disp));
+
+#if LV_USE_SYSMON
+    lv_sysmon_hide_performance(disp);
+    lv_sysmon_hide_memory(disp);
+#endif
+
+    scene_create(lv_display_get_screen_active(disp));
+    lv_display_add_event_cb(disp, event_cb, LV_EVENT_ALL, NULL);
+
+    dma2d_model_set_speed(DMA2D_PX_PER_US);
+    dma2d_model_set_async(DMA2D_TICK_US);
+
+    /*Reference: each flush waits for its transfer*/
+    port_flush_cb = disp->flush_cb;
+    lv_display_set_flush_cb(disp, flush_wait_dma2d_cb);
+    uint64_t sync_ns = redraw(disp, REDRAW_CNT);
+
+    size_t fb_size = HOR_RES * VER_RES * sizeof(uint16_t);
+    uint16_t * ref = malloc(fb_size);
+    memcpy(ref, ltdc_host_front_buf(), fb_size);
+    memset(ltdc_host_front_buf(), 0, fb_size);
+
+    /*The port's flush: the transfer runs while LVGL renders the next area*/
+    lv_display_set_flush_cb(disp, port_flush_cb);
+    dma2d_model_stat_t stat_start;
+    dma2d_model_get_stat(&stat_start);
+    logging = true;
+    uint64_t async_ns = redraw(disp, REDRAW_CNT);
+    logging = false;
+    dma2d_model_stat_t stat;
+    dma2d_model_get_stat(&stat);
+
+    dma2d_model_set_async(0);
+
+    TEST_ASSERT(flush_cnt >= REDRAW_CNT * (VER_RES / 10));
+    TEST_ASSERT(flush_cnt <= FLUSH_MAX);
+    TEST_ASSERT_EQUAL(0, ready_without_flush);
+    TEST_ASSERT_EQUAL(0, stat.error_cnt - stat_start.error_cnt);
+    TEST_ASSERT_EQUAL(0, stat.abort_cnt - stat_start.abort_cnt);
+    /*Only the flushes use the DMA2D interrupt*/
+    TEST_ASSERT_EQUAL(flush_cnt, stat.irq_cnt - stat_start.irq_cnt);
+
+    uint64_t transfer_ns = 0;
+    uint64_t overlap_ns = 0;
+    uint32_t overlapped_cnt = 0;
+    uint32_t i;
+    for(i = 0; i < flush_cnt; i++) {
+        flush_t * f = &flushes[i];
+        TEST_ASSERT_EQUAL(1, f->ready_cnt);
+        TEST_ASSERT(f->ready_in_fb);
+        TEST_ASSERT(f->ready_ns >= f->finish_ns);
+
+        /*LVGL may render until the transfer ends*/
+        transfer_ns += f->ready_ns - f->finish_ns;
+        uint64_t end = f->render_end_ns && f->render_end_ns < f->ready_ns ? f->render_end_ns : f->ready_ns;
+        if(end > f->finish_ns) {
+            overlap_ns += end - f->finish_ns;
+            overlapped_cnt++;
+        }
+    }
+
+    /*Nearly all of them, the last flush of a frame has nothing to render after it*/
+    TEST_ASSERT(overlapped_cnt >= flush_cnt - REDRAW_CNT);
+    TEST_ASSERT(memcmp(ref, ltdc_host_front_buf(), fb_size) == 0);
+
+    printf("flushes: %u, DMA2D transfers of the draw unit: %u\n", (unsigned)flush_cnt,
+           (unsigned)(stat.transfer_cnt - stat_start.transfer_cnt - flush_cnt));
+    printf("rendering during the flush transfers: %u of %u flushes, %.1f%% of the transfer time\n",
+           (unsigned)overlapped_cnt, (unsigned)flush_cnt, transfer_ns ? 100.0 * overlap_ns / transfer_ns : 0.0);
+    printf("frame time: %.2f ms waiting for each flush, %.2f ms with the asynchronous flush\n",
+           sync_ns / 1e6 / REDRAW_CNT, async_ns / 1e6 / REDRAW_CNT);
+
+    free(ref);
+
+    return test_finish("test_disp_flush");
+}
+
+/*The port calls it from DMA2D_IRQHandler: check the framebuffer and note the time*/
+void __wrap_lv_display_flush_ready(lv_display_t * disp)
+{
+    if(logging) {
+        if(flush_cnt == 0) {
+            ready_without_flush++;
+        }
+        else {
+            flush_t * f = &flushes[flush_cnt - 1];
+            f->ready_ns = test_time_ns();
+            f->ready_in_fb = area_in_fb(&f->area, f->px_map);
+            f->ready_cnt++;
+        }
+    }
+
+    __real_lv_display_flush_ready(disp);
+}
+
+/*The DMA2D draw unit waits for the flush through the port, LVGL doesn't render meanwhile*/
+uint8_t __wrap_ltdc_dma2d_wait(void)
+{
+    if(logging && flush_cnt) render_end_mark(&flushes[flush_cnt - 1]);
+
+    return __real_ltdc_dma2d_wait();
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static void scene_create(lv_obj_t * scr)
+{
+    lv_obj_set_style_bg_color(scr, lv_color_hex(0x203040), 0);
+    lv_obj_set_style_bg_grad_color(scr, lv_color_hex(0x608090), 0);
+    lv_obj_set_style_bg_grad_dir(scr, LV_GRAD_DIR_VER, 0);
+
+    int32_t i;
+    for(i = 0; i < 12; i++) {
+        lv_obj_t * btn = lv_button_create(scr);
+        lv_obj_set_size(btn, 220, 70);
+        lv_obj_set_pos(btn, 30 + (i % 4) * 245, 40 + (i / 4) * 180);
+
+        lv_obj_t * label = lv_label_create(btn);
+        lv_label_set_text_fmt(label, "Button %d", (int)i);
+        lv_obj_center(label);
+
+        lv_obj_t * bar = lv_bar_create(scr);
+        lv_obj_set_size(bar, 220, 16);
+        lv_obj_set_pos(bar, 30 + (i % 4) * 245, 130 + (i / 4) * 180);
+        lv_bar_set_value(bar, 8 * i, LV_ANIM_OFF);
+    }
+}
+
+static void event_cb(lv_event_t * e)
+{
+    if(!logging) return;
+
+    lv_event_code_t code = lv_event_get_code(e);
+    lv_display_t * disp = lv_event_get_target(e);
+
+    if(code == LV_EVENT_FLUSH_START) {
+        if(flush_cnt >= FLUSH_MAX) return;
+        flush_t * f = &flushes[flush_cnt];
+        memset(f, 0, sizeof(*f));
+        f->area = *(lv_area_t *)lv_event_get_param(e);
+        f->px_map = disp->buf_act->data;
+        flush_cnt++;
+    }
+    else if(code == LV_EVENT_FLUSH_FINISH) {
+        flushes[flush_cnt - 1].finish_ns = test_time_ns();
+    }
+    else if(code == LV_EVENT_FLUSH_WAIT_START && flush_cnt) {
+        render_end_mark(&flushes[flush_cnt - 1]);
+    }
+}
+
+static void render_end_mark(flush_t * f)
+{
+    if(f->render_end_ns == 0 && f->ready_cnt == 0) f->render_end_ns = test_time_ns();
+}
+
+static void flush_wait_dma2d_cb(lv_display_t * disp, const lv_area_t * area, uint8_t * px_map)
+{
+    port_flush_cb(disp, area, px_map);
+    ltdc_dma2d_wait();
+}
+
+static uint64_t redraw(lv_display_t * disp, uint32_t cnt)
+{
+    uint64_t start = test_time_ns();
+
+    uint32_t i;
+    for(i = 0; i < cnt; i++) {
+        test_display_redraw(disp);
+    }
+
+    /*The last transfer*/
+    ltdc_dma2d_wait();
+    while(disp->flushing);
+
+    return test_time_ns() - start;
+}
+
+static bool area_in_fb(const lv_area_t * area, const uint8_t * px_map)
+{
+    const uint16_t * fb = ltdc_host_front_buf();
+    const uint16_t * px = (const uint16_t *)px_map;
+    int32_t w = lv_area_get_width(area);
+
+    int32_t y;
+    for(y = area->y1; y <= area->y2; y++) {
+        if(memcmp(&fb[y * HOR_RES + area->x1], px, w * sizeof(uint16_t))) return false;
+        px += w;
+    }
+
+    return true;
+}
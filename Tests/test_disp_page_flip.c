@@ -0,0 +1,212 @@
+/**
+ * @file test_disp_page_flip.c
+ * The page flipping of `lv_port_disp.c` on the RGB panel.
+ * LVGL renders directly into the LTDC framebuffers, `ltdc_framebuf_swap()` takes effect at the
+ * vertical blanking (a timer signal of the host LTDC) and only then is `lv_display_flush_ready()` called.
+ *
+ * A series of frames redraws small parts of the screen (text, bar, moved and scrolled objects).
+ * Checked:
+ * - after each frame the shown framebuffer is the same as a full redraw of the same screen;
+ * - a shown framebuffer is never changed until it's swapped out;
+ * - after the next refresh synchronizes the areas (`refr_sync_areas()`), the back buffer is the same
+ *   as the front buffer.
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "test_common.h"
+#include "lv_port_disp.h"
+#include "./BSP/LCD/ltdc.h"
+#include "src/display/lv_display_private.h"
+#include <string.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+#define HOR_RES             1024
+#define VER_RES             600
+
+/*A fast refresh rate to keep the test short*/
+#define VBLANK_PERIOD_US    2000
+
+#define FRAME_CNT           24
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+typedef struct {
+    lv_obj_t * label;
+    lv_obj_t * bar;
+    lv_obj_t * box;
+    lv_obj_t * list;
+} scene_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void scene_create(lv_obj_t * scr, scene_t * scene);
+static void scene_step(scene_t * scene, uint32_t frame);
+static void vblank_cb(const uint16_t * shown);
+static uint32_t fb_hash(const uint16_t * fb);
+static bool fb_equal(const uint16_t * a, const uint16_t * b, uint32_t frame);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static const uint16_t * last_shown;
+static uint32_t last_hash;
+static volatile uint32_t swap_cnt;
+static volatile uint32_t tear_cnt;
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+int main(int argc, char ** argv)
+{
+    test_init(argc, argv);
+
+    lv_port_disp_init();
+    lv_display_t * disp = lv_display_get_default();
+    TEST_ASSERT_EQUAL(LV_DISPLAY_RENDER_MODE_DIRECT, disp->render_mode);
+    TEST_ASSERT(disp->buf_1->data == (uint8_t *)g_ltdc_framebuf[1]);
+    TEST_ASSERT(disp->buf_2->data == (uint8_t *)g_ltdc_framebuf[0]);
+
+#if LV_USE_SYSMON
+    lv_sysmon_hide_performance(disp);
+    lv_sysmon_hide_memory(disp);
+#endif
+
+    /*The reference renders the whole screen in every frame*/
+    lv_display_t * ref = test_display_create(HOR_RES, VER_RES);
+
+    scene_t scene;
+    scene_t ref_scene;
+    scene_create(lv_display_get_screen_active(disp), &scene);
+    scene_create(lv_display_get_screen_active(ref), &ref_scene);
+
+    ltdc_host_set_vblank(VBLANK_PERIOD_US, vblank_cb);
+
+    lv_refr_now(disp);
+    while(disp->flushing);
+
+    uint32_t mismatch_cnt = 0;
+    uint32_t swap_start = swap_cnt;
+    uint32_t i;
+    for(i = 0; i < FRAME_CNT; i++) {
+        scene_step(&scene, i);
+        scene_step(&ref_scene, i);
+
+        lv_refr_now(disp);
+        /*Shown from the next blanking*/
+        while(disp->flushing);
+
+        test_display_redraw(ref);
+        if(!fb_equal(test_display_pixels(ref), ltdc_host_front_buf(), i)) mismatch_cnt++;
+    }
+
+    TEST_ASSERT_EQUAL(0, mismatch_cnt);
+    TEST_ASSERT_EQUAL(FRAME_CNT, swap_cnt - swap_start);
+
+    /*Nothing has changed: the next refresh only brings the back buffer up to date*/
+    lv_refr_now(disp);
+    while(disp->flushing);
+    TEST_ASSERT_EQUAL(FRAME_CNT, swap_cnt - swap_start);
+    TEST_ASSERT(fb_equal((uint16_t *)g_ltdc_framebuf[0], (uint16_t *)g_ltdc_framebuf[1], FRAME_CNT));
+
+    ltdc_host_set_vblank(0, NULL);
+    TEST_ASSERT_EQUAL(0, tear_cnt);
+
+    printf("frames: %u, swaps: %u, changed shown framebuffers: %u\n",
+           (unsigned)FRAME_CNT, (unsigned)(swap_cnt - swap_start), (unsigned)tear_cnt);
+
+    return test_finish("test_disp_page_flip");
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static void scene_create(lv_obj_t * scr, scene_t * scene)
+{
+    lv_obj_set_style_bg_color(scr, lv_color_hex(0x102030), 0);
+
+    scene->label = lv_label_create(scr);
+    lv_obj_set_pos(scene->label, 40, 30);
+    lv_obj_set_style_text_font(scene->label, &lv_font_montserrat_28, 0);
+    lv_obj_set_style_text_color(scene->label, lv_color_white(), 0);
+
+    scene->bar = lv_bar_create(scr);
+    lv_obj_set_size(scene->bar, 400, 24);
+    lv_obj_set_pos(scene->bar, 40, 100);
+
+    scene->box = lv_obj_create(scr);
+    lv_obj_set_size(scene->box, 80, 80);
+    lv_obj_set_pos(scene->box, 40, 200);
+    lv_obj_set_style_bg_color(scene->box, lv_palette_main(LV_PALETTE_ORANGE), 0);
+
+    scene->list = lv_list_create(scr);
+    lv_obj_set_size(scene->list, 360, 520);
+    lv_obj_set_pos(scene->list, 620, 40);
+
+    int32_t i;
+    for(i = 0; i < 40; i++) {
+        lv_list_add_button(scene->list, LV_SYMBOL_FILE, "List item");
+    }
+}
+
+static void scene_step(scene_t * scene, uint32_t frame)
+{
+    lv_label_set_text_fmt(scene->label, "Frame %u", (unsigned)frame);
+    lv_bar_set_value(scene->bar, (frame * 7) % 100, LV_ANIM_OFF);
+    lv_obj_set_x(scene->box, 40 + (frame * 23) % 400);
+
+    /*Mostly down (moved by DMA2D), sometimes back up (redrawn)*/
+    if(frame % 4 == 3) lv_obj_scroll_by(scene->list, 0, 50, LV_ANIM_OFF);
+    else lv_obj_scroll_by(scene->list, 0, -37, LV_ANIM_OFF);
+}
+
+/*The shown framebuffer must not change until an other one is shown*/
+static void vblank_cb(const uint16_t * shown)
+{
+    uint32_t hash = fb_hash(shown);
+
+    if(shown == last_shown) {
+        if(hash != last_hash) tear_cnt++;
+    }
+    else {
+        if(last_shown) swap_cnt++;
+        last_shown = shown;
+    }
+
+    last_hash = hash;
+}
+
+static uint32_t fb_hash(const uint16_t * fb)
+{
+    /*FNV-1a on 32 bit words*/
+    const uint32_t * p = (const uint32_t *)fb;
+    uint32_t hash = 2166136261u;
+    uint32_t i;
+    for(i = 0; i < HOR_RES * VER_RES / 2; i++) {
+        hash = (hash ^ p[i]) * 16777619u;
+    }
+
+    return hash;
+}
+
+static bool fb_equal(const uint16_t * a, const uint16_t * b, uint32_t frame)
+{
+    uint32_t i;
+    for(i = 0; i < HOR_RES * VER_RES; i++) {
+        if(a[i] != b[i]) {
+            printf("frame %u: first different pixel at (%u;%u): 0x%04x != 0x%04x\n", (unsigned)frame,
+                   (unsigned)(i % HOR_RES), (unsigned)(i / HOR_RES), a[i], b[i]);
+            return false;
+        }
+    }
+
+    return true;
+}
@@ -0,0 +1,504 @@
+/**
+ * @file test_dma2d_draw.c
+ * The DMA2D draw unit draws the same as the software renderer and takes only the tasks it supports.
+ * Each scene is drawn with DMA2D (on the register model) and again with DMA2D disabled,
+ * then the pixels and the tasks taken by the draw units are compared.
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "test_common.h"
+#include "dma2d_model.h"
+#include "src/core/lv_global.h"
+#include "src/draw/lv_draw_private.h"
+#include <stdlib.h>
+#include <string.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+#define HOR_RES         240
+#define VER_RES         160
+
+#define UNIT_DMA2D      0
+#define UNIT_SW         1
+#define UNIT_CNT        2
+
+#define TASK_TYPE_CNT   (LV_DRAW_TASK_TYPE_VECTOR + 1)
+
+#define IMG_W           32
+#define IMG_H           24
+
+/*DMA2D blends in ARGB8888 and truncates to RGB565 while the software renderer blends in RGB565.
+ *Measured: the channels differ by at most 2 LSB (green of anti-aliased glyphs and layers).*/
+#define MAX_CHANNEL_DIFF    2
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+typedef struct {
+    const char * name;
+    void (*create_cb)(lv_obj_t * scr);
+    lv_draw_task_type_t type;   /**< This many tasks of this type...*/
+    uint32_t cnt;
+    int unit;                   /**< ...are expected to be drawn by this unit*/
+} scene_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void units_init(void);
+static int32_t evaluate_cb(lv_draw_unit_t * draw_unit, lv_draw_task_t * task);
+static int32_t dispatch_cb(lv_draw_unit_t * draw_unit, lv_layer_t * layer);
+static void split_print(const char * name);
+
+static void images_init(void);
+static void image_init(lv_image_dsc_t * dsc, void * data, lv_color_format_t cf, uint32_t px_size);
+
+static lv_obj_t * rect_create(lv_obj_t * parent, int32_t x, int32_t y, uint32_t color, lv_opa_t opa);
+static void scene_fill(lv_obj_t * scr);
+static void scene_fill_rounded(lv_obj_t * scr);
+static void scene_fill_gradient(lv_obj_t * scr);
+static void scene_border(lv_obj_t * scr);
+static void scene_image(lv_obj_t * scr);
+static void scene_image_transformed(lv_obj_t * scr);
+static void scene_image_recolored(lv_obj_t * scr);
+static void scene_label(lv_obj_t * scr);
+static void scene_layer(lv_obj_t * scr);
+
+static void test_scene(lv_display_t * disp, const scene_t * scene);
+static void test_canvas_unsupported_cf(void);
+static void test_canvas_unsupported_stride(void);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static const char * unit_names[UNIT_CNT] = {"DMA2D", "SW"};
+static const char * task_type_names[TASK_TYPE_CNT] = {
+    "none", "fill", "border", "box shadow", "label", "image", "layer", "line", "arc",
+    "triangle", "mask rectangle", "mask bitmap", "vector"
+};
+
+static int32_t (*dma2d_evaluate_cb)(lv_draw_unit_t * draw_unit, lv_draw_task_t * task);
+static int32_t (*dispatch_cbs[UNIT_CNT])(lv_draw_unit_t * draw_unit, lv_layer_t * layer);
+static bool dma2d_enabled = true;
+static uint32_t split[UNIT_CNT][TASK_TYPE_CNT];
+
+static uint16_t img_rgb565_data[IMG_W * IMG_H];
+static uint32_t img_argb8888_data[IMG_W * IMG_H];
+static uint32_t img_xrgb8888_data[IMG_W * IMG_H];
+static uint8_t img_rgb888_data[IMG_W * IMG_H * 3];
+static lv_image_dsc_t img_rgb565;
+static lv_image_dsc_t img_argb8888;
+static lv_image_dsc_t img_xrgb8888;
+static lv_image_dsc_t img_rgb888;
+
+static const scene_t scenes[] = {
+    /*The background of the screen is a DMA2D fill in each scene*/
+    {"fill", scene_fill, LV_DRAW_TASK_TYPE_FILL, 6, UNIT_DMA2D},
+    {"rounded fill", scene_fill_rounded, LV_DRAW_TASK_TYPE_FILL, 2, UNIT_SW},
+    {"gradient fill", scene_fill_gradient, LV_DRAW_TASK_TYPE_FILL, 1, UNIT_SW},
+    {"border", scene_border, LV_DRAW_TASK_TYPE_BORDER, 1, UNIT_SW},
+    {"image", scene_image, LV_DRAW_TASK_TYPE_IMAGE, 12, UNIT_DMA2D},
+    {"transformed image", scene_image_transformed, LV_DRAW_TASK_TYPE_IMAGE, 2, UNIT_SW},
+    {"recolored image", scene_image_recolored, LV_DRAW_TASK_TYPE_IMAGE, 1, UNIT_SW},
+    {"label", scene_label, LV_DRAW_TASK_TYPE_LABEL, 4, UNIT_DMA2D},
+    {"layer", scene_layer, LV_DRAW_TASK_TYPE_LAYER, 1, UNIT_DMA2D},
+};
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+int main(int argc, char ** argv)
+{
+    test_init(argc, argv);
+    lv_display_t * disp = test_display_create(HOR_RES, VER_RES);
+    units_init();
+    images_init();
+
+    uint32_t i;
+    for(i = 0; i < sizeof(scenes) / sizeof(scenes[0]); i++) {
+        test_scene(disp, &scenes[i]);
+    }
+
+    test_canvas_unsupported_cf();
+    test_canvas_unsupported_stride();
+
+    return test_finish("test_dma2d_draw");
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Hook the draw units to disable DMA2D and to count the tasks drawn by each unit.
+ * The DMA2D unit is created last so it's the head of the list, the SW unit is after it.
+ */
+static void units_init(void)
+{
+    lv_draw_unit_t * u = LV_GLOBAL_DEFAULT()->draw_info.unit_head;
+    TEST_ASSERT(u && u->next && u->next->next == NULL);
+
+    dma2d_evaluate_cb = u->evaluate_cb;
+    u->evaluate_cb = evaluate_cb;
+
+    uint32_t i;
+    for(i = 0; i < UNIT_CNT; i++) {
+        dispatch_cbs[i] = u->dispatch_cb;
+        u->dispatch_cb = dispatch_cb;
+        u = u->next;
+    }
+}
+
+static int32_t evaluate_cb(lv_draw_unit_t * draw_unit, lv_draw_task_t * task)
+{
+    if(!dma2d_enabled) return 0;
+    return dma2d_evaluate_cb(draw_unit, task);
+}
+
+/**
+ * The units draw synchronously (no OS), so the queued tasks which are ready after
+ * the dispatch were drawn by the unit.
+ */
+static int32_t dispatch_cb(lv_draw_unit_t * draw_unit, lv_layer_t * layer)
+{
+    int unit = draw_unit == LV_GLOBAL_DEFAULT()->draw_info.unit_head ? UNIT_DMA2D : UNIT_SW;
+
+    static lv_draw_task_t * queued[256];
+    uint32_t queued_cnt = 0;
+    lv_draw_task_t * t;
+    for(t = layer->draw_task_head; t; t = t->next) {
+        if(t->state == LV_DRAW_TASK_STATE_QUEUED && queued_cnt < 256) queued[queued_cnt++] = t;
+    }
+
+    int32_t res = dispatch_cbs[unit](draw_unit, layer);
+
+    uint32_t i;
+    for(i = 0; i < queued_cnt; i++) {
+        if(queued[i]->state == LV_DRAW_TASK_STATE_READY) split[unit][queued[i]->type]++;
+    }
+
+    return res;
+}
+
+static void split_print(const char * name)
+{
+    printf("  %-18s", name);
+    uint32_t u;
+    for(u = 0; u < UNIT_CNT; u++) {
+        printf(" %s:", unit_names[u]);
+        uint32_t type;
+        bool any = false;
+        for(type = 0; type < TASK_TYPE_CNT; type++) {
+            if(split[u][type] == 0) continue;
+            printf(" %s %u", task_type_names[type], (unsigned)split[u][type]);
+            any = true;
+        }
+        printf(any ? ";" : " -;");
+    }
+    printf("\n");
+}
+
+static void images_init(void)
+{
+    uint32_t x, y;
+    for(y = 0; y < IMG_H; y++) {
+        for(x = 0; x < IMG_W; x++) {
+            uint32_t i = y * IMG_W + x;
+            uint8_t r = x * 255 / (IMG_W - 1);
+            uint8_t g = y * 255 / (IMG_H - 1);
+            uint8_t b = (x * y * 7) & 0xFF;
+            img_rgb565_data[i] = ((r >> 3) << 11) | ((g >> 2) << 5) | (b >> 3);
+            img_argb8888_data[i] = ((uint32_t)((x + y) * 255 / (IMG_W + IMG_H - 2)) << 24) | (r << 16) | (g << 8) | b;
+            /*The X byte is garbage, it must not be used as alpha*/
+            img_xrgb8888_data[i] = ((uint32_t)(i * 37) << 24) | (b << 16) | (r << 8) | g;
+            img_rgb888_data[i * 3 + 0] = g;
+            img_rgb888_data[i * 3 + 1] = b;
+            img_rgb888_data[i * 3 + 2] = r;
+        }
+    }
+
+    image_init(&img_rgb565, img_rgb565_data, LV_COLOR_FORMAT_RGB565, 2);
+    image_init(&img_argb8888, img_argb8888_data, LV_COLOR_FORMAT_ARGB8888, 4);
+    image_init(&img_xrgb8888, img_xrgb8888_data, LV_COLOR_FORMAT_XRGB8888, 4);
+    image_init(&img_rgb888, img_rgb888_data, LV_COLOR_FORMAT_RGB888, 3);
+}
+
+static void image_init(lv_image_dsc_t * dsc, void * data, lv_color_format_t cf, uint32_t px_size)
+{
+    lv_memzero(dsc, sizeof(lv_image_dsc_t));
+    dsc->header.magic = LV_IMAGE_HEADER_MAGIC;
+    dsc->header.cf = cf;
+    dsc->header.w = IMG_W;
+    dsc->header.h = IMG_H;
+    dsc->header.stride = IMG_W * px_size;
+    dsc->data_size = IMG_W * IMG_H * px_size;
+    dsc->data = data;
+}
+
+static lv_obj_t * rect_create(lv_obj_t * parent, int32_t x, int32_t y, uint32_t color, lv_opa_t opa)
+{
+    lv_obj_t * obj = lv_obj_create(parent);
+    lv_obj_remove_style_all(obj);
+    lv_obj_set_pos(obj, x, y);
+    lv_obj_set_size(obj, 70, 50);
+    lv_obj_set_style_bg_color(obj, lv_color_hex(color), 0);
+    lv_obj_set_style_bg_opa(obj, opa, 0);
+    return obj;
+}
+
+static void scene_fill(lv_obj_t * scr)
+{
+    rect_create(scr, 10, 10, 0xff0000, LV_OPA_COVER);
+    rect_create(scr, 40, 30, 0x00ff80, LV_OPA_50);
+    rect_create(scr, 70, 50, 0x3050f0, LV_OPA_20);
+    rect_create(scr, 100, 70, 0xffffff, 200);
+    rect_create(scr, 150, 100, 0x808000, 3);
+}
+
+static void scene_fill_rounded(lv_obj_t * scr)
+{
+    lv_obj_set_style_radius(rect_create(scr, 10, 10, 0xff0000, LV_OPA_COVER), 10, 0);
+    lv_obj_set_style_radius(rect_create(scr, 40, 30, 0x00ff80, LV_OPA_50), 20, 0);
+}
+
+static void scene_fill_gradient(lv_obj_t * scr)
+{
+    lv_obj_t * obj = rect_create(scr, 10, 10, 0xff0000, LV_OPA_COVER);
+    lv_obj_set_style_bg_grad_color(obj, lv_color_hex(0x0000ff), 0);
+    lv_obj_set_style_bg_grad_dir(obj, LV_GRAD_DIR_HOR, 0);
+}
+
+static void scene_border(lv_obj_t * scr)
+{
+    lv_obj_t * obj = rect_create(scr, 10, 10, 0, LV_OPA_TRANSP);
+    lv_obj_set_style_border_width(obj, 3, 0);
+    lv_obj_set_style_border_color(obj, lv_color_hex(0x40a0ff), 0);
+    lv_obj_set_style_border_opa(obj, LV_OPA_COVER, 0);
+}
+
+static void scene_image(lv_obj_t * scr)
+{
+    const lv_image_dsc_t * srcs[] = {&img_rgb565, &img_argb8888, &img_xrgb8888, &img_rgb888};
+    uint32_t i;
+    for(i = 0; i < 4; i++) {
+        lv_obj_t * img = lv_image_create(scr);
+        lv_image_set_src(img, srcs[i]);
+        lv_obj_set_pos(img, 10 + i * 50, 10);
+
+        img = lv_image_create(scr);
+        lv_image_set_src(img, srcs[i]);
+        lv_obj_set_pos(img, 10 + i * 50, 60);
+        lv_obj_set_style_image_opa(img, LV_OPA_60, 0);
+
+        /*Partly out of the screen*/
+        img = lv_image_create(scr);
+        lv_image_set_src(img, srcs[i]);
+        lv_obj_set_pos(img, -10 + i * 75, VER_RES - IMG_H / 2);
+    }
+}
+
+static void scene_image_transformed(lv_obj_t * scr)
+{
+    lv_obj_t * img = lv_image_create(scr);
+    lv_image_set_src(img, &img_rgb565);
+    lv_obj_set_pos(img, 30, 30);
+    lv_image_set_rotation(img, 300);
+
+    img = lv_image_create(scr);
+    lv_image_set_src(img, &img_argb8888);
+    lv_obj_set_pos(img, 120, 30);
+    lv_image_set_scale(img, 384);
+}
+
+static void scene_image_recolored(lv_obj_t * scr)
+{
+    lv_obj_t * img = lv_image_create(scr);
+    lv_image_set_src(img, &img_rgb565);
+    lv_obj_set_pos(img, 30, 30);
+    lv_obj_set_style_image_recolor(img, lv_color_hex(0xff0000), 0);
+    lv_obj_set_style_image_recolor_opa(img, LV_OPA_50, 0);
+}
+
+static void scene_label(lv_obj_t * scr)
+{
+    lv_obj_set_style_bg_color(scr, lv_color_hex(0x204060), 0);
+    lv_obj_set_style_bg_opa(scr, LV_OPA_COVER, 0);
+
+    lv_obj_t * label = lv_label_create(scr);
+    lv_label_set_text(label, "Voltage: 12.5V");
+    lv_obj_set_pos(label, 5, 5);
+    lv_obj_set_style_text_color(label, lv_color_hex(0xffffff), 0);
+
+    label = lv_label_create(scr);
+    lv_label_set_text(label, "AaBbQq 0123");
+    lv_obj_set_pos(label, 5, 40);
+    lv_obj_set_style_text_font(label, &lv_font_montserrat_32, 0);
+    lv_obj_set_style_text_color(label, lv_color_hex(0xffa000), 0);
+
+    label = lv_label_create(scr);
+    lv_label_set_text(label, "half opacity");
+    lv_obj_set_pos(label, 5, 100);
+    lv_obj_set_style_text_font(label, &lv_font_montserrat_24, 0);
+    lv_obj_set_style_text_opa(label, LV_OPA_50, 0);
+
+    /*Clipped by the screen*/
+    label = lv_label_create(scr);
+    lv_label_set_text(label, "clipped");
+    lv_obj_set_pos(label, HOR_RES - 40, VER_RES - 12);
+}
+
+static void scene_layer(lv_obj_t * scr)
+{
+    /*Small enough to be drawn in one part (LV_DRAW_LAYER_SIMPLE_BUF_SIZE)*/
+    lv_obj_t * cont = rect_create(scr, 20, 20, 0x00ff00, LV_OPA_COVER);
+    lv_obj_set_size(cont, 100, 50);
+    lv_obj_set_style_opa_layered(cont, LV_OPA_70, 0);
+    rect_create(cont, 10, 10, 0xff00ff, LV_OPA_50);
+    lv_obj_t * label = lv_label_create(cont);
+    lv_label_set_text(label, "layer");
+    lv_obj_set_pos(label, 50, 25);
+}
+
+static void test_scene(lv_display_t * disp, const scene_t * scene)
+{
+    uint32_t px_cnt = HOR_RES * VER_RES;
+    uint16_t * ref = malloc(px_cnt * sizeof(uint16_t));
+
+    lv_obj_t * scr = lv_screen_active();
+    lv_obj_clean(scr);
+    lv_obj_remove_style_all(scr);
+    lv_obj_set_style_bg_color(scr, lv_color_hex(0x405060), 0);
+    lv_obj_set_style_bg_opa(scr, LV_OPA_COVER, 0);
+    scene->create_cb(scr);
+
+    /*Draw with the software renderer only*/
+    dma2d_enabled = false;
+    lv_memzero(split, sizeof(split));
+    dma2d_model_reset_stat();
+    test_display_redraw(disp);
+    memcpy(ref, test_display_pixels(disp), px_cnt * sizeof(uint16_t));
+
+    dma2d_model_stat_t stat;
+    dma2d_model_get_stat(&stat);
+    TEST_ASSERT_EQUAL(0, stat.transfer_cnt);
+    TEST_ASSERT_EQUAL(0, split[UNIT_DMA2D][scene->type]);
+
+    dma2d_enabled = true;
+    lv_memzero(split, sizeof(split));
+    dma2d_model_reset_stat();
+    test_display_redraw(disp);
+
+    dma2d_model_get_stat(&stat);
+    TEST_ASSERT_EQUAL(0, stat.error_cnt);
+    TEST_ASSERT_EQUAL(0, stat.abort_cnt);
+
+    uint32_t diff_cnt = 0;
+    uint32_t max_diff = 0;
+    const uint16_t * act = test_display_pixels(disp);
+    uint32_t i;
+    for(i = 0; i < px_cnt; i++) {
+        if(act[i] == ref[i]) continue;
+        diff_cnt++;
+        int32_t dr = abs((int32_t)(act[i] >> 11) - (int32_t)(ref[i] >> 11));
+        int32_t dg = abs((int32_t)((act[i] >> 5) & 0x3F) - (int32_t)((ref[i] >> 5) & 0x3F));
+        int32_t db = abs((int32_t)(act[i] & 0x1F) - (int32_t)(ref[i] & 0x1F));
+        uint32_t d = LV_MAX3(dr, dg, db);
+        if(d > max_diff) max_diff = d;
+    }
+
+    split_print(scene->name);
+    printf("  %-18s %u transfers, %u of %u pixels differ, max. %u LSB\n", "",
+           (unsigned)stat.transfer_cnt, (unsigned)diff_cnt, (unsigned)px_cnt, (unsigned)max_diff);
+
+    TEST_ASSERT(max_diff <= MAX_CHANNEL_DIFF);
+    TEST_ASSERT_EQUAL(scene->cnt, split[scene->unit][scene->type]);
+    if(scene->unit == UNIT_DMA2D) {
+        TEST_ASSERT_EQUAL(0, split[UNIT_SW][scene->type]);
+        TEST_ASSERT(stat.transfer_cnt > 0);
+    }
+
+    free(ref);
+}
+
+/**
+ * DMA2D can't write L8, such a layer is drawn in software
+ */
+static void test_canvas_unsupported_cf(void)
+{
+    LV_DRAW_BUF_DEFINE_STATIC(buf, 40, 30, LV_COLOR_FORMAT_L8);
+    LV_DRAW_BUF_INIT_STATIC(buf);
+
+    lv_obj_t * canvas = lv_canvas_create(lv_screen_active());
+    lv_canvas_set_draw_buf(canvas, &buf);
+    lv_canvas_fill_bg(canvas, lv_color_black(), LV_OPA_COVER);
+
+    lv_memzero(split, sizeof(split));
+    dma2d_model_reset_stat();
+
+    lv_layer_t layer;
+    lv_canvas_init_layer(canvas, &layer);
+    lv_draw_rect_dsc_t dsc;
+    lv_draw_rect_dsc_init(&dsc);
+    dsc.bg_color = lv_color_white();
+    lv_area_t area = {5, 5, 20, 20};
+    lv_draw_rect(&layer, &dsc, &area);
+    lv_canvas_finish_layer(canvas, &layer);
+
+    dma2d_model_stat_t stat;
+    dma2d_model_get_stat(&stat);
+    split_print("L8 canvas");
+
+    TEST_ASSERT_EQUAL(1, split[UNIT_SW][LV_DRAW_TASK_TYPE_FILL]);
+    TEST_ASSERT_EQUAL(0, split[UNIT_DMA2D][LV_DRAW_TASK_TYPE_FILL]);
+    TEST_ASSERT_EQUAL(0, stat.transfer_cnt);
+    TEST_ASSERT_EQUAL(0xff, buf.data[10 * buf.header.stride + 10]);
+    TEST_ASSERT_EQUAL(0, buf.data[25 * buf.header.stride + 25]);
+
+    lv_obj_delete(canvas);
+}
+
+/**
+ * The line offsets of DMA2D are in pixels: a stride which is not a multiple of the pixel size
+ * can't be used. DMA2D takes the task but draws it in software.
+ */
+static void test_canvas_unsupported_stride(void)
+{
+    uint32_t stride = 40 * 3 + 1;
+    lv_draw_buf_t * buf = lv_draw_buf_create(40, 30, LV_COLOR_FORMAT_RGB888, stride);
+    TEST_ASSERT(buf && buf->header.stride == stride);
+
+    lv_obj_t * canvas = lv_canvas_create(lv_screen_active());
+    lv_canvas_set_draw_buf(canvas, buf);
+    lv_canvas_fill_bg(canvas, lv_color_black(), LV_OPA_COVER);
+
+    lv_memzero(split, sizeof(split));
+    dma2d_model_reset_stat();
+
+    lv_layer_t layer;
+    lv_canvas_init_layer(canvas, &layer);
+    lv_draw_rect_dsc_t dsc;
+    lv_draw_rect_dsc_init(&dsc);
+    dsc.bg_color = lv_color_hex(0x123456);
+    lv_area_t area = {5, 5, 20, 20};
+    lv_draw_rect(&layer, &dsc, &area);
+    lv_canvas_finish_layer(canvas, &layer);
+
+    dma2d_model_stat_t stat;
+    dma2d_model_get_stat(&stat);
+    split_print("RGB888 canvas");
+
+    TEST_ASSERT_EQUAL(1, split[UNIT_DMA2D][LV_DRAW_TASK_TYPE_FILL]);
+    TEST_ASSERT_EQUAL(0, stat.transfer_cnt);
+    const uint8_t * px = buf->data + 10 * stride + 10 * 3;
+    TEST_ASSERT_EQUAL(0x56, px[0]);
+    TEST_ASSERT_EQUAL(0x34, px[1]);
+    TEST_ASSERT_EQUAL(0x12, px[2]);
+
+    lv_obj_delete(canvas);
+    lv_draw_buf_destroy(buf);
+}
@@ -0,0 +1,172 @@
+/**
+ * @file test_draw_task_arena.c
+ * The draw tasks are allocated in an arena with at most LV_DRAW_TASK_ARENA_CHUNK_MAX chunks.
+ * When the chunks are full, e.g. because the tasks of a layer are not finished yet, the tasks are
+ * allocated with `lv_malloc` and all memory is freed when they are finished.
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "test_common.h"
+#include "src/core/lv_global.h"
+#include "src/draw/lv_draw_private.h"
+#include "src/misc/lv_arena.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+#define RECT_CNT    200
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void test_arena_chunk_max(void);
+#if LV_DRAW_TASK_ARENA_SIZE
+static void test_pending_layer(void);
+static void test_frames(void);
+static size_t heap_used(void);
+#endif
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+int main(int argc, char ** argv)
+{
+    test_init(argc, argv);
+    test_display_create(320, 240);
+
+    test_arena_chunk_max();
+#if LV_DRAW_TASK_ARENA_SIZE
+    test_pending_layer();
+    test_frames();
+#endif
+
+    return test_finish("test_draw_task_arena");
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/*The allocations are refused when all chunks are full and work again after a reset*/
+static void test_arena_chunk_max(void)
+{
+    lv_arena_t arena;
+    lv_arena_init(&arena, 512);
+    lv_arena_set_chunk_max(&arena, 2);
+
+    uint32_t i;
+    for(i = 0; i < 16; i++) TEST_ASSERT(lv_arena_alloc(&arena, 64) != NULL);
+    TEST_ASSERT(lv_arena_alloc(&arena, 64) == NULL);
+    TEST_ASSERT(lv_arena_alloc(&arena, 1024) == NULL);
+
+    lv_arena_stat_t stat;
+    lv_arena_get_stat(&arena, &stat);
+    TEST_ASSERT_EQUAL(2, stat.chunk_cnt);
+    TEST_ASSERT_EQUAL(2, stat.full_cnt);
+
+    lv_arena_reset(&arena);
+    TEST_ASSERT(lv_arena_alloc(&arena, 64) != NULL);
+    lv_arena_get_stat(&arena, &stat);
+    TEST_ASSERT_EQUAL(1, stat.chunk_cnt);
+
+    /*No limit*/
+    lv_arena_set_chunk_max(&arena, 0);
+    for(i = 0; i < 64; i++) TEST_ASSERT(lv_arena_alloc(&arena, 64) != NULL);
+    lv_arena_get_stat(&arena, &stat);
+    TEST_ASSERT(stat.chunk_cnt > 2);
+    TEST_ASSERT_EQUAL(2, stat.full_cnt);
+
+    lv_arena_destroy(&arena);
+}
+
+#if LV_DRAW_TASK_ARENA_SIZE
+
+/*The tasks of a canvas layer stay until the layer is finished, so the arena can't be reset meanwhile*/
+static void test_pending_layer(void)
+{
+    lv_arena_t * arena = &LV_GLOBAL_DEFAULT()->draw_info.task_arena;
+
+    lv_obj_t * canvas = lv_canvas_create(lv_screen_active());
+    LV_DRAW_BUF_DEFINE_STATIC(buf, 100, 100, LV_COLOR_FORMAT_RGB565);
+    LV_DRAW_BUF_INIT_STATIC(buf);
+    lv_canvas_set_draw_buf(canvas, &buf);
+    lv_refr_now(NULL);
+
+    size_t used_before = heap_used();
+    lv_arena_reset_stat(arena);
+
+    lv_layer_t layer;
+    lv_canvas_init_layer(canvas, &layer);
+
+    lv_draw_rect_dsc_t dsc;
+    lv_draw_rect_dsc_init(&dsc);
+    dsc.bg_color = lv_palette_main(LV_PALETTE_RED);
+    dsc.border_width = 2;
+    uint32_t i;
+    for(i = 0; i < RECT_CNT; i++) {
+        lv_area_t a = {(int32_t)(i % 90), (int32_t)(i % 90), (int32_t)(i % 90) + 9, (int32_t)(i % 90) + 9};
+        lv_draw_rect(&layer, &dsc, &a);
+    }
+
+    /*The arena didn't grow beyond the limit, the rest of the tasks are on the heap*/
+    lv_arena_stat_t stat;
+    lv_arena_get_stat(arena, &stat);
+    printf("%u tasks: %u chunks, %u bytes in the arena, %u allocations refused\n", (unsigned)RECT_CNT,
+           (unsigned)stat.chunk_cnt, (unsigned)stat.used_size, (unsigned)stat.full_cnt);
+#if LV_DRAW_TASK_ARENA_CHUNK_MAX
+    TEST_ASSERT(stat.chunk_cnt <= LV_DRAW_TASK_ARENA_CHUNK_MAX);
+    TEST_ASSERT(stat.full_cnt > 0);
+#endif
+
+    lv_canvas_finish_layer(canvas, &layer);
+
+    /*All tasks are freed, the arena is reset to its first chunk and the heap tasks are freed too*/
+    TEST_ASSERT_EQUAL(0, LV_GLOBAL_DEFAULT()->draw_info.task_cnt);
+    lv_arena_get_stat(arena, &stat);
+    TEST_ASSERT_EQUAL(0, stat.used_size);
+    TEST_ASSERT_EQUAL(1, stat.chunk_cnt);
+    TEST_ASSERT(heap_used() <= used_before);
+
+    lv_obj_delete(canvas);
+}
+
+/*Normal frames fit into the arena*/
+static void test_frames(void)
+{
+    lv_arena_t * arena = &LV_GLOBAL_DEFAULT()->draw_info.task_arena;
+
+    lv_obj_t * cont = lv_obj_create(lv_screen_active());
+    lv_obj_set_size(cont, 300, 220);
+    uint32_t i;
+    for(i = 0; i < 6; i++) {
+        lv_obj_t * btn = lv_button_create(cont);
+        lv_obj_set_pos(btn, (i % 3) * 90, (i / 3) * 60);
+        lv_label_set_text_fmt(lv_label_create(btn), "Button %u", (unsigned)i);
+    }
+
+    lv_arena_reset_stat(arena);
+    for(i = 0; i < 10; i++) {
+        lv_obj_invalidate(cont);
+        lv_refr_now(NULL);
+    }
+
+    lv_arena_stat_t stat;
+    lv_arena_get_stat(arena, &stat);
+    TEST_ASSERT_EQUAL(0, stat.full_cnt);
+    TEST_ASSERT(stat.reset_cnt >= 10);
+    TEST_ASSERT_EQUAL(0, LV_GLOBAL_DEFAULT()->draw_info.task_cnt);
+
+    lv_obj_delete(cont);
+}
+
+static size_t heap_used(void)
+{
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    return mon.total_size - mon.free_size;
+}
+
+#endif /*LV_DRAW_TASK_ARENA_SIZE*/
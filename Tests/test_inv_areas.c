@@ -0,0 +1,162 @@
+/**
+ * @file test_inv_areas.c
+ * The buffer of the invalidated areas grows on the heap up to LV_INV_BUF_MAX areas
+ * and the display uses its static buffer again after a frame which fits into it.
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "test_common.h"
+#include "src/core/lv_refr_private.h"
+#include "src/display/lv_display_private.h"
+#include "src/misc/lv_area_private.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+/*Large enough for more areas than LV_INV_BUF_MAX which are too far apart to be joined*/
+#define HOR_RES     2048
+#define VER_RES     1200
+#define AREA_SIZE   20
+#define AREA_STEP   80
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void test_grow_and_cap(lv_display_t * disp);
+static void test_shrink(lv_display_t * disp);
+static void test_busy_frames(lv_display_t * disp);
+static uint32_t inv_grid(lv_display_t * disp, uint32_t cnt);
+static bool is_covered(lv_display_t * disp, const lv_area_t * area);
+static void grid_area(uint32_t i, lv_area_t * area);
+static size_t heap_used(void);
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+int main(int argc, char ** argv)
+{
+    test_init(argc, argv);
+    lv_display_t * disp = test_display_create(HOR_RES, VER_RES);
+    lv_refr_now(disp);
+
+    test_grow_and_cap(disp);
+    test_shrink(disp);
+    test_busy_frames(disp);
+
+    return test_finish("test_inv_areas");
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/*The buffer doubles until LV_INV_BUF_MAX, the other areas are merged into the saved ones*/
+static void test_grow_and_cap(lv_display_t * disp)
+{
+    TEST_ASSERT(disp->inv_areas == disp->_static_inv_areas);
+
+    uint32_t cnt = inv_grid(disp, LV_INV_BUF_MAX + 100);
+    printf("%u areas: %u saved, buffer of %u\n", (unsigned)cnt, (unsigned)disp->inv_p, (unsigned)disp->inv_size);
+    TEST_ASSERT(cnt > LV_INV_BUF_MAX);
+    TEST_ASSERT_EQUAL(LV_INV_BUF_MAX, disp->inv_size);
+    TEST_ASSERT(disp->inv_p <= LV_INV_BUF_MAX);
+    TEST_ASSERT(disp->inv_areas != disp->_static_inv_areas);
+
+    /*Nothing is lost*/
+    uint32_t i;
+    for(i = 0; i < cnt; i++) {
+        lv_area_t a;
+        grid_area(i, &a);
+        TEST_ASSERT(is_covered(disp, &a));
+    }
+
+    /*The frame needed the large buffer, keep it for the next one*/
+    lv_refr_now(disp);
+    TEST_ASSERT_EQUAL(0, disp->inv_p);
+    TEST_ASSERT(disp->inv_areas != disp->_static_inv_areas);
+}
+
+/*A frame with a few areas gives the heap buffer back*/
+static void test_shrink(lv_display_t * disp)
+{
+    inv_grid(disp, 5);
+    TEST_ASSERT_EQUAL(5, disp->inv_p);
+    lv_refr_now(disp);
+
+    TEST_ASSERT(disp->inv_areas == disp->_static_inv_areas);
+    TEST_ASSERT(disp->inv_area_joined == disp->_static_inv_area_joined);
+    TEST_ASSERT_EQUAL(LV_INV_BUF_SIZE, disp->inv_size);
+
+    /*The static buffer works as before*/
+    inv_grid(disp, LV_INV_BUF_SIZE);
+    TEST_ASSERT_EQUAL(LV_INV_BUF_SIZE, disp->inv_p);
+    TEST_ASSERT(disp->inv_areas == disp->_static_inv_areas);
+    lv_refr_now(disp);
+}
+
+/*The heap is the same after bursts of invalidations*/
+static void test_busy_frames(lv_display_t * disp)
+{
+    size_t used_before = heap_used();
+
+    uint32_t i;
+    for(i = 0; i < 10; i++) {
+        inv_grid(disp, LV_INV_BUF_SIZE * 3);
+        lv_refr_now(disp);
+        inv_grid(disp, 3);
+        lv_refr_now(disp);
+    }
+
+    TEST_ASSERT(disp->inv_areas == disp->_static_inv_areas);
+    TEST_ASSERT(heap_used() <= used_before);
+}
+
+/**
+ * Invalidate areas on a grid
+ * @param disp      pointer to a display
+ * @param cnt       number of areas to invalidate
+ * @return          number of areas invalidated, at most the size of the grid
+ */
+static uint32_t inv_grid(lv_display_t * disp, uint32_t cnt)
+{
+    uint32_t grid_cnt = (HOR_RES / AREA_STEP) * (VER_RES / AREA_STEP);
+    if(cnt > grid_cnt) cnt = grid_cnt;
+
+    uint32_t i;
+    for(i = 0; i < cnt; i++) {
+        lv_area_t a;
+        grid_area(i, &a);
+        lv_inv_area(disp, &a);
+    }
+
+    return cnt;
+}
+
+static bool is_covered(lv_display_t * disp, const lv_area_t * area)
+{
+    uint32_t i;
+    for(i = 0; i < disp->inv_p; i++) {
+        if(disp->inv_area_joined[i]) continue;
+        if(lv_area_is_in(area, &disp->inv_areas[i], 0)) return true;
+    }
+    return false;
+}
+
+static void grid_area(uint32_t i, lv_area_t * area)
+{
+    uint32_t col_cnt = HOR_RES / AREA_STEP;
+    area->x1 = (int32_t)(i % col_cnt) * AREA_STEP;
+    area->y1 = (int32_t)(i / col_cnt) * AREA_STEP;
+    area->x2 = area->x1 + AREA_SIZE - 1;
+    area->y2 = area->y1 + AREA_SIZE - 1;
+}
+
+static size_t heap_used(void)
+{
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    return mon.total_size - mon.free_size;
+}
@@ -0,0 +1,467 @@
+/**
+ * @file test_mem_placement.c
+ * The placement of the allocations in the fast (internal SRAM) and the bulk (SDRAM) pool (LV_MEM_BULK_SIZE).
+ *
+ * First it's checked that large draw buffers go to the bulk pool and everything else to the fast one,
+ * a full pool falls back to the other one and `lv_realloc()` keeps the data when it moves a block across.
+ *
+ * Then a scene is rendered and the memory traffic is attributed to the pool of the accessed block:
+ * - the pixels of the blend functions as sequential runs (one run per row of the destination, source and mask)
+ * - every style property lookup of an object as 4 random word accesses (object, style list, style, value)
+ * - every allocation and free as 4 random word accesses of the TLSF headers and free lists
+ * The traffic is priced with the assumed latencies of the STM32F429's SRAM and SDRAM, once as placed
+ * and once as if both pools were in SDRAM (a single large pool).
+ * Memory outside of the pools (framebuffer, constant data) costs the same in both cases and is not counted.
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "test_common.h"
+#include "src/draw/sw/blend/lv_draw_sw_blend_private.h"
+#include "src/draw/sw/blend/lv_draw_sw_blend_to_rgb565.h"
+#include "src/draw/sw/blend/lv_draw_sw_blend_to_argb8888.h"
+#include <pthread.h>
+#include <string.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+#define BLOCK_MAX           8192
+#define HEAP_OUTSIDE        LV_MEM_PLACEMENT_CNT
+
+/*Assumed costs on the STM32F429 at 180 MHz in CPU cycles:
+ *the first access of a run and each 32 bytes of it*/
+#define SRAM_LATENCY        1
+#define SRAM_CYCLES_32B     8       /*32 bit AHB, no wait state*/
+#define SDRAM_LATENCY       12      /*FMC at 90 MHz: row activation and CAS latency*/
+#define SDRAM_CYCLES_32B    32      /*16 bit data bus at half of the CPU clock*/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+typedef struct {
+    lv_uintptr_t start;
+    size_t size;
+    lv_mem_placement_t placement;
+} block_t;
+
+typedef struct {
+    uint64_t run_cnt;
+    uint64_t byte_cnt;
+} traffic_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+void * __real_lv_malloc_core(size_t size);
+void * __wrap_lv_malloc_core(size_t size);
+void * __real_lv_malloc_placed_core(size_t size, lv_mem_placement_t placement);
+void * __wrap_lv_malloc_placed_core(size_t size, lv_mem_placement_t placement);
+void * __real_lv_realloc_core(void * p, size_t new_size);
+void * __wrap_lv_realloc_core(void * p, size_t new_size);
+void __real_lv_free_core(void * p);
+void __wrap_lv_free_core(void * p);
+lv_style_value_t __real_lv_obj_get_style_prop(const lv_obj_t * obj, lv_part_t part, lv_style_prop_t prop);
+lv_style_value_t __wrap_lv_obj_get_style_prop(const lv_obj_t * obj, lv_part_t part, lv_style_prop_t prop);
+void __real_lv_draw_sw_blend_color_to_rgb565(lv_draw_sw_blend_fill_dsc_t * dsc);
+void __wrap_lv_draw_sw_blend_color_to_rgb565(lv_draw_sw_blend_fill_dsc_t * dsc);
+void __real_lv_draw_sw_blend_color_to_argb8888(lv_draw_sw_blend_fill_dsc_t * dsc);
+void __wrap_lv_draw_sw_blend_color_to_argb8888(lv_draw_sw_blend_fill_dsc_t * dsc);
+void __real_lv_draw_sw_blend_image_to_rgb565(lv_draw_sw_blend_image_dsc_t * dsc);
+void __wrap_lv_draw_sw_blend_image_to_rgb565(lv_draw_sw_blend_image_dsc_t * dsc);
+void __real_lv_draw_sw_blend_image_to_argb8888(lv_draw_sw_blend_image_dsc_t * dsc);
+void __wrap_lv_draw_sw_blend_image_to_argb8888(lv_draw_sw_blend_image_dsc_t * dsc);
+
+static void test_draw_buf_placement(void);
+static void test_fast_fallback(void);
+static void test_bulk_fallback(void);
+static void simulate_scene(uint32_t frame_cnt);
+static uint64_t traffic_cost(const traffic_t * t, bool all_sdram);
+static void fill_pool(lv_mem_placement_t placement, void ** blocks, uint32_t block_max);
+static size_t used_size(lv_mem_placement_t placement);
+static void * alloc_added(void * p, size_t size);
+static void block_add(void * p, size_t size, lv_mem_placement_t placement);
+static block_t * block_find(const void * p);
+static uint32_t heap_of(const void * p);
+static void count_rows(const void * buf, int32_t stride, int32_t row_bytes, int32_t h);
+static void count_random(const void * p, uint32_t cnt);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static block_t blocks[BLOCK_MAX];
+static uint32_t block_cnt;
+static size_t used[LV_MEM_PLACEMENT_CNT];
+static size_t used_peak[LV_MEM_PLACEMENT_CNT];
+static traffic_t traffic[HEAP_OUTSIDE + 1];
+static uint32_t lookup_cnt;
+static uint32_t alloc_cnt;
+static pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+int main(int argc, char ** argv)
+{
+    test_init(argc, argv);
+    test_display_create(480, 272);
+
+    test_draw_buf_placement();
+    test_fast_fallback();
+    test_bulk_fallback();
+    simulate_scene(test_quick() ? 10 : 200);
+
+    return test_finish("test_mem_placement");
+}
+
+/*Every allocation of LVGL passes these, keep a list of the blocks and their pools*/
+void * __wrap_lv_malloc_core(size_t size)
+{
+    return alloc_added(__real_lv_malloc_core(size), size);
+}
+
+void * __wrap_lv_malloc_placed_core(size_t size, lv_mem_placement_t placement)
+{
+    return alloc_added(__real_lv_malloc_placed_core(size, placement), size);
+}
+
+void * __wrap_lv_realloc_core(void * p, size_t new_size)
+{
+    void * p_new = __real_lv_realloc_core(p, new_size);
+    if(p_new == NULL) return NULL;
+
+    pthread_mutex_lock(&lock);
+    block_t * b = block_find(p);
+    if(b) {
+        used[b->placement] -= b->size;
+        *b = blocks[--block_cnt];
+    }
+    block_add(p_new, new_size, lv_mem_get_placement(p_new));
+    count_random(p_new, 4);
+    pthread_mutex_unlock(&lock);
+    return p_new;
+}
+
+void __wrap_lv_free_core(void * p)
+{
+    pthread_mutex_lock(&lock);
+    count_random(p, 4);
+    block_t * b = block_find(p);
+    if(b) {
+        used[b->placement] -= b->size;
+        *b = blocks[--block_cnt];
+    }
+    pthread_mutex_unlock(&lock);
+
+    __real_lv_free_core(p);
+}
+
+lv_style_value_t __wrap_lv_obj_get_style_prop(const lv_obj_t * obj, lv_part_t part, lv_style_prop_t prop)
+{
+    pthread_mutex_lock(&lock);
+    count_random(obj, 4);
+    lookup_cnt++;
+    pthread_mutex_unlock(&lock);
+    return __real_lv_obj_get_style_prop(obj, part, prop);
+}
+
+void __wrap_lv_draw_sw_blend_color_to_rgb565(lv_draw_sw_blend_fill_dsc_t * dsc)
+{
+    count_rows(dsc->dest_buf, dsc->dest_stride, dsc->dest_w * 2, dsc->dest_h);
+    if(dsc->mask_buf) count_rows(dsc->mask_buf, dsc->mask_stride, dsc->dest_w, dsc->dest_h);
+    __real_lv_draw_sw_blend_color_to_rgb565(dsc);
+}
+
+void __wrap_lv_draw_sw_blend_color_to_argb8888(lv_draw_sw_blend_fill_dsc_t * dsc)
+{
+    count_rows(dsc->dest_buf, dsc->dest_stride, dsc->dest_w * 4, dsc->dest_h);
+    if(dsc->mask_buf) count_rows(dsc->mask_buf, dsc->mask_stride, dsc->dest_w, dsc->dest_h);
+    __real_lv_draw_sw_blend_color_to_argb8888(dsc);
+}
+
+void __wrap_lv_draw_sw_blend_image_to_rgb565(lv_draw_sw_blend_image_dsc_t * dsc)
+{
+    uint32_t src_px_size = lv_color_format_get_size(dsc->src_color_format);
+    count_rows(dsc->dest_buf, dsc->dest_stride, dsc->dest_w * 2, dsc->dest_h);
+    count_rows(dsc->src_buf, dsc->src_stride, dsc->dest_w * src_px_size, dsc->dest_h);
+    if(dsc->mask_buf) count_rows(dsc->mask_buf, dsc->mask_stride, dsc->dest_w, dsc->dest_h);
+    __real_lv_draw_sw_blend_image_to_rgb565(dsc);
+}
+
+void __wrap_lv_draw_sw_blend_image_to_argb8888(lv_draw_sw_blend_image_dsc_t * dsc)
+{
+    uint32_t src_px_size = lv_color_format_get_size(dsc->src_color_format);
+    count_rows(dsc->dest_buf, dsc->dest_stride, dsc->dest_w * 4, dsc->dest_h);
+    count_rows(dsc->src_buf, dsc->src_stride, dsc->dest_w * src_px_size, dsc->dest_h);
+    if(dsc->mask_buf) count_rows(dsc->mask_buf, dsc->mask_stride, dsc->dest_w, dsc->dest_h);
+    __real_lv_draw_sw_blend_image_to_argb8888(dsc);
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static void test_draw_buf_placement(void)
+{
+    size_t fast_start = used_size(LV_MEM_PLACEMENT_FAST);
+    size_t bulk_start = used_size(LV_MEM_PLACEMENT_BULK);
+
+    /*Only the pixels of a large buffer go to the bulk pool*/
+    lv_draw_buf_t * large = lv_draw_buf_create(100, 100, LV_COLOR_FORMAT_ARGB8888, 0);
+    TEST_ASSERT(large != NULL);
+    TEST_ASSERT_EQUAL(LV_MEM_PLACEMENT_BULK, lv_mem_get_placement(large->unaligned_data));
+    TEST_ASSERT_EQUAL(LV_MEM_PLACEMENT_FAST, lv_mem_get_placement(large));
+    TEST_ASSERT(used_size(LV_MEM_PLACEMENT_BULK) >= bulk_start + 100 * 100 * 4);
+    TEST_ASSERT(used_size(LV_MEM_PLACEMENT_FAST) < fast_start + 1024);
+
+    /*A small buffer stays in the fast pool*/
+    bulk_start = used_size(LV_MEM_PLACEMENT_BULK);
+    lv_draw_buf_t * small = lv_draw_buf_create(8, 8, LV_COLOR_FORMAT_ARGB8888, 0);
+    TEST_ASSERT(small != NULL);
+    TEST_ASSERT_EQUAL(LV_MEM_PLACEMENT_FAST, lv_mem_get_placement(small->unaligned_data));
+    TEST_ASSERT_EQUAL(bulk_start, used_size(LV_MEM_PLACEMENT_BULK));
+
+    /*The other allocations are fast*/
+    void * p = lv_malloc(2000);
+    TEST_ASSERT_EQUAL(LV_MEM_PLACEMENT_FAST, lv_mem_get_placement(p));
+    TEST_ASSERT_EQUAL(bulk_start, used_size(LV_MEM_PLACEMENT_BULK));
+
+    lv_free(p);
+    lv_draw_buf_destroy(small);
+    lv_draw_buf_destroy(large);
+    lv_draw_buf_pool_trim();
+}
+
+static void test_fast_fallback(void)
+{
+    static void * held[256];
+    lv_mem_monitor_t mon;
+    lv_mem_monitor_placed(&mon, LV_MEM_PLACEMENT_FAST);
+    size_t fallback_start = mon.fallback_cnt;
+
+    /*A block to move when the fast pool is full*/
+    uint8_t * data = lv_malloc(1000);
+    lv_memset(data, 0x5a, 1000);
+
+    fill_pool(LV_MEM_PLACEMENT_FAST, held, 256);
+
+    /*Allocating in the full fast pool falls back to the bulk pool*/
+    size_t bulk_start = used_size(LV_MEM_PLACEMENT_BULK);
+    void * p = lv_malloc(8192);
+    TEST_ASSERT(p != NULL);
+    TEST_ASSERT_EQUAL(LV_MEM_PLACEMENT_BULK, lv_mem_get_placement(p));
+    TEST_ASSERT(used_size(LV_MEM_PLACEMENT_BULK) >= bulk_start + 8192);
+
+    /*Growing a fast block moves it to the bulk pool with its data*/
+    data = lv_realloc(data, 16384);
+    TEST_ASSERT(data != NULL);
+    TEST_ASSERT_EQUAL(LV_MEM_PLACEMENT_BULK, lv_mem_get_placement(data));
+    uint32_t i;
+    for(i = 0; i < 1000; i++) {
+        if(data[i] != 0x5a) break;
+    }
+    TEST_ASSERT_EQUAL(1000, i);
+
+    lv_mem_monitor_placed(&mon, LV_MEM_PLACEMENT_FAST);
+    TEST_ASSERT_EQUAL(fallback_start + 2, mon.fallback_cnt);
+
+    lv_free(p);
+    lv_free(data);
+    for(i = 0; i < 256 && held[i]; i++) lv_free(held[i]);
+}
+
+static void test_bulk_fallback(void)
+{
+    static void * held[256];
+    lv_mem_monitor_t mon;
+    lv_mem_monitor_placed(&mon, LV_MEM_PLACEMENT_BULK);
+    size_t fallback_start = mon.fallback_cnt;
+
+    fill_pool(LV_MEM_PLACEMENT_BULK, held, 256);
+
+    /*A draw buffer goes to the fast pool if the bulk pool is full*/
+    size_t fast_start = used_size(LV_MEM_PLACEMENT_FAST);
+    void * p = lv_malloc_placed(8192, LV_MEM_PLACEMENT_BULK);
+    TEST_ASSERT(p != NULL);
+    TEST_ASSERT_EQUAL(LV_MEM_PLACEMENT_FAST, lv_mem_get_placement(p));
+    TEST_ASSERT(used_size(LV_MEM_PLACEMENT_FAST) >= fast_start + 8192);
+
+    lv_mem_monitor_placed(&mon, LV_MEM_PLACEMENT_BULK);
+    TEST_ASSERT_EQUAL(fallback_start + 1, mon.fallback_cnt);
+
+    lv_free(p);
+    uint32_t i;
+    for(i = 0; i < 256 && held[i]; i++) lv_free(held[i]);
+}
+
+static void simulate_scene(uint32_t frame_cnt)
+{
+    /*A list to scroll, a half transparent panel (a layer) and a rotated image from a draw buffer*/
+    lv_obj_t * list = lv_list_create(lv_screen_active());
+    lv_obj_set_size(list, 220, 260);
+    lv_obj_align(list, LV_ALIGN_LEFT_MID, 4, 0);
+    uint32_t i;
+    for(i = 0; i < 30; i++) {
+        lv_list_add_button(list, LV_SYMBOL_FILE, "Measurement");
+    }
+
+    lv_obj_t * panel = lv_obj_create(lv_screen_active());
+    lv_obj_set_size(panel, 230, 120);
+    lv_obj_align(panel, LV_ALIGN_TOP_RIGHT, -4, 4);
+    lv_obj_set_style_opa(panel, LV_OPA_70, 0);
+    lv_obj_t * label = lv_label_create(panel);
+    lv_label_set_text(label, "DC bus 220 V\nLoad 12.5 A");
+
+    lv_draw_buf_t * img_buf = lv_draw_buf_create(64, 64, LV_COLOR_FORMAT_ARGB8888, 0);
+    lv_draw_buf_clear(img_buf, NULL);
+    lv_obj_t * img = lv_image_create(lv_screen_active());
+    lv_image_set_src(img, img_buf);
+    lv_obj_align(img, LV_ALIGN_BOTTOM_RIGHT, -60, -40);
+
+    lv_refr_now(NULL);
+
+    pthread_mutex_lock(&lock);
+    lv_memzero(traffic, sizeof(traffic));
+    lookup_cnt = 0;
+    alloc_cnt = 0;
+    used_peak[LV_MEM_PLACEMENT_FAST] = used[LV_MEM_PLACEMENT_FAST];
+    used_peak[LV_MEM_PLACEMENT_BULK] = used[LV_MEM_PLACEMENT_BULK];
+    pthread_mutex_unlock(&lock);
+
+    for(i = 0; i < frame_cnt; i++) {
+        lv_obj_scroll_to_y(list, (i * 7) % 600, LV_ANIM_OFF);
+        lv_image_set_rotation(img, (i * 50) % 3600);
+        lv_label_set_text_fmt(label, "DC bus %u V\nLoad %u.%u A", 215 + i % 10, 12, i % 10);
+        test_tick_inc(33);
+        lv_timer_handler();
+        lv_refr_now(NULL);
+    }
+
+    pthread_mutex_lock(&lock);
+    uint64_t cost_placed = 0;
+    uint64_t cost_sdram = 0;
+    uint32_t h;
+    for(h = 0; h < LV_MEM_PLACEMENT_CNT; h++) {
+        static const char * const names[] = {"fast", "bulk"};
+        traffic_t * t = &traffic[h];
+        printf("%s pool: %8.0f runs, %10.0f bytes per frame, %6u bytes peak, %5.1f bytes accessed per byte\n", names[h],
+               (double)t->run_cnt / frame_cnt, (double)t->byte_cnt / frame_cnt, (unsigned)used_peak[h],
+               used_peak[h] ? (double)t->byte_cnt / frame_cnt / used_peak[h] : 0.0);
+        cost_placed += traffic_cost(t, false);
+        cost_sdram += traffic_cost(t, true);
+    }
+    printf("%.0f style lookups and %.0f allocations per frame\n", (double)lookup_cnt / frame_cnt,
+           (double)alloc_cnt / frame_cnt);
+    pthread_mutex_unlock(&lock);
+
+    printf("memory cycles per frame: %.0f placed, %.0f with both pools in SDRAM (%.1fx)\n",
+           (double)cost_placed / frame_cnt, (double)cost_sdram / frame_cnt, (double)cost_sdram / cost_placed);
+
+    /*The fast pool holds the data with more accesses per byte, so it's worth the SRAM*/
+    TEST_ASSERT(traffic[LV_MEM_PLACEMENT_BULK].byte_cnt > 0);
+    TEST_ASSERT(traffic[LV_MEM_PLACEMENT_FAST].byte_cnt * used_peak[LV_MEM_PLACEMENT_BULK] >
+                traffic[LV_MEM_PLACEMENT_BULK].byte_cnt * used_peak[LV_MEM_PLACEMENT_FAST]);
+    TEST_ASSERT(cost_placed < cost_sdram);
+    TEST_ASSERT(used_peak[LV_MEM_PLACEMENT_FAST] <= LV_MEM_SIZE);
+
+    lv_obj_clean(lv_screen_active());
+    lv_draw_buf_destroy(img_buf);
+}
+
+static uint64_t traffic_cost(const traffic_t * t, bool all_sdram)
+{
+    bool sdram = all_sdram || t == &traffic[LV_MEM_PLACEMENT_BULK];
+    uint64_t latency = sdram ? SDRAM_LATENCY : SRAM_LATENCY;
+    uint64_t cycles_32b = sdram ? SDRAM_CYCLES_32B : SRAM_CYCLES_32B;
+    return t->run_cnt * latency + (t->byte_cnt * cycles_32b + 31) / 32;
+}
+
+/*Allocate blocks until less than 4 kB is left in the pool*/
+static void fill_pool(lv_mem_placement_t placement, void ** held, uint32_t held_max)
+{
+    lv_memzero(held, held_max * sizeof(void *));
+    uint32_t i;
+    for(i = 0; i < held_max - 1; i++) {
+        lv_mem_monitor_t mon;
+        lv_mem_monitor_placed(&mon, placement);
+        if(mon.free_biggest_size < 4096) break;
+
+        held[i] = lv_malloc_placed(mon.free_biggest_size / 2, placement);
+        TEST_ASSERT_EQUAL(placement, lv_mem_get_placement(held[i]));
+    }
+}
+
+static size_t used_size(lv_mem_placement_t placement)
+{
+    lv_mem_monitor_t mon;
+    lv_mem_monitor_placed(&mon, placement);
+    return mon.total_size - mon.free_size;
+}
+
+static void * alloc_added(void * p, size_t size)
+{
+    if(p == NULL) return NULL;
+
+    /*If the pool was full the block is in the other one*/
+    pthread_mutex_lock(&lock);
+    block_add(p, size, lv_mem_get_placement(p));
+    count_random(p, 4);
+    alloc_cnt++;
+    pthread_mutex_unlock(&lock);
+    return p;
+}
+
+static void block_add(void * p, size_t size, lv_mem_placement_t placement)
+{
+    if(block_cnt >= BLOCK_MAX) return;
+    blocks[block_cnt].start = (lv_uintptr_t)p;
+    blocks[block_cnt].size = size;
+    blocks[block_cnt].placement = placement;
+    block_cnt++;
+
+    used[placement] += size;
+    if(used[placement] > used_peak[placement]) used_peak[placement] = used[placement];
+}
+
+static block_t * block_find(const void * p)
+{
+    uint32_t i;
+    for(i = 0; i < block_cnt; i++) {
+        if(blocks[i].start == (lv_uintptr_t)p) return &blocks[i];
+    }
+    return NULL;
+}
+
+/*The pool of the block containing an address or HEAP_OUTSIDE*/
+static uint32_t heap_of(const void * p)
+{
+    lv_uintptr_t a = (lv_uintptr_t)p;
+    uint32_t i;
+    for(i = 0; i < block_cnt; i++) {
+        if(a >= blocks[i].start && a < blocks[i].start + blocks[i].size) return blocks[i].placement;
+    }
+    return HEAP_OUTSIDE;
+}
+
+/*The blend functions are called from the draw thread*/
+static void count_rows(const void * buf, int32_t stride, int32_t row_bytes, int32_t h)
+{
+    if(h <= 0 || row_bytes <= 0) return;
+
+    pthread_mutex_lock(&lock);
+    traffic_t * t = &traffic[heap_of(buf)];
+    /*Consecutive rows are one run*/
+    t->run_cnt += stride == row_bytes ? 1 : h;
+    t->byte_cnt += (uint64_t)row_bytes * h;
+    pthread_mutex_unlock(&lock);
+}
+
+static void count_random(const void * p, uint32_t cnt)
+{
+    traffic_t * t = &traffic[heap_of(p)];
+    t->run_cnt += cnt;
+    t->byte_cnt += cnt * 4;
+}
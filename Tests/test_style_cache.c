@@ -0,0 +1,286 @@
+/**
+ * @file test_style_cache.c
+ * The cached style values (LV_OBJ_STYLE_VALUE_CACHE) are always the same as the resolved ones
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "test_common.h"
+#include "src/core/lv_global.h"
+#include "src/core/lv_obj_private.h"
+#include "src/core/lv_obj_style_private.h"
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static lv_obj_t * plain_obj_create(lv_obj_t * parent);
+static bool values_dropped(const lv_obj_t * obj);
+static void test_shared_style_change(void);
+static void test_local_style_change(void);
+static void test_refresh_style(void);
+static void test_state_change(void);
+static void test_inherit(void);
+static void test_screen_unload(void);
+static void test_max_cnt(void);
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+int main(int argc, char ** argv)
+{
+    test_init(argc, argv);
+    test_display_create(320, 240);
+
+    test_shared_style_change();
+    test_local_style_change();
+    test_refresh_style();
+    test_state_change();
+    test_inherit();
+    test_screen_unload();
+    test_max_cnt();
+
+    return test_finish("test_style_cache");
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/*No theme styles, so only the styles added by the test matter*/
+static lv_obj_t * plain_obj_create(lv_obj_t * parent)
+{
+    lv_obj_t * obj = lv_obj_create(parent);
+    lv_obj_remove_style_all(obj);
+    return obj;
+}
+
+static bool values_dropped(const lv_obj_t * obj)
+{
+    lv_obj_style_value_cache_t * cache;
+    for(cache = obj->style_value_cache; cache; cache = cache->next) {
+        if(cache->valid) return false;
+    }
+    return true;
+}
+
+static void test_shared_style_change(void)
+{
+    static lv_style_t style;
+    lv_style_init(&style);
+    lv_style_set_bg_opa(&style, LV_OPA_50);
+
+    lv_obj_t * obj = plain_obj_create(lv_screen_active());
+    lv_obj_add_style(obj, &style, 0);
+
+    lv_obj_style_value_cache_stat_t stat;
+    lv_obj_style_value_cache_reset_stat();
+    TEST_ASSERT_EQUAL(LV_OPA_50, lv_obj_get_style_bg_opa(obj, 0));
+    TEST_ASSERT_EQUAL(LV_OPA_50, lv_obj_get_style_bg_opa(obj, 0));
+    lv_obj_style_value_cache_get_stat(&stat);
+    TEST_ASSERT_EQUAL(1, stat.miss_cnt);
+    TEST_ASSERT_EQUAL(1, stat.hit_cnt);
+
+    /*Setting a property of a shared style is seen even without reporting it*/
+    lv_style_set_bg_opa(&style, LV_OPA_70);
+    TEST_ASSERT_EQUAL(LV_OPA_70, lv_obj_get_style_bg_opa(obj, 0));
+
+    lv_style_set_bg_opa(&style, LV_OPA_30);
+    lv_obj_report_style_change(&style);
+    TEST_ASSERT_EQUAL(LV_OPA_30, lv_obj_get_style_bg_opa(obj, 0));
+
+    lv_obj_remove_style(obj, &style, 0);
+    TEST_ASSERT_EQUAL(LV_OPA_TRANSP, lv_obj_get_style_bg_opa(obj, 0));
+
+    lv_obj_delete(obj);
+    lv_style_reset(&style);
+}
+
+static void test_local_style_change(void)
+{
+    lv_obj_t * obj = plain_obj_create(lv_screen_active());
+    lv_obj_t * other = plain_obj_create(lv_screen_active());
+    lv_obj_set_style_radius(other, 5, 0);
+
+    TEST_ASSERT_EQUAL(0, lv_obj_get_style_radius(obj, 0));
+    TEST_ASSERT_EQUAL(5, lv_obj_get_style_radius(other, 0));
+
+    lv_obj_set_style_radius(obj, 10, 0);
+    TEST_ASSERT_EQUAL(10, lv_obj_get_style_radius(obj, 0));
+    TEST_ASSERT_EQUAL(5, lv_obj_get_style_radius(other, 0));
+
+    /*The values of the other objects are kept*/
+    lv_obj_style_value_cache_stat_t stat;
+    lv_obj_style_value_cache_reset_stat();
+    TEST_ASSERT_EQUAL(5, lv_obj_get_style_radius(other, 0));
+    lv_obj_style_value_cache_get_stat(&stat);
+    TEST_ASSERT_EQUAL(1, stat.hit_cnt);
+
+    lv_obj_remove_local_style_prop(obj, LV_STYLE_RADIUS, 0);
+    TEST_ASSERT_EQUAL(0, lv_obj_get_style_radius(obj, 0));
+
+    lv_obj_delete(obj);
+    lv_obj_delete(other);
+}
+
+static void test_refresh_style(void)
+{
+    static lv_style_t style;
+    lv_style_init(&style);
+    lv_style_set_pad_left(&style, 3);
+
+    lv_obj_t * parent = plain_obj_create(lv_screen_active());
+    lv_obj_t * child = plain_obj_create(parent);
+    lv_obj_add_style(parent, &style, 0);
+    lv_obj_set_style_text_font(child, &lv_font_montserrat_14, 0);
+
+    TEST_ASSERT_EQUAL(3, lv_obj_get_style_pad_left(parent, 0));
+    lv_obj_get_style_text_font(child, 0);
+    TEST_ASSERT(!values_dropped(parent));
+    TEST_ASSERT(!values_dropped(child));
+
+    /*Change the style as if it was done without `lv_style_set_...`. Only `lv_obj_refresh_style` tells about it.*/
+    uint32_t gen = LV_GLOBAL_DEFAULT()->style_value_cache_gen;
+    lv_style_set_pad_left(&style, 8);
+    LV_GLOBAL_DEFAULT()->style_value_cache_gen = gen;
+    TEST_ASSERT_EQUAL(3, lv_obj_get_style_pad_left(parent, 0));
+
+    lv_obj_enable_style_refresh(false);
+    lv_obj_refresh_style(parent, LV_PART_ANY, LV_STYLE_PROP_ANY);
+    lv_obj_enable_style_refresh(true);
+    TEST_ASSERT(values_dropped(parent));
+    TEST_ASSERT(values_dropped(child));
+
+    lv_obj_refresh_style(parent, LV_PART_ANY, LV_STYLE_PROP_ANY);
+    TEST_ASSERT_EQUAL(8, lv_obj_get_style_pad_left(parent, 0));
+
+    lv_obj_delete(parent);
+    lv_style_reset(&style);
+}
+
+static void test_state_change(void)
+{
+    static lv_style_t style_pr;
+    lv_style_init(&style_pr);
+    lv_style_set_bg_color(&style_pr, lv_color_hex(0xff0000));
+
+    lv_obj_t * parent = plain_obj_create(lv_screen_active());
+    lv_obj_t * child = plain_obj_create(parent);
+    lv_obj_set_style_bg_color(parent, lv_color_hex(0x0000ff), 0);
+    lv_obj_add_style(parent, &style_pr, LV_STATE_PRESSED);
+    lv_obj_set_style_bg_color(child, lv_color_hex(0x00ff00), LV_PART_SCROLLBAR);
+
+    TEST_ASSERT_EQUAL(0x0000ff, lv_color_to_u32(lv_obj_get_style_bg_color(parent, 0)) & 0xffffff);
+    TEST_ASSERT_EQUAL(0x00ff00, lv_color_to_u32(lv_obj_get_style_bg_color(child, LV_PART_SCROLLBAR)) & 0xffffff);
+
+    lv_obj_add_state(parent, LV_STATE_PRESSED);
+    TEST_ASSERT_EQUAL(0xff0000, lv_color_to_u32(lv_obj_get_style_bg_color(parent, 0)) & 0xffffff);
+    TEST_ASSERT(values_dropped(child));
+
+    lv_obj_remove_state(parent, LV_STATE_PRESSED);
+    TEST_ASSERT_EQUAL(0x0000ff, lv_color_to_u32(lv_obj_get_style_bg_color(parent, 0)) & 0xffffff);
+
+    lv_obj_delete(parent);
+    lv_style_reset(&style_pr);
+}
+
+static void test_inherit(void)
+{
+    static lv_style_t style;
+    lv_style_init(&style);
+    lv_style_set_text_color(&style, lv_color_hex(0x123456));
+
+    lv_obj_t * parent = plain_obj_create(lv_screen_active());
+    lv_obj_t * child = plain_obj_create(parent);
+    lv_obj_t * grandchild = plain_obj_create(child);
+    lv_obj_set_style_text_color(parent, lv_color_hex(0x111111), 0);
+
+    TEST_ASSERT_EQUAL(0x111111, lv_color_to_u32(lv_obj_get_style_text_color(grandchild, 0)) & 0xffffff);
+
+    lv_obj_add_style(parent, &style, 0);
+    TEST_ASSERT_EQUAL(0x111111, lv_color_to_u32(lv_obj_get_style_text_color(grandchild, 0)) & 0xffffff);
+
+    lv_obj_remove_local_style_prop(parent, LV_STYLE_TEXT_COLOR, 0);
+    TEST_ASSERT_EQUAL(0x123456, lv_color_to_u32(lv_obj_get_style_text_color(grandchild, 0)) & 0xffffff);
+
+    /*Moving to an other parent changes the inherited value*/
+    lv_obj_t * parent2 = plain_obj_create(lv_screen_active());
+    lv_obj_set_style_text_color(parent2, lv_color_hex(0x654321), 0);
+    lv_obj_set_parent(child, parent2);
+    TEST_ASSERT_EQUAL(0x654321, lv_color_to_u32(lv_obj_get_style_text_color(grandchild, 0)) & 0xffffff);
+
+    lv_obj_delete(parent);
+    lv_obj_delete(parent2);
+    lv_style_reset(&style);
+}
+
+static void test_screen_unload(void)
+{
+    lv_obj_style_value_cache_stat_t stat;
+    lv_obj_style_value_cache_get_stat(&stat);
+    uint32_t part_cnt = stat.part_cnt;
+
+    lv_obj_t * scr_old = lv_screen_active();
+    lv_obj_t * scr_a = lv_obj_create(NULL);
+    lv_obj_t * scr_b = lv_obj_create(NULL);
+    lv_obj_t * obj_a = plain_obj_create(scr_a);
+    lv_obj_t * obj_b = plain_obj_create(scr_b);
+
+    lv_screen_load(scr_a);
+    test_display_redraw(lv_display_get_default());
+    lv_obj_get_style_radius(obj_a, 0);
+    TEST_ASSERT(scr_a->style_value_cache != NULL);
+    TEST_ASSERT(obj_a->style_value_cache != NULL);
+
+    lv_screen_load(scr_b);
+    test_display_redraw(lv_display_get_default());
+    TEST_ASSERT(scr_a->style_value_cache == NULL);
+    TEST_ASSERT(obj_a->style_value_cache == NULL);
+    TEST_ASSERT(scr_b->style_value_cache != NULL);
+
+    /*The same when the screen is loaded with an animation*/
+    lv_obj_get_style_radius(obj_b, 0);
+    lv_screen_load_anim(scr_a, LV_SCR_LOAD_ANIM_FADE_IN, 100, 0, false);
+    uint32_t i;
+    for(i = 0; i < 10; i++) {
+        test_tick_inc(33);
+        lv_timer_handler();
+    }
+    TEST_ASSERT(lv_screen_active() == scr_a);
+    TEST_ASSERT(scr_b->style_value_cache == NULL);
+    TEST_ASSERT(obj_b->style_value_cache == NULL);
+
+    /*The screen is usable after it was unloaded*/
+    lv_obj_set_style_radius(obj_b, 7, 0);
+    TEST_ASSERT_EQUAL(7, lv_obj_get_style_radius(obj_b, 0));
+
+    lv_screen_load(scr_old);
+    lv_obj_delete(scr_a);
+    lv_obj_delete(scr_b);
+
+    /*No records are lost*/
+    lv_obj_style_value_cache_get_stat(&stat);
+    TEST_ASSERT(stat.part_cnt <= part_cnt);
+}
+
+static void test_max_cnt(void)
+{
+    lv_obj_t * parent = plain_obj_create(lv_screen_active());
+    uint32_t i;
+    for(i = 0; i < LV_OBJ_STYLE_VALUE_CACHE_MAX_CNT * 2; i++) {
+        lv_obj_t * obj = plain_obj_create(parent);
+        lv_obj_set_style_pad_top(obj, i, 0);
+    }
+
+    /*The values are right for the objects which didn't get a cache too*/
+    for(i = 0; i < LV_OBJ_STYLE_VALUE_CACHE_MAX_CNT * 2; i++) {
+        TEST_ASSERT_EQUAL(i, lv_obj_get_style_pad_top(lv_obj_get_child(parent, i), 0));
+    }
+
+    lv_obj_style_value_cache_stat_t stat;
+    lv_obj_style_value_cache_get_stat(&stat);
+    TEST_ASSERT(stat.part_cnt <= LV_OBJ_STYLE_VALUE_CACHE_MAX_CNT);
+
+    lv_obj_delete(parent);
+}
@@ -0,0 +1,283 @@
+/**
+ * @file test_style_intern.c
+ * `lv_style_intern()` returns one shared style for the styles with the same properties and values
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "test_common.h"
+#include "src/core/lv_global.h"
+#include "src/core/lv_obj_private.h"
+#include "src/core/lv_obj_style_private.h"
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+void * __real_lv_realloc(void * data_p, size_t new_size);
+void * __wrap_lv_realloc(void * data_p, size_t new_size);
+
+static uint32_t shared_cnt(void);
+static void test_same_props(void);
+static void test_different_props(void);
+static void test_const_style(void);
+static void test_temporary_style(void);
+static void test_value_types(void);
+static void test_style_value_cache(void);
+static void test_out_of_memory(void);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static bool realloc_fail;
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+int main(int argc, char ** argv)
+{
+    test_init(argc, argv);
+    test_display_create(320, 240);
+
+    test_same_props();
+    test_different_props();
+    test_const_style();
+    test_temporary_style();
+    test_value_types();
+    test_style_value_cache();
+    test_out_of_memory();
+
+    return test_finish("test_style_intern");
+}
+
+void * __wrap_lv_realloc(void * data_p, size_t new_size)
+{
+    if(realloc_fail) return NULL;
+    return __real_lv_realloc(data_p, new_size);
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static uint32_t shared_cnt(void)
+{
+    return lv_ll_get_len(&LV_GLOBAL_DEFAULT()->style_intern_ll);
+}
+
+static void test_same_props(void)
+{
+    lv_style_t style1;
+    lv_style_init(&style1);
+    lv_style_set_bg_opa(&style1, LV_OPA_50);
+    lv_style_set_radius(&style1, 8);
+    lv_style_set_text_font(&style1, &lv_font_montserrat_14);
+
+    /*The same properties set in another order*/
+    lv_style_t style2;
+    lv_style_init(&style2);
+    lv_style_set_text_font(&style2, &lv_font_montserrat_14);
+    lv_style_set_radius(&style2, 8);
+    lv_style_set_bg_opa(&style2, LV_OPA_50);
+
+    uint32_t cnt = shared_cnt();
+    const lv_style_t * shared1 = lv_style_intern(&style1);
+    const lv_style_t * shared2 = lv_style_intern(&style2);
+    TEST_ASSERT(shared1 != NULL);
+    TEST_ASSERT(shared1 == shared2);
+    TEST_ASSERT(shared1 != &style1);
+    TEST_ASSERT_EQUAL(cnt + 1, shared_cnt());
+
+    /*The shared style has the same values*/
+    lv_style_value_t v;
+    TEST_ASSERT_EQUAL(LV_STYLE_RES_FOUND, lv_style_get_prop(shared1, LV_STYLE_RADIUS, &v));
+    TEST_ASSERT_EQUAL(8, v.num);
+    TEST_ASSERT_EQUAL(LV_STYLE_RES_FOUND, lv_style_get_prop(shared1, LV_STYLE_TEXT_FONT, &v));
+    TEST_ASSERT(v.ptr == &lv_font_montserrat_14);
+    TEST_ASSERT_EQUAL(3, shared1->prop_cnt);
+
+    /*Objects see the values of the shared style*/
+    lv_obj_t * obj = lv_obj_create(lv_screen_active());
+    lv_obj_remove_style_all(obj);
+    lv_obj_add_style(obj, shared1, 0);
+    TEST_ASSERT_EQUAL(8, lv_obj_get_style_radius(obj, 0));
+    TEST_ASSERT(lv_obj_get_style_text_font(obj, 0) == &lv_font_montserrat_14);
+    lv_obj_delete(obj);
+
+    lv_style_reset(&style1);
+    lv_style_reset(&style2);
+}
+
+static void test_different_props(void)
+{
+    lv_style_t style;
+    lv_style_init(&style);
+    lv_style_set_radius(&style, 3);
+    lv_style_set_pad_all(&style, 4);
+    const lv_style_t * shared = lv_style_intern(&style);
+
+    /*A different value*/
+    lv_style_t other;
+    lv_style_init(&other);
+    lv_style_set_radius(&other, 3);
+    lv_style_set_pad_all(&other, 5);
+    TEST_ASSERT(lv_style_intern(&other) != shared);
+
+    /*Less properties*/
+    lv_style_reset(&other);
+    lv_style_set_radius(&other, 3);
+    TEST_ASSERT(lv_style_intern(&other) != shared);
+
+    /*More properties*/
+    lv_style_set_pad_all(&other, 4);
+    lv_style_set_bg_opa(&other, LV_OPA_COVER);
+    TEST_ASSERT(lv_style_intern(&other) != shared);
+
+    /*The same value of another property*/
+    lv_style_reset(&other);
+    lv_style_set_radius(&other, 3);
+    lv_style_set_margin_top(&other, 4);
+    lv_style_set_margin_bottom(&other, 4);
+    lv_style_set_margin_left(&other, 4);
+    lv_style_set_margin_right(&other, 4);
+    TEST_ASSERT(lv_style_intern(&other) != shared);
+
+    lv_style_reset(&style);
+    lv_style_reset(&other);
+}
+
+static void test_const_style(void)
+{
+    static lv_style_const_prop_t props[] = {
+        LV_STYLE_CONST_TEXT_FONT(&lv_font_montserrat_28),
+        LV_STYLE_CONST_TEXT_LETTER_SPACE(2),
+        LV_STYLE_CONST_PROPS_END
+    };
+    LV_STYLE_CONST_INIT(const_style, props);
+
+    lv_style_t style;
+    lv_style_init(&style);
+    lv_style_set_text_letter_space(&style, 2);
+    lv_style_set_text_font(&style, &lv_font_montserrat_28);
+
+    const lv_style_t * shared = lv_style_intern(&const_style);
+    TEST_ASSERT(shared != NULL);
+    TEST_ASSERT(shared != &const_style);
+    TEST_ASSERT(!lv_style_is_const(shared));
+    TEST_ASSERT(lv_style_intern(&style) == shared);
+    TEST_ASSERT(lv_style_intern(&const_style) == shared);
+
+    lv_style_reset(&style);
+}
+
+static void test_temporary_style(void)
+{
+    const lv_style_t * shared;
+    {
+        lv_style_t tmp;
+        lv_style_init(&tmp);
+        lv_style_set_outline_width(&tmp, 6);
+        shared = lv_style_intern(&tmp);
+        lv_style_reset(&tmp);
+    }
+
+    /*The shared style doesn't depend on the temporary one*/
+    lv_style_value_t v;
+    TEST_ASSERT_EQUAL(LV_STYLE_RES_FOUND, lv_style_get_prop(shared, LV_STYLE_OUTLINE_WIDTH, &v));
+    TEST_ASSERT_EQUAL(6, v.num);
+
+    lv_style_t tmp;
+    lv_style_init(&tmp);
+    lv_style_set_outline_width(&tmp, 6);
+    TEST_ASSERT(lv_style_intern(&tmp) == shared);
+    lv_style_reset(&tmp);
+}
+
+static void test_value_types(void)
+{
+    /*Only the set member of the value is compared: the colors are 3 bytes of the union*/
+    lv_style_value_t v1;
+    lv_style_value_t v2;
+    lv_memset(&v1, 0x00, sizeof(v1));
+    lv_memset(&v2, 0xff, sizeof(v2));
+    v1.color = lv_color_hex(0x123456);
+    v2.color = lv_color_hex(0x123456);
+
+    lv_style_t style1;
+    lv_style_t style2;
+    lv_style_init(&style1);
+    lv_style_init(&style2);
+    lv_style_set_prop(&style1, LV_STYLE_BG_COLOR, v1);
+    lv_style_set_prop(&style2, LV_STYLE_BG_COLOR, v2);
+    TEST_ASSERT(lv_style_intern(&style1) == lv_style_intern(&style2));
+
+    /*The pointers are compared*/
+    lv_style_reset(&style1);
+    lv_style_reset(&style2);
+    lv_style_set_text_font(&style1, &lv_font_montserrat_14);
+    lv_style_set_text_font(&style2, &lv_font_montserrat_28);
+    TEST_ASSERT(lv_style_intern(&style1) != lv_style_intern(&style2));
+
+    lv_style_reset(&style1);
+    lv_style_reset(&style2);
+}
+
+static void test_style_value_cache(void)
+{
+#if LV_OBJ_STYLE_VALUE_CACHE
+    lv_obj_t * obj = lv_obj_create(lv_screen_active());
+    lv_obj_remove_style_all(obj);
+    lv_obj_set_style_radius(obj, 4, 0);
+    TEST_ASSERT_EQUAL(4, lv_obj_get_style_radius(obj, 0));
+
+    lv_obj_style_value_cache_stat_t stat;
+    lv_obj_style_value_cache_reset_stat();
+
+    /*Creating a new shared style from a constant style doesn't drop the cached values*/
+    static lv_style_const_prop_t props[] = {
+        LV_STYLE_CONST_BORDER_WIDTH(7),
+        LV_STYLE_CONST_PROPS_END
+    };
+    LV_STYLE_CONST_INIT(style, props);
+    TEST_ASSERT(lv_style_intern(&style) != NULL);
+
+    TEST_ASSERT_EQUAL(4, lv_obj_get_style_radius(obj, 0));
+    lv_obj_style_value_cache_get_stat(&stat);
+    TEST_ASSERT_EQUAL(1, stat.hit_cnt);
+    TEST_ASSERT_EQUAL(0, stat.miss_cnt);
+
+    lv_obj_delete(obj);
+#endif
+}
+
+static void test_out_of_memory(void)
+{
+    lv_style_t style;
+    lv_style_init(&style);
+    lv_style_set_shadow_width(&style, 11);
+    lv_style_set_shadow_spread(&style, 2);
+
+    uint32_t cnt = shared_cnt();
+
+    /*No memory for the properties: the partly copied style is freed.
+     *The first try can leave an empty size class page, so the heap is compared on the second one.*/
+    realloc_fail = true;
+    TEST_ASSERT(lv_style_intern(&style) == NULL);
+
+    lv_mem_monitor_t mon_start;
+    lv_mem_monitor(&mon_start);
+    TEST_ASSERT(lv_style_intern(&style) == NULL);
+    realloc_fail = false;
+    TEST_ASSERT_EQUAL(cnt, shared_cnt());
+
+    lv_mem_monitor_t mon_end;
+    lv_mem_monitor(&mon_end);
+    TEST_ASSERT_EQUAL(mon_start.total_size - mon_start.free_size, mon_end.total_size - mon_end.free_size);
+
+    /*With memory it works again*/
+    TEST_ASSERT(lv_style_intern(&style) != NULL);
+    TEST_ASSERT_EQUAL(cnt + 1, shared_cnt());
+
+    lv_style_reset(&style);
+}